@@ -10,25 +10,36 @@
  * - Random circuits
  * - Ripple-carry adder
  * - QAOA-style circuits
+ *
+ * Also times every registered pass on its own, compile() against
+ * compileCut() on circuits of independent blocks, and routing::compile()
+ * at each optimization level, exiting with status 1 if a level exceeds
+ * its compile-time budget. Budgets assume an optimized build: without
+ * NDEBUG (e.g. Debug or an empty CMAKE_BUILD_TYPE) they are reported but
+ * not enforced.
  */
 
 #include "ir/Circuit.hpp"
 #include "ir/DAG.hpp"
 #include "ir/Gate.hpp"
 #include "passes/PassManager.hpp"
-#include "passes/CancellationPass.hpp"
-#include "passes/CommutationPass.hpp"
-#include "passes/RotationMergePass.hpp"
-#include "passes/IdentityEliminationPass.hpp"
+#include "passes/AllPasses.hpp"
+#include "passes/OptimizationLevel.hpp"
+#include "passes/PassRegistry.hpp"
+#include "routing/CircuitCutting.hpp"
+#include "routing/Compiler.hpp"
+#include "routing/HierarchicalRouter.hpp"
 #include "routing/SabreRouter.hpp"
 #include "routing/Topology.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <random>
 #include <string>
+#include <tuple>
 #include <vector>
 
 using namespace qopt;
@@ -201,7 +212,8 @@ struct BenchmarkResult {
 BenchmarkResult runBenchmark(
     const std::string& name,
     ir::Circuit circuit,
-    const routing::Topology& topology) {
+    const routing::Topology& topology,
+    routing::Router& router) {
 
     BenchmarkResult result;
     result.name = name;
@@ -225,7 +237,6 @@ BenchmarkResult runBenchmark(
     // Routing
     auto route_start = std::chrono::high_resolution_clock::now();
 
-    routing::SabreRouter router;
     auto routing_result = router.route(circuit, topology);
 
     auto route_end = std::chrono::high_resolution_clock::now();
@@ -252,6 +263,14 @@ BenchmarkResult runBenchmark(
     return result;
 }
 
+BenchmarkResult runBenchmark(
+    const std::string& name,
+    ir::Circuit circuit,
+    const routing::Topology& topology) {
+    routing::SabreRouter router;
+    return runBenchmark(name, std::move(circuit), topology, router);
+}
+
 void printResults(const std::vector<BenchmarkResult>& results) {
     std::cout << "\n";
     std::cout << "================================================================================\n";
@@ -305,6 +324,161 @@ void printResults(const std::vector<BenchmarkResult>& results) {
               << "\n\n";
 }
 
+/**
+ * @brief Runs each registered pass, with default options, over the suite.
+ *
+ * @param suite (name, circuit, topology) triples
+ */
+void runPassBenchmarks(
+    const std::vector<std::tuple<std::string, ir::Circuit, routing::Topology>>& suite) {
+    std::cout << "Passes (default options, one run per circuit):\n";
+    std::cout << std::left << std::setw(12) << "Pass"
+              << std::setw(11) << "Cost"
+              << std::right << std::setw(10) << "Removed"
+              << std::setw(12) << "Time ms"
+              << std::setw(12) << "us/gate"
+              << "\n";
+    std::cout << std::string(57, '-') << "\n";
+
+    for (const auto* info : passes::PassRegistry::instance().passes()) {
+        std::size_t gates_in = 0;
+        std::size_t removed = 0;
+        double time_ms = 0.0;
+
+        for (const auto& [name, circuit, topology] : suite) {
+            passes::PassManager pm;
+            pm.addPass(info->factory({info->short_name, {}}));
+            ir::Circuit copy = circuit.clone();
+
+            auto start = std::chrono::high_resolution_clock::now();
+            pm.run(copy);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            time_ms += std::chrono::duration<double, std::milli>(end - start).count();
+            gates_in += circuit.numGates();
+            removed += circuit.numGates() - std::min(circuit.numGates(), copy.numGates());
+        }
+
+        std::cout << std::left << std::setw(12) << info->short_name
+                  << std::setw(11) << passes::toString(info->cost)
+                  << std::right << std::setw(10) << removed
+                  << std::setw(12) << std::fixed << std::setprecision(2) << time_ms
+                  << std::setw(12) << std::fixed << std::setprecision(3)
+                  << 1000.0 * time_ms / static_cast<double>(gates_in)
+                  << "\n";
+    }
+    std::cout << "\n";
+}
+
+/**
+ * @brief Compares compile() and compileCut() on circuits of independent blocks.
+ *
+ * Each circuit places `blocks` random circuits side by side on disjoint
+ * qubits, as batched or multi-programmed workloads do.
+ */
+void runCutBenchmarks() {
+    std::cout << "Circuit cutting (O2, 8x8 grid):\n";
+    std::cout << std::left << std::setw(16) << "Blocks"
+              << std::right << std::setw(12) << "SWAPs"
+              << std::setw(12) << "Cut SWAPs"
+              << std::setw(12) << "Time ms"
+              << std::setw(12) << "Cut ms"
+              << "\n";
+    std::cout << std::string(64, '-') << "\n";
+
+    const auto topology = routing::Topology::grid(8, 8);
+    for (auto [blocks, width] : std::vector<std::pair<std::size_t, std::size_t>>{{2, 16}, {4, 12}, {8, 6}}) {
+        ir::Circuit circuit(blocks * width);
+        for (std::size_t b = 0; b < blocks; ++b) {
+            for (const auto& gate : generateRandom(width, 40 * width, static_cast<unsigned>(b))) {
+                std::vector<QubitIndex> qubits;
+                for (auto q : gate.qubits()) qubits.push_back(q + b * width);
+                circuit.addGate(gate.withQubits(std::move(qubits)));
+            }
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto whole = routing::compile(circuit, topology, passes::OptimizationLevel::O2);
+        auto mid = std::chrono::high_resolution_clock::now();
+        auto cut = routing::compileCut(circuit, topology, passes::OptimizationLevel::O2);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << std::left << std::setw(16)
+                  << (std::to_string(blocks) + " x " + std::to_string(width) + "q")
+                  << std::right << std::setw(12) << whole.routing.swaps_inserted
+                  << std::setw(12) << cut.compiled.routing.swaps_inserted
+                  << std::setw(12) << std::fixed << std::setprecision(2)
+                  << std::chrono::duration<double, std::milli>(mid - start).count()
+                  << std::setw(12) << std::fixed << std::setprecision(2)
+                  << std::chrono::duration<double, std::milli>(end - mid).count()
+                  << "\n";
+    }
+    std::cout << "\n";
+}
+
+/**
+ * @brief Compiles every circuit at every level and checks the time budgets.
+ *
+ * @param suite (name, circuit, topology) triples
+ * @return true if every level stayed within compileBudgetMicrosPerGate(),
+ *         or if the benchmark was built without optimization
+ */
+bool runLevelBenchmarks(
+    const std::vector<std::tuple<std::string, ir::Circuit, routing::Topology>>& suite) {
+    using passes::OptimizationLevel;
+
+    std::cout << "Optimization levels:\n";
+    std::cout << std::left << std::setw(8) << "Level"
+              << std::right << std::setw(12) << "Gates out"
+              << std::setw(10) << "SWAPs"
+              << std::setw(12) << "Time ms"
+              << std::setw(12) << "us/gate"
+              << std::setw(12) << "Budget"
+              << "\n";
+    std::cout << std::string(66, '-') << "\n";
+
+    bool within_budget = true;
+    for (auto level : {OptimizationLevel::O0, OptimizationLevel::O1,
+                       OptimizationLevel::O2, OptimizationLevel::O3}) {
+        std::size_t gates_in = 0;
+        std::size_t gates_out = 0;
+        std::size_t swaps = 0;
+        double time_ms = 0.0;
+
+        for (const auto& [name, circuit, topology] : suite) {
+            auto start = std::chrono::high_resolution_clock::now();
+            auto result = routing::compile(circuit, topology, level);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            time_ms += std::chrono::duration<double, std::milli>(end - start).count();
+            gates_in += circuit.numGates();
+            gates_out += result.routing.routed_circuit.numGates();
+            swaps += result.routing.swaps_inserted;
+        }
+
+        const double per_gate = 1000.0 * time_ms / static_cast<double>(gates_in);
+        const double budget = passes::compileBudgetMicrosPerGate(level);
+        within_budget = within_budget && per_gate <= budget;
+
+        std::cout << std::left << std::setw(8) << passes::toString(level)
+                  << std::right << std::setw(12) << gates_out
+                  << std::setw(10) << swaps
+                  << std::setw(12) << std::fixed << std::setprecision(2) << time_ms
+                  << std::setw(12) << std::fixed << std::setprecision(3) << per_gate
+                  << std::setw(12) << std::fixed << std::setprecision(3) << budget
+                  << (per_gate <= budget ? "" : "  OVER BUDGET")
+                  << "\n";
+    }
+#ifdef NDEBUG
+    std::cout << "\n";
+    return within_budget;
+#else
+    std::cout << "Budgets not enforced: built without optimization "
+              << "(configure with -DCMAKE_BUILD_TYPE=Release)\n\n";
+    return true;
+#endif
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -313,38 +487,58 @@ int main() {
     std::cout << "Generating benchmark circuits...\n";
 
     std::vector<BenchmarkResult> results;
+    std::vector<std::tuple<std::string, ir::Circuit, routing::Topology>> suite;
 
     // QFT benchmarks
     for (std::size_t n : {4UL, 8UL, 12UL, 16UL}) {
         auto circuit = generateQFT(n);
         auto topology = routing::Topology::grid((n + 3) / 4, 4);
-        results.push_back(runBenchmark("QFT-" + std::to_string(n), std::move(circuit), topology));
+        suite.emplace_back("QFT-" + std::to_string(n), std::move(circuit), topology);
     }
 
     // Random circuit benchmarks
     for (auto [n, g] : std::vector<std::pair<std::size_t, std::size_t>>{{10, 100}, {20, 500}, {50, 1000}}) {
         auto circuit = generateRandom(n, g);
         auto topology = routing::Topology::grid((n + 4) / 5, 5);
-        results.push_back(runBenchmark("Random-" + std::to_string(n) + "x" + std::to_string(g),
-                                        std::move(circuit), topology));
+        suite.emplace_back("Random-" + std::to_string(n) + "x" + std::to_string(g),
+                           std::move(circuit), topology);
     }
 
     // Adder benchmarks
     for (std::size_t n : {4UL, 8UL, 16UL}) {
         auto circuit = generateAdder(n);
         auto topology = routing::Topology::linear(2 * n + 1);
-        results.push_back(runBenchmark("Adder-" + std::to_string(n), std::move(circuit), topology));
+        suite.emplace_back("Adder-" + std::to_string(n), std::move(circuit), topology);
     }
 
     // QAOA benchmarks
     for (auto [n, p] : std::vector<std::pair<std::size_t, std::size_t>>{{10, 2}, {10, 4}, {20, 2}}) {
         auto circuit = generateQAOA(n, p);
         auto topology = routing::Topology::ring(n);
-        results.push_back(runBenchmark("QAOA-" + std::to_string(n) + "-p" + std::to_string(p),
-                                        std::move(circuit), topology));
+        suite.emplace_back("QAOA-" + std::to_string(n) + "-p" + std::to_string(p),
+                           std::move(circuit), topology);
+    }
+
+    for (const auto& [name, circuit, topology] : suite) {
+        results.push_back(runBenchmark(name, circuit.clone(), topology));
+    }
+
+    // Large-device benchmarks: wide front layers on 256- and 1024-qubit grids
+    for (std::size_t side : {16UL, 32UL}) {
+        std::size_t n = side * side;
+        auto circuit = generateRandom(n, 4 * n);
+        auto topology = routing::Topology::grid(side, side);
+        results.push_back(runBenchmark("Random-" + std::to_string(n) + "x" + std::to_string(4 * n),
+                                        circuit.clone(), topology));
+
+        routing::HierarchicalRouter hierarchical(64);
+        results.push_back(runBenchmark("Hier-" + std::to_string(n) + "x" + std::to_string(4 * n),
+                                        std::move(circuit), topology, hierarchical));
     }
 
     printResults(results);
+    runPassBenchmarks(suite);
+    runCutBenchmarks();
 
-    return 0;
+    return runLevelBenchmarks(suite) ? 0 : 1;
 }
@@ -7,7 +7,13 @@
  *
  * Provides the Circuit class for building and manipulating quantum circuits.
  * Circuits consist of a qubit register and a sequence of gates. The class
- * supports iteration, gate management, and circuit metrics.
+ * supports iteration, gate management, and circuit metrics. Symbolic gate
+ * parameters live in the circuit's ParameterTable until bind() substitutes
+ * values for them.
+ *
+ * Gates are stored in fixed-size chunks shared copy-on-write between a
+ * circuit and its clones, so clone() is O(1) and a later mutation copies
+ * only the chunk it touches.
  *
  * @see Gate.hpp for gate representation
  * @see DAG.hpp for dependency graph representation (Sprint 1B)
@@ -16,22 +22,76 @@
 #pragma once
 
 #include "Gate.hpp"
+#include "Parameter.hpp"
 #include "Qubit.hpp"
 #include "Types.hpp"
 
 #include <algorithm>
+#include <iterator>
+#include <memory>
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace qopt::ir {
 
+/**
+ * @brief Calculates the depth of a gate sequence.
+ *
+ * Depth is the maximum number of gates on any single wire. Measurements
+ * writing the same classical bit are ordered, so classical bits count as
+ * wires too. Shared by Circuit::depth() and CircuitView::depth().
+ *
+ * @param gates Any range of gates, in application order
+ * @param num_qubits Size of the qubit register the gates refer to
+ * @param num_clbits Size of the classical register
+ * @return Depth (0 for an empty range)
+ */
+template <typename GateRange>
+[[nodiscard]] std::size_t depthOf(const GateRange& gates, std::size_t num_qubits,
+                                  std::size_t num_clbits) {
+    // Track depth at each qubit, then each classical bit
+    std::vector<std::size_t> wire_depths(num_qubits + num_clbits, 0);
+    std::size_t depth = 0;
+
+    for (const Gate& g : gates) {
+        // Find max depth among wires this gate touches
+        std::size_t max_depth = 0;
+        for (auto q : g.qubits()) {
+            max_depth = std::max(max_depth, wire_depths[q]);
+        }
+        if (g.clbit().has_value()) {
+            max_depth = std::max(max_depth, wire_depths[num_qubits + *g.clbit()]);
+        }
+
+        // Update all touched wires to new depth
+        for (auto q : g.qubits()) {
+            wire_depths[q] = max_depth + 1;
+        }
+        if (g.clbit().has_value()) {
+            wire_depths[num_qubits + *g.clbit()] = max_depth + 1;
+        }
+        depth = std::max(depth, max_depth + 1);
+    }
+
+    return depth;
+}
+
 /**
  * @brief A quantum circuit consisting of qubits and gates.
  *
  * Circuits are containers for quantum gates applied to a fixed-size qubit
- * register. Gates are stored in application order and can be iterated.
+ * register, plus an optional classical register written by measurements.
+ * Gates are stored in application order and can be iterated.
+ *
+ * Storage is a list of chunks of CHUNK_SIZE gates held by shared pointers.
+ * clone() shares the list; a mutating call first makes the list and the
+ * affected chunk unique (copying them if shared), so snapshots stay
+ * unchanged and cost memory only for the chunks that diverge. As with
+ * std::shared_ptr, distinct Circuit objects sharing storage may be used
+ * from different threads.
  *
  * Example:
  * @code
@@ -46,16 +106,59 @@ namespace qopt::ir {
  */
 class Circuit {
 public:
-    using iterator = std::vector<Gate>::iterator;
-    using const_iterator = std::vector<Gate>::const_iterator;
+    /// @brief Number of gates per storage chunk (a power of two).
+    static constexpr std::size_t CHUNK_SIZE = 256;
+
+    /// @brief Read-only iterator over the gates in application order.
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Gate;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Gate*;
+        using reference = const Gate&;
+
+        const_iterator() = default;
+
+        [[nodiscard]] reference operator*() const { return (*circuit_)[index_]; }
+        [[nodiscard]] pointer operator->() const { return &(*circuit_)[index_]; }
+
+        const_iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            const_iterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        [[nodiscard]] bool operator==(const const_iterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        [[nodiscard]] bool operator!=(const const_iterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        friend class Circuit;
+        const_iterator(const Circuit* circuit, std::size_t index) noexcept
+            : circuit_(circuit), index_(index) {}
+
+        const Circuit* circuit_ = nullptr;
+        std::size_t index_ = 0;
+    };
+    using iterator = const_iterator;
 
     /**
-     * @brief Constructs an empty circuit with the specified number of qubits.
+     * @brief Constructs an empty circuit with the specified register sizes.
      * @param num_qubits Number of qubits in the circuit register
+     * @param num_clbits Number of classical bits (default: none)
      * @throws std::invalid_argument if num_qubits is 0 or exceeds MAX_QUBITS
      */
-    explicit Circuit(std::size_t num_qubits)
+    explicit Circuit(std::size_t num_qubits, std::size_t num_clbits = 0)
         : num_qubits_(num_qubits)
+        , num_clbits_(num_clbits)
         , next_gate_id_(0)
     {
         if (num_qubits == 0) {
@@ -85,12 +188,14 @@ public:
     /**
      * @brief Adds a gate to the circuit.
      * @param gate The gate to add
-     * @throws std::out_of_range if gate references qubit beyond circuit size
+     * @throws std::out_of_range if gate references a qubit or classical bit
+     *         beyond circuit size, or a parameter expression missing from
+     *         parameterTable()
      */
     void addGate(Gate gate) {
         validateGateQubits(gate);
         gate.setId(next_gate_id_++);
-        gates_.push_back(std::move(gate));
+        appendGate(std::move(gate));
     }
 
     /**
@@ -100,42 +205,57 @@ public:
      * @throws std::out_of_range if index >= numGates()
      */
     [[nodiscard]] const Gate& gate(std::size_t index) const {
-        if (index >= gates_.size()) {
-            throw std::out_of_range(
-                "Gate index " + std::to_string(index) +
-                " out of range [0, " + std::to_string(gates_.size()) + ")");
-        }
-        return gates_[index];
+        checkGateIndex(index);
+        return (*this)[index];
     }
 
     /**
      * @brief Returns a mutable reference to the gate at the specified index.
+     *
+     * Unshares the gate's chunk first, so clones are not affected. The
+     * reference is valid until the next mutating call.
+     *
      * @param index Gate index
      * @return Mutable reference to the gate
      * @throws std::out_of_range if index >= numGates()
      */
     [[nodiscard]] Gate& gate(std::size_t index) {
-        if (index >= gates_.size()) {
-            throw std::out_of_range(
-                "Gate index " + std::to_string(index) +
-                " out of range [0, " + std::to_string(gates_.size()) + ")");
-        }
-        return gates_[index];
+        checkGateIndex(index);
+        return (*mutableChunk(index / CHUNK_SIZE))[index % CHUNK_SIZE];
+    }
+
+    /**
+     * @brief Returns the gate at the specified index without bounds checking.
+     * @param index Gate index (must be < numGates())
+     */
+    [[nodiscard]] const Gate& operator[](std::size_t index) const noexcept {
+        return (*(*chunks_)[index / CHUNK_SIZE])[index % CHUNK_SIZE];
     }
 
     /**
-     * @brief Returns all gates in the circuit.
-     * @return Const reference to the gate vector
+     * @brief Copies all gates into a contiguous vector.
+     *
+     * Prefer iteration or CircuitView, which do not copy.
+     */
+    [[nodiscard]] std::vector<Gate> copyGates() const {
+        return std::vector<Gate>(begin(), end());
+    }
+
+    /**
+     * @brief Copies all gates into a contiguous vector.
+     * @deprecated Gates are no longer stored contiguously, so this copies;
+     *             iterate the circuit, or call copyGates() if a copy is needed.
      */
-    [[nodiscard]] const std::vector<Gate>& gates() const noexcept {
-        return gates_;
+    [[deprecated("gates() copies every gate; iterate the circuit or call copyGates()")]]
+    [[nodiscard]] std::vector<Gate> gates() const {
+        return copyGates();
     }
 
     /**
      * @brief Removes all gates from the circuit.
      */
     void clear() noexcept {
-        gates_.clear();
+        chunks_.reset();
         next_gate_id_ = 0;
     }
 
@@ -146,42 +266,52 @@ public:
     /// @brief Returns the number of qubits in the circuit.
     [[nodiscard]] std::size_t numQubits() const noexcept { return num_qubits_; }
 
+    /// @brief Returns the number of classical bits in the circuit.
+    [[nodiscard]] std::size_t numClbits() const noexcept { return num_clbits_; }
+
+    /// @brief Returns the side table of symbolic parameter expressions.
+    [[nodiscard]] const ParameterTable& parameterTable() const noexcept { return parameters_; }
+
+    /// @brief Returns the mutable parameter table (for adding expressions).
+    [[nodiscard]] ParameterTable& parameterTable() noexcept { return parameters_; }
+
     /// @brief Returns the number of gates in the circuit.
-    [[nodiscard]] std::size_t numGates() const noexcept { return gates_.size(); }
+    [[nodiscard]] std::size_t numGates() const noexcept {
+        // Every chunk but the last is full
+        if (chunks_ == nullptr || chunks_->empty()) return 0;
+        return (chunks_->size() - 1) * CHUNK_SIZE + chunks_->back()->size();
+    }
 
     /// @brief Returns true if the circuit has no gates.
-    [[nodiscard]] bool empty() const noexcept { return gates_.empty(); }
+    [[nodiscard]] bool empty() const noexcept { return numGates() == 0; }
+
+    /**
+     * @brief Counts the storage chunks this circuit shares with another.
+     *
+     * Two circuits share a chunk when neither has modified it since one was
+     * cloned from the other.
+     */
+    [[nodiscard]] std::size_t sharedChunks(const Circuit& other) const noexcept {
+        if (chunks_ == nullptr || other.chunks_ == nullptr) return 0;
+        std::size_t shared = 0;
+        const std::size_t n = std::min(chunks_->size(), other.chunks_->size());
+        for (std::size_t i = 0; i < n; ++i) {
+            if ((*chunks_)[i] == (*other.chunks_)[i]) ++shared;
+        }
+        return shared;
+    }
 
     /**
      * @brief Calculates the circuit depth.
      *
      * Depth is the maximum number of gates on any single qubit path,
-     * representing the critical path length.
+     * representing the critical path length. Measurements writing the same
+     * classical bit are ordered, so classical bits count as wires too.
      *
      * @return Circuit depth (0 for empty circuits)
      */
     [[nodiscard]] std::size_t depth() const noexcept {
-        if (gates_.empty()) {
-            return 0;
-        }
-
-        // Track depth at each qubit
-        std::vector<std::size_t> qubit_depths(num_qubits_, 0);
-
-        for (const auto& g : gates_) {
-            // Find max depth among qubits this gate touches
-            std::size_t max_depth = 0;
-            for (auto q : g.qubits()) {
-                max_depth = std::max(max_depth, qubit_depths[q]);
-            }
-
-            // Update all touched qubits to new depth
-            for (auto q : g.qubits()) {
-                qubit_depths[q] = max_depth + 1;
-            }
-        }
-
-        return *std::max_element(qubit_depths.begin(), qubit_depths.end());
+        return depthOf(*this, num_qubits_, num_clbits_);
     }
 
     /**
@@ -191,69 +321,159 @@ public:
      */
     [[nodiscard]] std::size_t countGates(GateType type) const noexcept {
         return static_cast<std::size_t>(
-            std::count_if(gates_.begin(), gates_.end(),
+            std::count_if(begin(), end(),
                           [type](const Gate& g) { return g.type() == type; }));
     }
 
     /**
      * @brief Counts two-qubit gates in the circuit.
-     * @return Number of two-qubit gates
+     * @return Number of two-qubit gates (barriers are not counted)
      */
     [[nodiscard]] std::size_t countTwoQubitGates() const noexcept {
         return static_cast<std::size_t>(
-            std::count_if(gates_.begin(), gates_.end(),
-                          [](const Gate& g) { return g.numQubits() == 2; }));
+            std::count_if(begin(), end(),
+                          [](const Gate& g) { return isTwoQubitGate(g.type()); }));
     }
 
     // -------------------------------------------------------------------------
     // Iteration
     // -------------------------------------------------------------------------
 
-    [[nodiscard]] iterator begin() noexcept { return gates_.begin(); }
-    [[nodiscard]] iterator end() noexcept { return gates_.end(); }
-    [[nodiscard]] const_iterator begin() const noexcept { return gates_.begin(); }
-    [[nodiscard]] const_iterator end() const noexcept { return gates_.end(); }
-    [[nodiscard]] const_iterator cbegin() const noexcept { return gates_.cbegin(); }
-    [[nodiscard]] const_iterator cend() const noexcept { return gates_.cend(); }
+    [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    [[nodiscard]] const_iterator end() const noexcept {
+        return const_iterator(this, numGates());
+    }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return end(); }
 
     // -------------------------------------------------------------------------
     // Utilities
     // -------------------------------------------------------------------------
 
     /**
-     * @brief Creates a deep copy of the circuit.
-     * @return New circuit with copied gates
+     * @brief Creates an independent copy of the circuit.
+     *
+     * O(1) in the number of gates: the copy shares gate storage with this
+     * circuit until either of them is modified (see sharedChunks()).
+     *
+     * @return New circuit with the same gates
      */
     [[nodiscard]] Circuit clone() const {
-        Circuit copy(num_qubits_);
-        copy.gates_ = gates_;
+        Circuit copy(num_qubits_, num_clbits_);
+        copy.parameters_ = parameters_;
+        copy.chunks_ = chunks_;
         copy.next_gate_id_ = next_gate_id_;
         return copy;
     }
 
+    /**
+     * @brief Substitutes values for the symbols of every symbolic parameter.
+     *
+     * All expressions of the parameter table are evaluated in one sweep,
+     * then each symbolic gate takes its values from the result. The circuit
+     * itself is left symbolic, so one compiled circuit can be bound many
+     * times.
+     *
+     * @param values One value per symbol, indexed by SymbolId
+     * @return Copy with concrete parameters, the same gate IDs and an empty
+     *         parameter table
+     * @throws std::invalid_argument if values.size() != numSymbols()
+     */
+    [[nodiscard]] Circuit bind(const std::vector<double>& values) const {
+        const std::vector<Angle> angles = parameters_.evaluate(values);
+        Circuit bound(num_qubits_, num_clbits_);
+        for (const auto& g : *this) {
+            bound.appendGate(g.isSymbolic() ? g.bound(angles) : g);
+        }
+        bound.next_gate_id_ = next_gate_id_;
+        return bound;
+    }
+
+    /**
+     * @brief Substitutes values for named symbols.
+     * @param values A value for every symbol of parameterTable()
+     * @return Copy with concrete parameters (see bind(const std::vector<double>&))
+     * @throws std::invalid_argument if a symbol is unbound or a name is unknown
+     */
+    [[nodiscard]] Circuit bindNamed(const std::unordered_map<std::string, double>& values) const {
+        return bind(parameters_.values(values));
+    }
+
     /**
      * @brief Returns a string representation of the circuit.
      * @return Multi-line string showing circuit structure
      */
     [[nodiscard]] std::string toString() const {
-        std::string result = "Circuit(" + std::to_string(num_qubits_) +
-                             " qubits, " + std::to_string(gates_.size()) +
-                             " gates, depth " + std::to_string(depth()) + "):\n";
-        for (const auto& g : gates_) {
+        std::string result = "Circuit(" + std::to_string(num_qubits_) + " qubits, ";
+        if (num_clbits_ > 0) {
+            result += std::to_string(num_clbits_) + " clbits, ";
+        }
+        result += std::to_string(numGates()) + " gates, depth " +
+                  std::to_string(depth()) + "):\n";
+        for (const auto& g : *this) {
             result += "  " + g.toString() + "\n";
         }
         return result;
     }
 
 private:
+    using Chunk = std::vector<Gate>;
+    using ChunkList = std::vector<std::shared_ptr<Chunk>>;
+
     std::size_t num_qubits_;
-    std::vector<Gate> gates_;
+    std::size_t num_clbits_;
+    std::shared_ptr<ChunkList> chunks_;  // Null when empty; shared with clones
     GateId next_gate_id_;
+    ParameterTable parameters_;
+
+    /// @brief Throws std::out_of_range unless index < numGates().
+    void checkGateIndex(std::size_t index) const {
+        if (index >= numGates()) {
+            throw std::out_of_range(
+                "Gate index " + std::to_string(index) +
+                " out of range [0, " + std::to_string(numGates()) + ")");
+        }
+    }
+
+    /// @brief Returns the chunk list, copying it first if it is shared.
+    ChunkList& mutableChunks() {
+        if (chunks_ == nullptr) {
+            chunks_ = std::make_shared<ChunkList>();
+        } else if (chunks_.use_count() > 1) {
+            chunks_ = std::make_shared<ChunkList>(*chunks_);
+        }
+        return *chunks_;
+    }
+
+    /// @brief Returns chunk @p index, copying it first if it is shared.
+    Chunk* mutableChunk(std::size_t index) {
+        std::shared_ptr<Chunk>& chunk = mutableChunks()[index];
+        if (chunk.use_count() > 1) {
+            auto copy = std::make_shared<Chunk>();
+            copy->reserve(CHUNK_SIZE);
+            copy->assign(chunk->begin(), chunk->end());
+            chunk = std::move(copy);
+        }
+        return chunk.get();
+    }
+
+    /// @brief Appends a gate without validation or renumbering.
+    void appendGate(Gate gate) {
+        ChunkList& chunks = mutableChunks();
+        if (chunks.empty() || chunks.back()->size() == CHUNK_SIZE) {
+            auto chunk = std::make_shared<Chunk>();
+            chunk->reserve(CHUNK_SIZE);
+            chunks.push_back(std::move(chunk));
+        }
+        mutableChunk(chunks.size() - 1)->push_back(std::move(gate));
+    }
 
     /**
-     * @brief Validates that a gate's qubits are within circuit bounds.
+     * @brief Validates that a gate's qubits and classical bit are within
+     *        circuit bounds.
      * @param g The gate to validate
-     * @throws std::out_of_range if any qubit index is invalid
+     * @throws std::out_of_range if any qubit, classical bit or parameter
+     *         expression index is invalid
      */
     void validateGateQubits(const Gate& g) const {
         for (auto q : g.qubits()) {
@@ -265,6 +485,23 @@ private:
                     " qubits");
             }
         }
+        if (g.clbit().has_value() && *g.clbit() >= num_clbits_) {
+            throw std::out_of_range(
+                "Gate " + std::string(gateTypeName(g.type())) +
+                " writes classical bit " + std::to_string(*g.clbit()) +
+                " but circuit only has " + std::to_string(num_clbits_) +
+                " classical bits");
+        }
+        for (std::size_t i = 0; i < g.numParameters(); ++i) {
+            auto expr = g.expression(i);
+            if (expr && *expr >= parameters_.numExpressions()) {
+                throw std::out_of_range(
+                    "Gate " + std::string(gateTypeName(g.type())) +
+                    " references parameter expression " + std::to_string(*expr) +
+                    " but circuit only has " +
+                    std::to_string(parameters_.numExpressions()));
+            }
+        }
     }
 };
 
@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file CircuitView.hpp
+ * @brief Non-owning, read-only windows onto a Circuit
+ *
+ * Provides CircuitView, which selects gates of a circuit without copying
+ * them: an index range ("gates 10k-20k"), a qubit filter ("only qubits
+ * 0-15") or the last N layers. Views compose, iterate in circuit order and
+ * support the same analyses as Circuit (depth, gate counts); the QASM
+ * writer accepts them directly.
+ *
+ * A view refers to the circuit by pointer and is invalidated when gates
+ * are added to or removed from it.
+ *
+ * @see Circuit.hpp for the owning container
+ * @see parser/QASMWriter.hpp for writeQASM()
+ */
+
+#pragma once
+
+#include "Circuit.hpp"
+#include "Gate.hpp"
+#include "Types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace qopt::ir {
+
+/**
+ * @brief A read-only selection of a circuit's gates.
+ *
+ * Gate indices always refer to the underlying circuit. Copying a view is
+ * cheap: filters are shared, never the gates.
+ *
+ * Example:
+ * @code
+ * CircuitView window = CircuitView(circuit).slice(10000, 20000).onQubits({0, 1, 2});
+ * std::size_t d = window.depth();
+ * for (const Gate& g : window.lastLayers(4)) { ... }
+ * @endcode
+ */
+class CircuitView {
+public:
+    /// @brief Forward iterator over the selected gates.
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Gate;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Gate*;
+        using reference = const Gate&;
+
+        const_iterator() = default;
+
+        [[nodiscard]] reference operator*() const { return (*view_->circuit_)[index_]; }
+        [[nodiscard]] pointer operator->() const { return &**this; }
+
+        const_iterator& operator++() {
+            index_ = view_->nextSelected(index_ + 1);
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        [[nodiscard]] bool operator==(const const_iterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        [[nodiscard]] bool operator!=(const const_iterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+        /// @brief Returns the index of the current gate in the circuit.
+        [[nodiscard]] std::size_t index() const noexcept { return index_; }
+
+    private:
+        friend class CircuitView;
+        const_iterator(const CircuitView* view, std::size_t index) : view_(view), index_(index) {}
+
+        const CircuitView* view_ = nullptr;
+        std::size_t index_ = 0;
+    };
+
+    /**
+     * @brief Views a whole circuit.
+     *
+     * Implicit, so functions taking a CircuitView also accept a Circuit.
+     */
+    CircuitView(const Circuit& circuit) noexcept  // NOLINT(google-explicit-constructor)
+        : circuit_(&circuit)
+        , first_(0)
+        , last_(circuit.numGates())
+    {}
+
+    // -------------------------------------------------------------------------
+    // Narrowing
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Restricts the view to circuit gate indices [first, last).
+     * @throws std::out_of_range if first > last or last > circuit().numGates()
+     */
+    [[nodiscard]] CircuitView slice(std::size_t first, std::size_t last) const {
+        if (first > last || last > circuit_->numGates()) {
+            throw std::out_of_range(
+                "Slice [" + std::to_string(first) + ", " + std::to_string(last) +
+                ") out of range [0, " + std::to_string(circuit_->numGates()) + "]");
+        }
+        CircuitView result(*this);
+        result.first_ = std::max(first_, first);
+        result.last_ = std::max(result.first_, std::min(last_, last));
+        return result;
+    }
+
+    /**
+     * @brief Restricts the view to gates acting only on the given qubits.
+     *
+     * Gates touching any other qubit (including barriers spanning it) are
+     * left out, so the result is a sub-circuit on those qubits.
+     *
+     * @throws std::out_of_range if a qubit is beyond the circuit's register
+     */
+    [[nodiscard]] CircuitView onQubits(const std::vector<QubitIndex>& qubits) const {
+        auto mask = std::make_shared<std::vector<bool>>(circuit_->numQubits(), false);
+        for (QubitIndex q : qubits) {
+            if (q >= circuit_->numQubits()) {
+                throw std::out_of_range(
+                    "Qubit " + std::to_string(q) + " out of range for a circuit with " +
+                    std::to_string(circuit_->numQubits()) + " qubits");
+            }
+            (*mask)[q] = qubit_mask_ == nullptr || (*qubit_mask_)[q];
+        }
+        CircuitView result(*this);
+        result.qubit_mask_ = std::move(mask);
+        return result;
+    }
+
+    /**
+     * @brief Restricts the view to its last @p n layers.
+     *
+     * A gate belongs to the last n layers if at most n gates of the view,
+     * itself included, follow it on some path to the end of the view. The
+     * selection is closed under successors, so it is a valid tail of the
+     * circuit. Costs one backward pass over the view.
+     */
+    [[nodiscard]] CircuitView lastLayers(std::size_t n) const {
+        const std::size_t num_qubits = circuit_->numQubits();
+        std::vector<std::size_t> wire_depths(num_qubits + circuit_->numClbits(), 0);
+        auto mask = std::make_shared<std::vector<bool>>(last_ - first_, false);
+        std::size_t new_first = last_;
+
+        for (std::size_t i = last_; i-- > first_;) {
+            if (!selected(i)) continue;
+            const Gate& g = (*circuit_)[i];
+            std::size_t depth = 0;
+            for (auto q : g.qubits()) {
+                depth = std::max(depth, wire_depths[q]);
+            }
+            if (g.clbit().has_value()) {
+                depth = std::max(depth, wire_depths[num_qubits + *g.clbit()]);
+            }
+            for (auto q : g.qubits()) {
+                wire_depths[q] = depth + 1;
+            }
+            if (g.clbit().has_value()) {
+                wire_depths[num_qubits + *g.clbit()] = depth + 1;
+            }
+            if (depth < n) {
+                (*mask)[i - first_] = true;
+                new_first = i;
+            }
+        }
+
+        CircuitView result(*this);
+        result.gate_mask_ = std::move(mask);
+        result.gate_mask_offset_ = first_;
+        result.first_ = new_first;
+        return result;
+    }
+
+    // -------------------------------------------------------------------------
+    // Properties
+    // -------------------------------------------------------------------------
+
+    /// @brief Returns the underlying circuit.
+    [[nodiscard]] const Circuit& circuit() const noexcept { return *circuit_; }
+
+    /// @brief Returns the size of the underlying qubit register.
+    [[nodiscard]] std::size_t numQubits() const noexcept { return circuit_->numQubits(); }
+
+    /// @brief Returns the size of the underlying classical register.
+    [[nodiscard]] std::size_t numClbits() const noexcept { return circuit_->numClbits(); }
+
+    /// @brief Returns true if the circuit gate at @p index is in the view.
+    [[nodiscard]] bool contains(std::size_t index) const noexcept {
+        return index >= first_ && index < last_ && selected(index);
+    }
+
+    /**
+     * @brief Returns the number of selected gates.
+     *
+     * Linear in the index range for filtered views.
+     */
+    [[nodiscard]] std::size_t numGates() const noexcept {
+        if (qubit_mask_ == nullptr && gate_mask_ == nullptr) {
+            return last_ - first_;
+        }
+        return static_cast<std::size_t>(std::distance(begin(), end()));
+    }
+
+    /// @brief Returns true if no gate is selected.
+    [[nodiscard]] bool empty() const noexcept { return begin() == end(); }
+
+    /// @brief Calculates the depth of the selected gates (see Circuit::depth()).
+    [[nodiscard]] std::size_t depth() const noexcept {
+        return depthOf(*this, circuit_->numQubits(), circuit_->numClbits());
+    }
+
+    /// @brief Counts selected gates of a specific type.
+    [[nodiscard]] std::size_t countGates(GateType type) const noexcept {
+        return static_cast<std::size_t>(
+            std::count_if(begin(), end(), [type](const Gate& g) { return g.type() == type; }));
+    }
+
+    /// @brief Counts selected two-qubit gates.
+    [[nodiscard]] std::size_t countTwoQubitGates() const noexcept {
+        return static_cast<std::size_t>(std::count_if(
+            begin(), end(), [](const Gate& g) { return isTwoQubitGate(g.type()); }));
+    }
+
+    // -------------------------------------------------------------------------
+    // Iteration
+    // -------------------------------------------------------------------------
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return const_iterator(this, nextSelected(first_));
+    }
+    [[nodiscard]] const_iterator end() const noexcept { return const_iterator(this, last_); }
+
+private:
+    const Circuit* circuit_;
+    std::size_t first_;
+    std::size_t last_;
+    std::shared_ptr<const std::vector<bool>> qubit_mask_;  // Null: all qubits
+    std::shared_ptr<const std::vector<bool>> gate_mask_;   // Null: all gates in range
+    std::size_t gate_mask_offset_ = 0;                     // Circuit index of gate_mask_[0]
+
+    /// @brief Applies the qubit and gate filters (not the range).
+    [[nodiscard]] bool selected(std::size_t index) const noexcept {
+        if (gate_mask_ != nullptr && !(*gate_mask_)[index - gate_mask_offset_]) {
+            return false;
+        }
+        if (qubit_mask_ != nullptr) {
+            const auto& qubits = (*circuit_)[index].qubits();
+            return std::all_of(qubits.begin(), qubits.end(),
+                               [this](QubitIndex q) { return (*qubit_mask_)[q]; });
+        }
+        return true;
+    }
+
+    /// @brief Returns the first selected index >= index, or last_.
+    [[nodiscard]] std::size_t nextSelected(std::size_t index) const noexcept {
+        while (index < last_ && !selected(index)) {
+            ++index;
+        }
+        return index;
+    }
+};
+
+}  // namespace qopt::ir
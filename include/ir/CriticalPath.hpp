@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file CriticalPath.hpp
+ * @brief Incrementally maintained critical-path analysis of a DAG
+ *
+ * Provides CriticalPath, which tracks for every DAG node the longest
+ * weighted path into it and out of it. Nodes with zero slack lie on a
+ * critical path; shortening the circuit's duration requires shortening
+ * one of them. After a rewrite, update() revisits only the nodes whose
+ * times actually change.
+ *
+ * @see Schedule.hpp for DurationTable and one-shot ASAP/ALAP schedules
+ * @see DAG.hpp for journaledNodes(), which reports what a rewrite touched
+ */
+
+#pragma once
+
+#include "DAG.hpp"
+#include "Schedule.hpp"
+#include "Types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace qopt::ir {
+
+/**
+ * @brief Longest-path times and slack for every node of a DAG.
+ *
+ * For a node v, head(v) is the earliest start time (the longest path
+ * ending at v's predecessors) and tail(v) the longest path starting at v,
+ * v's own duration included. length() is the critical-path duration and
+ * slack(v) = length() - head(v) - tail(v).
+ *
+ * Example:
+ * @code
+ * CriticalPath cp(dag, durations);
+ * dag.checkpoint();
+ * rewrite(dag);
+ * cp.update(dag, dag.journaledNodes());
+ * if (cp.length() >= before) dag.rollback(); else dag.commit();
+ * @endcode
+ * (after a rollback, call update() again with the same node list)
+ */
+class CriticalPath {
+public:
+    /**
+     * @brief Analyzes every node of a DAG.
+     * @param dag The DAG to analyze
+     * @param durations Gate durations (default: unit, so length() is the depth)
+     */
+    explicit CriticalPath(const DAG& dag, DurationTable durations = DurationTable())
+        : durations_(durations)
+    {
+        recompute(dag);
+    }
+
+    /**
+     * @brief Recomputes all times from scratch in O(V + E).
+     */
+    void recompute(const DAG& dag) {
+        present_.clear();
+        duration_.clear();
+        head_.clear();
+        tail_.clear();
+        through_.clear();
+        const std::vector<GateId> order = dag.topologicalOrder();
+        propagate(dag, order);
+    }
+
+    /**
+     * @brief Brings the times up to date after the DAG was edited.
+     *
+     * @p changed must list every node that was added, removed, given a new
+     * gate, or had its edge list rewired, e.g. DAG::journaledNodes(). IDs no
+     * longer in the DAG are dropped. Cost is proportional to the nodes whose
+     * times change and their degrees, not to the DAG size.
+     */
+    void update(const DAG& dag, const std::vector<GateId>& changed) {
+        std::vector<GateId> ids(changed);
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+        std::vector<GateId> seeds;
+        for (GateId id : ids) {
+            if (contains(id)) {
+                through_.erase(through_.find(through(id)));
+                present_[id] = false;
+            }
+            if (dag.hasNode(id)) {
+                seeds.push_back(id);
+            }
+        }
+        propagate(dag, seeds);
+    }
+
+    // -------------------------------------------------------------------------
+    // Queries
+    // -------------------------------------------------------------------------
+
+    /// @brief Returns the critical-path duration (0 for an empty DAG).
+    [[nodiscard]] Duration length() const noexcept {
+        return through_.empty() ? 0.0 : *through_.rbegin();
+    }
+
+    /// @brief Returns the duration table in use.
+    [[nodiscard]] const DurationTable& durations() const noexcept { return durations_; }
+
+    /// @brief Returns true if the node is tracked.
+    [[nodiscard]] bool contains(GateId id) const noexcept {
+        return id < present_.size() && present_[id];
+    }
+
+    /**
+     * @brief Returns the earliest start time of a node.
+     * @throws std::out_of_range if the node is not tracked
+     */
+    [[nodiscard]] Duration head(GateId id) const {
+        checkNode(id);
+        return head_[id];
+    }
+
+    /**
+     * @brief Returns the longest path from a node's start to the end.
+     * @throws std::out_of_range if the node is not tracked
+     */
+    [[nodiscard]] Duration tail(GateId id) const {
+        checkNode(id);
+        return tail_[id];
+    }
+
+    /**
+     * @brief Returns how much a node can be delayed without lengthening
+     *        the critical path.
+     * @throws std::out_of_range if the node is not tracked
+     */
+    [[nodiscard]] Duration slack(GateId id) const {
+        checkNode(id);
+        return length() - through(id);
+    }
+
+    /**
+     * @brief Returns true if a node has zero slack.
+     * @throws std::out_of_range if the node is not tracked
+     */
+    [[nodiscard]] bool isCritical(GateId id) const {
+        return slack(id) <= tolerance();
+    }
+
+    /// @brief Returns the IDs of all zero-slack nodes, in ID order.
+    [[nodiscard]] std::vector<GateId> criticalNodes() const {
+        std::vector<GateId> result;
+        const Duration threshold = length() - tolerance();
+        for (GateId id = 0; id < present_.size(); ++id) {
+            if (present_[id] && through(id) >= threshold) {
+                result.push_back(id);
+            }
+        }
+        return result;
+    }
+
+private:
+    DurationTable durations_;
+    std::vector<bool> present_;       // By GateId
+    std::vector<Duration> duration_;  // By GateId
+    std::vector<Duration> head_;      // By GateId
+    std::vector<Duration> tail_;      // By GateId
+    std::multiset<Duration> through_; // head + tail of every tracked node
+    std::vector<bool> fresh_;         // Scratch: seeds of the running propagate()
+    std::vector<bool> queued_;        // Scratch: nodes on the work list
+
+    [[nodiscard]] Duration through(GateId id) const noexcept {
+        return head_[id] + tail_[id];
+    }
+
+    [[nodiscard]] Duration tolerance() const noexcept {
+        return constants::TOLERANCE * std::max(1.0, length());
+    }
+
+    void checkNode(GateId id) const {
+        if (!contains(id)) {
+            throw std::out_of_range(
+                "Node with ID " + std::to_string(id) + " is not in the critical-path analysis");
+        }
+    }
+
+    /**
+     * @brief Recomputes heads forward and tails backward from the seeds.
+     *
+     * Seeds are (re)attached with fresh durations. A node whose time
+     * changes queues its neighbours, so the sweep stops where times settle.
+     * Seeds in topological order visit each node once.
+     */
+    void propagate(const DAG& dag, const std::vector<GateId>& seeds) {
+        GateId bound = present_.size();
+        for (GateId id : seeds) bound = std::max(bound, id + 1);
+        present_.resize(bound, false);
+        duration_.resize(bound, 0.0);
+        head_.resize(bound, 0.0);
+        tail_.resize(bound, 0.0);
+        fresh_.resize(bound, false);
+        queued_.resize(bound, false);
+
+        for (GateId id : seeds) {
+            present_[id] = true;
+            fresh_[id] = true;
+            duration_[id] = durations_(dag.node(id).gate());
+        }
+
+        std::vector<bool>& fresh = fresh_;
+        std::vector<bool>& queued = queued_;
+        std::deque<GateId> work;
+
+        // Seeds are detached from through_ until both sweeps are done
+        auto set_time = [&](std::vector<Duration>& times, GateId id, Duration value) {
+            if (!fresh[id]) through_.erase(through_.find(through(id)));
+            times[id] = value;
+            if (!fresh[id]) through_.insert(through(id));
+        };
+
+        // Forward: head(v) = max over predecessors p of head(p) + duration(p)
+        for (GateId id : seeds) {
+            queued[id] = true;
+            work.push_back(id);
+        }
+        while (!work.empty()) {
+            const GateId id = work.front();
+            work.pop_front();
+            queued[id] = false;
+            const DAGNode& n = dag.node(id);
+            Duration h = 0.0;
+            for (GateId p : n.predecessors()) {
+                h = std::max(h, head_[p] + duration_[p]);
+            }
+            if (h == head_[id] && !fresh[id]) continue;
+            set_time(head_, id, h);
+            for (GateId s : n.successors()) {
+                if (!queued[s]) {
+                    queued[s] = true;
+                    work.push_back(s);
+                }
+            }
+        }
+
+        // Backward: tail(v) = duration(v) + max over successors s of tail(s)
+        for (auto it = seeds.rbegin(); it != seeds.rend(); ++it) {
+            queued[*it] = true;
+            work.push_back(*it);
+        }
+        while (!work.empty()) {
+            const GateId id = work.front();
+            work.pop_front();
+            queued[id] = false;
+            const DAGNode& n = dag.node(id);
+            Duration t = 0.0;
+            for (GateId s : n.successors()) {
+                t = std::max(t, tail_[s]);
+            }
+            t += duration_[id];
+            if (t == tail_[id] && !fresh[id]) continue;
+            set_time(tail_, id, t);
+            for (GateId p : n.predecessors()) {
+                if (!queued[p]) {
+                    queued[p] = true;
+                    work.push_back(p);
+                }
+            }
+        }
+
+        for (GateId id : seeds) {
+            through_.insert(through(id));
+            fresh[id] = false;
+        }
+    }
+};
+
+}  // namespace qopt::ir
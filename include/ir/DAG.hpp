@@ -11,7 +11,8 @@
  *
  * The DAG structure represents:
  * - Nodes: quantum gates
- * - Edges: dependencies between gates (qubit wire connections)
+ * - Edges: dependencies between gates (qubit wire connections, plus
+ *   classical bit connections between measurements of the same bit)
  *
  * @see Circuit.hpp for linear circuit representation
  * @see Gate.hpp for gate representation
@@ -24,7 +25,9 @@
 #include "Types.hpp"
 
 #include <algorithm>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <stdexcept>
 #include <string>
@@ -145,14 +148,18 @@ private:
  *
  * The DAG represents gate dependencies explicitly, enabling efficient
  * pattern matching and optimization. Nodes are gates, edges represent
- * qubit wire dependencies.
+ * qubit and classical bit wire dependencies. Measure, Reset and Barrier
+ * are ordinary nodes, so any pass that only rewrites along edges cannot
+ * move a gate across them.
  *
  * Key features:
  * - Construct from Circuit (fromCircuit)
- * - Convert back to Circuit (toCircuit)
+ * - Convert back to Circuit (toCircuit); both carry the parameter table
  * - Topological traversal
  * - Node addition/removal
  * - Dependency queries
+ * - Transactions: checkpoint()/rollback()/commit() undo speculative edits
+ *   in time proportional to the number of changes
  *
  * Example:
  * @code
@@ -168,12 +175,14 @@ private:
 class DAG {
 public:
     /**
-     * @brief Constructs an empty DAG with the specified number of qubits.
+     * @brief Constructs an empty DAG with the specified register sizes.
      * @param num_qubits Number of qubits in the circuit
+     * @param num_clbits Number of classical bits (default: none)
      * @throws std::invalid_argument if num_qubits is 0 or exceeds MAX_QUBITS
      */
-    explicit DAG(std::size_t num_qubits)
+    explicit DAG(std::size_t num_qubits, std::size_t num_clbits = 0)
         : num_qubits_(num_qubits)
+        , num_clbits_(num_clbits)
         , next_gate_id_(0)
     {
         if (num_qubits == 0) {
@@ -186,6 +195,7 @@ public:
         }
         // Initialize last gate on each qubit to INVALID
         last_gate_on_qubit_.resize(num_qubits, INVALID_GATE_ID);
+        last_gate_on_clbit_.resize(num_clbits, INVALID_GATE_ID);
     }
 
     // Move semantics
@@ -206,13 +216,15 @@ public:
      * @brief Constructs a DAG from a Circuit.
      *
      * Analyzes gate dependencies based on qubit usage and builds the
-     * dependency graph. Gates are connected if they share a qubit.
+     * dependency graph. Gates are connected if they share a qubit or
+     * write the same classical bit.
      *
      * @param circuit The circuit to convert
      * @return DAG representation of the circuit
      */
     [[nodiscard]] static DAG fromCircuit(const Circuit& circuit) {
-        DAG dag(circuit.numQubits());
+        DAG dag(circuit.numQubits(), circuit.numClbits());
+        dag.parameters_ = circuit.parameterTable();
 
         for (const auto& gate : circuit) {
             dag.addGate(gate);
@@ -228,11 +240,14 @@ public:
     /**
      * @brief Adds a gate to the DAG, automatically computing dependencies.
      *
-     * The gate is connected to the last gate on each qubit it touches.
+     * The gate is connected to the last gate on each qubit it touches and,
+     * for a measurement, to the last measurement of the same classical bit.
      *
      * @param gate The gate to add
      * @return The assigned gate ID
-     * @throws std::out_of_range if gate references qubit beyond DAG size
+     * @throws std::out_of_range if gate references a qubit or classical bit
+     *         beyond DAG size, or a parameter expression missing from
+     *         parameterTable()
      */
     GateId addGate(Gate gate) {
         validateGateQubits(gate);
@@ -241,6 +256,20 @@ public:
         GateId id = next_gate_id_++;
         gate.setId(id);
 
+        if (journaling()) {
+            JournalEntry entry;
+            entry.kind = JournalEntry::Kind::Add;
+            entry.id = id;
+            saveWires(entry, gate);
+            for (auto q : gate.qubits()) {
+                saveSuccessors(entry, last_gate_on_qubit_[q]);
+            }
+            if (auto c = gate.clbit()) {
+                saveSuccessors(entry, last_gate_on_clbit_[*c]);
+            }
+            journal_.push_back(std::move(entry));
+        }
+
         // Create node
         auto node = std::make_unique<DAGNode>(std::move(gate));
 
@@ -256,6 +285,16 @@ public:
             last_gate_on_qubit_[q] = id;
         }
 
+        // Measurements of the same classical bit stay in program order
+        if (auto c = node->gate().clbit()) {
+            GateId pred_id = last_gate_on_clbit_[*c];
+            if (pred_id != INVALID_GATE_ID) {
+                node->addPredecessor(pred_id);
+                nodes_.at(pred_id)->addSuccessor(id);
+            }
+            last_gate_on_clbit_[*c] = id;
+        }
+
         nodes_[id] = std::move(node);
         return id;
     }
@@ -302,8 +341,8 @@ public:
     /**
      * @brief Removes a node from the DAG.
      *
-     * Reconnects predecessors directly to successors to maintain
-     * dependency relationships.
+     * Reconnects, on each of the gate's wires, the gate before it to the
+     * gate after it, so dependencies stay exactly those of the wires.
      *
      * @param id The gate ID to remove
      * @throws std::out_of_range if ID not found
@@ -317,48 +356,201 @@ public:
 
         DAGNode& target = *it->second;
 
-        // Reconnect: each predecessor connects to each successor
-        for (GateId pred_id : target.predecessors()) {
-            nodes_.at(pred_id)->removeSuccessor(id);
+        JournalEntry* entry = nullptr;
+        if (journaling()) {
+            entry = &journal_.emplace_back();
+            entry->kind = JournalEntry::Kind::Remove;
+            entry->id = id;
+            saveWires(*entry, target.gate());
+            for (GateId pred_id : target.predecessors()) {
+                saveSuccessors(*entry, pred_id);
+            }
             for (GateId succ_id : target.successors()) {
-                // Avoid duplicates
-                auto& pred_succs = nodes_.at(pred_id)->successors_;
-                if (std::find(pred_succs.begin(), pred_succs.end(), succ_id) == pred_succs.end()) {
-                    nodes_.at(pred_id)->addSuccessor(succ_id);
-                }
+                savePredecessors(*entry, succ_id);
             }
         }
 
+        for (GateId pred_id : target.predecessors()) {
+            nodes_.at(pred_id)->removeSuccessor(id);
+        }
         for (GateId succ_id : target.successors()) {
             nodes_.at(succ_id)->removePredecessor(id);
+        }
+
+        // Reconnect wire by wire. IDs grow along every wire, so a wire's
+        // neighbours are the largest-ID predecessor and smallest-ID successor
+        // on it; linking only those adds no dependency between gates that
+        // merely shared the removed gate on different wires.
+        auto reconnect = [&](auto on_wire) {
+            GateId before = INVALID_GATE_ID;
             for (GateId pred_id : target.predecessors()) {
-                // Avoid duplicates
-                auto& succ_preds = nodes_.at(succ_id)->predecessors_;
-                if (std::find(succ_preds.begin(), succ_preds.end(), pred_id) == succ_preds.end()) {
-                    nodes_.at(succ_id)->addPredecessor(pred_id);
+                if (on_wire(nodes_.at(pred_id)->gate()) &&
+                    (before == INVALID_GATE_ID || pred_id > before)) {
+                    before = pred_id;
                 }
             }
-        }
+            GateId after = INVALID_GATE_ID;
+            for (GateId succ_id : target.successors()) {
+                if (on_wire(nodes_.at(succ_id)->gate()) &&
+                    (after == INVALID_GATE_ID || succ_id < after)) {
+                    after = succ_id;
+                }
+            }
+            if (before != INVALID_GATE_ID && after != INVALID_GATE_ID && !hasEdge(before, after)) {
+                nodes_.at(before)->addSuccessor(after);
+                nodes_.at(after)->addPredecessor(before);
+            }
+            return before;
+        };
 
-        // Update last_gate_on_qubit_ if this was the last gate on any qubit
         for (auto q : target.gate().qubits()) {
+            GateId before = reconnect([q](const Gate& g) {
+                return std::find(g.qubits().begin(), g.qubits().end(), q) != g.qubits().end();
+            });
             if (last_gate_on_qubit_[q] == id) {
-                // Find new last gate on this qubit (search predecessors)
-                GateId new_last = INVALID_GATE_ID;
-                for (GateId pred_id : target.predecessors()) {
-                    const auto& pred_qubits = nodes_.at(pred_id)->gate().qubits();
-                    if (std::find(pred_qubits.begin(), pred_qubits.end(), q) != pred_qubits.end()) {
-                        new_last = pred_id;
-                        break;
-                    }
-                }
-                last_gate_on_qubit_[q] = new_last;
+                last_gate_on_qubit_[q] = before;
+            }
+        }
+        if (auto c = target.gate().clbit()) {
+            GateId before = reconnect([c](const Gate& g) { return g.clbit() == c; });
+            if (last_gate_on_clbit_[*c] == id) {
+                last_gate_on_clbit_[*c] = before;
             }
         }
 
+        if (entry != nullptr) {
+            entry->node = std::move(it->second);
+        }
         nodes_.erase(it);
     }
 
+    /**
+     * @brief Replaces the gate of a node, keeping its ID and edges.
+     *
+     * Unlike editing node(id).gate() directly, the change is journaled and
+     * undone by rollback().
+     *
+     * @param id The node to update
+     * @param gate The new gate; must act on the same qubits (in any order)
+     *        and classical bit
+     * @throws std::out_of_range if ID not found or the gate is out of bounds
+     * @throws std::invalid_argument if the gate's wires differ from the node's
+     */
+    void replaceGate(GateId id, Gate gate) {
+        DAGNode& target = node(id);
+        validateGateQubits(gate);
+        const auto& old_qubits = target.gate().qubits();
+        if (gate.qubits().size() != old_qubits.size() ||
+            !std::is_permutation(old_qubits.begin(), old_qubits.end(), gate.qubits().begin()) ||
+            gate.clbit() != target.gate().clbit()) {
+            throw std::invalid_argument(
+                "Replacement gate " + std::string(gateTypeName(gate.type())) +
+                " must act on the same wires as node " + std::to_string(id));
+        }
+        gate.setId(id);
+        if (journaling()) {
+            JournalEntry& entry = journal_.emplace_back();
+            entry.kind = JournalEntry::Kind::Replace;
+            entry.id = id;
+            entry.gate = std::move(target.gate_);
+        }
+        target.gate_ = std::move(gate);
+    }
+
+    // -------------------------------------------------------------------------
+    // Transactions
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Opens a transaction.
+     *
+     * While a transaction is open, addGate(), removeNode() and replaceGate()
+     * record how to undo themselves. Transactions nest: each checkpoint is
+     * closed by one rollback() or commit(). Edits made through node(id).gate()
+     * and additions to parameterTable() are not journaled.
+     *
+     * Example:
+     * @code
+     * dag.checkpoint();
+     * dag.removeNode(id);
+     * if (cost(dag) >= before) dag.rollback(); else dag.commit();
+     * @endcode
+     */
+    void checkpoint() {
+        checkpoints_.push_back({journal_.size(), next_gate_id_});
+    }
+
+    /**
+     * @brief Undoes every change since the innermost checkpoint and closes it.
+     *
+     * Restores nodes, edge order and gate IDs exactly. Cost is proportional
+     * to the number of undone changes and the degrees of the touched nodes.
+     *
+     * @throws std::logic_error if no transaction is open
+     */
+    void rollback() {
+        if (checkpoints_.empty()) {
+            throw std::logic_error("rollback() without an open checkpoint");
+        }
+        const Checkpoint cp = checkpoints_.back();
+        checkpoints_.pop_back();
+        while (journal_.size() > cp.journal_size) {
+            undo(journal_.back());
+            journal_.pop_back();
+        }
+        next_gate_id_ = cp.next_gate_id;
+    }
+
+    /**
+     * @brief Keeps every change since the innermost checkpoint and closes it.
+     *
+     * Inside an enclosing transaction the changes stay journaled, so the
+     * outer rollback() still undoes them.
+     *
+     * @throws std::logic_error if no transaction is open
+     */
+    void commit() {
+        if (checkpoints_.empty()) {
+            throw std::logic_error("commit() without an open checkpoint");
+        }
+        checkpoints_.pop_back();
+        if (checkpoints_.empty()) {
+            journal_.clear();
+        }
+    }
+
+    /// @brief Returns the number of open transactions.
+    [[nodiscard]] std::size_t checkpointDepth() const noexcept { return checkpoints_.size(); }
+
+    /// @brief Returns the number of changes journaled by open transactions.
+    [[nodiscard]] std::size_t journalSize() const noexcept { return journal_.size(); }
+
+    /**
+     * @brief Returns the nodes changed since the innermost checkpoint.
+     *
+     * Lists, sorted and without duplicates, every node added, removed or
+     * given a new gate, and every neighbour whose edge list changed. Some
+     * may no longer exist. Incremental analyses use this to revisit only
+     * what a rewrite touched.
+     *
+     * @throws std::logic_error if no transaction is open
+     */
+    [[nodiscard]] std::vector<GateId> journaledNodes() const {
+        if (checkpoints_.empty()) {
+            throw std::logic_error("journaledNodes() without an open checkpoint");
+        }
+        std::vector<GateId> ids;
+        for (std::size_t i = checkpoints_.back().journal_size; i < journal_.size(); ++i) {
+            const JournalEntry& entry = journal_[i];
+            ids.push_back(entry.id);
+            for (const auto& saved : entry.successors) ids.push_back(saved.first);
+            for (const auto& saved : entry.predecessors) ids.push_back(saved.first);
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+
     // -------------------------------------------------------------------------
     // DAG Properties
     // -------------------------------------------------------------------------
@@ -366,6 +558,15 @@ public:
     /// @brief Returns the number of qubits.
     [[nodiscard]] std::size_t numQubits() const noexcept { return num_qubits_; }
 
+    /// @brief Returns the number of classical bits.
+    [[nodiscard]] std::size_t numClbits() const noexcept { return num_clbits_; }
+
+    /// @brief Returns the side table of symbolic parameter expressions.
+    [[nodiscard]] const ParameterTable& parameterTable() const noexcept { return parameters_; }
+
+    /// @brief Returns the mutable parameter table (for adding expressions).
+    [[nodiscard]] ParameterTable& parameterTable() noexcept { return parameters_; }
+
     /// @brief Returns the number of nodes (gates).
     [[nodiscard]] std::size_t numNodes() const noexcept { return nodes_.size(); }
 
@@ -543,12 +744,12 @@ public:
      * @return Circuit representation of the DAG
      */
     [[nodiscard]] Circuit toCircuit() const {
-        Circuit circuit(num_qubits_);
+        Circuit circuit(num_qubits_, num_clbits_);
+        circuit.parameterTable() = parameters_;
 
         for (GateId id : topologicalOrder()) {
-            // Create a copy of the gate (Circuit will assign new IDs)
-            const Gate& g = nodes_.at(id)->gate();
-            circuit.addGate(Gate(g.type(), g.qubits(), g.parameter()));
+            // Circuit assigns new IDs
+            circuit.addGate(nodes_.at(id)->gate());
         }
 
         return circuit;
@@ -618,26 +819,174 @@ public:
         return result;
     }
 
+    /**
+     * @brief Renumbers the nodes densely in topological order.
+     *
+     * After many removals the IDs are sparse, so arrays indexed by GateId
+     * grow with every node ever added. compact() gives the surviving nodes
+     * IDs 0..numNodes()-1, rewriting gates, edge lists and wire tails. Among
+     * ready nodes the smallest old ID goes first, so compacting a DAG that
+     * never lost a node changes nothing.
+     *
+     * @return Old-to-new ID map, indexed by old ID; removed IDs map to
+     *         INVALID_GATE_ID
+     * @throws std::logic_error if a transaction is open
+     */
+    std::vector<GateId> compact() {
+        if (journaling()) {
+            throw std::logic_error("compact() inside an open transaction");
+        }
+
+        std::vector<GateId> remap(next_gate_id_, INVALID_GATE_ID);
+        std::unordered_map<GateId, std::size_t> in_degree;
+        std::priority_queue<GateId, std::vector<GateId>, std::greater<>> ready;
+        for (const auto& [id, n] : nodes_) {
+            in_degree[id] = n->inDegree();
+            if (n->isSource()) {
+                ready.push(id);
+            }
+        }
+        GateId next = 0;
+        while (!ready.empty()) {
+            GateId current = ready.top();
+            ready.pop();
+            remap[current] = next++;
+            for (GateId succ_id : nodes_.at(current)->successors()) {
+                if (--in_degree[succ_id] == 0) {
+                    ready.push(succ_id);
+                }
+            }
+        }
+        if (next != nodes_.size()) {
+            throw std::logic_error("DAG contains a cycle (internal error)");
+        }
+
+        std::unordered_map<GateId, std::unique_ptr<DAGNode>> renumbered;
+        renumbered.reserve(nodes_.size());
+        for (auto& [id, n] : nodes_) {
+            n->gate_.setId(remap[id]);
+            for (GateId& p : n->predecessors_) p = remap[p];
+            for (GateId& s : n->successors_) s = remap[s];
+            renumbered.emplace(remap[id], std::move(n));
+        }
+        nodes_ = std::move(renumbered);
+        for (GateId& last : last_gate_on_qubit_) {
+            if (last != INVALID_GATE_ID) last = remap[last];
+        }
+        for (GateId& last : last_gate_on_clbit_) {
+            if (last != INVALID_GATE_ID) last = remap[last];
+        }
+        next_gate_id_ = next;
+        return remap;
+    }
+
     /**
      * @brief Clears all nodes from the DAG.
+     *
+     * Also discards open transactions: there is nothing left to roll back to.
      */
     void clear() {
         nodes_.clear();
+        journal_.clear();
+        checkpoints_.clear();
         std::fill(last_gate_on_qubit_.begin(), last_gate_on_qubit_.end(),
                   INVALID_GATE_ID);
+        std::fill(last_gate_on_clbit_.begin(), last_gate_on_clbit_.end(),
+                  INVALID_GATE_ID);
         next_gate_id_ = 0;
     }
 
 private:
     std::size_t num_qubits_;
+    std::size_t num_clbits_;
     GateId next_gate_id_;
     std::unordered_map<GateId, std::unique_ptr<DAGNode>> nodes_;
     std::vector<GateId> last_gate_on_qubit_;  // Track last gate on each qubit
+    std::vector<GateId> last_gate_on_clbit_;  // Track last measurement of each bit
+    ParameterTable parameters_;
 
     /**
-     * @brief Validates that a gate's qubits are within DAG bounds.
+     * @brief How to undo one mutation.
+     *
+     * Neighbour edge lists and wire tails are saved whole before the change,
+     * so undo restores them exactly, including edge order.
+     */
+    struct JournalEntry {
+        enum class Kind { Add, Remove, Replace };
+        Kind kind = Kind::Add;
+        GateId id = INVALID_GATE_ID;
+        std::unique_ptr<DAGNode> node;  // Remove: the detached node
+        std::optional<Gate> gate;       // Replace: the previous gate
+        std::vector<std::pair<GateId, std::vector<GateId>>> successors;
+        std::vector<std::pair<GateId, std::vector<GateId>>> predecessors;
+        std::vector<std::pair<std::size_t, GateId>> wires;  // Clbits after qubits
+    };
+
+    struct Checkpoint {
+        std::size_t journal_size;
+        GateId next_gate_id;
+    };
+
+    std::vector<JournalEntry> journal_;
+    std::vector<Checkpoint> checkpoints_;
+
+    [[nodiscard]] bool journaling() const noexcept { return !checkpoints_.empty(); }
+
+    void saveSuccessors(JournalEntry& entry, GateId id) const {
+        if (id != INVALID_GATE_ID) {
+            entry.successors.emplace_back(id, nodes_.at(id)->successors_);
+        }
+    }
+
+    void savePredecessors(JournalEntry& entry, GateId id) const {
+        entry.predecessors.emplace_back(id, nodes_.at(id)->predecessors_);
+    }
+
+    void saveWires(JournalEntry& entry, const Gate& g) const {
+        for (auto q : g.qubits()) {
+            entry.wires.emplace_back(q, last_gate_on_qubit_[q]);
+        }
+        if (auto c = g.clbit()) {
+            entry.wires.emplace_back(num_qubits_ + *c, last_gate_on_clbit_[*c]);
+        }
+    }
+
+    /// @brief Reverts one journaled mutation; later ones are already undone.
+    void undo(JournalEntry& entry) {
+        switch (entry.kind) {
+            case JournalEntry::Kind::Add:
+                nodes_.erase(entry.id);
+                break;
+            case JournalEntry::Kind::Remove:
+                nodes_[entry.id] = std::move(entry.node);
+                break;
+            case JournalEntry::Kind::Replace:
+                nodes_.at(entry.id)->gate_ = std::move(*entry.gate);
+                return;
+        }
+        // Restore in reverse so the oldest saved copy of a repeated
+        // neighbour or wire wins
+        for (auto it = entry.successors.rbegin(); it != entry.successors.rend(); ++it) {
+            nodes_.at(it->first)->successors_ = std::move(it->second);
+        }
+        for (auto it = entry.predecessors.rbegin(); it != entry.predecessors.rend(); ++it) {
+            nodes_.at(it->first)->predecessors_ = std::move(it->second);
+        }
+        for (auto it = entry.wires.rbegin(); it != entry.wires.rend(); ++it) {
+            if (it->first < num_qubits_) {
+                last_gate_on_qubit_[it->first] = it->second;
+            } else {
+                last_gate_on_clbit_[it->first - num_qubits_] = it->second;
+            }
+        }
+    }
+
+    /**
+     * @brief Validates that a gate's qubits and classical bit are within
+     *        DAG bounds.
      * @param g The gate to validate
-     * @throws std::out_of_range if any qubit index is invalid
+     * @throws std::out_of_range if any qubit, classical bit or parameter
+     *         expression index is invalid
      */
     void validateGateQubits(const Gate& g) const {
         for (auto q : g.qubits()) {
@@ -649,6 +998,22 @@ private:
                     " qubits");
             }
         }
+        if (g.clbit().has_value() && *g.clbit() >= num_clbits_) {
+            throw std::out_of_range(
+                "Gate " + std::string(gateTypeName(g.type())) +
+                " writes classical bit " + std::to_string(*g.clbit()) +
+                " but DAG only has " + std::to_string(num_clbits_) +
+                " classical bits");
+        }
+        for (std::size_t i = 0; i < g.numParameters(); ++i) {
+            auto expr = g.expression(i);
+            if (expr && *expr >= parameters_.numExpressions()) {
+                throw std::out_of_range(
+                    "Gate " + std::string(gateTypeName(g.type())) +
+                    " references parameter expression " + std::to_string(*expr) +
+                    " but DAG only has " + std::to_string(parameters_.numExpressions()));
+            }
+        }
     }
 };
 
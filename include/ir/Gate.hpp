@@ -7,7 +7,9 @@
  *
  * Provides the Gate class representing single-qubit and multi-qubit quantum
  * gates, along with factory methods for common gates and utility functions
- * for gate properties.
+ * for gate properties. Gates take up to three qubits and up to three
+ * angle parameters. A parameter is either a concrete angle or symbolic: an
+ * index into the owning circuit's ParameterTable.
  *
  * @see Circuit.hpp for circuit-level operations
  * @see Types.hpp for common type definitions
@@ -17,6 +19,10 @@
 
 #include "Types.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -28,8 +34,10 @@ namespace qopt::ir {
 /**
  * @brief Enumeration of supported quantum gate types.
  *
- * Single-qubit gates: H, X, Y, Z, S, Sdg, T, Tdg, Rx, Ry, Rz
- * Two-qubit gates: CNOT, CZ, SWAP
+ * Single-qubit gates: H, X, Y, Z, S, Sdg, T, Tdg, SX, Rx, Ry, Rz, U3
+ * Two-qubit gates: CNOT, CZ, SWAP, CPhase, RZZ, ISWAP
+ * Three-qubit gates: CCX
+ * Non-unitary operations: Measure, Reset, Barrier
  */
 enum class GateType {
     // Single-qubit Clifford gates
@@ -41,16 +49,29 @@ enum class GateType {
     Sdg,    ///< S-dagger gate
     T,      ///< T gate (sqrt(S))
     Tdg,    ///< T-dagger gate
+    SX,     ///< sqrt(X) gate
 
     // Single-qubit rotation gates (parameterized)
     Rx,     ///< Rotation around X-axis
     Ry,     ///< Rotation around Y-axis
     Rz,     ///< Rotation around Z-axis
+    U3,     ///< General rotation U3(theta, phi, lambda)
 
     // Two-qubit gates
     CNOT,   ///< Controlled-NOT (CX) gate
     CZ,     ///< Controlled-Z gate
-    SWAP    ///< SWAP gate
+    SWAP,   ///< SWAP gate
+    CPhase, ///< Controlled phase, diag(1, 1, 1, e^{i lambda})
+    RZZ,    ///< ZZ interaction exp(-i theta/2 Z⊗Z)
+    ISWAP,  ///< iSWAP gate
+
+    // Three-qubit gates
+    CCX,    ///< Toffoli gate (controls first, target last)
+
+    // Non-unitary operations
+    Measure,  ///< Z-basis measurement of one qubit into a classical bit
+    Reset,    ///< Reset of one qubit to |0>
+    Barrier   ///< Scheduling barrier over any number of qubits
 };
 
 /**
@@ -68,12 +89,21 @@ enum class GateType {
         case GateType::Sdg:  return "Sdg";
         case GateType::T:    return "T";
         case GateType::Tdg:  return "Tdg";
+        case GateType::SX:   return "SX";
         case GateType::Rx:   return "Rx";
         case GateType::Ry:   return "Ry";
         case GateType::Rz:   return "Rz";
+        case GateType::U3:   return "U3";
         case GateType::CNOT: return "CNOT";
         case GateType::CZ:   return "CZ";
         case GateType::SWAP: return "SWAP";
+        case GateType::CPhase: return "CPhase";
+        case GateType::RZZ:    return "RZZ";
+        case GateType::ISWAP:  return "ISWAP";
+        case GateType::CCX:    return "CCX";
+        case GateType::Measure: return "Measure";
+        case GateType::Reset:   return "Reset";
+        case GateType::Barrier: return "Barrier";
     }
     return "Unknown";
 }
@@ -81,35 +111,106 @@ enum class GateType {
 /**
  * @brief Returns the number of qubits a gate type acts on.
  * @param type The gate type
- * @return Number of qubits (1 or 2)
+ * @return Number of qubits (1 to 3), or 0 for Barrier, which spans any
+ *         non-empty set of qubits
  */
 [[nodiscard]] constexpr std::size_t numQubitsFor(GateType type) noexcept {
     switch (type) {
         case GateType::CNOT:
         case GateType::CZ:
         case GateType::SWAP:
+        case GateType::CPhase:
+        case GateType::RZZ:
+        case GateType::ISWAP:
             return 2;
+        case GateType::CCX:
+            return 3;
+        case GateType::Barrier:
+            return 0;
         default:
             return 1;
     }
 }
 
 /**
- * @brief Returns whether a gate type is parameterized.
+ * @brief Returns whether a gate type is a two-qubit gate.
+ *
+ * Use this rather than Gate::numQubits() == 2, which is also true for a
+ * barrier over two qubits.
+ *
  * @param type The gate type
- * @return true if the gate requires a rotation angle parameter
+ * @return true for CNOT, CZ, SWAP, CPhase, RZZ and ISWAP
  */
-[[nodiscard]] constexpr bool isParameterized(GateType type) noexcept {
+[[nodiscard]] constexpr bool isTwoQubitGate(GateType type) noexcept {
+    return numQubitsFor(type) == 2;
+}
+
+/**
+ * @brief Returns whether a gate type is a unitary on two or more qubits.
+ *
+ * These are the gates that routing must place on connected qubits; for
+ * CCX both controls must neighbor the target.
+ *
+ * @param type The gate type
+ * @return true for two-qubit gates and CCX
+ */
+[[nodiscard]] constexpr bool isMultiQubitGate(GateType type) noexcept {
+    return numQubitsFor(type) >= 2;
+}
+
+/**
+ * @brief Returns whether a gate type is a non-unitary operation.
+ *
+ * Measure, Reset and Barrier are fixed points for optimization: passes
+ * must not cancel, merge, or commute other gates across them on the
+ * qubits they touch.
+ *
+ * @param type The gate type
+ * @return true for Measure, Reset and Barrier
+ */
+[[nodiscard]] constexpr bool isNonUnitary(GateType type) noexcept {
+    switch (type) {
+        case GateType::Measure:
+        case GateType::Reset:
+        case GateType::Barrier:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// @brief Maximum number of angle parameters a gate can take.
+inline constexpr std::size_t MAX_GATE_PARAMETERS = 3;
+
+/**
+ * @brief Returns the number of angle parameters a gate type takes.
+ * @param type The gate type
+ * @return 3 for U3, 1 for the other rotations, 0 otherwise
+ */
+[[nodiscard]] constexpr std::size_t numParametersFor(GateType type) noexcept {
     switch (type) {
         case GateType::Rx:
         case GateType::Ry:
         case GateType::Rz:
-            return true;
+        case GateType::CPhase:
+        case GateType::RZZ:
+            return 1;
+        case GateType::U3:
+            return 3;
         default:
-            return false;
+            return 0;
     }
 }
 
+/**
+ * @brief Returns whether a gate type is parameterized.
+ * @param type The gate type
+ * @return true if the gate requires at least one angle parameter
+ */
+[[nodiscard]] constexpr bool isParameterized(GateType type) noexcept {
+    return numParametersFor(type) > 0;
+}
+
 /**
  * @brief Returns whether a gate type is Hermitian (self-inverse).
  * @param type The gate type
@@ -124,6 +225,7 @@ enum class GateType {
         case GateType::CNOT:
         case GateType::CZ:
         case GateType::SWAP:
+        case GateType::CCX:
             return true;
         default:
             return false;
@@ -133,14 +235,22 @@ enum class GateType {
 /**
  * @brief Represents a quantum gate operation.
  *
- * A Gate consists of a type, target qubit(s), optional rotation parameter,
- * and a unique identifier. Gates are value types and can be copied/moved.
+ * A Gate consists of a type, target qubit(s), angle parameters (one for
+ * Rx/Ry/Rz/CPhase/RZZ, three for U3), and a unique identifier.
+ * Measurements additionally carry the classical bit they write. Gates are
+ * value types and can be copied/moved.
+ *
+ * A symbolic parameter refers to an expression of the owning circuit's
+ * ParameterTable instead of holding an angle; parameter() reports no value
+ * for it until the circuit is bound.
  *
  * Example:
  * @code
  * auto h = Gate::h(0);           // Hadamard on qubit 0
  * auto cx = Gate::cnot(0, 1);    // CNOT with control=0, target=1
  * auto rz = Gate::rz(0, PI/4);   // Rz(π/4) on qubit 0
+ * auto ccx = Gate::ccx(0, 1, 2); // Toffoli with controls 0, 1 and target 2
+ * auto m = Gate::measure(0, 0);  // Measure qubit 0 into bit 0
  * @endcode
  */
 class Gate {
@@ -149,22 +259,48 @@ public:
      * @brief Constructs a gate with the given properties.
      * @param type The gate type
      * @param qubits Target qubit indices
-     * @param parameter Optional rotation angle (for Rx, Ry, Rz)
+     * @param parameter Optional rotation angle for single-parameter gates;
+     *        use fromParameters() for U3
      * @param id Unique gate identifier (default: INVALID_GATE_ID)
-     * @throws std::invalid_argument if qubit count doesn't match gate type
+     * @param clbit Classical bit written (Measure only; a measurement
+     *        without one discards its result)
+     * @throws std::invalid_argument if qubit or parameter count doesn't
+     *         match gate type, or a classical bit is given for a gate other
+     *         than Measure
      */
     Gate(GateType type,
          std::vector<QubitIndex> qubits,
          std::optional<Angle> parameter = std::nullopt,
-         GateId id = INVALID_GATE_ID)
+         GateId id = INVALID_GATE_ID,
+         std::optional<ClbitIndex> clbit = std::nullopt)
         : type_(type)
         , qubits_(std::move(qubits))
-        , parameter_(parameter)
+        , num_params_(parameter.has_value() ? 1 : 0)
+        , clbit_(clbit)
         , id_(id)
     {
+        params_[0] = parameter.value_or(0.0);
         validate();
     }
 
+    /**
+     * @brief Constructs a gate from any number of angle parameters.
+     * @param type The gate type
+     * @param qubits Target qubit indices
+     * @param parameters Angles, in the order of the gate's definition
+     * @param id Unique gate identifier (default: INVALID_GATE_ID)
+     * @throws std::invalid_argument if qubit or parameter count doesn't
+     *         match gate type
+     */
+    [[nodiscard]] static Gate fromParameters(GateType type,
+                                             std::vector<QubitIndex> qubits,
+                                             const std::vector<Angle>& parameters,
+                                             GateId id = INVALID_GATE_ID) {
+        checkParameterCount(type, parameters.size());
+        return Gate(type, std::move(qubits), std::nullopt, id, std::nullopt,
+                    parameters.begin(), parameters.end());
+    }
+
     // Default special members
     ~Gate() noexcept = default;
     Gate(const Gate&) = default;
@@ -231,6 +367,21 @@ public:
         return Gate(GateType::Rz, {qubit}, angle);
     }
 
+    /// @brief Creates a sqrt(X) gate on the specified qubit.
+    [[nodiscard]] static Gate sx(QubitIndex qubit) {
+        return Gate(GateType::SX, {qubit});
+    }
+
+    /**
+     * @brief Creates a general single-qubit rotation.
+     *
+     * U3(theta, phi, lambda) = Rz(phi) Ry(theta) Rz(lambda) up to global
+     * phase.
+     */
+    [[nodiscard]] static Gate u3(QubitIndex qubit, Angle theta, Angle phi, Angle lambda) {
+        return fromParameters(GateType::U3, {qubit}, {theta, phi, lambda});
+    }
+
     /// @brief Creates a CNOT gate with specified control and target qubits.
     /// @throws std::invalid_argument if control == target
     [[nodiscard]] static Gate cnot(QubitIndex control, QubitIndex target) {
@@ -261,6 +412,67 @@ public:
         return Gate(GateType::SWAP, {qubit1, qubit2});
     }
 
+    /// @brief Creates a controlled-phase gate between two qubits.
+    /// @throws std::invalid_argument if qubit1 == qubit2
+    [[nodiscard]] static Gate cphase(QubitIndex qubit1, QubitIndex qubit2, Angle lambda) {
+        if (qubit1 == qubit2) {
+            throw std::invalid_argument(
+                "CPhase requires two different qubits");
+        }
+        return Gate(GateType::CPhase, {qubit1, qubit2}, lambda);
+    }
+
+    /// @brief Creates a ZZ rotation between two qubits.
+    /// @throws std::invalid_argument if qubit1 == qubit2
+    [[nodiscard]] static Gate rzz(QubitIndex qubit1, QubitIndex qubit2, Angle theta) {
+        if (qubit1 == qubit2) {
+            throw std::invalid_argument(
+                "RZZ requires two different qubits");
+        }
+        return Gate(GateType::RZZ, {qubit1, qubit2}, theta);
+    }
+
+    /// @brief Creates an iSWAP gate between two qubits.
+    /// @throws std::invalid_argument if qubit1 == qubit2
+    [[nodiscard]] static Gate iswap(QubitIndex qubit1, QubitIndex qubit2) {
+        if (qubit1 == qubit2) {
+            throw std::invalid_argument(
+                "ISWAP requires two different qubits");
+        }
+        return Gate(GateType::ISWAP, {qubit1, qubit2});
+    }
+
+    /// @brief Creates a Toffoli gate with two controls and a target.
+    /// @throws std::invalid_argument if any two qubits coincide
+    [[nodiscard]] static Gate ccx(QubitIndex control1, QubitIndex control2, QubitIndex target) {
+        if (control1 == control2 || control1 == target || control2 == target) {
+            throw std::invalid_argument(
+                "CCX requires three different qubits");
+        }
+        return Gate(GateType::CCX, {control1, control2, target});
+    }
+
+    /// @brief Creates a measurement of a qubit into a classical bit.
+    [[nodiscard]] static Gate measure(QubitIndex qubit, ClbitIndex clbit) {
+        return Gate(GateType::Measure, {qubit}, std::nullopt, INVALID_GATE_ID, clbit);
+    }
+
+    /// @brief Creates a measurement whose result is discarded.
+    [[nodiscard]] static Gate measure(QubitIndex qubit) {
+        return Gate(GateType::Measure, {qubit});
+    }
+
+    /// @brief Creates a reset of a qubit to |0>.
+    [[nodiscard]] static Gate reset(QubitIndex qubit) {
+        return Gate(GateType::Reset, {qubit});
+    }
+
+    /// @brief Creates a barrier across the given qubits.
+    /// @throws std::invalid_argument if qubits is empty or has duplicates
+    [[nodiscard]] static Gate barrier(std::vector<QubitIndex> qubits) {
+        return Gate(GateType::Barrier, std::move(qubits));
+    }
+
     // -------------------------------------------------------------------------
     // Accessors
     // -------------------------------------------------------------------------
@@ -273,9 +485,57 @@ public:
         return qubits_;
     }
 
-    /// @brief Returns the rotation parameter if present.
+    /// @brief Returns the first angle parameter if present and concrete.
     [[nodiscard]] std::optional<Angle> parameter() const noexcept {
-        return parameter_;
+        if (num_params_ == 0 || exprs_[0] != NO_PARAMETER_EXPR) return std::nullopt;
+        return params_[0];
+    }
+
+    /**
+     * @brief Returns an angle parameter by position.
+     * @throws std::out_of_range if index >= numParameters()
+     * @throws std::logic_error if the parameter is symbolic
+     */
+    [[nodiscard]] Angle parameter(std::size_t index) const {
+        checkParameterIndex(index);
+        if (exprs_[index] != NO_PARAMETER_EXPR) {
+            throw std::logic_error(
+                "Gate " + std::string(gateTypeName(type_)) + " parameter " +
+                std::to_string(index) + " is symbolic");
+        }
+        return params_[index];
+    }
+
+    /**
+     * @brief Returns the parameter table entry of a symbolic parameter.
+     * @return The expression id, or nullopt if the parameter is concrete
+     * @throws std::out_of_range if index >= numParameters()
+     */
+    [[nodiscard]] std::optional<ParameterExprId> expression(std::size_t index) const {
+        checkParameterIndex(index);
+        if (exprs_[index] == NO_PARAMETER_EXPR) return std::nullopt;
+        return exprs_[index];
+    }
+
+    /// @brief Returns true if any parameter is symbolic.
+    [[nodiscard]] bool isSymbolic() const noexcept {
+        return std::any_of(exprs_.begin(), exprs_.begin() + num_params_,
+                           [](ParameterExprId e) { return e != NO_PARAMETER_EXPR; });
+    }
+
+    /// @brief Returns all angle parameters in order (0 for symbolic ones).
+    [[nodiscard]] std::vector<Angle> parameters() const {
+        return std::vector<Angle>(params_.begin(), params_.begin() + num_params_);
+    }
+
+    /// @brief Returns the number of angle parameters.
+    [[nodiscard]] std::size_t numParameters() const noexcept {
+        return num_params_;
+    }
+
+    /// @brief Returns the classical bit written by this gate, if any.
+    [[nodiscard]] std::optional<ClbitIndex> clbit() const noexcept {
+        return clbit_;
     }
 
     /// @brief Returns the unique gate identifier.
@@ -291,7 +551,7 @@ public:
 
     /// @brief Returns whether this gate is parameterized.
     [[nodiscard]] bool isParameterized() const noexcept {
-        return parameter_.has_value();
+        return num_params_ > 0;
     }
 
     /// @brief Returns the maximum qubit index referenced by this gate.
@@ -303,6 +563,91 @@ public:
         return max;
     }
 
+    /**
+     * @brief Returns a copy of this gate acting on other qubits.
+     *
+     * Type, parameter and classical bit are kept; the ID is reset. Used by
+     * routers to move a logical operation onto physical qubits.
+     *
+     * @param qubits Replacement qubits, position for position
+     * @return Relabeled gate
+     * @throws std::invalid_argument if the qubit count changes
+     */
+    [[nodiscard]] Gate withQubits(std::vector<QubitIndex> qubits) const {
+        if (qubits.size() != qubits_.size()) {
+            throw std::invalid_argument(
+                "Gate " + std::string(gateTypeName(type_)) + " acts on " +
+                std::to_string(qubits_.size()) + " qubit(s), got " +
+                std::to_string(qubits.size()));
+        }
+        Gate result(*this);
+        result.qubits_ = std::move(qubits);
+        result.id_ = INVALID_GATE_ID;
+        return result;
+    }
+
+    /**
+     * @brief Returns a copy of this gate with other angle parameters.
+     *
+     * Type, qubits and classical bit are kept; the ID is reset. Used by
+     * passes that fold angles, such as rotation merging.
+     *
+     * @param parameters Replacement angles
+     * @return Updated gate
+     * @throws std::invalid_argument if the parameter count is wrong
+     */
+    [[nodiscard]] Gate withParameters(const std::vector<Angle>& parameters) const {
+        checkParameterCount(type_, parameters.size());
+        return Gate(type_, qubits_, std::nullopt, INVALID_GATE_ID, clbit_,
+                    parameters.begin(), parameters.end());
+    }
+
+    /**
+     * @brief Returns a copy of this gate with a symbolic parameter.
+     *
+     * Type, qubits, classical bit and the other parameters are kept; the
+     * ID is reset.
+     *
+     * @param index Parameter position
+     * @param expr Entry of the owning circuit's ParameterTable
+     * @return Updated gate
+     * @throws std::out_of_range if index >= numParameters()
+     */
+    [[nodiscard]] Gate withExpression(std::size_t index, ParameterExprId expr) const {
+        checkParameterIndex(index);
+        Gate result(*this);
+        result.params_[index] = 0.0;
+        result.exprs_[index] = expr;
+        result.id_ = INVALID_GATE_ID;
+        return result;
+    }
+
+    /**
+     * @brief Returns a copy of this gate with its symbolic parameters resolved.
+     *
+     * The ID is kept, so a bound circuit numbers its gates like the template.
+     *
+     * @param values Evaluated expressions, indexed by ParameterExprId
+     *        (see ParameterTable::evaluate())
+     * @return Gate with concrete parameters only
+     * @throws std::out_of_range if an expression has no value
+     */
+    [[nodiscard]] Gate bound(const std::vector<Angle>& values) const {
+        Gate result(*this);
+        for (std::size_t i = 0; i < num_params_; ++i) {
+            if (exprs_[i] == NO_PARAMETER_EXPR) continue;
+            if (exprs_[i] >= values.size()) {
+                throw std::out_of_range(
+                    "Gate " + std::string(gateTypeName(type_)) + " references parameter "
+                    "expression " + std::to_string(exprs_[i]) + " but only " +
+                    std::to_string(values.size()) + " values given");
+            }
+            result.params_[i] = values[exprs_[i]];
+            result.exprs_[i] = NO_PARAMETER_EXPR;
+        }
+        return result;
+    }
+
     // -------------------------------------------------------------------------
     // Operators
     // -------------------------------------------------------------------------
@@ -311,7 +656,12 @@ public:
     [[nodiscard]] bool operator==(const Gate& other) const noexcept {
         return type_ == other.type_ &&
                qubits_ == other.qubits_ &&
-               parameter_ == other.parameter_;
+               num_params_ == other.num_params_ &&
+               std::equal(params_.begin(), params_.begin() + num_params_,
+                          other.params_.begin()) &&
+               std::equal(exprs_.begin(), exprs_.begin() + num_params_,
+                          other.exprs_.begin()) &&
+               clbit_ == other.clbit_;
     }
 
     /// @brief Inequality comparison.
@@ -322,25 +672,76 @@ public:
     /// @brief Returns a string representation of the gate.
     [[nodiscard]] std::string toString() const {
         std::string result{gateTypeName(type_)};
-        if (parameter_.has_value()) {
-            result += "(" + std::to_string(parameter_.value()) + ")";
+        if (num_params_ > 0) {
+            result += "(";
+            for (std::size_t i = 0; i < num_params_; ++i) {
+                if (i > 0) result += ", ";
+                result += exprs_[i] == NO_PARAMETER_EXPR
+                              ? std::to_string(params_[i])
+                              : "$" + std::to_string(exprs_[i]);
+            }
+            result += ")";
         }
         result += " ";
         for (std::size_t i = 0; i < qubits_.size(); ++i) {
             if (i > 0) result += ", ";
             result += "q[" + std::to_string(qubits_[i]) + "]";
         }
+        if (clbit_.has_value()) {
+            result += " -> c[" + std::to_string(clbit_.value()) + "]";
+        }
         return result;
     }
 
 private:
     GateType type_;
     std::vector<QubitIndex> qubits_;
-    std::optional<Angle> parameter_;
+    std::array<Angle, MAX_GATE_PARAMETERS> params_{};
+    std::array<ParameterExprId, MAX_GATE_PARAMETERS> exprs_{
+        {NO_PARAMETER_EXPR, NO_PARAMETER_EXPR, NO_PARAMETER_EXPR}};
+    std::uint8_t num_params_;
+    std::optional<ClbitIndex> clbit_;
     GateId id_;
 
+    /// @brief Constructs a gate from a range of at most MAX_GATE_PARAMETERS angles.
+    template <typename It>
+    Gate(GateType type, std::vector<QubitIndex> qubits, std::nullopt_t, GateId id,
+         std::optional<ClbitIndex> clbit, It first, It last)
+        : type_(type)
+        , qubits_(std::move(qubits))
+        , num_params_(static_cast<std::uint8_t>(std::distance(first, last)))
+        , clbit_(clbit)
+        , id_(id)
+    {
+        std::copy(first, last, params_.begin());
+        validate();
+    }
+
+    /// @brief Throws std::out_of_range unless index < numParameters().
+    void checkParameterIndex(std::size_t index) const {
+        if (index >= num_params_) {
+            throw std::out_of_range(
+                "Gate " + std::string(gateTypeName(type_)) + " has no parameter " +
+                std::to_string(index));
+        }
+    }
+
+    /// @brief Rejects parameter lists that cannot fit into a gate.
+    static void checkParameterCount(GateType type, std::size_t count) {
+        if (count > MAX_GATE_PARAMETERS) {
+            throw std::invalid_argument(
+                "Gate " + std::string(gateTypeName(type)) + " given " +
+                std::to_string(count) + " parameters");
+        }
+    }
+
     /// @brief Validates gate construction parameters.
     void validate() const {
+        if (type_ == GateType::Barrier) {
+            validateBarrier();
+            return;
+        }
+
         const std::size_t expected = numQubitsFor(type_);
         if (qubits_.size() != expected) {
             throw std::invalid_argument(
@@ -349,11 +750,42 @@ private:
                 " qubit(s), got " + std::to_string(qubits_.size()));
         }
 
-        if (ir::isParameterized(type_) && !parameter_.has_value()) {
+        const std::size_t params = numParametersFor(type_);
+        if (params > 0 && num_params_ == 0) {
             throw std::invalid_argument(
                 "Gate " + std::string(gateTypeName(type_)) +
                 " requires a rotation parameter");
         }
+        if (num_params_ > 0 && num_params_ != params) {
+            throw std::invalid_argument(
+                "Gate " + std::string(gateTypeName(type_)) +
+                " requires " + std::to_string(params) +
+                " parameter(s), got " + std::to_string(num_params_));
+        }
+
+        if (clbit_.has_value() && type_ != GateType::Measure) {
+            throw std::invalid_argument(
+                "Gate " + std::string(gateTypeName(type_)) +
+                " does not write a classical bit");
+        }
+    }
+
+    /// @brief Validates a barrier: at least one qubit, no duplicates.
+    void validateBarrier() const {
+        if (qubits_.empty()) {
+            throw std::invalid_argument("Gate Barrier requires at least 1 qubit");
+        }
+        if (num_params_ > 0 || clbit_.has_value()) {
+            throw std::invalid_argument(
+                "Gate Barrier takes no parameter or classical bit");
+        }
+        std::vector<QubitIndex> sorted(qubits_);
+        std::sort(sorted.begin(), sorted.end());
+        auto dup = std::adjacent_find(sorted.begin(), sorted.end());
+        if (dup != sorted.end()) {
+            throw std::invalid_argument(
+                "Gate Barrier has duplicate qubit " + std::to_string(*dup));
+        }
     }
 };
 
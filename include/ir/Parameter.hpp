@@ -0,0 +1,381 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file Parameter.hpp
+ * @brief Symbolic angle parameters and their side table
+ *
+ * Provides AffineExpression, an angle of the form c + a0*s0 + a1*s1 + ...
+ * over named symbols, and ParameterTable, which stores the expressions of a
+ * circuit's symbolic gate parameters. A gate refers to its expression by
+ * index (ParameterExprId), so symbolic gates are as small as concrete ones.
+ *
+ * The table keeps every expression in flat arrays (compressed sparse rows:
+ * one constant and one term range per expression), so evaluating all of
+ * them for a set of symbol values is a single sweep over contiguous memory.
+ *
+ * @see Gate.hpp for symbolic parameter slots
+ * @see Circuit.hpp for bind()
+ */
+
+#pragma once
+
+#include "Types.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace qopt::ir {
+
+/// @brief Index of a named symbol in a ParameterTable.
+using SymbolId = std::uint32_t;
+
+/// @brief One weighted symbol of an affine expression.
+struct ParameterTerm {
+    SymbolId symbol;     ///< The symbol
+    double coefficient;  ///< Its weight (never 0 inside an expression)
+
+    [[nodiscard]] bool operator==(const ParameterTerm& other) const noexcept {
+        return symbol == other.symbol && coefficient == other.coefficient;
+    }
+    [[nodiscard]] bool operator!=(const ParameterTerm& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief An angle that is affine in a set of symbols.
+ *
+ * Terms are kept sorted by symbol with nonzero coefficients, so equal
+ * expressions compare equal and theta - theta folds to a constant.
+ *
+ * Example:
+ * @code
+ * auto e = AffineExpression::symbol(0) * 2.0 + AffineExpression(0.5);
+ * double v = e.evaluate({0.25});  // 1.0
+ * @endcode
+ */
+class AffineExpression {
+public:
+    /// @brief Constructs a constant expression (0 by default).
+    explicit AffineExpression(double constant = 0.0) noexcept : constant_(constant) {}
+
+    /// @brief Creates coefficient * symbol.
+    [[nodiscard]] static AffineExpression symbol(SymbolId symbol, double coefficient = 1.0) {
+        AffineExpression e;
+        if (coefficient != 0.0) {
+            e.terms_.push_back({symbol, coefficient});
+        }
+        return e;
+    }
+
+    /// @brief Returns the constant part.
+    [[nodiscard]] double constant() const noexcept { return constant_; }
+
+    /// @brief Returns the symbol terms, sorted by symbol.
+    [[nodiscard]] const std::vector<ParameterTerm>& terms() const noexcept { return terms_; }
+
+    /// @brief Returns true if the expression references no symbols.
+    [[nodiscard]] bool isConstant() const noexcept { return terms_.empty(); }
+
+    /// @brief Adds another expression, merging terms of the same symbol.
+    AffineExpression& operator+=(const AffineExpression& other) {
+        constant_ += other.constant_;
+        std::vector<ParameterTerm> merged;
+        merged.reserve(terms_.size() + other.terms_.size());
+        auto a = terms_.begin();
+        auto b = other.terms_.begin();
+        while (a != terms_.end() || b != other.terms_.end()) {
+            if (b == other.terms_.end() || (a != terms_.end() && a->symbol < b->symbol)) {
+                merged.push_back(*a++);
+            } else if (a == terms_.end() || b->symbol < a->symbol) {
+                merged.push_back(*b++);
+            } else {
+                double sum = a->coefficient + b->coefficient;
+                if (sum != 0.0) {
+                    merged.push_back({a->symbol, sum});
+                }
+                ++a;
+                ++b;
+            }
+        }
+        terms_ = std::move(merged);
+        return *this;
+    }
+
+    /// @brief Multiplies the expression by a constant.
+    AffineExpression& operator*=(double factor) {
+        constant_ *= factor;
+        if (factor == 0.0) {
+            terms_.clear();
+        }
+        for (auto& term : terms_) {
+            term.coefficient *= factor;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] friend AffineExpression operator+(AffineExpression a, const AffineExpression& b) {
+        return a += b;
+    }
+    [[nodiscard]] friend AffineExpression operator-(AffineExpression a) {
+        return a *= -1.0;
+    }
+    [[nodiscard]] friend AffineExpression operator-(AffineExpression a, AffineExpression b) {
+        return a += (b *= -1.0);
+    }
+    [[nodiscard]] friend AffineExpression operator*(AffineExpression a, double factor) {
+        return a *= factor;
+    }
+    [[nodiscard]] friend AffineExpression operator*(double factor, AffineExpression a) {
+        return a *= factor;
+    }
+
+    /// @brief Equality comparison (exact coefficients).
+    [[nodiscard]] bool operator==(const AffineExpression& other) const noexcept {
+        return constant_ == other.constant_ && terms_ == other.terms_;
+    }
+    [[nodiscard]] bool operator!=(const AffineExpression& other) const noexcept {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Evaluates the expression.
+     * @param values Symbol values, indexed by SymbolId
+     * @throws std::out_of_range if a referenced symbol has no value
+     */
+    [[nodiscard]] double evaluate(const std::vector<double>& values) const {
+        double result = constant_;
+        for (const auto& term : terms_) {
+            if (term.symbol >= values.size()) {
+                throw std::out_of_range(
+                    "Expression references symbol " + std::to_string(term.symbol) +
+                    " but only " + std::to_string(values.size()) + " values given");
+            }
+            result += term.coefficient * values[term.symbol];
+        }
+        return result;
+    }
+
+private:
+    double constant_;
+    std::vector<ParameterTerm> terms_;
+};
+
+/**
+ * @brief Side table of symbols and symbolic parameter expressions.
+ *
+ * Each Circuit and DAG owns one table. Symbols are declared by name;
+ * expressions are appended and never removed, so a ParameterExprId stays
+ * valid for the lifetime of the table (an expression superseded by a pass
+ * simply becomes unreferenced).
+ *
+ * Example:
+ * @code
+ * ParameterTable table;
+ * SymbolId theta = table.addSymbol("theta");
+ * ParameterExprId e = table.add(AffineExpression::symbol(theta) * 0.5);
+ * std::vector<double> angles = table.evaluate({1.0});  // angles[e] == 0.5
+ * @endcode
+ */
+class ParameterTable {
+public:
+    /**
+     * @brief Declares a symbol.
+     * @param name Symbol name
+     * @return Its id (the existing id if the name is already declared)
+     */
+    SymbolId addSymbol(const std::string& name) {
+        auto it = symbol_index_.find(name);
+        if (it != symbol_index_.end()) {
+            return it->second;
+        }
+        auto id = static_cast<SymbolId>(symbols_.size());
+        symbols_.push_back(name);
+        symbol_index_.emplace(name, id);
+        return id;
+    }
+
+    /// @brief Returns the id of a declared symbol, if any.
+    [[nodiscard]] std::optional<SymbolId> findSymbol(const std::string& name) const {
+        auto it = symbol_index_.find(name);
+        if (it == symbol_index_.end()) return std::nullopt;
+        return it->second;
+    }
+
+    /// @brief Returns the names of all symbols, indexed by SymbolId.
+    [[nodiscard]] const std::vector<std::string>& symbols() const noexcept { return symbols_; }
+
+    /// @brief Returns the number of declared symbols.
+    [[nodiscard]] std::size_t numSymbols() const noexcept { return symbols_.size(); }
+
+    /// @brief Returns the number of stored expressions.
+    [[nodiscard]] std::size_t numExpressions() const noexcept { return constants_.size(); }
+
+    /// @brief Returns true if no symbols and no expressions are stored.
+    [[nodiscard]] bool empty() const noexcept {
+        return symbols_.empty() && constants_.empty();
+    }
+
+    /**
+     * @brief Appends an expression.
+     * @param expr The expression
+     * @return Its id
+     * @throws std::out_of_range if the expression references an undeclared symbol
+     */
+    ParameterExprId add(const AffineExpression& expr) {
+        for (const auto& term : expr.terms()) {
+            if (term.symbol >= symbols_.size()) {
+                throw std::out_of_range(
+                    "Expression references symbol " + std::to_string(term.symbol) +
+                    " but only " + std::to_string(symbols_.size()) + " are declared");
+            }
+        }
+        auto id = static_cast<ParameterExprId>(constants_.size());
+        constants_.push_back(expr.constant());
+        for (const auto& term : expr.terms()) {
+            term_symbols_.push_back(term.symbol);
+            term_coefficients_.push_back(term.coefficient);
+        }
+        row_end_.push_back(term_symbols_.size());
+        return id;
+    }
+
+    /**
+     * @brief Returns a stored expression.
+     * @throws std::out_of_range if id >= numExpressions()
+     */
+    [[nodiscard]] AffineExpression expression(ParameterExprId id) const {
+        checkExpression(id);
+        AffineExpression result(constants_[id]);
+        for (std::size_t k = rowBegin(id); k < row_end_[id]; ++k) {
+            result += AffineExpression::symbol(term_symbols_[k], term_coefficients_[k]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Evaluates every stored expression.
+     *
+     * One pass over the flat term arrays; the cost is linear in the total
+     * number of terms, independent of how many gates share an expression.
+     *
+     * @param values Symbol values, indexed by SymbolId
+     * @return Expression values, indexed by ParameterExprId
+     * @throws std::invalid_argument if values.size() != numSymbols()
+     */
+    [[nodiscard]] std::vector<Angle> evaluate(const std::vector<double>& values) const {
+        if (values.size() != symbols_.size()) {
+            throw std::invalid_argument(
+                "Expected " + std::to_string(symbols_.size()) + " symbol values, got " +
+                std::to_string(values.size()));
+        }
+        std::vector<Angle> result(constants_.size());
+        std::size_t k = 0;
+        for (std::size_t e = 0; e < constants_.size(); ++e) {
+            double acc = constants_[e];
+            for (; k < row_end_[e]; ++k) {
+                acc += term_coefficients_[k] * values[term_symbols_[k]];
+            }
+            result[e] = acc;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Orders named values by SymbolId.
+     * @param bindings A value for every declared symbol
+     * @return Values indexed by SymbolId
+     * @throws std::invalid_argument if a symbol is missing or a name is unknown
+     */
+    [[nodiscard]] std::vector<double> values(
+            const std::unordered_map<std::string, double>& bindings) const {
+        std::vector<double> result(symbols_.size());
+        for (std::size_t s = 0; s < symbols_.size(); ++s) {
+            auto it = bindings.find(symbols_[s]);
+            if (it == bindings.end()) {
+                throw std::invalid_argument("No value bound to symbol '" + symbols_[s] + "'");
+            }
+            result[s] = it->second;
+        }
+        if (bindings.size() != symbols_.size()) {
+            for (const auto& [name, value] : bindings) {
+                if (symbol_index_.count(name) == 0) {
+                    throw std::invalid_argument("Unknown symbol '" + name + "'");
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Formats an expression in OpenQASM syntax, e.g. "0.5*theta - phi + 1".
+     *
+     * Coefficients and constants are printed with 17 significant digits so
+     * the text parses back to the same expression.
+     *
+     * @throws std::out_of_range if id >= numExpressions()
+     */
+    [[nodiscard]] std::string toString(ParameterExprId id) const {
+        checkExpression(id);
+        std::string result;
+        for (std::size_t k = rowBegin(id); k < row_end_[id]; ++k) {
+            double c = term_coefficients_[k];
+            if (!result.empty()) {
+                result += c < 0.0 ? " - " : " + ";
+                c = std::fabs(c);
+            } else if (c < 0.0) {
+                result += "-";
+                c = -c;
+            }
+            if (c != 1.0) {
+                result += formatNumber(c) + "*";
+            }
+            result += symbols_[term_symbols_[k]];
+        }
+        const double constant = constants_[id];
+        if (result.empty()) {
+            return formatNumber(constant);
+        }
+        if (constant != 0.0) {
+            result += (constant < 0.0 ? " - " : " + ") + formatNumber(std::fabs(constant));
+        }
+        return result;
+    }
+
+private:
+    std::vector<std::string> symbols_;
+    std::unordered_map<std::string, SymbolId> symbol_index_;
+    // Expression e is constants_[e] plus the terms [row_end_[e-1], row_end_[e])
+    std::vector<double> constants_;
+    std::vector<std::size_t> row_end_;
+    std::vector<SymbolId> term_symbols_;
+    std::vector<double> term_coefficients_;
+
+    [[nodiscard]] std::size_t rowBegin(ParameterExprId id) const noexcept {
+        return id == 0 ? 0 : row_end_[id - 1];
+    }
+
+    void checkExpression(ParameterExprId id) const {
+        if (id >= constants_.size()) {
+            throw std::out_of_range(
+                "Parameter expression " + std::to_string(id) + " out of range [0, " +
+                std::to_string(constants_.size()) + ")");
+        }
+    }
+
+    [[nodiscard]] static std::string formatNumber(double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        return buffer;
+    }
+};
+
+}  // namespace qopt::ir
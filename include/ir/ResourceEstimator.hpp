@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file ResourceEstimator.hpp
+ * @brief One-pass resource estimation over a gate stream
+ *
+ * Provides ResourceEstimator, which accumulates T-count, T-depth, CNOT
+ * count, rotation count, per-qubit activity and depth from gates fed to it
+ * one at a time. State is O(num_qubits + num_clbits): no Circuit or DAG is
+ * built, so it pairs with parser::Parser::parseStreaming() for circuits too
+ * large to hold in memory.
+ *
+ * @see parser/Parser.hpp for parseStreaming()
+ */
+
+#pragma once
+
+#include "Gate.hpp"
+#include "Types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace qopt::ir {
+
+/**
+ * @brief Resource counts of a circuit.
+ */
+struct ResourceEstimate {
+    /// @brief Qubits (declared, or one past the highest index used)
+    std::size_t num_qubits = 0;
+
+    /// @brief Total gates, including measurements, resets and barriers
+    std::size_t num_gates = 0;
+
+    /// @brief Layer depth, as Circuit::depth()
+    std::size_t depth = 0;
+
+    /// @brief T and Tdg gates
+    std::size_t t_count = 0;
+
+    /// @brief Layers containing a T or Tdg gate on some path (other gates take no time)
+    std::size_t t_depth = 0;
+
+    /// @brief CNOT gates
+    std::size_t cnot_count = 0;
+
+    /// @brief Gates on two qubits (CNOT, CZ, SWAP, CPhase, RZZ, iSWAP)
+    std::size_t two_qubit_count = 0;
+
+    /// @brief Toffoli gates
+    std::size_t ccx_count = 0;
+
+    /// @brief Parameterized rotations (Rx, Ry, Rz, U3, CPhase, RZZ)
+    std::size_t rotation_count = 0;
+
+    /// @brief Measurements
+    std::size_t measure_count = 0;
+
+    /// @brief Gates acting on each qubit (barriers excluded)
+    std::vector<std::size_t> qubit_activity;
+
+    /**
+     * @brief Exports the estimate as a JSON object.
+     * @return Single-line JSON text
+     */
+    [[nodiscard]] std::string toJson() const {
+        std::string json = "{\"num_qubits\":" + std::to_string(num_qubits);
+        json += ",\"num_gates\":" + std::to_string(num_gates);
+        json += ",\"depth\":" + std::to_string(depth);
+        json += ",\"t_count\":" + std::to_string(t_count);
+        json += ",\"t_depth\":" + std::to_string(t_depth);
+        json += ",\"cnot_count\":" + std::to_string(cnot_count);
+        json += ",\"two_qubit_count\":" + std::to_string(two_qubit_count);
+        json += ",\"ccx_count\":" + std::to_string(ccx_count);
+        json += ",\"rotation_count\":" + std::to_string(rotation_count);
+        json += ",\"measure_count\":" + std::to_string(measure_count);
+        json += ",\"qubit_activity\":[";
+        for (std::size_t i = 0; i < qubit_activity.size(); ++i) {
+            if (i > 0) json += ",";
+            json += std::to_string(qubit_activity[i]);
+        }
+        json += "]}";
+        return json;
+    }
+};
+
+/**
+ * @brief Accumulates a ResourceEstimate one gate at a time.
+ *
+ * Per-wire state grows on demand, so the register sizes need not be known
+ * up front. Each add() costs O(gate arity).
+ *
+ * Example:
+ * @code
+ * ResourceEstimator estimator;
+ * parser::Parser parser(source);
+ * auto info = parser.parseStreaming([&](const Gate& g) { estimator.add(g); });
+ * ResourceEstimate report = estimator.estimate(info.numQubits);
+ * @endcode
+ */
+class ResourceEstimator {
+public:
+    /**
+     * @brief Adds one gate, in program order.
+     */
+    void add(const Gate& gate) {
+        ++estimate_.num_gates;
+        switch (gate.type()) {
+            case GateType::T:
+            case GateType::Tdg:
+                ++estimate_.t_count;
+                break;
+            case GateType::CNOT:
+                ++estimate_.cnot_count;
+                break;
+            case GateType::CCX:
+                ++estimate_.ccx_count;
+                break;
+            case GateType::Measure:
+                ++estimate_.measure_count;
+                break;
+            default:
+                break;
+        }
+        if (isTwoQubitGate(gate.type())) ++estimate_.two_qubit_count;
+        if (isParameterized(gate.type())) ++estimate_.rotation_count;
+
+        const bool is_t = gate.type() == GateType::T || gate.type() == GateType::Tdg;
+        std::size_t level = 0;
+        std::size_t t_level = 0;
+        for (auto q : gate.qubits()) {
+            growQubits(q + 1);
+            level = std::max(level, qubit_levels_[q]);
+            t_level = std::max(t_level, qubit_t_levels_[q]);
+        }
+        if (auto c = gate.clbit()) {
+            if (*c >= clbit_levels_.size()) {
+                clbit_levels_.resize(*c + 1, 0);
+                clbit_t_levels_.resize(*c + 1, 0);
+            }
+            level = std::max(level, clbit_levels_[*c]);
+            t_level = std::max(t_level, clbit_t_levels_[*c]);
+            clbit_levels_[*c] = level + 1;
+            clbit_t_levels_[*c] = t_level + (is_t ? 1 : 0);
+        }
+        ++level;
+        if (is_t) ++t_level;
+
+        for (auto q : gate.qubits()) {
+            qubit_levels_[q] = level;
+            qubit_t_levels_[q] = t_level;
+            if (gate.type() != GateType::Barrier) ++estimate_.qubit_activity[q];
+        }
+        estimate_.depth = std::max(estimate_.depth, level);
+        estimate_.t_depth = std::max(estimate_.t_depth, t_level);
+    }
+
+    /**
+     * @brief Returns the estimate for the gates added so far.
+     * @param num_qubits Declared register size; the report covers at least
+     *        this many qubits (idle ones show zero activity)
+     */
+    [[nodiscard]] ResourceEstimate estimate(std::size_t num_qubits = 0) const {
+        ResourceEstimate result = estimate_;
+        result.num_qubits = std::max(num_qubits, result.qubit_activity.size());
+        result.qubit_activity.resize(result.num_qubits, 0);
+        return result;
+    }
+
+private:
+    ResourceEstimate estimate_;
+    std::vector<std::size_t> qubit_levels_;    // Depth reached on each qubit
+    std::vector<std::size_t> qubit_t_levels_;  // T-depth reached on each qubit
+    std::vector<std::size_t> clbit_levels_;
+    std::vector<std::size_t> clbit_t_levels_;
+
+    void growQubits(std::size_t n) {
+        if (n > qubit_levels_.size()) {
+            qubit_levels_.resize(n, 0);
+            qubit_t_levels_.resize(n, 0);
+            estimate_.qubit_activity.resize(n, 0);
+        }
+    }
+};
+
+}  // namespace qopt::ir
@@ -0,0 +1,389 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file Schedule.hpp
+ * @brief ASAP/ALAP scheduling of a DAG with per-gate durations
+ *
+ * Provides DurationTable, which assigns a duration to each gate type, and
+ * Schedule, which computes as-soon-as-possible and as-late-as-possible start
+ * times over a DAG. Circuit::depth() and DAG::depth() count layers; a
+ * Schedule measures wall-clock time instead, reporting the critical-path
+ * duration, per-gate slack and the windows in which each qubit sits idle.
+ *
+ * @see DAG.hpp for the dependency graph being scheduled
+ */
+
+#pragma once
+
+#include "Circuit.hpp"
+#include "DAG.hpp"
+#include "Gate.hpp"
+#include "Types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace qopt::ir {
+
+/// @brief Type alias for gate durations and start times (any consistent unit)
+using Duration = double;
+
+/**
+ * @brief Gate durations by gate type.
+ *
+ * Defaults to unit duration for every gate and zero for barriers, so a
+ * default schedule's duration equals the layer depth of a barrier-free
+ * circuit.
+ *
+ * Example:
+ * @code
+ * // 20 ns single-qubit gates, 300 ns two-qubit gates, 1 us measurement
+ * auto table = DurationTable::byArity(20.0, 300.0, 1000.0);
+ * table.set(GateType::Rz, 0.0);  // Virtual Z
+ * @endcode
+ */
+class DurationTable {
+public:
+    /// @brief Constructs a table with unit durations (barriers take 0).
+    DurationTable() noexcept {
+        durations_.fill(1.0);
+        durations_[index(GateType::Barrier)] = 0.0;
+    }
+
+    /**
+     * @brief Constructs a table from per-class durations.
+     *
+     * Single-qubit gates take @p single, two- and three-qubit gates take
+     * @p two, Measure and Reset take @p measure; barriers take 0.
+     *
+     * @throws std::invalid_argument if any duration is negative
+     */
+    [[nodiscard]] static DurationTable byArity(Duration single, Duration two, Duration measure) {
+        DurationTable table;
+        for (std::size_t i = 0; i < NUM_GATE_TYPES; ++i) {
+            const auto type = static_cast<GateType>(i);
+            if (type == GateType::Barrier) continue;
+            Duration d = single;
+            if (type == GateType::Measure || type == GateType::Reset) {
+                d = measure;
+            } else if (isTwoQubitGate(type) || type == GateType::CCX) {
+                d = two;
+            }
+            table.set(type, d);
+        }
+        return table;
+    }
+
+    /**
+     * @brief Sets the duration of a gate type.
+     * @return Reference to this table, for chaining
+     * @throws std::invalid_argument if duration is negative
+     */
+    DurationTable& set(GateType type, Duration duration) {
+        if (!(duration >= 0.0)) {
+            throw std::invalid_argument(
+                "Duration of " + std::string(gateTypeName(type)) + " must be non-negative");
+        }
+        durations_[index(type)] = duration;
+        return *this;
+    }
+
+    /// @brief Returns the duration of a gate type.
+    [[nodiscard]] Duration duration(GateType type) const noexcept {
+        return durations_[index(type)];
+    }
+
+    /// @brief Returns the duration of a gate.
+    [[nodiscard]] Duration operator()(const Gate& gate) const noexcept {
+        return duration(gate.type());
+    }
+
+private:
+    static constexpr std::size_t NUM_GATE_TYPES = static_cast<std::size_t>(GateType::Barrier) + 1;
+
+    std::array<Duration, NUM_GATE_TYPES> durations_{};
+
+    [[nodiscard]] static constexpr std::size_t index(GateType type) noexcept {
+        return static_cast<std::size_t>(type);
+    }
+};
+
+/**
+ * @brief An interval [start, end) during which a qubit runs no gate.
+ */
+struct IdleWindow {
+    QubitIndex qubit;
+    Duration start;
+    Duration end;
+
+    [[nodiscard]] Duration length() const noexcept { return end - start; }
+
+    [[nodiscard]] bool operator==(const IdleWindow& other) const noexcept {
+        return qubit == other.qubit && start == other.start && end == other.end;
+    }
+};
+
+/// @brief Which start times an IdleWindow query uses.
+enum class Alignment {
+    ASAP,  ///< Every gate starts as early as its predecessors allow
+    ALAP   ///< Every gate starts as late as the total duration allows
+};
+
+/**
+ * @brief ASAP and ALAP start times for every node of a DAG.
+ *
+ * Computed once by compute() in O(V + E): a forward pass over the
+ * topological order for ASAP times and a backward pass for ALAP times.
+ * Per-node data is indexed by GateId, so call DAG::compact() first on a
+ * DAG with many removed nodes. The schedule is a snapshot and does not
+ * follow later edits of the DAG.
+ *
+ * Example:
+ * @code
+ * Schedule s = Schedule::compute(dag, DurationTable::byArity(20.0, 300.0, 1000.0));
+ * Duration total = s.duration();
+ * for (const IdleWindow& w : s.idleWindows(0)) { ... }
+ * @endcode
+ */
+class Schedule {
+public:
+    /**
+     * @brief Schedules every node of a DAG.
+     * @param dag The DAG to schedule
+     * @param durations Gate durations (default: unit)
+     */
+    [[nodiscard]] static Schedule compute(const DAG& dag,
+                                          const DurationTable& durations = DurationTable()) {
+        Schedule s;
+        s.qubit_gates_.resize(dag.numQubits());
+
+        const std::vector<GateId> order = dag.topologicalOrder();
+        GateId max_id = 0;
+        for (GateId id : order) max_id = std::max(max_id, id);
+        const std::size_t size = order.empty() ? 0 : max_id + 1;
+        s.present_.assign(size, false);
+        s.durations_.assign(size, 0.0);
+        s.asap_.assign(size, 0.0);
+        s.alap_.assign(size, 0.0);
+
+        // Forward pass: start once every predecessor has finished
+        for (GateId id : order) {
+            const DAGNode& n = dag.node(id);
+            Duration start = 0.0;
+            for (GateId pred : n.predecessors()) {
+                start = std::max(start, s.asap_[pred] + s.durations_[pred]);
+            }
+            s.present_[id] = true;
+            s.durations_[id] = durations(n.gate());
+            s.asap_[id] = start;
+            s.duration_ = std::max(s.duration_, start + s.durations_[id]);
+            for (auto q : n.gate().qubits()) {
+                s.qubit_gates_[q].push_back(id);
+            }
+        }
+
+        // Backward pass: finish before any successor must start
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            const DAGNode& n = dag.node(*it);
+            Duration finish = s.duration_;
+            for (GateId succ : n.successors()) {
+                finish = std::min(finish, s.alap_[succ]);
+            }
+            s.alap_[*it] = finish - s.durations_[*it];
+        }
+
+        s.num_nodes_ = order.size();
+        return s;
+    }
+
+    /// @brief Schedules a circuit (via its DAG; gate IDs are circuit indices).
+    [[nodiscard]] static Schedule compute(const Circuit& circuit,
+                                          const DurationTable& durations = DurationTable()) {
+        return compute(DAG::fromCircuit(circuit), durations);
+    }
+
+    // -------------------------------------------------------------------------
+    // Whole-Schedule Properties
+    // -------------------------------------------------------------------------
+
+    /// @brief Returns the critical-path duration (the makespan).
+    [[nodiscard]] Duration duration() const noexcept { return duration_; }
+
+    /// @brief Returns the number of scheduled nodes.
+    [[nodiscard]] std::size_t numNodes() const noexcept { return num_nodes_; }
+
+    /// @brief Returns the number of qubits.
+    [[nodiscard]] std::size_t numQubits() const noexcept { return qubit_gates_.size(); }
+
+    // -------------------------------------------------------------------------
+    // Per-Node Times
+    // -------------------------------------------------------------------------
+
+    /// @brief Returns true if the node was scheduled.
+    [[nodiscard]] bool contains(GateId id) const noexcept {
+        return id < present_.size() && present_[id];
+    }
+
+    /**
+     * @brief Returns the earliest start time of a node.
+     * @throws std::out_of_range if the node was not scheduled
+     */
+    [[nodiscard]] Duration asap(GateId id) const {
+        checkNode(id);
+        return asap_[id];
+    }
+
+    /**
+     * @brief Returns the latest start time that keeps duration() unchanged.
+     * @throws std::out_of_range if the node was not scheduled
+     */
+    [[nodiscard]] Duration alap(GateId id) const {
+        checkNode(id);
+        return alap_[id];
+    }
+
+    /**
+     * @brief Returns how far a node can be delayed without lengthening the
+     *        schedule (alap - asap).
+     * @throws std::out_of_range if the node was not scheduled
+     */
+    [[nodiscard]] Duration slack(GateId id) const {
+        checkNode(id);
+        return alap_[id] - asap_[id];
+    }
+
+    /**
+     * @brief Returns the duration of a node's gate.
+     * @throws std::out_of_range if the node was not scheduled
+     */
+    [[nodiscard]] Duration durationOf(GateId id) const {
+        checkNode(id);
+        return durations_[id];
+    }
+
+    /**
+     * @brief Returns true if a node has zero slack, i.e. lies on a critical path.
+     * @throws std::out_of_range if the node was not scheduled
+     */
+    [[nodiscard]] bool isCritical(GateId id) const {
+        return slack(id) <= tolerance();
+    }
+
+    /**
+     * @brief Returns one critical path, from a node starting at 0 to a node
+     *        ending at duration().
+     *
+     * Each node on it starts exactly when its predecessor on the path
+     * ends, and every node has zero slack.
+     */
+    [[nodiscard]] std::vector<GateId> criticalPath(const DAG& dag) const {
+        std::vector<GateId> path;
+        GateId current = INVALID_GATE_ID;
+        for (GateId id : dag.sources()) {
+            if (contains(id) && isCritical(id) && (current == INVALID_GATE_ID || id < current)) {
+                current = id;
+            }
+        }
+        while (current != INVALID_GATE_ID) {
+            path.push_back(current);
+            const Duration end = asap_[current] + durations_[current];
+            GateId next = INVALID_GATE_ID;
+            for (GateId succ : dag.node(current).successors()) {
+                if (contains(succ) && isCritical(succ) &&
+                    asap_[succ] - end <= tolerance() &&
+                    (next == INVALID_GATE_ID || succ < next)) {
+                    next = succ;
+                }
+            }
+            current = next;
+        }
+        return path;
+    }
+
+    // -------------------------------------------------------------------------
+    // Idle Windows
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Returns the intervals in [0, duration()) when a qubit runs no gate.
+     *
+     * Includes the gap before the qubit's first gate and after its last; a
+     * qubit without gates is idle throughout.
+     *
+     * @throws std::out_of_range if qubit >= numQubits()
+     */
+    [[nodiscard]] std::vector<IdleWindow> idleWindows(QubitIndex qubit,
+                                                      Alignment alignment = Alignment::ASAP) const {
+        if (qubit >= qubit_gates_.size()) {
+            throw std::out_of_range(
+                "Qubit " + std::to_string(qubit) + " out of range for a schedule of " +
+                std::to_string(qubit_gates_.size()) + " qubits");
+        }
+        const std::vector<Duration>& starts = alignment == Alignment::ASAP ? asap_ : alap_;
+        std::vector<IdleWindow> result;
+        Duration busy_until = 0.0;
+        // Gates on one qubit form a chain, so topological order is time order
+        for (GateId id : qubit_gates_[qubit]) {
+            if (starts[id] - busy_until > tolerance()) {
+                result.push_back({qubit, busy_until, starts[id]});
+            }
+            busy_until = std::max(busy_until, starts[id] + durations_[id]);
+        }
+        if (duration_ - busy_until > tolerance()) {
+            result.push_back({qubit, busy_until, duration_});
+        }
+        return result;
+    }
+
+    /// @brief Returns the idle windows of every qubit, by qubit.
+    [[nodiscard]] std::vector<IdleWindow> idleWindows(Alignment alignment = Alignment::ASAP) const {
+        std::vector<IdleWindow> result;
+        for (QubitIndex q = 0; q < qubit_gates_.size(); ++q) {
+            auto windows = idleWindows(q, alignment);
+            result.insert(result.end(), windows.begin(), windows.end());
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the total idle time of a qubit.
+     * @throws std::out_of_range if qubit >= numQubits()
+     */
+    [[nodiscard]] Duration idleTime(QubitIndex qubit, Alignment alignment = Alignment::ASAP) const {
+        Duration total = 0.0;
+        for (const IdleWindow& w : idleWindows(qubit, alignment)) {
+            total += w.length();
+        }
+        return total;
+    }
+
+private:
+    Duration duration_ = 0.0;
+    std::size_t num_nodes_ = 0;
+    std::vector<bool> present_;                      // By GateId
+    std::vector<Duration> durations_;                // By GateId
+    std::vector<Duration> asap_;                     // By GateId
+    std::vector<Duration> alap_;                     // By GateId
+    std::vector<std::vector<GateId>> qubit_gates_;   // Gates on each qubit, in order
+
+    Schedule() = default;
+
+    /// @brief Absolute tolerance for comparing times, relative to the makespan.
+    [[nodiscard]] Duration tolerance() const noexcept {
+        return constants::TOLERANCE * std::max(1.0, duration_);
+    }
+
+    void checkNode(GateId id) const {
+        if (!contains(id)) {
+            throw std::out_of_range(
+                "Node with ID " + std::to_string(id) + " is not in the schedule");
+        }
+    }
+};
+
+}  // namespace qopt::ir
@@ -20,6 +20,9 @@ namespace qopt {
 /// @brief Type alias for qubit indices
 using QubitIndex = std::size_t;
 
+/// @brief Type alias for classical bit indices
+using ClbitIndex = std::size_t;
+
 /// @brief Type alias for unique gate identifiers
 using GateId = std::size_t;
 
@@ -32,10 +35,17 @@ inline constexpr GateId INVALID_GATE_ID = std::numeric_limits<GateId>::max();
 /// @brief Sentinel value for invalid qubit indices
 inline constexpr QubitIndex INVALID_QUBIT = std::numeric_limits<QubitIndex>::max();
 
+/// @brief Type alias for indices into a circuit's symbolic parameter table
+using ParameterExprId = std::uint32_t;
+
+/// @brief Sentinel value for a concrete (non-symbolic) gate parameter
+inline constexpr ParameterExprId NO_PARAMETER_EXPR =
+    std::numeric_limits<ParameterExprId>::max();
+
 namespace constants {
 
-/// @brief Maximum number of qubits supported (practical limit for simulation)
-inline constexpr std::size_t MAX_QUBITS = 30;
+/// @brief Maximum number of qubits supported (large enough for 1000+ qubit devices)
+inline constexpr std::size_t MAX_QUBITS = 4096;
 
 /// @brief Default tolerance for floating-point comparisons
 inline constexpr double TOLERANCE = 1e-10;
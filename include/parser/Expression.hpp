@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file Expression.hpp
+ * @brief Compiled arithmetic expressions for gate parameters
+ * @author Rylan Malarchick
+ * @date 2025
+ *
+ * Provides the Expression class, a compact postfix (RPN) program over
+ * constants and numbered parameters. The parser compiles each parameter
+ * expression once; gate definitions keep the programs in their body
+ * templates and evaluate them per call, without re-parsing.
+ *
+ * Constant subexpressions are folded at construction, so an expression
+ * without parameters is a single instruction.
+ *
+ * @see Parser.hpp for expression parsing and gate definitions
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace qopt::parser {
+
+/**
+ * @brief A parameter expression compiled to a postfix program.
+ *
+ * Example:
+ * @code
+ * // theta / 2 + pi, with theta as parameter 0
+ * auto e = Expression::binary(Expression::OpCode::Add,
+ *     Expression::binary(Expression::OpCode::Div,
+ *                        Expression::parameter(0), Expression::constant(2.0)),
+ *     Expression::constant(M_PI));
+ * double v = e.evaluate({1.0});  // 0.5 + pi
+ * @endcode
+ */
+class Expression {
+public:
+    /// @brief Postfix instruction opcodes.
+    enum class OpCode : std::uint8_t {
+        Constant,   ///< Push value
+        Parameter,  ///< Push params[index]
+        Add,        ///< Pop b, a; push a + b
+        Sub,        ///< Pop b, a; push a - b
+        Mul,        ///< Pop b, a; push a * b
+        Div,        ///< Pop b, a; push a / b
+        Neg         ///< Pop a; push -a
+    };
+
+    /// @brief One postfix instruction.
+    struct Instruction {
+        OpCode op;
+        double value;       ///< Constant value (Constant only)
+        std::size_t index;  ///< Parameter index (Parameter only)
+    };
+
+    /// @brief Constructs the constant 0.
+    Expression() : code_{{OpCode::Constant, 0.0, 0}}, stack_depth_(1) {}
+
+    /// @brief Creates a constant expression.
+    [[nodiscard]] static Expression constant(double value) {
+        Expression e;
+        e.code_[0].value = value;
+        return e;
+    }
+
+    /// @brief Creates a reference to parameter @p index.
+    [[nodiscard]] static Expression parameter(std::size_t index) {
+        Expression e;
+        e.code_[0] = {OpCode::Parameter, 0.0, index};
+        return e;
+    }
+
+    /**
+     * @brief Combines two expressions with a binary operator.
+     *
+     * Folds to a constant when both operands are constant.
+     *
+     * @throws std::invalid_argument if op is not Add, Sub, Mul or Div
+     */
+    [[nodiscard]] static Expression binary(OpCode op, Expression lhs, const Expression& rhs) {
+        if (op != OpCode::Add && op != OpCode::Sub && op != OpCode::Mul && op != OpCode::Div) {
+            throw std::invalid_argument("Expression::binary requires an arithmetic opcode");
+        }
+        if (lhs.isConstant() && rhs.isConstant()) {
+            return constant(apply(op, lhs.constantValue(), rhs.constantValue()));
+        }
+        std::size_t depth = std::max(lhs.stack_depth_, rhs.stack_depth_ + 1);
+        lhs.code_.insert(lhs.code_.end(), rhs.code_.begin(), rhs.code_.end());
+        lhs.code_.push_back({op, 0.0, 0});
+        lhs.stack_depth_ = depth;
+        return lhs;
+    }
+
+    /// @brief Negates an expression (folded when constant).
+    [[nodiscard]] static Expression negate(Expression operand) {
+        if (operand.isConstant()) {
+            return constant(-operand.constantValue());
+        }
+        operand.code_.push_back({OpCode::Neg, 0.0, 0});
+        return operand;
+    }
+
+    /// @brief Returns true if the expression references no parameters.
+    [[nodiscard]] bool isConstant() const noexcept {
+        return code_.size() == 1 && code_[0].op == OpCode::Constant;
+    }
+
+    /// @brief Returns the value of a constant expression.
+    /// @throws std::logic_error if the expression is not constant
+    [[nodiscard]] double constantValue() const {
+        if (!isConstant()) {
+            throw std::logic_error("Expression is not constant");
+        }
+        return code_[0].value;
+    }
+
+    /**
+     * @brief Evaluates the expression.
+     * @param params Parameter values, indexed as in parameter()
+     * @return The value (IEEE semantics: division by zero yields inf/nan)
+     * @throws std::out_of_range if a referenced parameter is missing
+     */
+    [[nodiscard]] double evaluate(const std::vector<double>& params) const {
+        if (isConstant()) {
+            return code_[0].value;
+        }
+
+        std::vector<double> stack;
+        stack.reserve(stack_depth_);
+        for (const auto& ins : code_) {
+            switch (ins.op) {
+                case OpCode::Constant:
+                    stack.push_back(ins.value);
+                    break;
+                case OpCode::Parameter:
+                    if (ins.index >= params.size()) {
+                        throw std::out_of_range(
+                            "Expression references parameter " + std::to_string(ins.index) +
+                            " but only " + std::to_string(params.size()) + " given");
+                    }
+                    stack.push_back(params[ins.index]);
+                    break;
+                case OpCode::Neg:
+                    stack.back() = -stack.back();
+                    break;
+                default: {
+                    double b = stack.back();
+                    stack.pop_back();
+                    stack.back() = apply(ins.op, stack.back(), b);
+                    break;
+                }
+            }
+        }
+        return stack.back();
+    }
+
+    /**
+     * @brief Replaces each parameter reference with an argument expression.
+     *
+     * Used to inline a gate body into a caller: the callee's parameter i
+     * becomes the caller's argument expression args[i]. The result is
+     * refolded, so fully constant arguments give a constant.
+     *
+     * @param args Argument expressions, indexed by parameter
+     * @return The substituted expression
+     * @throws std::out_of_range if a referenced parameter has no argument
+     */
+    [[nodiscard]] Expression substitute(const std::vector<Expression>& args) const {
+        std::vector<Expression> stack;
+        for (const auto& ins : code_) {
+            switch (ins.op) {
+                case OpCode::Constant:
+                    stack.push_back(constant(ins.value));
+                    break;
+                case OpCode::Parameter:
+                    if (ins.index >= args.size()) {
+                        throw std::out_of_range(
+                            "Expression references parameter " + std::to_string(ins.index) +
+                            " but only " + std::to_string(args.size()) + " given");
+                    }
+                    stack.push_back(args[ins.index]);
+                    break;
+                case OpCode::Neg:
+                    stack.back() = negate(std::move(stack.back()));
+                    break;
+                default: {
+                    Expression b = std::move(stack.back());
+                    stack.pop_back();
+                    stack.back() = binary(ins.op, std::move(stack.back()), b);
+                    break;
+                }
+            }
+        }
+        return std::move(stack.back());
+    }
+
+    /// @brief Returns the postfix program.
+    [[nodiscard]] const std::vector<Instruction>& code() const noexcept { return code_; }
+
+private:
+    std::vector<Instruction> code_;
+    std::size_t stack_depth_;  // Maximum evaluation stack size
+
+    [[nodiscard]] static double apply(OpCode op, double a, double b) noexcept {
+        switch (op) {
+            case OpCode::Add: return a + b;
+            case OpCode::Sub: return a - b;
+            case OpCode::Mul: return a * b;
+            case OpCode::Div: return a / b;
+            default:          return 0.0;
+        }
+    }
+};
+
+}  // namespace qopt::parser
@@ -15,9 +15,16 @@
  * - Include statements: include "stdgates.inc";
  * - Register declarations: qubit[n] q; bit[n] c;
  * - Gate applications: h q[0]; cx q[0], q[1]; rz(pi/4) q[0];
+ *   U(theta, phi, lambda) q[0]; ccx q[0], q[1], q[2];
  * - Measurement: c[0] = measure q[0];
+ * - Gate definitions: gate name(theta) a, b { ... }
+ * - Loops: for i in [0:n] { ... } and for i in [a:step:b] { ... }
+ * - Barriers and resets: barrier q; reset q[0];
  * - Comments: // single-line, multi-line with slash-star
  *
+ * In the OpenQASM 2.0 dialect the lexer additionally recognizes the
+ * qreg/creg declarations and the built-in CX gate.
+ *
  * @see Token.hpp for token types
  * @see Parser.hpp for the parser that consumes tokens
  *
@@ -36,6 +43,14 @@
 
 namespace qopt::parser {
 
+/**
+ * @brief Source language dialect.
+ */
+enum class Dialect {
+    QASM3,  ///< OpenQASM 3.0 (default)
+    QASM2   ///< OpenQASM 2.0
+};
+
 /**
  * @brief Tokenizer for OpenQASM 3.0 source code.
  *
@@ -59,13 +74,31 @@ public:
     /**
      * @brief Construct a lexer for the given source code.
      * @param source The OpenQASM 3.0 source code to tokenize
+     * @param dialect Keyword set to use (default: OpenQASM 3.0)
      */
-    explicit Lexer(std::string_view source) noexcept
+    explicit Lexer(std::string_view source, Dialect dialect = Dialect::QASM3) noexcept
         : source_(source)
         , current_(0)
         , line_(1)
         , column_(1)
-        , lineStart_(0) {}
+        , lineStart_(0)
+        , dialect_(dialect) {}
+
+    /**
+     * @brief Switch the keyword set for subsequent tokens.
+     *
+     * The parser calls this after reading the version declaration.
+     */
+    void setDialect(Dialect dialect) noexcept {
+        dialect_ = dialect;
+    }
+
+    /**
+     * @brief Get the current dialect.
+     */
+    [[nodiscard]] Dialect dialect() const noexcept {
+        return dialect_;
+    }
 
     /**
      * @brief Get the next token from the source.
@@ -97,6 +130,7 @@ public:
             case ']': return makeToken(TokenType::RightBracket);
             case '{': return makeToken(TokenType::LeftBrace);
             case '}': return makeToken(TokenType::RightBrace);
+            case ':': return makeToken(TokenType::Colon);
             case '=': return makeToken(TokenType::Equals);
             case '+': return makeToken(TokenType::Plus);
             case '*': return makeToken(TokenType::Star);
@@ -182,6 +216,7 @@ private:
     size_t line_;
     size_t column_;
     size_t lineStart_;
+    Dialect dialect_;
     size_t tokenStart_ = 0;
     SourceLocation tokenStartLocation_{};
 
@@ -193,6 +228,11 @@ private:
             {"qubit", TokenType::Qubit},
             {"bit", TokenType::Bit},
             {"measure", TokenType::Measure},
+            {"gate", TokenType::GateDecl},
+            {"for", TokenType::For},
+            {"in", TokenType::In},
+            {"barrier", TokenType::Barrier},
+            {"reset", TokenType::Reset},
             {"h", TokenType::GateH},
             {"x", TokenType::GateX},
             {"y", TokenType::GateY},
@@ -201,18 +241,36 @@ private:
             {"t", TokenType::GateT},
             {"sdg", TokenType::GateSdg},
             {"tdg", TokenType::GateTdg},
+            {"sx", TokenType::GateSX},
             {"rx", TokenType::GateRx},
             {"ry", TokenType::GateRy},
             {"rz", TokenType::GateRz},
+            {"U", TokenType::GateU3},
+            {"u3", TokenType::GateU3},    // Alias
             {"cx", TokenType::GateCX},
             {"cnot", TokenType::GateCX},  // Alias
             {"cz", TokenType::GateCZ},
             {"swap", TokenType::GateSwap},
+            {"cp", TokenType::GateCPhase},
+            {"cphase", TokenType::GateCPhase},  // Alias
+            {"rzz", TokenType::GateRZZ},
+            {"iswap", TokenType::GateISwap},
+            {"ccx", TokenType::GateCCX},
             {"pi", TokenType::Pi},
         };
         return kw;
     }
 
+    // Additional keywords of the OpenQASM 2.0 dialect
+    static const std::unordered_map<std::string_view, TokenType>& qasm2Keywords() {
+        static const std::unordered_map<std::string_view, TokenType> kw = {
+            {"qreg", TokenType::Qreg},
+            {"creg", TokenType::Creg},
+            {"CX", TokenType::GateCX},
+        };
+        return kw;
+    }
+
     /**
      * @brief Consume and return the current character.
      */
@@ -380,6 +438,12 @@ private:
         // Check if it's a keyword
         auto it = keywords().find(text);
         TokenType type = (it != keywords().end()) ? it->second : TokenType::Identifier;
+        if (type == TokenType::Identifier && dialect_ == Dialect::QASM2) {
+            auto it2 = qasm2Keywords().find(text);
+            if (it2 != qasm2Keywords().end()) {
+                type = it2->second;
+            }
+        }
 
         return Token(type, std::string(text), tokenStartLocation_);
     }
@@ -14,7 +14,45 @@
  * - Include statements: include "stdgates.inc";
  * - Register declarations: qubit[n] q; bit[n] c;
  * - Gate applications: h q[0]; cx q[0], q[1]; rz(pi/4) q[0];
- * - Measurement: c[0] = measure q[0];
+ * - Measurement: c[0] = measure q[0]; c = measure q; measure q[0];
+ * - Reset: reset q[0];
+ * - Gate definitions: gate name(theta) a, b { ... } and calls to them
+ * - Loops: for i in [0:n] { ... }, for uint i in [a:step:b] { ... }
+ * - Register broadcast: h q; cx q, r; (applied element-wise)
+ * - Barriers: barrier q, r[0]; (barrier; spans every declared qubit)
+ * - Inputs: input float[64] theta; input angle phi; (symbolic parameters)
+ *
+ * Measurements, resets and barriers are kept in the circuit in program
+ * order; measurement targets become the circuit's classical bits.
+ *
+ * A program declaring OPENQASM 2.x is parsed in the 2.0 dialect on the same
+ * lexer: qreg/creg declarations, CX, measure q -> c, and the qelib1.inc gates
+ * U/u3/u2/u1/id, which are provided as built-in gate definitions over Rz/Ry
+ * (equal up to global phase).
+ *
+ * Gate definitions are compiled once into a body template of built-in gates
+ * (calls to earlier definitions are inlined) whose parameters are Expression
+ * programs. Each call looks up the expansion for its argument values in a
+ * per-definition cache, so repeated calls copy an already evaluated gate
+ * sequence instead of re-parsing or re-evaluating the body.
+ *
+ * Top-level gate parameters and custom gate arguments may be affine
+ * expressions over inputs (2*theta + pi/4). They are not folded: each one
+ * is stored in the circuit's ParameterTable and the gate refers to it, so
+ * the compiled circuit can be bound to many input values (see
+ * ir::Circuit::bind()). Loop and gate bodies only see loop variables and
+ * formal parameters.
+ *
+ * Loop bodies are compiled once into a flat instruction list whose qubit
+ * indices and parameters are Expression programs over the loop variables;
+ * the list is then interpreted for each iteration, so unrolling never
+ * re-lexes or re-parses the body.
+ *
+ * parseStreaming() hands each gate to a callback as soon as it is parsed
+ * instead of collecting a Circuit, so memory stays proportional to the
+ * program's declarations, not to its (unrolled) gate count. The custom
+ * gate expansion cache is bounded by STREAMING_EXPANSION_LIMIT entries
+ * per gate while streaming.
  *
  * @see Lexer.hpp for tokenization
  * @see QASMError.hpp for error handling
@@ -25,16 +63,24 @@
  */
 #pragma once
 
+#include "Expression.hpp"
 #include "Lexer.hpp"
 #include "QASMError.hpp"
 #include "Token.hpp"
 #include "ir/Circuit.hpp"
 #include "ir/Gate.hpp"
+#include "ir/Parameter.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace qopt::parser {
@@ -56,6 +102,23 @@ struct ParseResult {
     }
 };
 
+/// @brief Receives each gate of a streamed parse, in program order.
+using GateCallback = std::function<void(const ir::Gate&)>;
+
+/**
+ * @brief Result of a streamed parse (see Parser::parseStreaming()).
+ *
+ * Gates went to the callback; this holds what a Circuit would have
+ * carried besides them.
+ */
+struct StreamResult {
+    size_t numQubits = 0;             ///< Declared qubits
+    size_t numClbits = 0;             ///< Declared classical bits
+    size_t numGates = 0;              ///< Gates passed to the callback
+    ir::ParameterTable parameters;    ///< Expressions symbolic gates refer to
+    std::vector<QASMError> warnings;  ///< Non-fatal warnings
+};
+
 /**
  * @brief Recursive descent parser for OpenQASM 3.0.
  *
@@ -114,6 +177,39 @@ public:
         return result;
     }
 
+    /**
+     * @brief Parse the source code, passing each gate to a callback.
+     *
+     * Never builds a Circuit: gates are created, numbered in program order
+     * and handed to @p sink one at a time, then dropped. Because parsing is
+     * single-pass, the sink may already have seen some gates when a later
+     * error is found.
+     *
+     * @param sink Called once per gate, in program order
+     * @return Register sizes, gate count, parameter table and warnings
+     * @throws QASMParseException if parsing fails
+     */
+    [[nodiscard]] StreamResult parseStreaming(const GateCallback& sink) {
+        sink_ = &sink;
+        parseVersionDeclaration();
+        while (!check(TokenType::EndOfFile) && !hadError_) {
+            parseStatement();
+        }
+        sink_ = nullptr;
+
+        if (hadError_) {
+            throw QASMParseException(errors_);
+        }
+
+        StreamResult result;
+        result.numQubits = numQubits_;
+        result.numClbits = numClbits_;
+        result.numGates = streamedGates_;
+        result.parameters = std::move(parameters_);
+        result.warnings = std::move(warnings_);
+        return result;
+    }
+
     /**
      * @brief Check if any errors occurred during parsing.
      */
@@ -128,6 +224,30 @@ public:
         return errors_;
     }
 
+    /// @brief Expansions each custom gate caches during parseStreaming().
+    /// Calls with further argument values are evaluated but not cached.
+    static constexpr size_t STREAMING_EXPANSION_LIMIT = 256;
+
+    /// @brief Counters for the custom gate expansion cache.
+    struct GateCacheStats {
+        size_t hits = 0;    ///< Calls served from the cache
+        size_t misses = 0;  ///< Calls that evaluated the body template
+    };
+
+    /**
+     * @brief Get expansion cache counters for custom gate calls.
+     */
+    [[nodiscard]] const GateCacheStats& gateCacheStats() const noexcept {
+        return gateCacheStats_;
+    }
+
+    /**
+     * @brief Get the dialect selected by the version declaration.
+     */
+    [[nodiscard]] Dialect dialect() const noexcept {
+        return lexer_.dialect();
+    }
+
 private:
     Lexer lexer_;
     Token current_;
@@ -142,30 +262,87 @@ private:
     struct RegisterInfo {
         std::string name;
         size_t size;
-        bool isQubit;  // true for qubit, false for bit
+        bool isQubit;   // true for qubit, false for bit
+        size_t offset;  // First global qubit or bit index
     };
     std::vector<RegisterInfo> registers_;
     std::unordered_map<std::string, size_t> registerIndex_;  // name -> index in registers_
+    size_t numQubits_ = 0;  // Qubits declared so far
+    size_t numClbits_ = 0;  // Bits declared so far
+
+    // A register operand: one element (q[i]) or a whole register (q)
+    struct RegisterArgument {
+        size_t first;  // Global index of the (first) element
+        size_t size;   // Register size if whole, else 1
+        bool whole;    // true if the register was named without an index
+    };
     
-    // Parsed gates (before building circuit)
+    // Parsed gates and measurements (before building circuit)
     struct ParsedGate {
         ir::GateType type;
-        std::vector<std::pair<std::string, size_t>> qubits;  // (register, index) pairs
-        std::optional<double> parameter;
+        std::vector<size_t> qubits;  // Global qubit indices
+        std::vector<double> params;  // One per parameter of the gate type
+        std::optional<size_t> clbit = std::nullopt;  // Global bit index (Measure)
+        std::vector<ParameterExprId> exprs = {};  // Per parameter if any is symbolic
     };
     std::vector<ParsedGate> gates_;
-    
-    // Parsed measurements
-    struct ParsedMeasurement {
-        std::pair<std::string, size_t> bitTarget;   // (register, index)
-        std::pair<std::string, size_t> qubitSource; // (register, index)
+    ir::ParameterTable parameters_;  // Inputs and symbolic gate parameters
+    const GateCallback* sink_ = nullptr;  // Set while streaming: gates bypass gates_
+    size_t streamedGates_ = 0;
+
+    // Custom gate definitions
+    struct GateTemplateOp {
+        ir::GateType type;
+        std::vector<size_t> qubits;       // Indices into the formal qubit list
+        std::vector<Expression> params;   // Over the formal parameter list
+    };
+    struct GateDefinition {
+        std::string name;
+        size_t numParams;
+        size_t numQubits;
+        std::vector<GateTemplateOp> body;  // Built-in gates only (calls inlined)
+        // Argument values -> evaluated parameters of the body ops, concatenated
+        std::map<std::vector<double>, std::vector<double>> expansions;
+    };
+    std::vector<GateDefinition> gateDefs_;
+    std::unordered_map<std::string, size_t> gateDefIndex_;  // name -> index in gateDefs_
+    const std::vector<std::string>* paramScope_ = nullptr;  // Formal parameters in scope
+
+    // Compiled loop bodies: a flat instruction list interpreted per iteration.
+    // A Loop instruction owns the instructions up to bodyEnd.
+    struct LoopOp {
+        enum class Kind : std::uint8_t { Gate, Call, Loop };
+        Kind kind;
+        ir::GateType type;   // Gate
+        size_t index;        // Call: index into gateDefs_; Loop: variable slot
+        size_t bodyEnd;      // Loop: one past the last body instruction
+        std::vector<std::pair<size_t, Expression>> qubits;  // (register, index expression);
+                                                            // Measure: qubit, then bit if any
+        std::vector<Expression> args;  // Gate: parameter; Call: arguments; Loop: start, step, stop
+        Token token;         // For diagnostics during unrolling
     };
-    std::vector<ParsedMeasurement> measurements_;
+    std::vector<std::string> loopVars_;  // Loop variables in scope, outermost first
+    GateCacheStats gateCacheStats_;
+    std::vector<double> uncachedExpansion_;  // Expansion not cached while streaming
 
     // =========================================================================
     // Token Management
     // =========================================================================
 
+    /**
+     * @brief Record a parsed gate, or pass it straight on when streaming.
+     */
+    void emit(ParsedGate gate) {
+        if (sink_ == nullptr) {
+            gates_.push_back(std::move(gate));
+            return;
+        }
+        if (auto g = toGate(gate)) {
+            g->setId(streamedGates_++);
+            (*sink_)(*g);
+        }
+    }
+
     /**
      * @brief Advance to the next token.
      */
@@ -193,6 +370,16 @@ private:
         return current_.type() == type;
     }
 
+    /**
+     * @brief Check if the current token can name a gate formal.
+     *
+     * Gate keywords are lexed as their own tokens, but OpenQASM allows them
+     * as formal names (e.g. a qubit formal x); their lexeme is the name.
+     */
+    [[nodiscard]] bool checkFormalName() const noexcept {
+        return check(TokenType::Identifier) || current_.isGate();
+    }
+
     /**
      * @brief Consume the current token if it matches the expected type.
      */
@@ -269,8 +456,14 @@ private:
             switch (current_.type()) {
                 case TokenType::Qubit:
                 case TokenType::Bit:
+                case TokenType::Qreg:
+                case TokenType::Creg:
+                case TokenType::Barrier:
+                case TokenType::Reset:
                 case TokenType::Include:
                 case TokenType::Measure:
+                case TokenType::GateDecl:
+                case TokenType::For:
                 case TokenType::GateH:
                 case TokenType::GateX:
                 case TokenType::GateY:
@@ -279,12 +472,18 @@ private:
                 case TokenType::GateT:
                 case TokenType::GateSdg:
                 case TokenType::GateTdg:
+                case TokenType::GateSX:
                 case TokenType::GateRx:
                 case TokenType::GateRy:
                 case TokenType::GateRz:
+                case TokenType::GateU3:
                 case TokenType::GateCX:
                 case TokenType::GateCZ:
                 case TokenType::GateSwap:
+                case TokenType::GateCPhase:
+                case TokenType::GateRZZ:
+                case TokenType::GateISwap:
+                case TokenType::GateCCX:
                     return;
                 default:
                     break;
@@ -314,10 +513,14 @@ private:
         Token versionToken = current_;
         advance();
         
-        // Check version is 3.x
+        // 2.x selects the 2.0 dialect; the lookahead token is the ';', so
+        // every statement after it is lexed with the 2.0 keyword set
         double version = std::stod(versionToken.lexeme());
-        if (version < 3.0 || version >= 4.0) {
-            warn(versionToken, "Only OpenQASM 3.x is fully supported");
+        if (version >= 2.0 && version < 3.0) {
+            lexer_.setDialect(Dialect::QASM2);
+            defineQasm2Gates();
+        } else if (version < 3.0 || version >= 4.0) {
+            warn(versionToken, "Only OpenQASM 2.x and 3.x are supported");
         }
         
         consume(TokenType::Semicolon, "Expected ';' after version declaration");
@@ -333,13 +536,31 @@ private:
             parseQubitDeclaration();
         } else if (match(TokenType::Bit)) {
             parseBitDeclaration();
+        } else if (match(TokenType::Qreg)) {
+            parseLegacyRegisterDeclaration(true);
+        } else if (match(TokenType::Creg)) {
+            parseLegacyRegisterDeclaration(false);
+        } else if (match(TokenType::Barrier)) {
+            parseBarrier();
+        } else if (match(TokenType::Reset)) {
+            parseReset();
+        } else if (match(TokenType::GateDecl)) {
+            parseGateDefinition();
+        } else if (match(TokenType::For)) {
+            parseForLoop();
         } else if (current_.isGate()) {
             parseGateApplication();
+        } else if (check(TokenType::Identifier) && current_.lexeme() == "input" &&
+                   registerIndex_.count("input") == 0) {
+            advance();
+            parseInputDeclaration();
+        } else if (check(TokenType::Identifier) && gateDefIndex_.count(current_.lexeme()) > 0) {
+            parseGateCall();
         } else if (check(TokenType::Identifier)) {
             // Could be: c[0] = measure q[0]; or c = measure q;
             parseMeasurementOrAssignment();
         } else if (match(TokenType::Measure)) {
-            // Standalone measure (result discarded)
+            // measure q -> c; or measure q; (result discarded)
             parseStandaloneMeasure();
         } else {
             errorAtCurrent("Expected statement");
@@ -361,9 +582,12 @@ private:
         advance();
         
         // We don't actually process includes, just acknowledge them
-        // stdgates.inc defines standard gates which we have built-in
-        if (filename.lexeme() != "stdgates.inc") {
-            warn(filename, "Include file ignored (only stdgates.inc is supported)");
+        // stdgates.inc / qelib1.inc define standard gates which we have built-in
+        const char* standardInclude =
+            lexer_.dialect() == Dialect::QASM2 ? "qelib1.inc" : "stdgates.inc";
+        if (filename.lexeme() != standardInclude) {
+            warn(filename, std::string("Include file ignored (only ") + standardInclude +
+                 " is supported)");
         }
         
         consume(TokenType::Semicolon, "Expected ';' after include statement");
@@ -389,15 +613,7 @@ private:
         std::string name = current_.lexeme();
         advance();
         
-        // Check for duplicate
-        if (registerIndex_.count(name) > 0) {
-            errorAtPrevious("Register '" + name + "' already declared");
-            synchronize();
-            return;
-        }
-        
-        registerIndex_[name] = registers_.size();
-        registers_.push_back({name, size, true});
+        if (!declareRegister(name, size, true)) return;
         
         consume(TokenType::Semicolon, "Expected ';' after qubit declaration");
     }
@@ -422,134 +638,427 @@ private:
         std::string name = current_.lexeme();
         advance();
         
-        // Check for duplicate
+        if (!declareRegister(name, size, false)) return;
+        
+        consume(TokenType::Semicolon, "Expected ';' after bit declaration");
+    }
+
+    /**
+     * @brief Parse (OpenQASM 2.0): qreg name[n]; or creg name[n];
+     */
+    void parseLegacyRegisterDeclaration(bool isQubit) {
+        const char* keyword = isQubit ? "qreg" : "creg";
+        if (!check(TokenType::Identifier)) {
+            errorAtCurrent(std::string("Expected register name after '") + keyword + "'");
+            synchronize();
+            return;
+        }
+        
+        std::string name = current_.lexeme();
+        advance();
+        
+        consume(TokenType::LeftBracket, std::string("Expected '[' after ") + keyword + " name");
+        size_t size = parseIntegerLiteral(std::string(keyword) + " size");
+        consume(TokenType::RightBracket, std::string("Expected ']' after ") + keyword + " size");
+        if (hadError_) return;
+        
+        if (!declareRegister(name, size, isQubit)) return;
+        
+        consume(TokenType::Semicolon,
+                std::string("Expected ';' after ") + keyword + " declaration");
+    }
+
+    /**
+     * @brief Record a register declaration whose name was just consumed.
+     * @return false (after reporting) if the name is already taken
+     */
+    bool declareRegister(const std::string& name, size_t size, bool isQubit) {
         if (registerIndex_.count(name) > 0) {
             errorAtPrevious("Register '" + name + "' already declared");
             synchronize();
-            return;
+            return false;
+        }
+        if (gateDefIndex_.count(name) > 0) {
+            errorAtPrevious("Register '" + name + "' conflicts with a gate definition");
+            synchronize();
+            return false;
+        }
+        if (parameters_.findSymbol(name)) {
+            errorAtPrevious("Register '" + name + "' conflicts with an input");
+            synchronize();
+            return false;
         }
         
+        size_t& counter = isQubit ? numQubits_ : numClbits_;
         registerIndex_[name] = registers_.size();
-        registers_.push_back({name, size, false});
+        registers_.push_back({name, size, isQubit, counter});
+        counter += size;
+        return true;
+    }
+
+    /**
+     * @brief Parse: input float[64] name; or input angle name;
+     *
+     * Declares a symbolic parameter whose value is bound after compilation.
+     * The type width is accepted and ignored.
+     */
+    void parseInputDeclaration() {
+        if (!check(TokenType::Identifier) ||
+            (current_.lexeme() != "float" && current_.lexeme() != "angle")) {
+            errorAtCurrent("Expected 'float' or 'angle' after 'input'");
+            synchronize();
+            return;
+        }
+        advance();
+        if (match(TokenType::LeftBracket)) {
+            parseIntegerLiteral("input width");
+            consume(TokenType::RightBracket, "Expected ']' after input width");
+        }
         
-        consume(TokenType::Semicolon, "Expected ';' after bit declaration");
+        if (!check(TokenType::Identifier)) {
+            errorAtCurrent("Expected input name");
+            synchronize();
+            return;
+        }
+        
+        std::string name = current_.lexeme();
+        advance();
+        
+        if (parameters_.findSymbol(name) || registerIndex_.count(name) > 0 ||
+            gateDefIndex_.count(name) > 0) {
+            errorAtPrevious("Input '" + name + "' conflicts with an earlier declaration");
+            synchronize();
+            return;
+        }
+        parameters_.addSymbol(name);
+        
+        consume(TokenType::Semicolon, "Expected ';' after input declaration");
     }
 
     /**
      * @brief Parse gate application: h q[0]; cx q[0], q[1]; rz(pi/4) q[0];
+     *
+     * Whole-register operands are broadcast: h q; applies h to every
+     * element of q, and cx q, r; pairs the elements of q and r.
      */
     void parseGateApplication() {
         Token gateToken = current_;
         ir::GateType gateType = tokenToGateType(gateToken.type());
         advance();
         
-        std::optional<double> parameter;
+        std::vector<Expression> params = parseBuiltinParameters(gateToken, gateType);
         
-        // Parse optional parameter for rotation gates
-        if (gateToken.isParameterizedGate()) {
-            consume(TokenType::LeftParen, "Expected '(' for gate parameter");
-            parameter = parseExpression();
-            consume(TokenType::RightParen, "Expected ')' after gate parameter");
+        // Parse qubit operands, one per qubit of the gate
+        std::vector<RegisterArgument> qubits;
+        for (size_t i = 0; i < ir::numQubitsFor(gateType) && !hadError_; ++i) {
+            if (i > 0) consume(TokenType::Comma, "Expected ',' between qubit operands");
+            qubits.push_back(parseRegisterArgument(true));
         }
         
-        // Parse qubit operands
-        std::vector<std::pair<std::string, size_t>> qubits;
-        qubits.push_back(parseQubitOperand());
+        consume(TokenType::Semicolon, "Expected ';' after gate application");
+        if (hadError_) return;
         
-        // Two-qubit gates need a second operand
-        if (gateToken.isTwoQubitGate()) {
-            consume(TokenType::Comma, "Expected ',' between qubit operands");
-            qubits.push_back(parseQubitOperand());
-        }
+        ParsedGate resolved{gateType, {}, {}};
+        if (!resolveParameters(params, resolved, gateToken)) return;
         
-        consume(TokenType::Semicolon, "Expected ';' after gate application");
+        size_t width = broadcastWidth(qubits, gateToken);
+        for (size_t k = 0; k < width; ++k) {
+            ParsedGate gate = resolved;
+            gate.qubits.reserve(qubits.size());
+            for (const auto& arg : qubits) {
+                gate.qubits.push_back(broadcastElement(arg, k));
+            }
+            emit(std::move(gate));
+        }
+    }
+
+    /**
+     * @brief Store the parameters of a top-level gate.
+     *
+     * Constant expressions become angles. An expression over inputs is
+     * appended to the parameter table and the gate refers to its entry.
+     *
+     * @return false (after reporting) if an expression is not affine
+     */
+    bool resolveParameters(const std::vector<Expression>& exprs, ParsedGate& gate,
+                           const Token& token) {
+        for (size_t i = 0; i < exprs.size(); ++i) {
+            if (exprs[i].isConstant()) {
+                gate.params.push_back(exprs[i].constantValue());
+                continue;
+            }
+            auto affine = toAffine(exprs[i], token);
+            if (!affine) return false;
+            if (affine->isConstant()) {
+                gate.params.push_back(affine->constant());
+                continue;
+            }
+            gate.params.push_back(0.0);
+            gate.exprs.resize(exprs.size(), NO_PARAMETER_EXPR);
+            gate.exprs[i] = parameters_.add(*affine);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Convert an expression over inputs to an affine expression.
+     *
+     * Products need a constant factor and quotients a constant divisor.
+     *
+     * @return The affine form, or nullopt (after reporting) if there is none
+     */
+    std::optional<ir::AffineExpression> toAffine(const Expression& expr, const Token& token) {
+        std::vector<ir::AffineExpression> stack;
+        for (const auto& ins : expr.code()) {
+            switch (ins.op) {
+                case Expression::OpCode::Constant:
+                    stack.emplace_back(ins.value);
+                    break;
+                case Expression::OpCode::Parameter:
+                    stack.push_back(ir::AffineExpression::symbol(
+                        static_cast<ir::SymbolId>(ins.index)));
+                    break;
+                case Expression::OpCode::Neg:
+                    stack.back() *= -1.0;
+                    break;
+                default: {
+                    ir::AffineExpression b = std::move(stack.back());
+                    stack.pop_back();
+                    ir::AffineExpression& a = stack.back();
+                    if (ins.op == Expression::OpCode::Add) {
+                        a += b;
+                    } else if (ins.op == Expression::OpCode::Sub) {
+                        a += b * -1.0;
+                    } else if (ins.op == Expression::OpCode::Mul && b.isConstant()) {
+                        a *= b.constant();
+                    } else if (ins.op == Expression::OpCode::Mul && a.isConstant()) {
+                        a = b * a.constant();
+                    } else if (ins.op == Expression::OpCode::Div && b.isConstant()) {
+                        a *= 1.0 / b.constant();
+                    } else {
+                        errorAt(token, "Symbolic gate parameter must be affine in the inputs");
+                        return std::nullopt;
+                    }
+                    break;
+                }
+            }
+        }
         
-        if (!hadError_) {
-            gates_.push_back({gateType, std::move(qubits), parameter});
+        const ir::AffineExpression& result = stack.back();
+        bool finite = std::isfinite(result.constant());
+        for (const auto& term : result.terms()) {
+            finite = finite && std::isfinite(term.coefficient);
+        }
+        if (!finite) {
+            errorAt(token, "Gate parameter is not finite");
+            return std::nullopt;
         }
+        return result;
     }
 
     /**
-     * @brief Parse a qubit operand: q[0] or q
+     * @brief Parse the parenthesized angles of a built-in gate: (a, b, c)
+     * @return One expression per parameter of the gate type
      */
-    std::pair<std::string, size_t> parseQubitOperand() {
-        if (!check(TokenType::Identifier)) {
-            errorAtCurrent("Expected qubit register name");
-            return {"", 0};
+    std::vector<Expression> parseBuiltinParameters(const Token& gateToken, ir::GateType type) {
+        std::vector<Expression> params;
+        const size_t expected = ir::numParametersFor(type);
+        if (expected == 0) return params;
+        
+        consume(TokenType::LeftParen, "Expected '(' for gate parameter");
+        do {
+            params.push_back(parseExpression());
+        } while (match(TokenType::Comma) && !hadError_);
+        consume(TokenType::RightParen, "Expected ')' after gate parameter");
+        
+        if (!hadError_ && params.size() != expected) {
+            errorAt(gateToken, "Gate '" + gateToken.lexeme() + "' expects " +
+                    std::to_string(expected) + " parameter(s), got " +
+                    std::to_string(params.size()));
+        }
+        return params;
+    }
+
+    /**
+     * @brief Parse a register operand: q[0] or q
+     * @param isQubit true for a qubit register, false for a bit register
+     */
+    RegisterArgument parseRegisterArgument(bool isQubit) {
+        size_t reg = parseRegisterName(isQubit);
+        if (hadError_) return {0, 1, false};
+        const RegisterInfo& info = registers_[reg];
+        
+        if (!check(TokenType::LeftBracket)) {
+            return {info.offset, info.size, true};
         }
         
-        std::string regName = current_.lexeme();
         advance();
+        Token indexToken = current_;
+        size_t index = parseIntegerLiteral(isQubit ? "qubit index" : "bit index");
+        consume(TokenType::RightBracket,
+                isQubit ? "Expected ']' after qubit index" : "Expected ']' after bit index");
+        
+        if (!hadError_ && index >= info.size) {
+            errorAt(indexToken, std::string(isQubit ? "Qubit" : "Bit") +
+                    " index out of range for register '" + info.name + "'");
+        }
+        return {info.offset + index, 1, false};
+    }
+
+    /**
+     * @brief Parse the name of a declared register.
+     * @param isQubit true for a qubit register, false for a bit register
+     * @return Index into registers_
+     */
+    size_t parseRegisterName(bool isQubit) {
+        if (!check(TokenType::Identifier)) {
+            errorAtCurrent(isQubit ? "Expected qubit register name" : "Expected bit register name");
+            return 0;
+        }
         
-        size_t index = 0;
-        if (match(TokenType::LeftBracket)) {
-            index = parseIntegerLiteral("qubit index");
-            consume(TokenType::RightBracket, "Expected ']' after qubit index");
+        auto it = registerIndex_.find(current_.lexeme());
+        if (it == registerIndex_.end()) {
+            errorAtCurrent("Undeclared register");
+            return 0;
+        }
+        if (registers_[it->second].isQubit != isQubit) {
+            errorAtCurrent(isQubit ? "Expected a qubit register" : "Expected a bit register");
+            return 0;
         }
         
-        return {regName, index};
+        advance();
+        return it->second;
+    }
+
+    /**
+     * @brief Number of applications implied by register broadcast.
+     *
+     * Whole-register operands must all have the same size; indexed operands
+     * are repeated. Reports an error (and returns 0) on a size mismatch.
+     */
+    size_t broadcastWidth(const std::vector<RegisterArgument>& args, const Token& token) {
+        size_t width = 0;
+        for (const auto& arg : args) {
+            if (!arg.whole) continue;
+            if (width == 0) {
+                width = arg.size;
+            } else if (arg.size != width) {
+                errorAt(token, "Register sizes differ in broadcast operands");
+                return 0;
+            }
+        }
+        return width == 0 ? 1 : width;
+    }
+
+    /**
+     * @brief Global index of element k of a (possibly broadcast) operand.
+     */
+    [[nodiscard]] static size_t broadcastElement(const RegisterArgument& arg, size_t k) noexcept {
+        return arg.whole ? arg.first + k : arg.first;
     }
 
     /**
      * @brief Parse measurement assignment: c[0] = measure q[0]; or c = measure q;
      */
     void parseMeasurementOrAssignment() {
-        std::string targetReg = current_.lexeme();
-        advance();
-        
-        size_t targetIndex = 0;
-        if (match(TokenType::LeftBracket)) {
-            targetIndex = parseIntegerLiteral("bit index");
-            consume(TokenType::RightBracket, "Expected ']' after bit index");
-        }
+        RegisterArgument target = parseRegisterArgument(false);
         
         consume(TokenType::Equals, "Expected '=' in measurement assignment");
         consume(TokenType::Measure, "Expected 'measure' after '='");
         
-        if (!check(TokenType::Identifier)) {
-            errorAtCurrent("Expected qubit register name after 'measure'");
-            synchronize();
-            return;
-        }
+        RegisterArgument source = parseRegisterArgument(true);
         
-        std::string sourceReg = current_.lexeme();
-        advance();
+        consume(TokenType::Semicolon, "Expected ';' after measurement");
         
-        size_t sourceIndex = 0;
-        if (match(TokenType::LeftBracket)) {
-            sourceIndex = parseIntegerLiteral("qubit index");
-            consume(TokenType::RightBracket, "Expected ']' after qubit index");
+        recordMeasurement(source, target, previous_);
+    }
+
+    /**
+     * @brief Parse measure q[0] -> c[0]; or standalone measure q[0];
+     *
+     * A standalone measurement still collapses the qubit, so it is kept as
+     * a Measure without a classical bit.
+     */
+    void parseStandaloneMeasure() {
+        RegisterArgument source = parseRegisterArgument(true);
+        
+        if (match(TokenType::Arrow)) {
+            RegisterArgument target = parseRegisterArgument(false);
+            consume(TokenType::Semicolon, "Expected ';' after measurement");
+            recordMeasurement(source, target, previous_);
+            return;
         }
         
         consume(TokenType::Semicolon, "Expected ';' after measurement");
+        if (hadError_) return;
         
-        if (!hadError_) {
-            measurements_.push_back({{targetReg, targetIndex}, {sourceReg, sourceIndex}});
+        for (size_t k = 0; k < source.size; ++k) {
+            emit({ir::GateType::Measure, {broadcastElement(source, k)}, {}});
         }
     }
 
     /**
-     * @brief Parse standalone measure: measure q[0];
+     * @brief Record a (possibly broadcast) measurement.
      */
-    void parseStandaloneMeasure() {
-        if (!check(TokenType::Identifier)) {
-            errorAtCurrent("Expected qubit register name after 'measure'");
-            synchronize();
+    void recordMeasurement(const RegisterArgument& source, const RegisterArgument& target,
+                           const Token& token) {
+        if (hadError_) return;
+        if (source.size != target.size) {
+            errorAt(token, "Measurement source and target sizes differ");
             return;
         }
-        
-        // We parse but don't store standalone measurements
-        // (result is discarded in our model)
-        advance();  // register name
-        
-        if (match(TokenType::LeftBracket)) {
-            parseIntegerLiteral("qubit index");
-            consume(TokenType::RightBracket, "Expected ']' after qubit index");
+        for (size_t k = 0; k < source.size; ++k) {
+            emit({ir::GateType::Measure, {broadcastElement(source, k)}, {},
+                              broadcastElement(target, k)});
         }
+    }
+
+    /**
+     * @brief Parse: reset q; or reset q[0];
+     */
+    void parseReset() {
+        RegisterArgument target = parseRegisterArgument(true);
+        consume(TokenType::Semicolon, "Expected ';' after reset");
+        if (hadError_) return;
         
-        consume(TokenType::Semicolon, "Expected ';' after measurement");
+        for (size_t k = 0; k < target.size; ++k) {
+            emit({ir::GateType::Reset, {broadcastElement(target, k)}, {}});
+        }
+    }
+
+    /**
+     * @brief Parse: barrier q, r[0]; or barrier; (all declared qubits)
+     *
+     * Produces one Barrier over the union of the operands, in ascending
+     * qubit order.
+     */
+    void parseBarrier() {
+        std::vector<size_t> qubits;
+        if (check(TokenType::Semicolon)) {
+            for (size_t q = 0; q < numQubits_; ++q) {
+                qubits.push_back(q);
+            }
+        } else {
+            do {
+                RegisterArgument arg = parseRegisterArgument(true);
+                for (size_t k = 0; k < arg.size && !hadError_; ++k) {
+                    qubits.push_back(broadcastElement(arg, k));
+                }
+            } while (match(TokenType::Comma) && !hadError_);
+        }
+        consume(TokenType::Semicolon, "Expected ';' after barrier");
+        if (hadError_ || qubits.empty()) return;
         
-        warn(previous_, "Standalone measure discards result (use 'c = measure q')");
+        emitBarrier(std::move(qubits));
+    }
+
+    /**
+     * @brief Append a barrier, dropping repeated operands.
+     */
+    void emitBarrier(std::vector<size_t> qubits) {
+        std::sort(qubits.begin(), qubits.end());
+        qubits.erase(std::unique(qubits.begin(), qubits.end()), qubits.end());
+        emit({ir::GateType::Barrier, std::move(qubits), {}});
     }
 
     /**
@@ -569,56 +1078,55 @@ private:
     /**
      * @brief Parse an arithmetic expression for gate parameters.
      *
-     * Supports: pi, numbers, +, -, *, /
-     * Uses simple precedence climbing.
+     * Supports: pi, numbers, +, -, *, /, and (inside a gate body) the
+     * gate's formal parameters. Uses simple precedence climbing; constant
+     * subexpressions are folded as they are built.
      */
-    double parseExpression() {
+    Expression parseExpression() {
         return parseAdditive();
     }
 
-    double parseAdditive() {
-        double left = parseMultiplicative();
+    Expression parseAdditive() {
+        Expression left = parseMultiplicative();
         
         while (check(TokenType::Plus) || check(TokenType::Minus)) {
             TokenType op = current_.type();
             advance();
-            double right = parseMultiplicative();
+            Expression right = parseMultiplicative();
             
-            if (op == TokenType::Plus) {
-                left = left + right;
-            } else {
-                left = left - right;
-            }
+            left = Expression::binary(
+                op == TokenType::Plus ? Expression::OpCode::Add : Expression::OpCode::Sub,
+                std::move(left), right);
         }
         
         return left;
     }
 
-    double parseMultiplicative() {
-        double left = parseUnary();
+    Expression parseMultiplicative() {
+        Expression left = parseUnary();
         
         while (check(TokenType::Star) || check(TokenType::Slash)) {
             TokenType op = current_.type();
             advance();
-            double right = parseUnary();
+            Expression right = parseUnary();
             
             if (op == TokenType::Star) {
-                left = left * right;
+                left = Expression::binary(Expression::OpCode::Mul, std::move(left), right);
             } else {
-                if (right == 0.0) {
+                if (right.isConstant() && right.constantValue() == 0.0) {
                     errorAtPrevious("Division by zero in gate parameter");
-                    return 0.0;
+                    return Expression::constant(0.0);
                 }
-                left = left / right;
+                left = Expression::binary(Expression::OpCode::Div, std::move(left), right);
             }
         }
         
         return left;
     }
 
-    double parseUnary() {
+    Expression parseUnary() {
         if (match(TokenType::Minus)) {
-            return -parseUnary();
+            return Expression::negate(parseUnary());
         }
         if (match(TokenType::Plus)) {
             return parseUnary();
@@ -626,56 +1134,739 @@ private:
         return parsePrimary();
     }
 
-    double parsePrimary() {
+    Expression parsePrimary() {
         if (match(TokenType::Pi)) {
-            return M_PI;
+            return Expression::constant(M_PI);
         }
         
         if (check(TokenType::Integer)) {
             double value = std::stod(current_.lexeme());
             advance();
-            return value;
+            return Expression::constant(value);
         }
         
         if (check(TokenType::Float)) {
             double value = std::stod(current_.lexeme());
             advance();
-            return value;
+            return Expression::constant(value);
         }
         
         if (match(TokenType::LeftParen)) {
-            double value = parseExpression();
+            Expression value = parseExpression();
             consume(TokenType::RightParen, "Expected ')' after expression");
             return value;
         }
         
+        if (paramScope_ == nullptr && check(TokenType::Identifier)) {
+            if (auto symbol = parameters_.findSymbol(current_.lexeme())) {
+                advance();
+                return Expression::parameter(*symbol);
+            }
+        }
+        
+        if (paramScope_ != nullptr && checkFormalName()) {
+            for (size_t i = 0; i < paramScope_->size(); ++i) {
+                if ((*paramScope_)[i] == current_.lexeme()) {
+                    advance();
+                    return Expression::parameter(i);
+                }
+            }
+            errorAtCurrent("Unknown identifier in expression");
+            return Expression::constant(0.0);
+        }
+        
         errorAtCurrent("Expected number or 'pi' in expression");
-        return 0.0;
+        return Expression::constant(0.0);
     }
 
     // =========================================================================
-    // Helper Functions
+    // Gate Definitions
     // =========================================================================
 
     /**
-     * @brief Convert a token type to an IR gate type.
+     * @brief Parse: gate name(p0, p1) a, b { body }
+     *
+     * The body may apply built-in gates and earlier definitions to the
+     * formal qubits. Calls are inlined, so the stored template contains
+     * built-in gates only and expansion never recurses.
      */
-    [[nodiscard]] ir::GateType tokenToGateType(TokenType type) const noexcept {
-        switch (type) {
-            case TokenType::GateH:    return ir::GateType::H;
-            case TokenType::GateX:    return ir::GateType::X;
-            case TokenType::GateY:    return ir::GateType::Y;
-            case TokenType::GateZ:    return ir::GateType::Z;
-            case TokenType::GateS:    return ir::GateType::S;
-            case TokenType::GateT:    return ir::GateType::T;
-            case TokenType::GateSdg:  return ir::GateType::Sdg;
-            case TokenType::GateTdg:  return ir::GateType::Tdg;
+    void parseGateDefinition() {
+        if (!check(TokenType::Identifier)) {
+            errorAtCurrent("Expected gate name after 'gate'");
+            synchronize();
+            return;
+        }
+        
+        std::string name = current_.lexeme();
+        advance();
+        
+        if (gateDefIndex_.count(name) > 0) {
+            errorAtPrevious("Gate '" + name + "' already defined");
+            synchronize();
+            return;
+        }
+        if (registerIndex_.count(name) > 0) {
+            errorAtPrevious("Gate '" + name + "' conflicts with a register");
+            synchronize();
+            return;
+        }
+        if (parameters_.findSymbol(name)) {
+            errorAtPrevious("Gate '" + name + "' conflicts with an input");
+            synchronize();
+            return;
+        }
+        
+        std::vector<std::string> params;
+        std::vector<std::string> qubits;
+        if (match(TokenType::LeftParen)) {
+            if (!check(TokenType::RightParen)) {
+                do {
+                    params.push_back(parseFormalName(params, qubits));
+                } while (match(TokenType::Comma) && !hadError_);
+            }
+            consume(TokenType::RightParen, "Expected ')' after gate parameters");
+        }
+        
+        do {
+            qubits.push_back(parseFormalName(params, qubits));
+        } while (match(TokenType::Comma) && !hadError_);
+        
+        consume(TokenType::LeftBrace, "Expected '{' to open gate body");
+        
+        GateDefinition def{name, params.size(), qubits.size(), {}, {}};
+        paramScope_ = &params;
+        while (!check(TokenType::RightBrace) && !check(TokenType::EndOfFile) && !hadError_) {
+            parseGateBodyStatement(def, qubits);
+        }
+        paramScope_ = nullptr;
+        
+        consume(TokenType::RightBrace, "Expected '}' to close gate body");
+        
+        if (!hadError_) {
+            gateDefIndex_[name] = gateDefs_.size();
+            gateDefs_.push_back(std::move(def));
+        }
+    }
+
+    /**
+     * @brief Parse a formal parameter or qubit name in a gate declaration.
+     */
+    std::string parseFormalName(const std::vector<std::string>& params,
+                                const std::vector<std::string>& qubits) {
+        if (!checkFormalName()) {
+            errorAtCurrent("Expected identifier in gate declaration");
+            return "";
+        }
+        
+        std::string name = current_.lexeme();
+        advance();
+        
+        if (std::find(params.begin(), params.end(), name) != params.end() ||
+            std::find(qubits.begin(), qubits.end(), name) != qubits.end()) {
+            errorAtPrevious("Duplicate name '" + name + "' in gate declaration");
+        }
+        return name;
+    }
+
+    /**
+     * @brief Parse a reference to a formal qubit inside a gate body.
+     * @return Index of the formal qubit
+     */
+    size_t parseFormalQubit(const std::vector<std::string>& qubits) {
+        if (!checkFormalName()) {
+            errorAtCurrent("Expected qubit argument name in gate body");
+            return 0;
+        }
+        
+        auto it = std::find(qubits.begin(), qubits.end(), current_.lexeme());
+        if (it == qubits.end()) {
+            errorAtCurrent("Unknown qubit argument in gate body");
+            return 0;
+        }
+        
+        advance();
+        return static_cast<size_t>(it - qubits.begin());
+    }
+
+    /**
+     * @brief Parse one statement of a gate body into the definition's template.
+     */
+    void parseGateBodyStatement(GateDefinition& def, const std::vector<std::string>& formals) {
+        if (current_.isGate()) {
+            Token gateToken = current_;
+            ir::GateType gateType = tokenToGateType(gateToken.type());
+            advance();
+            
+            std::vector<Expression> params = parseBuiltinParameters(gateToken, gateType);
+            
+            std::vector<size_t> qubits;
+            for (size_t i = 0; i < ir::numQubitsFor(gateType) && !hadError_; ++i) {
+                if (i > 0) consume(TokenType::Comma, "Expected ',' between qubit operands");
+                qubits.push_back(parseFormalQubit(formals));
+            }
+            
+            consume(TokenType::Semicolon, "Expected ';' after gate application");
+            if (hadError_) return;
+            
+            if (!checkDistinct(qubits)) {
+                errorAt(gateToken, "Duplicate qubit operand in gate body");
+                return;
+            }
+            def.body.push_back({gateType, std::move(qubits), std::move(params)});
+            return;
+        }
+        
+        if (!check(TokenType::Identifier)) {
+            errorAtCurrent("Expected gate application in gate body");
+            return;
+        }
+        
+        auto found = gateDefIndex_.find(current_.lexeme());
+        if (found == gateDefIndex_.end()) {
+            errorAtCurrent("Unknown gate in gate body");
+            return;
+        }
+        
+        Token callToken = current_;
+        advance();
+        const GateDefinition& callee = gateDefs_[found->second];
+        
+        std::vector<Expression> args;
+        if (match(TokenType::LeftParen)) {
+            if (!check(TokenType::RightParen)) {
+                do {
+                    args.push_back(parseExpression());
+                } while (match(TokenType::Comma) && !hadError_);
+            }
+            consume(TokenType::RightParen, "Expected ')' after gate arguments");
+        }
+        
+        std::vector<size_t> operands;
+        do {
+            operands.push_back(parseFormalQubit(formals));
+        } while (match(TokenType::Comma) && !hadError_);
+        
+        consume(TokenType::Semicolon, "Expected ';' after gate application");
+        if (hadError_) return;
+        
+        if (!checkCallShape(callee, callToken, args.size(), operands)) return;
+        
+        for (const auto& op : callee.body) {
+            GateTemplateOp inlined{op.type, {}, {}};
+            inlined.qubits.reserve(op.qubits.size());
+            for (size_t q : op.qubits) {
+                inlined.qubits.push_back(operands[q]);
+            }
+            inlined.params.reserve(op.params.size());
+            for (const auto& param : op.params) {
+                inlined.params.push_back(param.substitute(args));
+            }
+            def.body.push_back(std::move(inlined));
+        }
+    }
+
+    /**
+     * @brief Parse a call to a custom gate: name(args) q[0], r[1];
+     */
+    void parseGateCall() {
+        Token callToken = current_;
+        advance();
+        GateDefinition& def = gateDefs_[gateDefIndex_.at(callToken.lexeme())];
+        
+        std::vector<Expression> argExprs;
+        if (match(TokenType::LeftParen)) {
+            if (!check(TokenType::RightParen)) {
+                do {
+                    argExprs.push_back(parseExpression());
+                } while (match(TokenType::Comma) && !hadError_);
+            }
+            consume(TokenType::RightParen, "Expected ')' after gate arguments");
+        }
+        
+        bool symbolic = false;
+        std::vector<double> args;
+        for (const auto& arg : argExprs) {
+            symbolic = symbolic || !arg.isConstant();
+            args.push_back(arg.isConstant() ? arg.constantValue() : 0.0);
+        }
+        
+        std::vector<RegisterArgument> qubits;
+        do {
+            qubits.push_back(parseRegisterArgument(true));
+        } while (match(TokenType::Comma) && !hadError_);
+        
+        consume(TokenType::Semicolon, "Expected ';' after gate application");
+        if (hadError_) return;
+        
+        size_t width = broadcastWidth(qubits, callToken);
+        std::vector<size_t> operands(qubits.size());
+        for (size_t k = 0; k < width; ++k) {
+            for (size_t i = 0; i < qubits.size(); ++i) {
+                operands[i] = broadcastElement(qubits[i], k);
+            }
+            if (!checkCallShape(def, callToken, args.size(), operands)) return;
+            if (symbolic) {
+                emitSymbolicGateCall(def, argExprs, operands, callToken);
+            } else {
+                emitGateCall(def, args, operands, callToken);
+            }
+        }
+    }
+
+    /**
+     * @brief Append the expansion of a custom gate call with symbolic arguments.
+     *
+     * The body's parameter programs are substituted with the argument
+     * expressions and stored like top-level parameters. These calls bypass
+     * the expansion cache.
+     */
+    void emitSymbolicGateCall(const GateDefinition& def, const std::vector<Expression>& args,
+                              const std::vector<size_t>& operands, const Token& callToken) {
+        std::vector<Expression> params;
+        for (const auto& op : def.body) {
+            params.clear();
+            for (const auto& param : op.params) {
+                params.push_back(param.substitute(args));
+            }
+            ParsedGate gate{op.type, {}, {}};
+            if (!resolveParameters(params, gate, callToken)) return;
+            gate.qubits.reserve(op.qubits.size());
+            for (size_t q : op.qubits) {
+                gate.qubits.push_back(operands[q]);
+            }
+            emit(std::move(gate));
+        }
+    }
+
+    /**
+     * @brief Append the expansion of a custom gate call to the gate list.
+     */
+    void emitGateCall(GateDefinition& def, const std::vector<double>& args,
+                      const std::vector<size_t>& operands, const Token& callToken) {
+        const auto* params = expandGate(def, args, callToken);
+        if (params == nullptr) return;
+        
+        auto next = params->begin();
+        for (const auto& op : def.body) {
+            auto last = next + static_cast<std::ptrdiff_t>(op.params.size());
+            ParsedGate gate{op.type, {}, std::vector<double>(next, last)};
+            next = last;
+            gate.qubits.reserve(op.qubits.size());
+            for (size_t q : op.qubits) {
+                gate.qubits.push_back(operands[q]);
+            }
+            emit(std::move(gate));
+        }
+    }
+
+    /**
+     * @brief Check argument and operand counts of a custom gate call.
+     * @return true if the call is well-formed
+     */
+    template <typename Operand>
+    bool checkCallShape(const GateDefinition& def, const Token& callToken,
+                        size_t numArgs, const std::vector<Operand>& operands) {
+        if (numArgs != def.numParams) {
+            errorAt(callToken, "Gate '" + def.name + "' expects " +
+                    std::to_string(def.numParams) + " parameter(s), got " +
+                    std::to_string(numArgs));
+            return false;
+        }
+        if (operands.size() != def.numQubits) {
+            errorAt(callToken, "Gate '" + def.name + "' expects " +
+                    std::to_string(def.numQubits) + " qubit(s), got " +
+                    std::to_string(operands.size()));
+            return false;
+        }
+        if (!checkDistinct(operands)) {
+            errorAt(callToken, "Duplicate qubit operand in call to '" + def.name + "'");
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Check that no operand appears twice.
+     */
+    template <typename Operand>
+    [[nodiscard]] static bool checkDistinct(const std::vector<Operand>& operands) {
+        for (size_t i = 0; i < operands.size(); ++i) {
+            for (size_t j = i + 1; j < operands.size(); ++j) {
+                if (operands[i] == operands[j]) return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Look up or compute the parameter values of a custom gate's body.
+     *
+     * While streaming, a definition caches at most STREAMING_EXPANSION_LIMIT
+     * argument lists; others are evaluated into a buffer reused by the next
+     * uncached call.
+     *
+     * @return Evaluated parameters of the body ops in order, or nullptr on error
+     */
+    const std::vector<double>* expandGate(GateDefinition& def,
+                                          const std::vector<double>& args,
+                                          const Token& callToken) {
+        auto it = def.expansions.find(args);
+        if (it != def.expansions.end()) {
+            ++gateCacheStats_.hits;
+            return &it->second;
+        }
+        ++gateCacheStats_.misses;
+        
+        std::vector<double> params;
+        for (const auto& op : def.body) {
+            for (const auto& param : op.params) {
+                double value = param.evaluate(args);
+                if (!std::isfinite(value)) {
+                    errorAt(callToken, "Gate '" + def.name + "' parameter is not finite");
+                    return nullptr;
+                }
+                params.push_back(value);
+            }
+        }
+        
+        if (sink_ != nullptr && def.expansions.size() >= STREAMING_EXPANSION_LIMIT) {
+            uncachedExpansion_ = std::move(params);
+            return &uncachedExpansion_;
+        }
+        return &def.expansions.emplace(args, std::move(params)).first->second;
+    }
+
+    /**
+     * @brief Register the OpenQASM 2.0 (qelib1.inc) single-qubit gates.
+     *
+     * U and u3 are native U3 gates; u2(phi, lambda) is U(pi/2, phi, lambda)
+     * and u1(lambda) is Rz(lambda) up to global phase.
+     */
+    void defineQasm2Gates() {
+        auto param = [](size_t i) { return Expression::parameter(i); };
+        defineBuiltinGate("u2", 2, {{ir::GateType::U3, {0},
+                                     {Expression::constant(M_PI / 2), param(0), param(1)}}});
+        defineBuiltinGate("u1", 1, {{ir::GateType::Rz, {0}, {param(0)}}});
+        defineBuiltinGate("id", 0, {});
+    }
+
+    /**
+     * @brief Add a single-qubit gate definition that is not parsed from source.
+     */
+    void defineBuiltinGate(std::string name, size_t numParams, std::vector<GateTemplateOp> body) {
+        gateDefIndex_[name] = gateDefs_.size();
+        gateDefs_.push_back({std::move(name), numParams, 1, std::move(body), {}});
+    }
+
+    // =========================================================================
+    // Loops
+    // =========================================================================
+
+    /**
+     * @brief Parse a top-level for loop and unroll it into the gate list.
+     *
+     * The loop (including nested loops) is compiled into a LoopOp list in a
+     * single pass over the tokens, then interpreted once per iteration.
+     */
+    void parseForLoop() {
+        std::vector<LoopOp> code;
+        paramScope_ = &loopVars_;
+        compileForLoop(code);
+        paramScope_ = nullptr;
+        loopVars_.clear();
+        if (hadError_) return;
+        
+        std::vector<double> vars;
+        unrollLoop(code, 0, code.size(), vars);
+    }
+
+    /**
+     * @brief Compile: for [int|uint] i in [start:stop] body
+     *                 for [int|uint] i in [start:step:stop] body
+     *
+     * Ranges include both endpoints, as in OpenQASM 3. Bounds may refer to
+     * enclosing loop variables. The body is a braced block or a single
+     * statement.
+     */
+    void compileForLoop(std::vector<LoopOp>& code) {
+        Token forToken = previous_;
+        
+        // Optional loop variable type
+        if (check(TokenType::Identifier) &&
+            (current_.lexeme() == "int" || current_.lexeme() == "uint")) {
+            advance();
+            if (match(TokenType::LeftBracket)) {
+                parseIntegerLiteral("integer width");
+                consume(TokenType::RightBracket, "Expected ']' after integer width");
+            }
+        }
+        
+        if (!check(TokenType::Identifier)) {
+            errorAtCurrent("Expected loop variable name");
+            return;
+        }
+        std::string name = current_.lexeme();
+        advance();
+        if (std::find(loopVars_.begin(), loopVars_.end(), name) != loopVars_.end()) {
+            errorAtPrevious("Loop variable '" + name + "' shadows an enclosing loop variable");
+            return;
+        }
+        
+        consume(TokenType::In, "Expected 'in' after loop variable");
+        consume(TokenType::LeftBracket, "Expected '[' to open loop range");
+        Expression start = parseExpression();
+        consume(TokenType::Colon, "Expected ':' in loop range");
+        Expression step = Expression::constant(1.0);
+        Expression stop = parseExpression();
+        if (match(TokenType::Colon)) {
+            step = std::move(stop);
+            stop = parseExpression();
+        }
+        consume(TokenType::RightBracket, "Expected ']' to close loop range");
+        if (hadError_) return;
+        
+        size_t loopAt = code.size();
+        code.push_back({LoopOp::Kind::Loop, ir::GateType::H, loopVars_.size(), 0, {},
+                        {std::move(start), std::move(step), std::move(stop)}, forToken});
+        
+        loopVars_.push_back(name);
+        if (match(TokenType::LeftBrace)) {
+            while (!check(TokenType::RightBrace) && !check(TokenType::EndOfFile) && !hadError_) {
+                compileLoopStatement(code);
+            }
+            consume(TokenType::RightBrace, "Expected '}' to close loop body");
+        } else {
+            compileLoopStatement(code);
+        }
+        loopVars_.pop_back();
+        
+        code[loopAt].bodyEnd = code.size();
+    }
+
+    /**
+     * @brief Compile one statement of a loop body.
+     *
+     * Gate applications, calls, nested loops, measurements, resets and
+     * barriers are accepted.
+     */
+    void compileLoopStatement(std::vector<LoopOp>& code) {
+        if (match(TokenType::For)) {
+            compileForLoop(code);
+            return;
+        }
+        
+        Token opToken = current_;
+        LoopOp op{LoopOp::Kind::Gate, ir::GateType::H, 0, 0, {}, {}, opToken};
+        size_t numQubits = 0;
+        
+        if (current_.isGate()) {
+            advance();
+            op.type = tokenToGateType(opToken.type());
+            op.args = parseBuiltinParameters(opToken, op.type);
+            numQubits = ir::numQubitsFor(op.type);
+        } else if (check(TokenType::Identifier) && gateDefIndex_.count(current_.lexeme()) > 0) {
+            advance();
+            op.kind = LoopOp::Kind::Call;
+            op.index = gateDefIndex_[opToken.lexeme()];
+            if (match(TokenType::LeftParen)) {
+                if (!check(TokenType::RightParen)) {
+                    do {
+                        op.args.push_back(parseExpression());
+                    } while (match(TokenType::Comma) && !hadError_);
+                }
+                consume(TokenType::RightParen, "Expected ')' after gate arguments");
+            }
+        } else if (check(TokenType::Identifier)) {
+            // c[i] = measure q[j]; operands are stored as {qubit, bit}
+            auto target = parseLoopOperand(false);
+            consume(TokenType::Equals, "Expected '=' in measurement assignment");
+            consume(TokenType::Measure, "Expected 'measure' after '='");
+            if (hadError_) return;
+            op.type = ir::GateType::Measure;
+            op.qubits.push_back(parseLoopOperand(true));
+            op.qubits.push_back(std::move(target));
+            consume(TokenType::Semicolon, "Expected ';' after measurement");
+            if (!hadError_) code.push_back(std::move(op));
+            return;
+        } else if (match(TokenType::Measure)) {
+            op.type = ir::GateType::Measure;
+            op.qubits.push_back(parseLoopOperand(true));
+            if (match(TokenType::Arrow)) {
+                op.qubits.push_back(parseLoopOperand(false));
+            }
+            consume(TokenType::Semicolon, "Expected ';' after measurement");
+            if (!hadError_) code.push_back(std::move(op));
+            return;
+        } else if (match(TokenType::Reset)) {
+            op.type = ir::GateType::Reset;
+            numQubits = 1;
+        } else if (match(TokenType::Barrier)) {
+            op.type = ir::GateType::Barrier;
+        } else {
+            errorAtCurrent("Expected gate application or loop in loop body");
+            return;
+        }
+        
+        do {
+            op.qubits.push_back(parseLoopOperand(true));
+        } while (match(TokenType::Comma) && !hadError_);
+        consume(TokenType::Semicolon, "Expected ';' after gate application");
+        if (hadError_) return;
+        
+        if (op.type == ir::GateType::Barrier) {
+            // Any number of operands
+        } else if (op.kind == LoopOp::Kind::Call) {
+            const GateDefinition& def = gateDefs_[op.index];
+            if (op.args.size() != def.numParams || op.qubits.size() != def.numQubits) {
+                errorAt(opToken, "Gate '" + def.name + "' expects " +
+                        std::to_string(def.numParams) + " parameter(s) and " +
+                        std::to_string(def.numQubits) + " qubit(s)");
+                return;
+            }
+        } else if (op.qubits.size() != numQubits) {
+            errorAt(opToken, "Wrong number of qubit operands");
+            return;
+        }
+        
+        code.push_back(std::move(op));
+    }
+
+    /**
+     * @brief Parse a loop body operand: q[expr] or q (qubit or bit register)
+     */
+    std::pair<size_t, Expression> parseLoopOperand(bool isQubit) {
+        size_t reg = parseRegisterName(isQubit);
+        if (hadError_) return {0, Expression()};
+        
+        Expression index = Expression::constant(0.0);
+        if (match(TokenType::LeftBracket)) {
+            index = parseExpression();
+            consume(TokenType::RightBracket, "Expected ']' after register index");
+        } else if (!hadError_ && registers_[reg].size != 1) {
+            errorAtPrevious("Register operands in loop bodies must be indexed");
+        }
+        return {reg, std::move(index)};
+    }
+
+    /**
+     * @brief Evaluate an expression that must yield an integer.
+     */
+    bool evaluateInteger(const Expression& expr, const std::vector<double>& vars,
+                         const Token& token, long long& out) {
+        double value = expr.evaluate(vars);
+        if (!std::isfinite(value) || value != std::floor(value) ||
+            std::fabs(value) > 9.0e15) {
+            errorAt(token, "Loop expression must evaluate to an integer");
+            return false;
+        }
+        out = static_cast<long long>(value);
+        return true;
+    }
+
+    /**
+     * @brief Interpret code[begin, end) for the given loop variable values.
+     */
+    void unrollLoop(const std::vector<LoopOp>& code, size_t begin, size_t end,
+                    std::vector<double>& vars) {
+        std::vector<size_t> operands;
+        std::vector<double> args;
+        
+        size_t pc = begin;
+        while (pc < end && !hadError_) {
+            const LoopOp& op = code[pc];
+            
+            if (op.kind == LoopOp::Kind::Loop) {
+                long long start = 0, step = 0, stop = 0;
+                if (!evaluateInteger(op.args[0], vars, op.token, start) ||
+                    !evaluateInteger(op.args[1], vars, op.token, step) ||
+                    !evaluateInteger(op.args[2], vars, op.token, stop)) {
+                    return;
+                }
+                if (step == 0) {
+                    errorAt(op.token, "Loop step must be nonzero");
+                    return;
+                }
+                
+                vars.resize(op.index + 1);
+                for (long long i = start; step > 0 ? i <= stop : i >= stop; i += step) {
+                    vars[op.index] = static_cast<double>(i);
+                    unrollLoop(code, pc + 1, op.bodyEnd, vars);
+                    if (hadError_) return;
+                }
+                vars.resize(op.index);
+                pc = op.bodyEnd;
+                continue;
+            }
+            
+            operands.clear();
+            for (const auto& [reg, indexExpr] : op.qubits) {
+                long long index = 0;
+                if (!evaluateInteger(indexExpr, vars, op.token, index)) return;
+                const RegisterInfo& info = registers_[reg];
+                if (index < 0 || static_cast<size_t>(index) >= info.size) {
+                    errorAt(op.token, std::string(info.isQubit ? "Qubit" : "Bit") +
+                            " index " + std::to_string(index) +
+                            " out of range for register '" + info.name + "'");
+                    return;
+                }
+                operands.push_back(info.offset + static_cast<size_t>(index));
+            }
+            
+            args.clear();
+            for (const auto& arg : op.args) {
+                args.push_back(arg.evaluate(vars));
+                if (!std::isfinite(args.back())) {
+                    errorAt(op.token, "Gate parameter is not finite");
+                    return;
+                }
+            }
+            
+            if (op.type == ir::GateType::Measure) {
+                std::optional<size_t> clbit;
+                if (operands.size() > 1) clbit = operands[1];
+                emit({op.type, {operands[0]}, {}, clbit});
+            } else if (op.type == ir::GateType::Barrier) {
+                emitBarrier(operands);
+            } else if (op.kind == LoopOp::Kind::Gate) {
+                emit({op.type, operands, args});
+            } else {
+                GateDefinition& def = gateDefs_[op.index];
+                if (!checkCallShape(def, op.token, args.size(), operands)) return;
+                emitGateCall(def, args, operands, op.token);
+            }
+            ++pc;
+        }
+    }
+
+    // =========================================================================
+    // Helper Functions
+    // =========================================================================
+
+    /**
+     * @brief Convert a token type to an IR gate type.
+     */
+    [[nodiscard]] ir::GateType tokenToGateType(TokenType type) const noexcept {
+        switch (type) {
+            case TokenType::GateH:    return ir::GateType::H;
+            case TokenType::GateX:    return ir::GateType::X;
+            case TokenType::GateY:    return ir::GateType::Y;
+            case TokenType::GateZ:    return ir::GateType::Z;
+            case TokenType::GateS:    return ir::GateType::S;
+            case TokenType::GateT:    return ir::GateType::T;
+            case TokenType::GateSdg:  return ir::GateType::Sdg;
+            case TokenType::GateTdg:  return ir::GateType::Tdg;
+            case TokenType::GateSX:   return ir::GateType::SX;
             case TokenType::GateRx:   return ir::GateType::Rx;
             case TokenType::GateRy:   return ir::GateType::Ry;
             case TokenType::GateRz:   return ir::GateType::Rz;
+            case TokenType::GateU3:   return ir::GateType::U3;
             case TokenType::GateCX:   return ir::GateType::CNOT;
             case TokenType::GateCZ:   return ir::GateType::CZ;
             case TokenType::GateSwap: return ir::GateType::SWAP;
+            case TokenType::GateCPhase: return ir::GateType::CPhase;
+            case TokenType::GateRZZ:    return ir::GateType::RZZ;
+            case TokenType::GateISwap:  return ir::GateType::ISWAP;
+            case TokenType::GateCCX:    return ir::GateType::CCX;
             default:                  return ir::GateType::H;  // Should never happen
         }
     }
@@ -684,16 +1875,7 @@ private:
      * @brief Build the IR Circuit from parsed data.
      */
     [[nodiscard]] std::unique_ptr<ir::Circuit> buildCircuit() {
-        // Calculate total qubit count
-        size_t totalQubits = 0;
-        std::unordered_map<std::string, size_t> qubitOffset;
-        
-        for (const auto& reg : registers_) {
-            if (reg.isQubit) {
-                qubitOffset[reg.name] = totalQubits;
-                totalQubits += reg.size;
-            }
-        }
+        size_t totalQubits = numQubits_;
         
         if (totalQubits == 0) {
             // No qubits declared - create minimal circuit
@@ -701,44 +1883,66 @@ private:
             warn(Token(), "No qubit declarations found, defaulting to 1 qubit");
         }
         
-        auto circuit = std::make_unique<ir::Circuit>(totalQubits);
+        auto circuit = std::make_unique<ir::Circuit>(totalQubits, numClbits_);
+        circuit->parameterTable() = std::move(parameters_);
         
         // Add gates
         for (const auto& pg : gates_) {
-            std::vector<QubitIndex> qubitIndices;
-            
-            for (const auto& [regName, idx] : pg.qubits) {
-                auto it = qubitOffset.find(regName);
-                if (it == qubitOffset.end()) {
-                    // Error: undeclared register - should have been caught earlier
-                    continue;
+            if (auto gate = toGate(pg)) {
+                try {
+                    circuit->addGate(std::move(*gate));
+                } catch (const std::exception& e) {
+                    warnGateCreation(e);
                 }
-                qubitIndices.push_back(static_cast<QubitIndex>(it->second + idx));
-            }
-            
-            try {
-                ir::Gate gate = createGate(pg.type, qubitIndices, pg.parameter);
-                circuit->addGate(std::move(gate));
-            } catch (const std::exception& e) {
-                // Gate creation failed - add warning but continue
-                warnings_.push_back(QASMError(
-                    QASMErrorKind::Semantic,
-                    std::string("Gate creation failed: ") + e.what(),
-                    SourceLocation{}));
             }
         }
         
         return circuit;
     }
 
+    /**
+     * @brief Convert a parsed gate to an IR Gate.
+     * @return The gate, or nullopt (with a warning) if it is invalid
+     */
+    [[nodiscard]] std::optional<ir::Gate> toGate(const ParsedGate& pg) {
+        std::vector<QubitIndex> qubitIndices;
+        qubitIndices.reserve(pg.qubits.size());
+        for (size_t q : pg.qubits) {
+            qubitIndices.push_back(static_cast<QubitIndex>(q));
+        }
+
+        try {
+            ir::Gate gate = createGate(pg.type, qubitIndices, pg.params, pg.clbit);
+            for (size_t i = 0; i < pg.exprs.size(); ++i) {
+                if (pg.exprs[i] != NO_PARAMETER_EXPR) {
+                    gate = gate.withExpression(i, pg.exprs[i]);
+                }
+            }
+            return gate;
+        } catch (const std::exception& e) {
+            // Gate creation failed - add warning but continue
+            warnGateCreation(e);
+            return std::nullopt;
+        }
+    }
+
+    void warnGateCreation(const std::exception& e) {
+        warnings_.push_back(QASMError(
+            QASMErrorKind::Semantic,
+            std::string("Gate creation failed: ") + e.what(),
+            SourceLocation{}));
+    }
+
     /**
      * @brief Create an IR Gate from parsed data.
      */
     [[nodiscard]] ir::Gate createGate(
         ir::GateType type,
         const std::vector<QubitIndex>& qubits,
-        std::optional<double> param) const {
+        const std::vector<double>& params,
+        std::optional<size_t> clbit) const {
         
+        const double param = params.empty() ? 0.0 : params[0];
         switch (type) {
             case ir::GateType::H:    return ir::Gate::h(qubits[0]);
             case ir::GateType::X:    return ir::Gate::x(qubits[0]);
@@ -748,12 +1952,22 @@ private:
             case ir::GateType::Sdg:  return ir::Gate::sdg(qubits[0]);
             case ir::GateType::T:    return ir::Gate::t(qubits[0]);
             case ir::GateType::Tdg:  return ir::Gate::tdg(qubits[0]);
-            case ir::GateType::Rx:   return ir::Gate::rx(qubits[0], param.value_or(0.0));
-            case ir::GateType::Ry:   return ir::Gate::ry(qubits[0], param.value_or(0.0));
-            case ir::GateType::Rz:   return ir::Gate::rz(qubits[0], param.value_or(0.0));
+            case ir::GateType::SX:   return ir::Gate::sx(qubits[0]);
+            case ir::GateType::Rx:   return ir::Gate::rx(qubits[0], param);
+            case ir::GateType::Ry:   return ir::Gate::ry(qubits[0], param);
+            case ir::GateType::Rz:   return ir::Gate::rz(qubits[0], param);
+            case ir::GateType::U3:   return ir::Gate::fromParameters(type, qubits, params);
             case ir::GateType::CNOT: return ir::Gate::cnot(qubits[0], qubits[1]);
             case ir::GateType::CZ:   return ir::Gate::cz(qubits[0], qubits[1]);
             case ir::GateType::SWAP: return ir::Gate::swap(qubits[0], qubits[1]);
+            case ir::GateType::CPhase: return ir::Gate::cphase(qubits[0], qubits[1], param);
+            case ir::GateType::RZZ:    return ir::Gate::rzz(qubits[0], qubits[1], param);
+            case ir::GateType::ISWAP:  return ir::Gate::iswap(qubits[0], qubits[1]);
+            case ir::GateType::CCX:    return ir::Gate::ccx(qubits[0], qubits[1], qubits[2]);
+            case ir::GateType::Measure:
+                return clbit ? ir::Gate::measure(qubits[0], *clbit) : ir::Gate::measure(qubits[0]);
+            case ir::GateType::Reset:   return ir::Gate::reset(qubits[0]);
+            case ir::GateType::Barrier: return ir::Gate::barrier(qubits);
         }
         
         // Should never reach here
@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file QASMWriter.hpp
+ * @brief OpenQASM 3.0 emission for circuits and gate streams
+ * @author Rylan Malarchick
+ * @date 2025
+ *
+ * Writes IR gates as OpenQASM 3.0 text accepted by Parser. Two entry points:
+ *
+ * - toQASM() / writeQASM(): serialize a Circuit or a CircuitView
+ * - QASMWriter: incremental writer that emits one statement per gate, so it
+ *   can be used directly as a routing GateSink without materializing the
+ *   routed circuit
+ *
+ * Angles are printed with 17 significant digits, so parse(toQASM(c)) yields
+ * bit-identical parameters. Symbols of the circuit's parameter table are
+ * declared as input float[64] variables and symbolic parameters are written
+ * as affine expressions over them.
+ *
+ * @see Parser.hpp for the inverse direction
+ * @see routing/Router.hpp for GateSink
+ */
+#pragma once
+
+#include "ir/Circuit.hpp"
+#include "ir/CircuitView.hpp"
+#include "ir/Gate.hpp"
+#include "ir/Parameter.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace qopt::parser {
+
+/**
+ * @brief Returns the OpenQASM 3.0 (stdgates.inc) name of a gate type.
+ * @param type The gate type
+ * @return Lower-case gate identifier as accepted by the Lexer
+ */
+[[nodiscard]] constexpr std::string_view qasmGateName(ir::GateType type) noexcept {
+    switch (type) {
+        case ir::GateType::H:    return "h";
+        case ir::GateType::X:    return "x";
+        case ir::GateType::Y:    return "y";
+        case ir::GateType::Z:    return "z";
+        case ir::GateType::S:    return "s";
+        case ir::GateType::Sdg:  return "sdg";
+        case ir::GateType::T:    return "t";
+        case ir::GateType::Tdg:  return "tdg";
+        case ir::GateType::SX:   return "sx";
+        case ir::GateType::Rx:   return "rx";
+        case ir::GateType::Ry:   return "ry";
+        case ir::GateType::Rz:   return "rz";
+        case ir::GateType::U3:   return "u3";
+        case ir::GateType::CNOT: return "cx";
+        case ir::GateType::CZ:   return "cz";
+        case ir::GateType::SWAP: return "swap";
+        case ir::GateType::CPhase: return "cp";
+        case ir::GateType::RZZ:    return "rzz";
+        case ir::GateType::ISWAP:  return "iswap";
+        case ir::GateType::CCX:    return "ccx";
+        case ir::GateType::Measure: return "measure";
+        case ir::GateType::Reset:   return "reset";
+        case ir::GateType::Barrier: return "barrier";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Incremental OpenQASM 3.0 writer.
+ *
+ * The header (version, include, inputs, qubit and bit registers) is written on
+ * construction; each write() then appends one gate statement. Nothing is buffered beyond
+ * the underlying stream, so memory use is independent of circuit size.
+ *
+ * Example:
+ * @code
+ * std::ofstream file("routed.qasm");
+ * QASMWriter writer(file, topology.numQubits());
+ * router.routeTo(circuit, topology, std::ref(writer));
+ * @endcode
+ *
+ * The writer refers to the stream by pointer; pass it to APIs that copy
+ * callables via std::ref so gatesWritten() stays accurate.
+ */
+class QASMWriter {
+public:
+    /**
+     * @brief Constructs a writer and emits the program header.
+     * @param out Destination stream (must outlive the writer)
+     * @param num_qubits Size of the declared qubit register
+     * @param register_name Name of the qubit register (default: "q")
+     * @param num_clbits Size of the declared bit register "c" (none if 0)
+     * @param parameters Table of the gates' symbolic parameters, if any
+     *        (must outlive the writer)
+     */
+    QASMWriter(std::ostream& out, std::size_t num_qubits, std::string register_name = "q",
+               std::size_t num_clbits = 0, const ir::ParameterTable* parameters = nullptr)
+        : out_(&out)
+        , register_name_(std::move(register_name))
+        , parameters_(parameters)
+        , gates_written_(0)
+    {
+        *out_ << "OPENQASM 3.0;\n"
+              << "include \"stdgates.inc\";\n";
+        if (parameters_ != nullptr) {
+            for (const auto& symbol : parameters_->symbols()) {
+                *out_ << "input float[64] " << symbol << ";\n";
+            }
+        }
+        *out_ << "qubit[" << num_qubits << "] " << register_name_ << ";\n";
+        if (num_clbits > 0) {
+            *out_ << "bit[" << num_clbits << "] " << CLBIT_REGISTER << ";\n";
+        }
+    }
+
+    /**
+     * @brief Writes one gate statement.
+     * @param gate The gate to write
+     * @throws std::logic_error if the gate is symbolic and no parameter
+     *         table was given
+     */
+    void write(const ir::Gate& gate) {
+        std::ostream& out = *out_;
+        if (auto clbit = gate.clbit()) {
+            out << CLBIT_REGISTER << '[' << *clbit << "] = ";
+        }
+        out << qasmGateName(gate.type());
+        for (std::size_t i = 0; i < gate.numParameters(); ++i) {
+            out << (i == 0 ? "(" : ", ");
+            if (auto expr = gate.expression(i)) {
+                if (parameters_ == nullptr) {
+                    throw std::logic_error(
+                        "QASMWriter: symbolic gate written without a parameter table");
+                }
+                out << parameters_->toString(*expr);
+                continue;
+            }
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.17g", gate.parameter(i));
+            out << buffer;
+        }
+        if (gate.numParameters() > 0) out << ')';
+        const auto& qubits = gate.qubits();
+        for (std::size_t i = 0; i < qubits.size(); ++i) {
+            out << (i == 0 ? " " : ", ") << register_name_ << '[' << qubits[i] << ']';
+        }
+        out << ";\n";
+        ++gates_written_;
+    }
+
+    /// @brief Writes one gate statement (GateSink-compatible).
+    void operator()(const ir::Gate& gate) { write(gate); }
+
+    /// @brief Returns the number of gate statements written so far.
+    [[nodiscard]] std::size_t gatesWritten() const noexcept { return gates_written_; }
+
+private:
+    static constexpr std::string_view CLBIT_REGISTER = "c";
+
+    std::ostream* out_;
+    std::string register_name_;
+    const ir::ParameterTable* parameters_;
+    std::size_t gates_written_;
+};
+
+/**
+ * @brief Writes a circuit, or the gates of a view, as an OpenQASM 3.0 program.
+ *
+ * A view is written with the full registers of its circuit.
+ *
+ * @param out Destination stream
+ * @param circuit The circuit or view to write
+ */
+inline void writeQASM(std::ostream& out, const ir::CircuitView& circuit) {
+    QASMWriter writer(out, circuit.numQubits(), "q", circuit.numClbits(),
+                      &circuit.circuit().parameterTable());
+    for (const auto& gate : circuit) {
+        writer.write(gate);
+    }
+}
+
+/**
+ * @brief Serializes a circuit or view as an OpenQASM 3.0 program.
+ * @param circuit The circuit or view to serialize
+ * @return Program text
+ */
+[[nodiscard]] inline std::string toQASM(const ir::CircuitView& circuit) {
+    std::ostringstream out;
+    writeQASM(out, circuit);
+    return out.str();
+}
+
+}  // namespace qopt::parser
@@ -49,6 +49,13 @@ enum class TokenType {
     Qubit,       ///< qubit keyword
     Bit,         ///< bit keyword
     Measure,     ///< measure keyword
+    GateDecl,    ///< gate keyword (custom gate definition)
+    For,         ///< for keyword
+    Barrier,     ///< barrier keyword
+    Reset,       ///< reset keyword
+    Qreg,        ///< qreg keyword (OpenQASM 2.0)
+    Creg,        ///< creg keyword (OpenQASM 2.0)
+    In,          ///< in keyword
 
     // Gate names (treated as keywords for simplicity)
     // Single-qubit gates
@@ -60,14 +67,22 @@ enum class TokenType {
     GateT,       ///< t (T gate)
     GateSdg,     ///< sdg (S-dagger)
     GateTdg,     ///< tdg (T-dagger)
+    GateSX,      ///< sx (sqrt(X))
     GateRx,      ///< rx (X rotation)
     GateRy,      ///< ry (Y rotation)
     GateRz,      ///< rz (Z rotation)
+    GateU3,      ///< U, u3 (general rotation, three parameters)
 
     // Two-qubit gates
     GateCX,      ///< cx (CNOT)
     GateCZ,      ///< cz (controlled-Z)
     GateSwap,    ///< swap
+    GateCPhase,  ///< cp (controlled phase)
+    GateRZZ,     ///< rzz (ZZ rotation)
+    GateISwap,   ///< iswap
+
+    // Three-qubit gates
+    GateCCX,     ///< ccx (Toffoli)
 
     // Mathematical constants
     Pi,          ///< pi constant
@@ -81,6 +96,7 @@ enum class TokenType {
     RightBracket,///< ]
     LeftBrace,   ///< {
     RightBrace,  ///< }
+    Colon,       ///< : (range separator)
     Equals,      ///< =
     Arrow,       ///< -> (for measurement)
 
@@ -109,6 +125,13 @@ enum class TokenType {
         case TokenType::Qubit:        return "qubit";
         case TokenType::Bit:          return "bit";
         case TokenType::Measure:      return "measure";
+        case TokenType::GateDecl:     return "gate";
+        case TokenType::For:          return "for";
+        case TokenType::Barrier:      return "barrier";
+        case TokenType::Reset:        return "reset";
+        case TokenType::Qreg:         return "qreg";
+        case TokenType::Creg:         return "creg";
+        case TokenType::In:           return "in";
         case TokenType::GateH:        return "h";
         case TokenType::GateX:        return "x";
         case TokenType::GateY:        return "y";
@@ -117,12 +140,18 @@ enum class TokenType {
         case TokenType::GateT:        return "t";
         case TokenType::GateSdg:      return "sdg";
         case TokenType::GateTdg:      return "tdg";
+        case TokenType::GateSX:       return "sx";
         case TokenType::GateRx:       return "rx";
         case TokenType::GateRy:       return "ry";
         case TokenType::GateRz:       return "rz";
+        case TokenType::GateU3:       return "u3";
         case TokenType::GateCX:       return "cx";
         case TokenType::GateCZ:       return "cz";
         case TokenType::GateSwap:     return "swap";
+        case TokenType::GateCPhase:   return "cp";
+        case TokenType::GateRZZ:      return "rzz";
+        case TokenType::GateISwap:    return "iswap";
+        case TokenType::GateCCX:      return "ccx";
         case TokenType::Pi:           return "pi";
         case TokenType::Semicolon:    return ";";
         case TokenType::Comma:        return ",";
@@ -132,6 +161,7 @@ enum class TokenType {
         case TokenType::RightBracket: return "]";
         case TokenType::LeftBrace:    return "{";
         case TokenType::RightBrace:   return "}";
+        case TokenType::Colon:        return ":";
         case TokenType::Equals:       return "=";
         case TokenType::Arrow:        return "->";
         case TokenType::Plus:         return "+";
@@ -231,8 +261,10 @@ public:
         return isOneOf(
             TokenType::GateH, TokenType::GateX, TokenType::GateY, TokenType::GateZ,
             TokenType::GateS, TokenType::GateT, TokenType::GateSdg, TokenType::GateTdg,
-            TokenType::GateRx, TokenType::GateRy, TokenType::GateRz,
-            TokenType::GateCX, TokenType::GateCZ, TokenType::GateSwap
+            TokenType::GateSX, TokenType::GateRx, TokenType::GateRy, TokenType::GateRz,
+            TokenType::GateU3, TokenType::GateCX, TokenType::GateCZ, TokenType::GateSwap,
+            TokenType::GateCPhase, TokenType::GateRZZ, TokenType::GateISwap,
+            TokenType::GateCCX
         );
     }
 
@@ -240,14 +272,16 @@ public:
      * @brief Check if this is a parameterized gate.
      */
     [[nodiscard]] bool isParameterizedGate() const noexcept {
-        return isOneOf(TokenType::GateRx, TokenType::GateRy, TokenType::GateRz);
+        return isOneOf(TokenType::GateRx, TokenType::GateRy, TokenType::GateRz,
+                       TokenType::GateU3, TokenType::GateCPhase, TokenType::GateRZZ);
     }
 
     /**
      * @brief Check if this is a two-qubit gate.
      */
     [[nodiscard]] bool isTwoQubitGate() const noexcept {
-        return isOneOf(TokenType::GateCX, TokenType::GateCZ, TokenType::GateSwap);
+        return isOneOf(TokenType::GateCX, TokenType::GateCZ, TokenType::GateSwap,
+                       TokenType::GateCPhase, TokenType::GateRZZ, TokenType::GateISwap);
     }
 
     /**
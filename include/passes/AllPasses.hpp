@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file AllPasses.hpp
+ * @brief Includes every built-in pass, registering all of them
+ *
+ * Passes register themselves with PassRegistry when their header is
+ * included, so a program that looks passes up by name sees only those it
+ * happens to include. Including this header instead makes the whole
+ * built-in set available. A new pass header is added here.
+ *
+ * @see PassRegistry.hpp for lookup by name
+ */
+
+#pragma once
+
+#include "CancellationPass.hpp"
+#include "CommutationPass.hpp"
+#include "DeadCodeEliminationPass.hpp"
+#include "FusedPeepholePass.hpp"
+#include "IdentityEliminationPass.hpp"
+#include "PeepholePass.hpp"
+#include "RotationMergePass.hpp"
+#include "SingleQubitFusionPass.hpp"
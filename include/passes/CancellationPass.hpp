@@ -17,9 +17,11 @@
 #pragma once
 
 #include "Pass.hpp"
+#include "PassRegistry.hpp"
 #include "../ir/DAG.hpp"
 #include "../ir/Gate.hpp"
 
+#include <algorithm>
 #include <unordered_set>
 #include <vector>
 
@@ -52,6 +54,17 @@ public:
         return "CancellationPass";
     }
 
+    /// @brief Registry entry (see PassRegistry.hpp).
+    [[nodiscard]] static PassInfo describe() {
+        return {"CancellationPass", "cancel",
+                "Removes adjacent pairs of mutually inverse gates",
+                {},
+                PassCost::Linear,
+                [](const PassSpec&) -> std::unique_ptr<Pass> {
+                    return std::make_unique<CancellationPass>();
+                }};
+    }
+
     void run(ir::DAG& dag) override {
         resetStatistics();
 
@@ -96,50 +109,15 @@ public:
         }
     }
 
-private:
-    /**
-     * @brief Checks if two gates are directly adjacent on the same qubits.
-     *
-     * Gates are adjacent if:
-     * 1. They operate on exactly the same qubits
-     * 2. There's a direct edge between them
-     * 3. There are no other gates between them on those qubits
-     *
-     * @param dag The DAG containing the gates
-     * @param id1 First gate ID
-     * @param id2 Second gate ID (must be successor of id1)
-     * @return true if gates are adjacent on same qubits
-     */
-    [[nodiscard]] static bool areAdjacentOnSameQubits(
-            const ir::DAG& dag,
-            GateId id1,
-            GateId id2) {
-        const ir::Gate& g1 = dag.node(id1).gate();
-        const ir::Gate& g2 = dag.node(id2).gate();
-
-        // Must operate on same qubits
-        if (g1.qubits() != g2.qubits()) {
-            return false;
-        }
-
-        // Must have direct edge
-        if (!dag.hasEdge(id1, id2)) {
-            return false;
-        }
-
-        // For each qubit, verify id2 is the immediate successor of id1
-        // This is guaranteed by the DAG structure if there's a direct edge
-        // and they operate on the same qubits
-        return true;
-    }
-
     /**
      * @brief Checks if two gates cancel to identity.
      *
      * Cancellation rules:
      * - Hermitian gates cancel with themselves: H·H, X·X, Y·Y, Z·Z
      * - Adjoint pairs: S·Sdg, Sdg·S, T·Tdg, Tdg·T
-     * - Two-qubit Hermitian: CNOT·CNOT, CZ·CZ, SWAP·SWAP
+     * - Multi-qubit Hermitian: CNOT·CNOT, CZ·CZ, SWAP·SWAP, CCX·CCX
+     *
+     * Shared with FusedPeepholePass.
      *
      * @param g1 First gate
      * @param g2 Second gate
@@ -175,6 +153,48 @@ private:
 
         return false;
     }
+
+private:
+    /**
+     * @brief Checks if two gates are directly adjacent on the same qubits.
+     *
+     * Gates are adjacent if:
+     * 1. They operate on exactly the same qubits
+     * 2. There's a direct edge between them
+     * 3. There are no other gates between them on those qubits
+     *
+     * @param dag The DAG containing the gates
+     * @param id1 First gate ID
+     * @param id2 Second gate ID (must be successor of id1)
+     * @return true if gates are adjacent on same qubits
+     */
+    [[nodiscard]] static bool areAdjacentOnSameQubits(
+            const ir::DAG& dag,
+            GateId id1,
+            GateId id2) {
+        const ir::Gate& g1 = dag.node(id1).gate();
+        const ir::Gate& g2 = dag.node(id2).gate();
+
+        // Must operate on same qubits
+        if (g1.qubits() != g2.qubits()) {
+            return false;
+        }
+
+        // Must have direct edge
+        if (!dag.hasEdge(id1, id2)) {
+            return false;
+        }
+
+        // For each qubit, verify id2 is the immediate successor of id1: a
+        // direct edge only proves this for one shared wire, so any other
+        // predecessor of id2 (e.g. a barrier on the other qubit) sits in between
+        const auto& preds = dag.node(id2).predecessors();
+        return std::all_of(preds.begin(), preds.end(),
+                           [id1](GateId p) { return p == id1; });
+    }
 };
 
+/// @brief Registers CancellationPass as "cancel".
+inline const bool CANCELLATION_PASS_REGISTERED = registerPass<CancellationPass>();
+
 }  // namespace qopt::passes
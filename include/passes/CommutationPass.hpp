@@ -21,6 +21,7 @@
 #pragma once
 
 #include "Pass.hpp"
+#include "PassRegistry.hpp"
 #include "../ir/DAG.hpp"
 #include "../ir/Gate.hpp"
 #include "../ir/Types.hpp"
@@ -58,6 +59,17 @@ public:
         return "CommutationPass";
     }
 
+    /// @brief Registry entry (see PassRegistry.hpp).
+    [[nodiscard]] static PassInfo describe() {
+        return {"CommutationPass", "commute",
+                "Moves gates past commuting neighbours to expose other rewrites",
+                {},
+                PassCost::Iterative,
+                [](const PassSpec&) -> std::unique_ptr<Pass> {
+                    return std::make_unique<CommutationPass>();
+                }};
+    }
+
     void run(ir::DAG& dag) override {
         resetStatistics();
 
@@ -105,7 +117,7 @@ private:
      * @brief Checks if a gate is diagonal (commutes with other diagonals).
      *
      * Diagonal gates are those that are diagonal in the computational basis:
-     * Z, S, Sdg, T, Tdg, Rz, CZ
+     * Z, S, Sdg, T, Tdg, Rz, CZ, CPhase, RZZ
      *
      * @param type The gate type
      * @return true if diagonal
@@ -119,6 +131,8 @@ private:
             case ir::GateType::Tdg:
             case ir::GateType::Rz:
             case ir::GateType::CZ:
+            case ir::GateType::CPhase:
+            case ir::GateType::RZZ:
                 return true;
             default:
                 return false;
@@ -135,13 +149,25 @@ private:
     [[nodiscard]] static bool commute(
             const ir::Gate& g1,
             const ir::Gate& g2) noexcept {
+        // Measurements of the same classical bit are ordered
+        if (g1.clbit().has_value() && g1.clbit() == g2.clbit()) {
+            return false;
+        }
+
         // Gates on disjoint qubits always commute
         if (!qubitsOverlap(g1, g2)) {
             return true;
         }
 
-        // Identical gates commute
-        if (g1.type() == g2.type() && g1.qubits() == g2.qubits()) {
+        // Nothing moves across a measurement, reset or barrier
+        if (ir::isNonUnitary(g1.type()) || ir::isNonUnitary(g2.type())) {
+            return false;
+        }
+
+        // Gates of one type on the same qubits commute, except U3 whose
+        // rotation axis depends on its angles
+        if (g1.type() == g2.type() && g1.qubits() == g2.qubits() &&
+            (g1.type() != ir::GateType::U3 || g1 == g2)) {
             return true;
         }
 
@@ -175,6 +201,17 @@ private:
             }
         }
 
+        // Likewise for the controls and target of a Toffoli
+        if (g1.type() == ir::GateType::CCX || g2.type() == ir::GateType::CCX) {
+            const ir::Gate& ccx = g1.type() == ir::GateType::CCX ? g1 : g2;
+            const ir::Gate& other = g1.type() == ir::GateType::CCX ? g2 : g1;
+            if (other.numQubits() == 1) {
+                QubitIndex q = other.qubits()[0];
+                if (isZLike(other.type()) && q != ccx.qubits()[2]) return true;
+                if (other.type() == ir::GateType::X && q == ccx.qubits()[2]) return true;
+            }
+        }
+
         return false;
     }
 
@@ -280,8 +317,8 @@ private:
             const ir::Gate& g2) noexcept {
         if (g1.qubits() != g2.qubits()) return false;
 
-        // Same rotation type
-        if (g1.type() == g2.type() && ir::isParameterized(g1.type())) {
+        // Same single-angle rotation type
+        if (g1.type() == g2.type() && ir::numParametersFor(g1.type()) == 1) {
             return true;
         }
 
@@ -322,4 +359,7 @@ private:
     }
 };
 
+/// @brief Registers CommutationPass as "commute".
+inline const bool COMMUTATION_PASS_REGISTERED = registerPass<CommutationPass>();
+
 }  // namespace qopt::passes
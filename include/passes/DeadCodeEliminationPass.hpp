@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file DeadCodeEliminationPass.hpp
+ * @brief Removes gates that cannot affect any measurement outcome
+ *
+ * Measurements are the observable outputs of a circuit. A gate is live if
+ * a path along its qubit wires leads to a measurement; everything else is
+ * dead and removed:
+ * - gates on qubits that are never measured
+ * - gates on a qubit after its last measurement
+ * - gates on a qubit before a reset, unless a two-qubit gate has carried
+ *   their effect to another live qubit
+ *
+ * A circuit without measurements is treated as observing its whole
+ * output state, and is left unchanged.
+ *
+ * releaseUnusedQubits() then drops qubits with no gates left, so routers
+ * place fewer logical qubits.
+ *
+ * @see Pass.hpp for the base pass interface
+ */
+
+#pragma once
+
+#include "Pass.hpp"
+#include "PassRegistry.hpp"
+#include "../ir/Circuit.hpp"
+#include "../ir/DAG.hpp"
+#include "../ir/Gate.hpp"
+#include "../ir/Types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace qopt::passes {
+
+/**
+ * @brief Result of releaseUnusedQubits(): the compacted circuit and its remap.
+ */
+struct ReleasedQubits {
+    /// @brief The circuit on qubits 0..n-1, n the number of qubits in use
+    ir::Circuit circuit;
+
+    /// @brief original_qubits[q] is the input qubit now numbered q
+    std::vector<QubitIndex> original_qubits;
+};
+
+/**
+ * @brief Optimization pass that removes gates with no observable effect.
+ *
+ * One backward sweep over the DAG in reverse topological order, keeping
+ * for each qubit whether its current state can still reach a measurement:
+ * - Measure keeps its qubit live
+ * - Reset is kept only if its qubit is live, and makes it dead before it
+ * - a barrier is kept if any of its qubits is live, and changes nothing
+ * - any other gate is kept if any of its qubits is live, and then makes
+ *   all of them live
+ *
+ * Measurements without a classical bit are kept too: they still collapse
+ * their qubit.
+ *
+ * Example:
+ * @code
+ * // Before: H q[0]; X q[1]; measure q[0] -> c[0]; CX q[0], q[1];
+ * // After:  H q[0]; measure q[0] -> c[0];
+ *
+ * DeadCodeEliminationPass pass;
+ * pass.run(dag);
+ * @endcode
+ */
+class DeadCodeEliminationPass : public Pass {
+public:
+    [[nodiscard]] std::string name() const override {
+        return "DeadCodeEliminationPass";
+    }
+
+    /// @brief Registry entry (see PassRegistry.hpp).
+    [[nodiscard]] static PassInfo describe() {
+        return {"DeadCodeEliminationPass", "dce",
+                "Removes gates that cannot affect a measurement outcome",
+                {},
+                PassCost::Linear,
+                [](const PassSpec&) -> std::unique_ptr<Pass> {
+                    return std::make_unique<DeadCodeEliminationPass>();
+                }};
+    }
+
+    void run(ir::DAG& dag) override {
+        resetStatistics();
+
+        std::vector<GateId> order = dag.topologicalOrder();
+        const bool measured = std::any_of(order.begin(), order.end(), [&dag](GateId id) {
+            return dag.node(id).gate().type() == ir::GateType::Measure;
+        });
+        if (!measured) return;
+
+        std::vector<bool> live(dag.numQubits(), false);
+        std::vector<GateId> to_remove;
+
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            const ir::Gate& gate = dag.node(*it).gate();
+            const auto& qubits = gate.qubits();
+            const bool any_live = std::any_of(qubits.begin(), qubits.end(),
+                                              [&live](QubitIndex q) { return live[q]; });
+
+            switch (gate.type()) {
+                case ir::GateType::Measure:
+                    live[qubits[0]] = true;
+                    break;
+                case ir::GateType::Reset:
+                    if (!any_live) to_remove.push_back(*it);
+                    live[qubits[0]] = false;
+                    break;
+                case ir::GateType::Barrier:
+                    if (!any_live) to_remove.push_back(*it);
+                    break;
+                default:
+                    if (!any_live) {
+                        to_remove.push_back(*it);
+                        break;
+                    }
+                    for (QubitIndex q : qubits) live[q] = true;
+                    break;
+            }
+        }
+
+        for (GateId id : to_remove) {
+            dag.removeNode(id);
+            gates_removed_++;
+        }
+    }
+
+    /**
+     * @brief Renumbers a circuit onto the qubits it uses.
+     *
+     * A qubit is in use if a gate other than a barrier acts on it. Unused
+     * qubits are dropped from barriers; barriers left empty are dropped.
+     * Kept qubits stay in their original order. A circuit with no gates
+     * keeps one qubit, the smallest a circuit can have.
+     *
+     * Example:
+     * @code
+     * auto released = DeadCodeEliminationPass::releaseUnusedQubits(circuit);
+     * auto routed = router.route(released.circuit, topology);
+     * // Logical qubit q of routed is released.original_qubits[q] of circuit
+     * @endcode
+     *
+     * @param circuit The circuit, typically after this pass
+     * @return The compacted circuit and the original index of each qubit
+     */
+    [[nodiscard]] static ReleasedQubits releaseUnusedQubits(const ir::Circuit& circuit) {
+        std::vector<bool> used(circuit.numQubits(), false);
+        for (const auto& gate : circuit) {
+            if (gate.type() == ir::GateType::Barrier) continue;
+            for (QubitIndex q : gate.qubits()) used[q] = true;
+        }
+
+        std::vector<QubitIndex> original;
+        std::vector<QubitIndex> renumbered(circuit.numQubits(), INVALID_QUBIT);
+        for (QubitIndex q = 0; q < circuit.numQubits(); ++q) {
+            if (!used[q]) continue;
+            renumbered[q] = original.size();
+            original.push_back(q);
+        }
+        if (original.empty()) original.push_back(0);
+
+        ReleasedQubits result{ir::Circuit(original.size(), circuit.numClbits()),
+                              std::move(original)};
+        result.circuit.parameterTable() = circuit.parameterTable();
+        for (const auto& gate : circuit) {
+            std::vector<QubitIndex> qubits;
+            for (QubitIndex q : gate.qubits()) {
+                if (renumbered[q] != INVALID_QUBIT) qubits.push_back(renumbered[q]);
+            }
+            if (gate.type() == ir::GateType::Barrier) {
+                if (!qubits.empty()) result.circuit.addGate(ir::Gate::barrier(std::move(qubits)));
+                continue;
+            }
+            result.circuit.addGate(gate.withQubits(std::move(qubits)));
+        }
+        return result;
+    }
+};
+
+/// @brief Registers DeadCodeEliminationPass as "dce".
+inline const bool DEAD_CODE_ELIMINATION_PASS_REGISTERED = registerPass<DeadCodeEliminationPass>();
+
+}  // namespace qopt::passes
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file FusedPeepholePass.hpp
+ * @brief Single-traversal fusion of the built-in peephole passes
+ *
+ * Applies the rules of CancellationPass, RotationMergePass and
+ * IdentityEliminationPass in one topological sweep, with the same result
+ * as running those passes (and CommutationPass) in a loop until nothing
+ * changes. Per-rule counts are reported under the original pass names.
+ *
+ * @see CancellationPass.hpp, RotationMergePass.hpp and
+ *      IdentityEliminationPass.hpp for the individual rules
+ * @see PeepholePass.hpp for user-defined rules
+ */
+
+#pragma once
+
+#include "Pass.hpp"
+#include "PassRegistry.hpp"
+#include "CancellationPass.hpp"
+#include "IdentityEliminationPass.hpp"
+#include "RotationMergePass.hpp"
+#include "../ir/DAG.hpp"
+#include "../ir/Gate.hpp"
+#include "../ir/Types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace qopt::passes {
+
+/**
+ * @brief Cancellation, rotation merging and identity elimination in one sweep.
+ *
+ * Gates are visited in topological order while each qubit keeps a stack
+ * of the surviving gates on it. A gate whose qubits all have the same
+ * gate on top, acting on exactly those qubits, is directly adjacent to
+ * it: the pair cancels (both popped) or merges into the earlier gate.
+ * Otherwise the gate is pushed; identity rotations are dropped once the
+ * next gate on their wires does not merge with them. Since
+ * removals expose the gate below, chains such as X H H X collapse in the
+ * same sweep, which is what makes a fixed-point loop unnecessary.
+ *
+ * CommutationPass only moves gates past gates on disjoint qubits, which
+ * the DAG leaves unordered already, so its entry always reads zero.
+ *
+ * Example:
+ * @code
+ * PassManager pm;
+ * pm.addPass(std::make_unique<FusedPeepholePass>());
+ * pm.run(circuit);  // per_pass lists the four fused passes
+ * @endcode
+ */
+class FusedPeepholePass : public Pass {
+public:
+    /**
+     * @brief Constructs the pass.
+     * @param tolerance Rotation angles this close to 0 (mod 2π) are removed
+     */
+    explicit FusedPeepholePass(double tolerance = constants::TOLERANCE)
+        : tolerance_(tolerance)
+    {}
+
+    [[nodiscard]] std::string name() const override {
+        return "FusedPeepholePass";
+    }
+
+    /// @brief Registry entry (see PassRegistry.hpp).
+    [[nodiscard]] static PassInfo describe() {
+        return {"FusedPeepholePass", "fused",
+                "Cancellation, rotation merging and identity elimination in one sweep",
+                {{"tolerance", PassOption::Type::Number, numberText(constants::TOLERANCE),
+                  "Angles this close to 0 (mod 2 pi) count as zero"}},
+                PassCost::Linear,
+                [](const PassSpec& spec) -> std::unique_ptr<Pass> {
+                    return std::make_unique<FusedPeepholePass>(
+                        spec.number("tolerance", constants::TOLERANCE));
+                }};
+    }
+
+    void run(ir::DAG& dag) override {
+        resetStatistics();
+        cancelled_ = 0;
+        merged_ = 0;
+        eliminated_ = 0;
+
+        std::vector<std::vector<GateId>> stacks(dag.numQubits());
+
+        for (GateId id : dag.topologicalOrder()) {
+            if (!absorb(dag, stacks, id)) {
+                for (QubitIndex q : dag.node(id).gate().qubits()) {
+                    stacks[q].push_back(id);
+                }
+            }
+        }
+
+        // Identity rotations left on top of a wire had nothing to merge with
+        for (const auto& stack : stacks) {
+            if (!stack.empty() && dag.hasNode(stack.back()) && isIdentity(dag, stack.back())) {
+                dag.removeNode(stack.back());
+                ++eliminated_;
+            }
+        }
+
+        gates_removed_ = cancelled_ + merged_ + eliminated_;
+    }
+
+    /**
+     * @brief Returns the counts of the last run() under the fused passes' names.
+     */
+    [[nodiscard]] std::vector<RuleStatistics> ruleStatistics() const override {
+        return {
+            {"CommutationPass", 0, 0},
+            {"CancellationPass", cancelled_, 0},
+            {"RotationMergePass", merged_, 0},
+            {"IdentityEliminationPass", eliminated_, 0},
+        };
+    }
+
+private:
+    double tolerance_;
+    std::size_t cancelled_ = 0;
+    std::size_t merged_ = 0;
+    std::size_t eliminated_ = 0;
+
+    [[nodiscard]] bool isIdentity(const ir::DAG& dag, GateId id) const {
+        return IdentityEliminationPass::isIdentityGate(dag.node(id).gate(), tolerance_);
+    }
+
+    /**
+     * @brief Cancels or merges a gate with the surviving gate before it.
+     *
+     * An identity rotation stays on its wires until the next gate there
+     * fails to merge with it, as in the pass pipeline, where merging runs
+     * before identity elimination. Removing it may expose a partner below,
+     * so the search repeats.
+     *
+     * @return true if the gate was removed
+     */
+    bool absorb(ir::DAG& dag, std::vector<std::vector<GateId>>& stacks, GateId id) {
+        while (true) {
+            const ir::Gate& gate = dag.node(id).gate();
+            if (auto top = adjacentSurvivor(dag, stacks, gate)) {
+                const ir::Gate& prev = dag.node(*top).gate();
+                if (prev.qubits() == gate.qubits() &&
+                    CancellationPass::areCancellingPair(prev, gate)) {
+                    pop(stacks, prev);
+                    dag.removeNode(*top);
+                    dag.removeNode(id);
+                    cancelled_ += 2;
+                    return true;
+                }
+                if (canMerge(prev, gate)) {
+                    dag.replaceGate(*top, RotationMergePass::merge(dag.parameterTable(),
+                                                                   prev, gate));
+                    dag.removeNode(id);
+                    ++merged_;
+                    return true;
+                }
+            }
+
+            bool exposed = false;
+            for (QubitIndex q : gate.qubits()) {
+                if (!stacks[q].empty() && isIdentity(dag, stacks[q].back())) {
+                    const GateId identity = stacks[q].back();
+                    pop(stacks, dag.node(identity).gate());
+                    dag.removeNode(identity);
+                    ++eliminated_;
+                    exposed = true;
+                }
+            }
+            if (!exposed) return false;
+        }
+    }
+
+    /**
+     * @brief Returns the surviving gate directly before a gate, if the gate
+     *        follows it on all of its qubits and it acts on no others.
+     *
+     * Only unitary gates qualify; measurements, resets and barriers stay
+     * on the stacks and block everything behind them.
+     */
+    [[nodiscard]] static std::optional<GateId> adjacentSurvivor(
+            const ir::DAG& dag,
+            const std::vector<std::vector<GateId>>& stacks,
+            const ir::Gate& gate) {
+        if (ir::isNonUnitary(gate.type())) return std::nullopt;
+        const auto& first = stacks[gate.qubits()[0]];
+        if (first.empty()) return std::nullopt;
+        const GateId top = first.back();
+        for (QubitIndex q : gate.qubits()) {
+            if (stacks[q].empty() || stacks[q].back() != top) return std::nullopt;
+        }
+        if (dag.node(top).gate().qubits().size() != gate.qubits().size()) return std::nullopt;
+        return top;
+    }
+
+    /// @brief Same rule as RotationMergePass: one rotation type on the same qubits.
+    [[nodiscard]] static bool canMerge(const ir::Gate& g1, const ir::Gate& g2) {
+        if (g1.type() != g2.type() || !RotationMergePass::isRotationGate(g1.type())) {
+            return false;
+        }
+        return std::is_permutation(g1.qubits().begin(), g1.qubits().end(),
+                                   g2.qubits().begin(), g2.qubits().end());
+    }
+
+    static void pop(std::vector<std::vector<GateId>>& stacks, const ir::Gate& gate) {
+        for (QubitIndex q : gate.qubits()) {
+            stacks[q].pop_back();
+        }
+    }
+};
+
+/// @brief Registers FusedPeepholePass as "fused".
+inline const bool FUSED_PEEPHOLE_PASS_REGISTERED = registerPass<FusedPeepholePass>();
+
+}  // namespace qopt::passes
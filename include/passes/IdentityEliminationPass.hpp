@@ -9,8 +9,11 @@
  * - Rz(0) = I
  * - Rx(0) = I
  * - Ry(0) = I
+ * - CPhase(0) = RZZ(0) = I
+ * - U3(0, φ, -φ) = I
  *
- * Also handles angles that are multiples of 2π.
+ * Also handles angles that are multiples of 2π. Equality is up to
+ * global phase.
  *
  * @see Pass.hpp for the base pass interface
  * @see RotationMergePass.hpp which may produce Rz(0) gates
@@ -19,6 +22,7 @@
 #pragma once
 
 #include "Pass.hpp"
+#include "PassRegistry.hpp"
 #include "../ir/DAG.hpp"
 #include "../ir/Gate.hpp"
 #include "../ir/Types.hpp"
@@ -58,6 +62,19 @@ public:
         return "IdentityEliminationPass";
     }
 
+    /// @brief Registry entry (see PassRegistry.hpp).
+    [[nodiscard]] static PassInfo describe() {
+        return {"IdentityEliminationPass", "idelim",
+                "Removes rotations by angles equivalent to zero",
+                {{"tolerance", PassOption::Type::Number, numberText(constants::TOLERANCE),
+                  "Angles this close to 0 (mod 2 pi) count as zero"}},
+                PassCost::Linear,
+                [](const PassSpec& spec) -> std::unique_ptr<Pass> {
+                    return std::make_unique<IdentityEliminationPass>(
+                        spec.number("tolerance", constants::TOLERANCE));
+                }};
+    }
+
     void run(ir::DAG& dag) override {
         resetStatistics();
 
@@ -67,7 +84,7 @@ public:
         for (GateId id : dag.topologicalOrder()) {
             const ir::Gate& gate = dag.node(id).gate();
 
-            if (isIdentityGate(gate)) {
+            if (isIdentityGate(gate, tolerance_)) {
                 to_remove.push_back(id);
             }
         }
@@ -81,43 +98,60 @@ public:
         }
     }
 
-private:
-    double tolerance_;
-
     /**
      * @brief Checks if a gate is effectively an identity operation.
      *
      * A rotation gate is identity if its angle is a multiple of 2π
-     * (within tolerance).
+     * (within tolerance). U3(θ, φ, λ) = Rz(φ) Ry(θ) Rz(λ) is identity if
+     * θ and φ + λ are. Shared with FusedPeepholePass.
      *
      * @param gate The gate to check
+     * @param tolerance Angles closer than this to 0 (mod 2π) count as zero
      * @return true if the gate is equivalent to identity
      */
-    [[nodiscard]] bool isIdentityGate(const ir::Gate& gate) const noexcept {
+    [[nodiscard]] static bool isIdentityGate(const ir::Gate& gate,
+                                             double tolerance) noexcept {
         // Only rotation gates can be identity based on parameter
         if (!ir::isParameterized(gate.type())) {
             return false;
         }
 
+        // A symbolic angle is unknown until the circuit is bound
+        if (gate.isSymbolic()) {
+            return false;
+        }
+
+        if (gate.type() == ir::GateType::U3) {
+            return isEffectivelyZero(gate.parameter(0), tolerance) &&
+                   isEffectivelyZero(gate.parameter(1) + gate.parameter(2), tolerance);
+        }
+
         // Check if angle is effectively zero or 2πn
         Angle angle = gate.parameter().value_or(0.0);
-        return isEffectivelyZero(angle);
+        return isEffectivelyZero(angle, tolerance);
     }
 
+private:
+    double tolerance_;
+
     /**
      * @brief Checks if an angle is effectively zero (mod 2π).
      * @param angle The angle in radians
+     * @param tolerance Largest distance from 0 (mod 2π) that counts as zero
      * @return true if angle ≈ 0 (mod 2π)
      */
-    [[nodiscard]] bool isEffectivelyZero(Angle angle) const noexcept {
+    [[nodiscard]] static bool isEffectivelyZero(Angle angle, double tolerance) noexcept {
         constexpr Angle TWO_PI = 2.0 * constants::PI;
 
         // Reduce modulo 2π
         Angle reduced = std::fmod(std::abs(angle), TWO_PI);
 
         // Check if close to 0 or 2π
-        return reduced < tolerance_ || (TWO_PI - reduced) < tolerance_;
+        return reduced < tolerance || (TWO_PI - reduced) < tolerance;
     }
 };
 
+/// @brief Registers IdentityEliminationPass as "idelim".
+inline const bool IDENTITY_ELIMINATION_PASS_REGISTERED = registerPass<IdentityEliminationPass>();
+
 }  // namespace qopt::passes
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file OptimizationLevel.hpp
+ * @brief Preset pass pipelines trading compile time for circuit quality
+ *
+ * | Level | Pipeline                                                  | Budget      |
+ * |-------|-----------------------------------------------------------|-------------|
+ * | O0    | nothing                                                   | 6 µs/gate   |
+ * | O1    | FusedPeepholePass, once                                   | 8 µs/gate   |
+ * | O2    | FusedPeepholePass, SingleQubitFusionPass to a fixed point | 12 µs/gate  |
+ * | O3    | O2 plus PeepholePass rules, see routing::compile()        | 120 µs/gate |
+ *
+ * Budgets bound the time of routing::compile() per input gate, summed
+ * over the benchmark suite. Routing is included and dominates below O3
+ * (about 3 µs/gate); O3 spends most of its time on layout trials.
+ * benchmark_circuits fails when a level exceeds its budget.
+ *
+ * @see PassManager.hpp for running a pipeline
+ * @see Compiler.hpp for the routing stages of each level
+ */
+
+#pragma once
+
+#include "FusedPeepholePass.hpp"
+#include "PassManager.hpp"
+#include "PeepholePass.hpp"
+#include "SingleQubitFusionPass.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace qopt::passes {
+
+/**
+ * @brief Named optimization levels, from fastest to most thorough.
+ */
+enum class OptimizationLevel {
+    O0,  ///< No optimization
+    O1,  ///< One fused peephole sweep
+    O2,  ///< Fixed-point peepholes and single-qubit fusion
+    O3   ///< O2 plus two-qubit rewrite rules, layout trials and post-routing cleanup
+};
+
+/// @brief Iteration bound of the fixed-point pipelines (O2 and O3).
+inline constexpr std::size_t FIXPOINT_ITERATIONS = 4;
+
+/**
+ * @brief Returns a level's name ("O0" to "O3").
+ * @param level The level
+ * @return Its name
+ */
+[[nodiscard]] constexpr std::string_view toString(OptimizationLevel level) noexcept {
+    switch (level) {
+        case OptimizationLevel::O0: return "O0";
+        case OptimizationLevel::O1: return "O1";
+        case OptimizationLevel::O2: return "O2";
+        case OptimizationLevel::O3: return "O3";
+    }
+    return "O0";
+}
+
+/**
+ * @brief Parses a level name such as "O2" or "2".
+ * @param text The name
+ * @return The level
+ * @throws std::invalid_argument for anything else
+ */
+[[nodiscard]] inline OptimizationLevel parseOptimizationLevel(std::string_view text) {
+    if (text.size() == 2 && (text[0] == 'O' || text[0] == 'o')) {
+        text.remove_prefix(1);
+    }
+    if (text.size() == 1 && text[0] >= '0' && text[0] <= '3') {
+        return static_cast<OptimizationLevel>(text[0] - '0');
+    }
+    throw std::invalid_argument("Unknown optimization level '" + std::string(text) +
+                                "' (expected O0, O1, O2 or O3)");
+}
+
+/**
+ * @brief Returns a level's compile-time budget.
+ *
+ * The budget covers routing::compile() at that level, averaged over the
+ * input gates of the benchmark suite (Release build).
+ *
+ * @param level The level
+ * @return Microseconds per input gate
+ */
+[[nodiscard]] constexpr double compileBudgetMicrosPerGate(OptimizationLevel level) noexcept {
+    switch (level) {
+        case OptimizationLevel::O0: return 6.0;
+        case OptimizationLevel::O1: return 8.0;
+        case OptimizationLevel::O2: return 12.0;
+        case OptimizationLevel::O3: return 120.0;
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Builds the optimization pipeline of a level.
+ *
+ * Example:
+ * @code
+ * PassManager pm = makePassManager(OptimizationLevel::O2);
+ * pm.run(circuit);
+ * @endcode
+ *
+ * @param level The level
+ * @return The pipeline (empty for O0)
+ */
+[[nodiscard]] inline PassManager makePassManager(OptimizationLevel level) {
+    PassManager pm;
+    switch (level) {
+        case OptimizationLevel::O0:
+            break;
+        case OptimizationLevel::O1:
+            pm.addPass(std::make_unique<FusedPeepholePass>());
+            break;
+        case OptimizationLevel::O2:
+            pm.addPass(std::make_unique<FusedPeepholePass>());
+            pm.addPass(std::make_unique<SingleQubitFusionPass>());
+            pm.setMaxIterations(FIXPOINT_ITERATIONS);
+            break;
+        case OptimizationLevel::O3:
+            pm.addPass(std::make_unique<FusedPeepholePass>());
+            pm.addPass(std::make_unique<PeepholePass>());
+            pm.addPass(std::make_unique<SingleQubitFusionPass>());
+            pm.setMaxIterations(FIXPOINT_ITERATIONS);
+            break;
+    }
+    return pm;
+}
+
+}  // namespace qopt::passes
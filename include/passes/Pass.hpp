@@ -19,9 +19,27 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 namespace qopt::passes {
 
+/**
+ * @brief Gate counts of one rule inside a pass that applies several.
+ *
+ * A fused pass reports these so that pipeline statistics stay broken down
+ * by rule, just as if each rule had run as its own pass.
+ */
+struct RuleStatistics {
+    /// Name the rule is reported under (e.g. the pass it replaces).
+    std::string name;
+
+    /// Gates this rule removed.
+    std::size_t gates_removed = 0;
+
+    /// Gates this rule added.
+    std::size_t gates_added = 0;
+};
+
 /**
  * @brief Abstract base class for optimization passes.
  *
@@ -101,6 +119,19 @@ public:
                static_cast<std::ptrdiff_t>(gates_removed_);
     }
 
+    /**
+     * @brief Returns per-rule counts from the last run() call.
+     *
+     * Passes that apply several independent rules override this; PassManager
+     * then records one entry per rule instead of one for the pass. The
+     * counts must add up to gatesRemoved() and gatesAdded().
+     *
+     * @return Per-rule counts, or empty (the default) for a single-rule pass
+     */
+    [[nodiscard]] virtual std::vector<RuleStatistics> ruleStatistics() const {
+        return {};
+    }
+
     /**
      * @brief Resets statistics counters to zero.
      *
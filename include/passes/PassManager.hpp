@@ -6,8 +6,10 @@
  * @brief Pipeline manager for running optimization passes
  *
  * Provides the PassManager class for building and executing optimization
- * pipelines. Passes are run in sequence, and statistics are aggregated
- * across all passes.
+ * pipelines. Passes are run in sequence, optionally repeated until a fixed
+ * point, and statistics are aggregated across all passes. Optionally, each
+ * pass's effect on the critical-path duration is measured too, so passes
+ * can be ranked by depth impact.
  *
  * @see Pass.hpp for the base pass interface
  * @see DAG.hpp for the circuit representation
@@ -17,14 +19,42 @@
 
 #include "Pass.hpp"
 #include "../ir/Circuit.hpp"
+#include "../ir/CriticalPath.hpp"
 #include "../ir/DAG.hpp"
+#include "../ir/Schedule.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace qopt::passes {
 
+/**
+ * @brief A pass's effect on the critical-path duration.
+ */
+struct PassImpact {
+    /// Name of the pass.
+    std::string name;
+
+    /// Critical-path duration before the pass ran.
+    ir::Duration duration_before = 0.0;
+
+    /// Critical-path duration after the pass ran.
+    ir::Duration duration_after = 0.0;
+
+    /**
+     * @brief Returns the change in critical-path duration.
+     * @return Negative means the pass shortened the circuit (good)
+     */
+    [[nodiscard]] ir::Duration change() const noexcept {
+        return duration_after - duration_before;
+    }
+};
+
 /**
  * @brief Statistics from running an optimization pipeline.
  *
@@ -44,9 +74,33 @@ struct PassStatistics {
     /// Final gate count after optimization.
     std::size_t final_gate_count = 0;
 
-    /// Per-pass statistics: (pass_name, gates_removed, gates_added).
+    /// Number of times the pipeline ran (see PassManager::setMaxIterations()).
+    std::size_t iterations = 0;
+
+    /// Per-pass statistics: (pass_name, gates_removed, gates_added), summed
+    /// over iterations. A pass that reports Pass::ruleStatistics()
+    /// contributes one entry per rule.
     std::vector<std::tuple<std::string, std::size_t, std::size_t>> per_pass;
 
+    /// Per-pass critical-path impact, in pipeline order (empty unless tracked).
+    /// Over several iterations, each entry spans from the pass's first run
+    /// to its last.
+    std::vector<PassImpact> depth_impact;
+
+    /**
+     * @brief Returns depth_impact ordered by change, largest reduction first.
+     *
+     * Passes with equal impact keep their pipeline order.
+     */
+    [[nodiscard]] std::vector<PassImpact> rankedByDepthImpact() const {
+        std::vector<PassImpact> ranked = depth_impact;
+        std::stable_sort(ranked.begin(), ranked.end(),
+                         [](const PassImpact& a, const PassImpact& b) {
+                             return a.change() < b.change();
+                         });
+        return ranked;
+    }
+
     /**
      * @brief Returns the net change in gate count.
      * @return Negative means reduction (good)
@@ -75,11 +129,22 @@ struct PassStatistics {
         result += "  Initial gates: " + std::to_string(initial_gate_count) + "\n";
         result += "  Final gates:   " + std::to_string(final_gate_count) + "\n";
         result += "  Reduction:     " + std::to_string(reductionPercent()) + "%\n";
+        if (iterations > 1) {
+            result += "  Iterations:    " + std::to_string(iterations) + "\n";
+        }
         result += "  Per-pass:\n";
         for (const auto& [name, removed, added] : per_pass) {
             result += "    " + name + ": -" + std::to_string(removed) +
                       " / +" + std::to_string(added) + "\n";
         }
+        if (!depth_impact.empty()) {
+            result += "  Critical path:\n";
+            for (const auto& impact : depth_impact) {
+                result += "    " + impact.name + ": " +
+                          std::to_string(impact.duration_before) + " -> " +
+                          std::to_string(impact.duration_after) + "\n";
+            }
+        }
         return result;
     }
 };
@@ -157,6 +222,44 @@ public:
         statistics_ = PassStatistics{};
     }
 
+    /**
+     * @brief Repeats the pipeline until an iteration changes nothing.
+     *
+     * run() stops after the first iteration in which no pass removed or
+     * added a gate, or after max_iterations, whichever comes first.
+     *
+     * @param max_iterations Upper bound on pipeline runs (default 1: run once)
+     * @throws std::invalid_argument if max_iterations is 0
+     */
+    void setMaxIterations(std::size_t max_iterations) {
+        if (max_iterations == 0) {
+            throw std::invalid_argument("PassManager needs at least one iteration");
+        }
+        max_iterations_ = max_iterations;
+    }
+
+    /**
+     * @brief Returns the iteration bound set by setMaxIterations().
+     * @return Maximum pipeline runs per run() call
+     */
+    [[nodiscard]] std::size_t maxIterations() const noexcept {
+        return max_iterations_;
+    }
+
+    /**
+     * @brief Measures each pass's effect on the critical-path duration.
+     *
+     * run() then keeps an ir::CriticalPath up to date across the pipeline,
+     * wrapping each pass in a DAG checkpoint and revisiting only the nodes
+     * the pass journaled, and fills PassStatistics::depth_impact. Passes
+     * must edit gates through DAG::replaceGate() for this to see them.
+     *
+     * @param durations Gate durations (default: unit, i.e. layer depth)
+     */
+    void trackCriticalPath(ir::DurationTable durations = ir::DurationTable()) {
+        durations_ = durations;
+    }
+
     // -------------------------------------------------------------------------
     // Execution
     // -------------------------------------------------------------------------
@@ -164,8 +267,8 @@ public:
     /**
      * @brief Runs all passes on the given DAG.
      *
-     * Passes are executed in order. Statistics are accumulated and can
-     * be retrieved with statistics().
+     * Passes are executed in order, up to maxIterations() times.
+     * Statistics are accumulated and can be retrieved with statistics().
      *
      * @param dag The DAG to transform (modified in place)
      */
@@ -173,16 +276,63 @@ public:
         statistics_ = PassStatistics{};
         statistics_.initial_gate_count = dag.numNodes();
 
-        for (auto& pass : passes_) {
-            pass->resetStatistics();
-            pass->run(dag);
+        std::optional<ir::CriticalPath> critical_path;
+        if (durations_) {
+            critical_path.emplace(dag, *durations_);
+        }
 
-            statistics_.total_gates_removed += pass->gatesRemoved();
-            statistics_.total_gates_added += pass->gatesAdded();
-            statistics_.per_pass.emplace_back(
-                pass->name(),
-                pass->gatesRemoved(),
-                pass->gatesAdded());
+        while (statistics_.iterations < max_iterations_) {
+            ++statistics_.iterations;
+            std::size_t changes = 0;
+            std::size_t entry = 0;
+            std::size_t impact = 0;
+
+            for (auto& pass : passes_) {
+                pass->resetStatistics();
+                if (critical_path) {
+                    const ir::Duration before = critical_path->length();
+                    dag.checkpoint();
+                    try {
+                        pass->run(dag);
+                    } catch (...) {
+                        dag.commit();
+                        throw;
+                    }
+                    critical_path->update(dag, dag.journaledNodes());
+                    dag.commit();
+                    if (impact < statistics_.depth_impact.size()) {
+                        statistics_.depth_impact[impact].duration_after = critical_path->length();
+                    } else {
+                        statistics_.depth_impact.push_back(
+                            {pass->name(), before, critical_path->length()});
+                    }
+                    ++impact;
+                } else {
+                    pass->run(dag);
+                }
+
+                changes += pass->gatesRemoved() + pass->gatesAdded();
+                statistics_.total_gates_removed += pass->gatesRemoved();
+                statistics_.total_gates_added += pass->gatesAdded();
+                std::vector<RuleStatistics> rules = pass->ruleStatistics();
+                if (rules.empty()) {
+                    rules.push_back({pass->name(), pass->gatesRemoved(), pass->gatesAdded()});
+                }
+                for (auto& rule : rules) {
+                    if (entry < statistics_.per_pass.size()) {
+                        std::get<1>(statistics_.per_pass[entry]) += rule.gates_removed;
+                        std::get<2>(statistics_.per_pass[entry]) += rule.gates_added;
+                    } else {
+                        statistics_.per_pass.emplace_back(
+                            std::move(rule.name),
+                            rule.gates_removed,
+                            rule.gates_added);
+                    }
+                    ++entry;
+                }
+            }
+
+            if (changes == 0) break;
         }
 
         statistics_.final_gate_count = dag.numNodes();
@@ -217,6 +367,8 @@ public:
 private:
     std::vector<std::unique_ptr<Pass>> passes_;
     PassStatistics statistics_;
+    std::optional<ir::DurationTable> durations_;  // Set: track the critical path
+    std::size_t max_iterations_ = 1;
 };
 
 }  // namespace qopt::passes
@@ -0,0 +1,313 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file PassRegistry.hpp
+ * @brief Registry for finding and constructing passes by name
+ *
+ * Every pass header registers its pass when included: the class provides
+ * a static describe() returning its PassInfo, and the header defines
+ *
+ * @code
+ * inline const bool MY_PASS_REGISTERED = registerPass<MyPass>();
+ * @endcode
+ *
+ * so any program that includes a pass can look it up by name, read its
+ * option schema and cost class, and build it from a PassSpec.
+ *
+ * @see PipelineSpec.hpp for pipelines built through the registry
+ */
+
+#pragma once
+
+#include "Pass.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace qopt::passes {
+
+/**
+ * @brief One pass of a pipeline spec: its name and options.
+ */
+struct PassSpec {
+    /// Pass name: registered short name or class name.
+    std::string name;
+
+    /// (key, value) options in spec order; values are unparsed text.
+    std::vector<std::pair<std::string, std::string>> options;
+
+    /**
+     * @brief Returns an option's value.
+     * @param key Option name
+     * @return The value, or nullopt if the option is not given
+     */
+    [[nodiscard]] std::optional<std::string> option(std::string_view key) const {
+        for (const auto& [k, v] : options) {
+            if (k == key) return v;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Returns a numeric option.
+     * @param key Option name
+     * @param fallback Value if the option is not given
+     * @return The option's value
+     * @throws std::invalid_argument if the value is not a number
+     */
+    [[nodiscard]] double number(std::string_view key, double fallback) const {
+        auto text = option(key);
+        if (!text) return fallback;
+        const char* begin = text->c_str();
+        char* end = nullptr;
+        errno = 0;
+        const double value = std::strtod(begin, &end);
+        if (text->empty() || end != begin + text->size() || errno == ERANGE) {
+            throw std::invalid_argument("Pass '" + name + "': option " + std::string(key) +
+                                        " must be a number, got '" + *text + "'");
+        }
+        return value;
+    }
+
+    friend bool operator==(const PassSpec& a, const PassSpec& b) {
+        return a.name == b.name && a.options == b.options;
+    }
+    friend bool operator!=(const PassSpec& a, const PassSpec& b) { return !(a == b); }
+};
+
+/**
+ * @brief How a pass's run time grows with the circuit.
+ */
+enum class PassCost {
+    Linear,    ///< One sweep over the DAG
+    Iterative  ///< Sweeps until nothing changes; linear per sweep
+};
+
+/**
+ * @brief Returns a cost class's name ("linear" or "iterative").
+ */
+[[nodiscard]] constexpr std::string_view toString(PassCost cost) noexcept {
+    switch (cost) {
+        case PassCost::Linear:    return "linear";
+        case PassCost::Iterative: return "iterative";
+    }
+    return "linear";
+}
+
+/**
+ * @brief Schema entry for one pass option.
+ */
+struct PassOption {
+    /// Value types an option accepts.
+    enum class Type {
+        Number,  ///< Parsed with PassSpec::number()
+        String   ///< Taken as is
+    };
+
+    /// Option name, as written in a spec.
+    std::string name;
+
+    /// Accepted values.
+    Type type = Type::Number;
+
+    /// Default used when the option is omitted, as text.
+    std::string default_value;
+
+    /// One-line description.
+    std::string description;
+};
+
+/**
+ * @brief Formats a number option's default as the shortest text that
+ *        PassSpec::number() reads back exactly (e.g. "1e-10").
+ *
+ * Lets describe() derive defaults from the constants the constructors use
+ * instead of repeating them as literals.
+ */
+[[nodiscard]] inline std::string numberText(double value) {
+    std::string shortest;
+    char buffer[32];
+    for (int precision = 1; precision <= 17; ++precision) {
+        std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        if (std::strtod(buffer, nullptr) != value) continue;
+        // "2e+01" reads back too, but "20" (one more digit) is shorter
+        if (shortest.empty() || std::string_view(buffer).size() < shortest.size()) {
+            shortest = buffer;
+        }
+    }
+    return shortest;
+}
+
+/**
+ * @brief What the registry knows about a pass.
+ */
+struct PassInfo {
+    /// Class name, as returned by Pass::name().
+    std::string name;
+
+    /// Short name for specs (e.g. "cancel").
+    std::string short_name;
+
+    /// One-line description.
+    std::string description;
+
+    /// Options the factory reads.
+    std::vector<PassOption> options;
+
+    /// Run-time growth.
+    PassCost cost = PassCost::Linear;
+
+    /// Builds the pass; receives a PassSpec already checked against options.
+    std::function<std::unique_ptr<Pass>(const PassSpec&)> factory;
+};
+
+/**
+ * @brief Process-wide table of registered passes.
+ *
+ * Example:
+ * @code
+ * auto& registry = PassRegistry::instance();
+ * for (const PassInfo* info : registry.passes()) {
+ *     std::cout << info->short_name << ": " << info->description << "\n";
+ * }
+ * auto pass = registry.create({"idelim", {{"tolerance", "1e-6"}}});
+ * @endcode
+ */
+class PassRegistry {
+public:
+    /**
+     * @brief Returns the registry.
+     *
+     * Constructed on first use, so registration from other headers' static
+     * initializers is safe in any order.
+     */
+    [[nodiscard]] static PassRegistry& instance() {
+        static PassRegistry registry;
+        return registry;
+    }
+
+    PassRegistry(const PassRegistry&) = delete;
+    PassRegistry& operator=(const PassRegistry&) = delete;
+
+    /**
+     * @brief Registers a pass.
+     * @param info Description and factory
+     * @return true, for use in a static initializer
+     * @throws std::invalid_argument if the name or short name is taken,
+     *         or the factory is missing
+     */
+    bool add(PassInfo info) {
+        if (!info.factory) {
+            throw std::invalid_argument("Pass '" + info.name + "' registered without a factory");
+        }
+        if (find(info.name) != nullptr || find(info.short_name) != nullptr) {
+            throw std::invalid_argument("Pass '" + info.name + "' (" + info.short_name +
+                                        ") is already registered");
+        }
+        passes_.push_back(std::make_unique<PassInfo>(std::move(info)));
+        return true;
+    }
+
+    /**
+     * @brief Looks up a pass by class name or short name.
+     * @param name e.g. "IdentityEliminationPass" or "idelim"
+     * @return The pass's info, or nullptr if not registered
+     */
+    [[nodiscard]] const PassInfo* find(std::string_view name) const {
+        for (const auto& info : passes_) {
+            if (info->name == name || info->short_name == name) return info.get();
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Looks up a pass by class name or short name.
+     * @param name e.g. "IdentityEliminationPass" or "idelim"
+     * @return The pass's info
+     * @throws std::invalid_argument if no such pass is registered
+     */
+    [[nodiscard]] const PassInfo& at(std::string_view name) const {
+        if (const PassInfo* info = find(name)) return *info;
+        throw std::invalid_argument("Unknown pass '" + std::string(name) + "'");
+    }
+
+    /**
+     * @brief Returns every registered pass, ordered by short name.
+     */
+    [[nodiscard]] std::vector<const PassInfo*> passes() const {
+        std::vector<const PassInfo*> out;
+        for (const auto& info : passes_) out.push_back(info.get());
+        std::sort(out.begin(), out.end(), [](const PassInfo* a, const PassInfo* b) {
+            return a->short_name < b->short_name;
+        });
+        return out;
+    }
+
+    /**
+     * @brief Checks a spec's options against the pass's schema.
+     * @param spec Pass name and options
+     * @throws std::invalid_argument for unknown passes, unknown or repeated
+     *         options, and numeric options that do not parse
+     */
+    void validate(const PassSpec& spec) const {
+        const PassInfo& info = at(spec.name);
+        for (std::size_t i = 0; i < spec.options.size(); ++i) {
+            const std::string& key = spec.options[i].first;
+            auto schema = std::find_if(info.options.begin(), info.options.end(),
+                                       [&key](const PassOption& o) { return o.name == key; });
+            if (schema == info.options.end()) {
+                throw std::invalid_argument("Pass '" + spec.name + "' has no option '" + key + "'");
+            }
+            for (std::size_t j = 0; j < i; ++j) {
+                if (spec.options[j].first == key) {
+                    throw std::invalid_argument("Pass '" + spec.name + "': option '" + key +
+                                                "' given twice");
+                }
+            }
+            if (schema->type == PassOption::Type::Number) {
+                (void)spec.number(key, 0.0);
+            }
+        }
+    }
+
+    /**
+     * @brief Builds a pass from a spec.
+     * @param spec Pass name and options
+     * @return The configured pass
+     * @throws std::invalid_argument if validate() fails or the factory rejects a value
+     */
+    [[nodiscard]] std::unique_ptr<Pass> create(const PassSpec& spec) const {
+        validate(spec);
+        return at(spec.name).factory(spec);
+    }
+
+private:
+    PassRegistry() = default;
+
+    // Stable addresses: find() results stay valid as passes are added
+    std::vector<std::unique_ptr<PassInfo>> passes_;
+};
+
+/**
+ * @brief Registers a pass class through its static describe().
+ * @tparam P A Pass subclass with `static PassInfo describe()`
+ * @return true, for use in a static initializer
+ */
+template <typename P>
+bool registerPass() {
+    return PassRegistry::instance().add(P::describe());
+}
+
+}  // namespace qopt::passes
@@ -0,0 +1,671 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file PeepholePass.hpp
+ * @brief Declarative peephole rewrites compiled into a matching trie
+ *
+ * Rules are written one per line as gate sequences on qubit variables:
+ * @code
+ * H a; H a =>
+ * T a; T a => S a
+ * Rz(x) a; Rz(y) a => Rz(x + y) a
+ * CX a, b; CX b, a; CX a, b => SWAP a, b
+ * @endcode
+ * The left side matches a run of gates that follow each other directly on
+ * the same qubits; the right side is what the run becomes. Angles are
+ * affine expressions over variables bound on the left, numbers and pi.
+ * All rules of a pass share one trie keyed by gate type, so a single DAG
+ * traversal tries every rule at every node.
+ *
+ * @see Pass.hpp for the base pass interface
+ * @see CancellationPass.hpp and RotationMergePass.hpp for the hand-written
+ *      equivalents of several default rules
+ */
+
+#pragma once
+
+#include "Pass.hpp"
+#include "PassRegistry.hpp"
+#include "../ir/DAG.hpp"
+#include "../ir/Gate.hpp"
+#include "../ir/Types.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace qopt::passes {
+
+/**
+ * @brief Rule set used by a default-constructed PeepholePass.
+ *
+ * Inverse pairs, Clifford+T products, rotation merges and the CNOT
+ * decomposition of SWAP.
+ */
+inline constexpr std::string_view DEFAULT_PEEPHOLE_RULES = R"(
+# Self-inverse and adjoint pairs
+H a; H a =>
+X a; X a =>
+Y a; Y a =>
+Z a; Z a =>
+S a; Sdg a =>
+Sdg a; S a =>
+T a; Tdg a =>
+Tdg a; T a =>
+CX a, b; CX a, b =>
+CZ a, b; CZ a, b =>
+CZ a, b; CZ b, a =>
+SWAP a, b; SWAP a, b =>
+SWAP a, b; SWAP b, a =>
+CCX a, b, c; CCX a, b, c =>
+CCX a, b, c; CCX b, a, c =>
+
+# Products of phase gates
+S a; S a => Z a
+Sdg a; Sdg a => Z a
+T a; T a => S a
+Tdg a; Tdg a => Sdg a
+SX a; SX a => X a
+
+# Basis changes
+H a; X a; H a => Z a
+H a; Z a; H a => X a
+
+# Rotations
+Rx(x) a; Rx(y) a => Rx(x + y) a
+Ry(x) a; Ry(y) a => Ry(x + y) a
+Rz(x) a; Rz(y) a => Rz(x + y) a
+Rx(0) a =>
+Ry(0) a =>
+Rz(0) a =>
+
+# Three alternating CNOTs are a SWAP
+CX a, b; CX b, a; CX a, b => SWAP a, b
+)";
+
+/**
+ * @brief One compiled rewrite rule.
+ */
+struct PeepholeRule {
+    /// @brief Affine angle expression: constant + sum of coefficients[i] * variable i.
+    struct AngleTerm {
+        Angle constant = 0.0;
+        std::vector<Angle> coefficients;   ///< By angle variable
+        std::optional<std::size_t> binds;  ///< Left side only: first use of this variable
+    };
+
+    /// @brief One gate of either side of a rule.
+    struct GateTerm {
+        ir::GateType type = ir::GateType::H;
+        std::vector<std::size_t> qubits;   ///< Qubit variables, in operand order
+        std::vector<AngleTerm> angles;
+    };
+
+    /// @brief The rule as written (whitespace-trimmed).
+    std::string text;
+
+    /// @brief Gates to match, in program order.
+    std::vector<GateTerm> pattern;
+
+    /// @brief Gates to emit in their place (shorter than the pattern).
+    std::vector<GateTerm> replacement;
+
+    /// @brief Number of qubit variables.
+    std::size_t num_qubits = 0;
+
+    /// @brief Number of angle variables.
+    std::size_t num_angles = 0;
+
+    /**
+     * @brief Compiles one rule.
+     *
+     * Every gate of a rule must act on all of its qubit variables (in any
+     * order), the right side must be shorter than the left, and right-side
+     * angles may only use variables bound on the left.
+     *
+     * @param text Rule text, e.g. "Rz(x) a; Rz(y) a => Rz(x + y) a"
+     * @throws std::invalid_argument on a syntax error or an invalid rule
+     */
+    [[nodiscard]] static PeepholeRule parse(std::string_view text);
+};
+
+/**
+ * @brief Recursive descent reader for one peephole rule.
+ *
+ * Used by PeepholeRule::parse().
+ */
+class PeepholeRuleReader {
+public:
+    using AngleTerm = PeepholeRule::AngleTerm;
+    using GateTerm = PeepholeRule::GateTerm;
+
+    explicit PeepholeRuleReader(std::string_view text) : text_(text) {}
+
+    PeepholeRule rule() {
+        skipSpace();
+        const std::size_t begin = pos_;
+        std::size_t end = text_.size();
+        while (end > begin && std::isspace(static_cast<unsigned char>(text_[end - 1]))) --end;
+        rule_.text = std::string(text_.substr(begin, end - begin));
+
+        rule_.pattern = sequence(true);
+        expect("=>");
+        rule_.replacement = sequence(false);
+        skipSpace();
+        if (pos_ < text_.size()) fail("unexpected '" + std::string(1, text_[pos_]) + "'");
+
+        if (rule_.pattern.empty()) fail("left side is empty");
+        if (rule_.replacement.size() >= rule_.pattern.size()) {
+            fail("right side must have fewer gates than the left");
+        }
+        for (auto& term : rule_.pattern) pad(term);
+        for (auto& term : rule_.replacement) pad(term);
+        return std::move(rule_);
+    }
+
+private:
+    std::string_view text_;
+    std::size_t pos_ = 0;
+    PeepholeRule rule_;
+    std::map<std::string, std::size_t> qubit_vars_;
+    std::map<std::string, std::size_t> angle_vars_;
+    bool qubits_declared_ = false;  // Only the first gate introduces qubits
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::invalid_argument("Peephole rule '" + std::string(text_) + "': " + message);
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool accept(std::string_view token) {
+        skipSpace();
+        if (text_.substr(pos_, token.size()) != token) return false;
+        pos_ += token.size();
+        return true;
+    }
+
+    void expect(std::string_view token) {
+        if (!accept(token)) fail("expected '" + std::string(token) + "'");
+    }
+
+    [[nodiscard]] bool atIdentifier() {
+        skipSpace();
+        return pos_ < text_.size() &&
+               (std::isalpha(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_');
+    }
+
+    std::string identifier() {
+        if (!atIdentifier()) fail("expected a name");
+        const std::size_t begin = pos_;
+        while (pos_ < text_.size() &&
+               (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_')) {
+            ++pos_;
+        }
+        return std::string(text_.substr(begin, pos_ - begin));
+    }
+
+    /// @brief Gates separated by ';' up to "=>" or the end of the rule.
+    std::vector<GateTerm> sequence(bool left) {
+        std::vector<GateTerm> gates;
+        while (atIdentifier()) {
+            gates.push_back(gate(left));
+            if (!accept(";")) break;
+        }
+        return gates;
+    }
+
+    GateTerm gate(bool left) {
+        GateTerm term;
+        const std::string name = identifier();
+        term.type = gateType(name);
+        if (ir::isNonUnitary(term.type)) fail(name + " cannot appear in a rule");
+
+        if (accept("(")) {
+            do {
+                term.angles.push_back(angle(left));
+            } while (accept(","));
+            expect(")");
+        }
+        if (term.angles.size() != ir::numParametersFor(term.type)) {
+            fail(name + " takes " + std::to_string(ir::numParametersFor(term.type)) +
+                 " angle(s)");
+        }
+
+        do {
+            const std::string var = identifier();
+            auto it = qubit_vars_.find(var);
+            if (it == qubit_vars_.end()) {
+                if (!left || qubits_declared_) fail("unknown qubit '" + var + "'");
+                it = qubit_vars_.emplace(var, qubit_vars_.size()).first;
+            }
+            if (std::find(term.qubits.begin(), term.qubits.end(), it->second) !=
+                term.qubits.end()) {
+                fail("qubit '" + var + "' repeated in " + name);
+            }
+            term.qubits.push_back(it->second);
+        } while (accept(","));
+
+        if (term.qubits.size() != ir::numQubitsFor(term.type)) {
+            fail(name + " acts on " + std::to_string(ir::numQubitsFor(term.type)) +
+                 " qubit(s)");
+        }
+        qubits_declared_ = true;
+        rule_.num_qubits = qubit_vars_.size();
+        if (term.qubits.size() != rule_.num_qubits) {
+            fail(name + " must act on every qubit of the rule");
+        }
+        return term;
+    }
+
+    ir::GateType gateType(const std::string& name) {
+        std::string lower;
+        for (char c : name) lower += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (lower == "cx") return ir::GateType::CNOT;
+        if (lower == "u") return ir::GateType::U3;
+        if (lower == "cp") return ir::GateType::CPhase;
+        for (int t = 0; t <= static_cast<int>(ir::GateType::Barrier); ++t) {
+            const auto type = static_cast<ir::GateType>(t);
+            std::string candidate(ir::gateTypeName(type));
+            for (char& c : candidate) {
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            if (candidate == lower) return type;
+        }
+        fail("unknown gate '" + name + "'");
+    }
+
+    /**
+     * @brief Reads one gate angle.
+     *
+     * On the left, a variable's first appearance as a bare angle binds
+     * it; other angles are checked against what the gates hold.
+     */
+    AngleTerm angle(bool left) {
+        skipSpace();
+        const std::size_t mark = pos_;
+        if (left && atIdentifier()) {
+            const std::string name = identifier();
+            skipSpace();
+            const bool bare = pos_ < text_.size() && (text_[pos_] == ',' || text_[pos_] == ')');
+            if (bare && name != "pi" && angle_vars_.count(name) == 0) {
+                AngleTerm term;
+                term.binds = angle_vars_.emplace(name, angle_vars_.size()).first->second;
+                term.coefficients.assign(*term.binds + 1, 0.0);
+                term.coefficients[*term.binds] = 1.0;
+                rule_.num_angles = angle_vars_.size();
+                return term;
+            }
+            pos_ = mark;
+        }
+        return sum();
+    }
+
+    AngleTerm sum() {
+        AngleTerm result = product();
+        while (true) {
+            if (accept("+")) {
+                result = combine(result, product(), 1.0);
+            } else if (accept("-")) {
+                result = combine(result, product(), -1.0);
+            } else {
+                return result;
+            }
+        }
+    }
+
+    AngleTerm product() {
+        AngleTerm result = unary();
+        while (true) {
+            if (accept("*")) {
+                AngleTerm rhs = unary();
+                if (isConstant(rhs)) {
+                    result = scale(result, rhs.constant);
+                } else if (isConstant(result)) {
+                    result = scale(rhs, result.constant);
+                } else {
+                    fail("angles must be affine in the variables");
+                }
+            } else if (accept("/")) {
+                AngleTerm rhs = unary();
+                if (!isConstant(rhs) || rhs.constant == 0.0) {
+                    fail("angles may only be divided by a nonzero constant");
+                }
+                result = scale(result, 1.0 / rhs.constant);
+            } else {
+                return result;
+            }
+        }
+    }
+
+    AngleTerm unary() {
+        if (accept("-")) return scale(unary(), -1.0);
+        if (accept("(")) {
+            AngleTerm inner = sum();
+            expect(")");
+            return inner;
+        }
+        AngleTerm term;
+        if (atIdentifier()) {
+            const std::string name = identifier();
+            if (name == "pi") {
+                term.constant = constants::PI;
+                return term;
+            }
+            auto it = angle_vars_.find(name);
+            if (it == angle_vars_.end()) fail("unknown angle '" + name + "'");
+            term.coefficients.assign(it->second + 1, 0.0);
+            term.coefficients[it->second] = 1.0;
+            return term;
+        }
+        char* end = nullptr;
+        const std::string rest(text_.substr(pos_));
+        term.constant = std::strtod(rest.c_str(), &end);
+        if (end == rest.c_str()) fail("expected an angle");
+        pos_ += static_cast<std::size_t>(end - rest.c_str());
+        return term;
+    }
+
+    [[nodiscard]] static bool isConstant(const AngleTerm& term) {
+        return std::all_of(term.coefficients.begin(), term.coefficients.end(),
+                           [](Angle c) { return c == 0.0; });
+    }
+
+    [[nodiscard]] static AngleTerm scale(AngleTerm term, Angle factor) {
+        term.constant *= factor;
+        for (Angle& c : term.coefficients) c *= factor;
+        return term;
+    }
+
+    [[nodiscard]] static AngleTerm combine(AngleTerm lhs, const AngleTerm& rhs, Angle sign) {
+        lhs.constant += sign * rhs.constant;
+        if (lhs.coefficients.size() < rhs.coefficients.size()) {
+            lhs.coefficients.resize(rhs.coefficients.size(), 0.0);
+        }
+        for (std::size_t i = 0; i < rhs.coefficients.size(); ++i) {
+            lhs.coefficients[i] += sign * rhs.coefficients[i];
+        }
+        return lhs;
+    }
+
+    /// @brief Sizes every coefficient list to the rule's variable count.
+    void pad(GateTerm& term) const {
+        for (AngleTerm& a : term.angles) a.coefficients.resize(rule_.num_angles, 0.0);
+    }
+};
+
+inline PeepholeRule PeepholeRule::parse(std::string_view text) {
+    return PeepholeRuleReader(text).rule();
+}
+
+/**
+ * @brief Applies declarative peephole rules in one traversal per sweep.
+ *
+ * Rules are compiled into a trie over gate types. At each node, in
+ * topological order, the pass follows the chain of gates that directly
+ * succeed one another on the same qubits down the trie, then tries the
+ * rules ending at the deepest trie node first (earlier rules win ties).
+ * Sweeps repeat until nothing changes; since every rule shrinks the
+ * circuit, this terminates. Gates with symbolic angles are never matched.
+ *
+ * Edits go through DAG::replaceGate() and DAG::removeNode(), so they are
+ * journaled.
+ *
+ * Example:
+ * @code
+ * PeepholePass pass;                   // DEFAULT_PEEPHOLE_RULES
+ * pass.addRule("S a; T a; T a => Z a");
+ * pass.run(dag);
+ * @endcode
+ */
+class PeepholePass : public Pass {
+public:
+    /// @brief Creates a pass with DEFAULT_PEEPHOLE_RULES.
+    PeepholePass() : PeepholePass(DEFAULT_PEEPHOLE_RULES) {}
+
+    /**
+     * @brief Creates a pass from rule text.
+     * @param rules One rule per line; blank lines and '#' comments are skipped
+     * @throws std::invalid_argument if a rule does not compile
+     */
+    explicit PeepholePass(std::string_view rules) {
+        addRules(rules);
+    }
+
+    [[nodiscard]] std::string name() const override {
+        return "PeepholePass";
+    }
+
+    /// @brief Registry entry (see PassRegistry.hpp).
+    [[nodiscard]] static PassInfo describe() {
+        return {"PeepholePass", "peephole",
+                "Applies declarative rewrite rules matched through a trie",
+                {{"rules", PassOption::Type::String, "(built-in rules)",
+                  "Rules to use instead of the defaults, one per line"}},
+                PassCost::Iterative,
+                [](const PassSpec& spec) -> std::unique_ptr<Pass> {
+                    auto rules = spec.option("rules");
+                    if (!rules) return std::make_unique<PeepholePass>();
+                    return std::make_unique<PeepholePass>(*rules);
+                }};
+    }
+
+    /**
+     * @brief Compiles one rule and adds it to the trie.
+     * @throws std::invalid_argument if the rule does not compile
+     */
+    PeepholePass& addRule(std::string_view rule) {
+        insert(PeepholeRule::parse(rule));
+        return *this;
+    }
+
+    /**
+     * @brief Compiles rules given one per line.
+     * @throws std::invalid_argument if a rule does not compile
+     */
+    PeepholePass& addRules(std::string_view rules) {
+        while (!rules.empty()) {
+            std::size_t end = rules.find('\n');
+            std::string_view line = rules.substr(0, end);
+            rules = end == std::string_view::npos ? std::string_view() : rules.substr(end + 1);
+            line = line.substr(0, line.find('#'));
+            if (line.find_first_not_of(" \t\r") != std::string_view::npos) {
+                addRule(line);
+            }
+        }
+        return *this;
+    }
+
+    /// @brief Returns the compiled rules, in the order they were added.
+    [[nodiscard]] const std::vector<PeepholeRule>& rules() const noexcept { return rules_; }
+
+    /// @brief Returns how often each rule fired during the last run(), by rule index.
+    [[nodiscard]] const std::vector<std::size_t>& ruleHits() const noexcept { return hits_; }
+
+    void run(ir::DAG& dag) override {
+        resetStatistics();
+        hits_.assign(rules_.size(), 0);
+
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            std::unordered_set<GateId> visited;
+            for (GateId id : dag.topologicalOrder()) {
+                if (!dag.hasNode(id) || visited.count(id) > 0) continue;
+                if (auto match = findMatch(dag, id)) {
+                    for (GateId g : match->chain) visited.insert(g);
+                    apply(dag, *match);
+                    changed = true;
+                }
+            }
+        }
+    }
+
+private:
+    /// @brief Trie node; rules lists rules whose pattern ends here.
+    struct TrieNode {
+        std::vector<std::pair<ir::GateType, std::size_t>> next;
+        std::vector<std::size_t> rules;
+    };
+
+    /// @brief A rule bound to a chain of nodes.
+    struct Match {
+        std::size_t rule = 0;
+        std::vector<GateId> chain;
+        std::vector<QubitIndex> qubits;
+        std::vector<Angle> angles;
+    };
+
+    std::vector<PeepholeRule> rules_;
+    std::vector<TrieNode> trie_{TrieNode{}};
+    std::vector<std::size_t> hits_;
+
+    void insert(PeepholeRule rule) {
+        std::size_t state = 0;
+        for (const auto& term : rule.pattern) {
+            std::optional<std::size_t> child = step(state, term.type);
+            if (!child) {
+                child = trie_.size();
+                trie_[state].next.emplace_back(term.type, *child);
+                trie_.emplace_back();
+            }
+            state = *child;
+        }
+        trie_[state].rules.push_back(rules_.size());
+        rules_.push_back(std::move(rule));
+        hits_.push_back(0);
+    }
+
+    [[nodiscard]] std::optional<std::size_t> step(std::size_t state, ir::GateType type) const {
+        for (const auto& [t, child] : trie_[state].next) {
+            if (t == type) return child;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Returns the gate directly after a node on all of its qubits and
+     *        on no others, if there is one.
+     */
+    [[nodiscard]] static std::optional<GateId> nextInChain(const ir::DAG& dag, GateId id) {
+        const ir::DAGNode& node = dag.node(id);
+        for (GateId succ : node.successors()) {
+            const ir::DAGNode& s = dag.node(succ);
+            const auto& preds = s.predecessors();
+            if (!std::all_of(preds.begin(), preds.end(), [id](GateId p) { return p == id; })) {
+                continue;
+            }
+            const auto& a = node.gate().qubits();
+            const auto& b = s.gate().qubits();
+            if (a.size() == b.size() && std::is_permutation(a.begin(), a.end(), b.begin())) {
+                return succ;
+            }
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<Match> findMatch(const ir::DAG& dag, GateId start) const {
+        std::vector<GateId> chain;
+        std::vector<std::size_t> states;
+        std::optional<GateId> id = start;
+        std::size_t state = 0;
+        while (id) {
+            auto child = step(state, dag.node(*id).gate().type());
+            if (!child) break;
+            state = *child;
+            chain.push_back(*id);
+            states.push_back(state);
+            id = nextInChain(dag, *id);
+        }
+
+        for (std::size_t len = chain.size(); len > 0; --len) {
+            for (std::size_t r : trie_[states[len - 1]].rules) {
+                Match match;
+                match.rule = r;
+                match.chain.assign(chain.begin(), chain.begin() + static_cast<std::ptrdiff_t>(len));
+                if (bind(dag, rules_[r], match)) return match;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// @brief Binds a rule's variables to the chain; false if they conflict.
+    [[nodiscard]] static bool bind(const ir::DAG& dag, const PeepholeRule& rule, Match& match) {
+        match.qubits.assign(rule.num_qubits, 0);
+        match.angles.assign(rule.num_angles, 0.0);
+        std::vector<bool> bound(rule.num_qubits, false);
+
+        for (std::size_t i = 0; i < rule.pattern.size(); ++i) {
+            const auto& term = rule.pattern[i];
+            const ir::Gate& gate = dag.node(match.chain[i]).gate();
+            if (gate.isSymbolic()) return false;
+
+            for (std::size_t k = 0; k < term.qubits.size(); ++k) {
+                const std::size_t var = term.qubits[k];
+                if (!bound[var]) {
+                    bound[var] = true;
+                    match.qubits[var] = gate.qubits()[k];
+                } else if (match.qubits[var] != gate.qubits()[k]) {
+                    return false;
+                }
+            }
+            for (std::size_t k = 0; k < term.angles.size(); ++k) {
+                const auto& a = term.angles[k];
+                if (a.binds) {
+                    match.angles[*a.binds] = gate.parameter(k);
+                } else if (std::abs(evaluate(a, match.angles) - gate.parameter(k)) >
+                           constants::TOLERANCE) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] static Angle evaluate(const PeepholeRule::AngleTerm& term,
+                                        const std::vector<Angle>& angles) {
+        Angle value = term.constant;
+        for (std::size_t i = 0; i < term.coefficients.size(); ++i) {
+            value += term.coefficients[i] * angles[i];
+        }
+        return value;
+    }
+
+    /// @brief Rewrites the first nodes of the chain and removes the rest.
+    void apply(ir::DAG& dag, const Match& match) {
+        const PeepholeRule& rule = rules_[match.rule];
+        for (std::size_t i = 0; i < rule.replacement.size(); ++i) {
+            const auto& term = rule.replacement[i];
+            std::vector<QubitIndex> qubits;
+            for (std::size_t var : term.qubits) qubits.push_back(match.qubits[var]);
+            std::vector<Angle> angles;
+            for (const auto& a : term.angles) angles.push_back(evaluate(a, match.angles));
+            dag.replaceGate(match.chain[i],
+                            ir::Gate::fromParameters(term.type, std::move(qubits), angles));
+        }
+        for (std::size_t i = match.chain.size(); i > rule.replacement.size(); --i) {
+            dag.removeNode(match.chain[i - 1]);
+        }
+        gates_removed_ += match.chain.size() - rule.replacement.size();
+        ++hits_[match.rule];
+    }
+};
+
+/// @brief Registers PeepholePass as "peephole".
+inline const bool PEEPHOLE_PASS_REGISTERED = registerPass<PeepholePass>();
+
+}  // namespace qopt::passes
@@ -0,0 +1,492 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file PipelineSpec.hpp
+ * @brief Textual and JSON pipeline descriptions parsed into a PassManager
+ *
+ * A pipeline spec names passes in order, with options, plus pipeline
+ * directives after a semicolon:
+ *
+ * @code
+ * cancel, rotmerge, idelim(tolerance=1e-6); fixpoint(max=4)
+ * @endcode
+ *
+ * The same pipeline as JSON:
+ *
+ * @code
+ * {"passes": ["cancel", "rotmerge", {"pass": "idelim", "tolerance": 1e-6}],
+ *  "fixpoint": {"max": 4}}
+ * @endcode
+ *
+ * Pass names are the short or class names of PassRegistry entries, and
+ * options are checked against each pass's schema. The built-in passes:
+ *
+ * | Name     | Pass                    | Options            |
+ * |----------|-------------------------|--------------------|
+ * | cancel   | CancellationPass        |                    |
+ * | commute  | CommutationPass         |                    |
+ * | rotmerge | RotationMergePass       |                    |
+ * | idelim   | IdentityEliminationPass | tolerance          |
+ * | fused    | FusedPeepholePass       | tolerance          |
+ * | fuse1q   | SingleQubitFusionPass   | tolerance          |
+ * | peephole | PeepholePass            | rules (one string) |
+ * | dce      | DeadCodeEliminationPass |                    |
+ *
+ * Directives: `fixpoint(max=N)` repeats the passes until nothing changes,
+ * at most N times (default FIXPOINT_ITERATIONS).
+ *
+ * @see PassManager.hpp for running the pipeline
+ * @see PassRegistry.hpp for the pass table
+ */
+
+#pragma once
+
+#include "AllPasses.hpp"
+#include "OptimizationLevel.hpp"
+#include "PassManager.hpp"
+#include "PassRegistry.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace qopt::passes {
+
+/**
+ * @brief A pass pipeline described as data.
+ *
+ * Example:
+ * @code
+ * PipelineSpec spec = PipelineSpec::parse("fused, fuse1q; fixpoint(max=4)");
+ * PassManager pm = spec.build();
+ * pm.run(circuit);
+ * @endcode
+ */
+struct PipelineSpec {
+    /// Passes in pipeline order.
+    std::vector<PassSpec> passes;
+
+    /// Pipeline runs per PassManager::run() (fixpoint(max=N); 1 without it).
+    std::size_t max_iterations = 1;
+
+    /**
+     * @brief Parses the textual form.
+     * @param text e.g. "cancel, idelim(tolerance=1e-6); fixpoint(max=4)"
+     * @return The spec, with pass names made canonical
+     * @throws std::invalid_argument on syntax errors, unknown passes or bad options
+     */
+    [[nodiscard]] static PipelineSpec parse(std::string_view text);
+
+    /**
+     * @brief Parses the JSON form.
+     * @param json An object with "passes" and optionally "fixpoint"
+     * @return The spec, with pass names made canonical
+     * @throws std::invalid_argument on syntax errors, unknown passes or bad options
+     */
+    [[nodiscard]] static PipelineSpec parseJson(std::string_view json);
+
+    /**
+     * @brief Parses either form: JSON if the text starts with '{'.
+     * @param text Spec text, e.g. the contents of a config file
+     * @return The spec
+     * @throws std::invalid_argument on any error
+     */
+    [[nodiscard]] static PipelineSpec parseConfig(std::string_view text) {
+        const auto first = text.find_first_not_of(" \t\r\n");
+        if (first != std::string_view::npos && text[first] == '{') {
+            return parseJson(text);
+        }
+        return parse(text);
+    }
+
+    /**
+     * @brief Builds a PassManager running this pipeline.
+     * @return The configured pipeline
+     */
+    [[nodiscard]] PassManager build() const {
+        PassManager pm;
+        const PassRegistry& registry = PassRegistry::instance();
+        for (const auto& pass : passes) {
+            pm.addPass(registry.create(pass));
+        }
+        pm.setMaxIterations(max_iterations);
+        return pm;
+    }
+
+    /**
+     * @brief Returns the textual form; parse() of it gives an equal spec.
+     * @return e.g. "cancel,idelim(tolerance=1e-6);fixpoint(max=4)"
+     */
+    [[nodiscard]] std::string toString() const {
+        std::string out;
+        for (std::size_t i = 0; i < passes.size(); ++i) {
+            if (i > 0) out += ",";
+            out += passes[i].name;
+            if (!passes[i].options.empty()) {
+                out += "(";
+                for (std::size_t k = 0; k < passes[i].options.size(); ++k) {
+                    if (k > 0) out += ",";
+                    out += passes[i].options[k].first + "=" + quote(passes[i].options[k].second);
+                }
+                out += ")";
+            }
+        }
+        if (max_iterations > 1) {
+            out += ";fixpoint(max=" + std::to_string(max_iterations) + ")";
+        }
+        return out;
+    }
+
+    friend bool operator==(const PipelineSpec& a, const PipelineSpec& b) {
+        return a.passes == b.passes && a.max_iterations == b.max_iterations;
+    }
+    friend bool operator!=(const PipelineSpec& a, const PipelineSpec& b) { return !(a == b); }
+
+    /**
+     * @brief Canonicalizes pass names and checks every pass can be built.
+     * @throws std::invalid_argument for unknown passes or bad options
+     */
+    void validate() {
+        const PassRegistry& registry = PassRegistry::instance();
+        for (auto& pass : passes) {
+            (void)registry.create(pass);
+            pass.name = registry.at(pass.name).short_name;
+        }
+    }
+
+private:
+    /// @brief Quotes a value unless it is a bare word or number.
+    [[nodiscard]] static std::string quote(const std::string& value) {
+        const bool bare = !value.empty() && std::all_of(value.begin(), value.end(), [](char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.' ||
+                   c == '+' || c == '-';
+        });
+        if (bare) return value;
+        std::string out = "\"";
+        for (char c : value) {
+            if (c == '\n') {
+                out += "\\n";
+                continue;
+            }
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out + "\"";
+    }
+};
+
+/**
+ * @brief Recursive descent reader for the textual pipeline form.
+ *
+ * Used by PipelineSpec::parse().
+ */
+class PipelineSpecReader {
+public:
+    explicit PipelineSpecReader(std::string_view text) : text_(text) {}
+
+    PipelineSpec spec() {
+        PipelineSpec spec;
+        skipSpace();
+        if (pos_ < text_.size() && text_[pos_] != ';') {
+            do {
+                spec.passes.push_back(item());
+            } while (accept(','));
+        }
+        while (accept(';')) {
+            directive(spec, item());
+        }
+        skipSpace();
+        if (pos_ < text_.size()) fail("unexpected '" + std::string(1, text_[pos_]) + "'");
+        return spec;
+    }
+
+private:
+    std::string_view text_;
+    std::size_t pos_ = 0;
+    bool fixpoint_seen_ = false;
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::invalid_argument("Pipeline spec '" + std::string(text_) + "': " + message +
+                                    " at column " + std::to_string(pos_ + 1));
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool accept(char c) {
+        skipSpace();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!accept(c)) fail(std::string("expected '") + c + "'");
+    }
+
+    /// @brief Letters, digits and '_', '.', '+', '-': names and bare values.
+    std::string word() {
+        skipSpace();
+        const std::size_t begin = pos_;
+        while (pos_ < text_.size()) {
+            const char c = text_[pos_];
+            if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '.' &&
+                c != '+' && c != '-') {
+                break;
+            }
+            ++pos_;
+        }
+        return std::string(text_.substr(begin, pos_ - begin));
+    }
+
+    std::string value() {
+        skipSpace();
+        if (pos_ < text_.size() && text_[pos_] == '"') {
+            ++pos_;
+            std::string out;
+            while (pos_ < text_.size() && text_[pos_] != '"') {
+                char c = text_[pos_++];
+                if (c == '\\' && pos_ < text_.size()) {
+                    c = text_[pos_++];
+                    if (c == 'n') c = '\n';
+                }
+                out += c;
+            }
+            if (pos_ == text_.size()) fail("unterminated string");
+            ++pos_;
+            return out;
+        }
+        std::string out = word();
+        if (out.empty()) fail("expected a value");
+        return out;
+    }
+
+    /// @brief name [ '(' key '=' value { ',' key '=' value } ')' ]
+    PassSpec item() {
+        PassSpec pass;
+        pass.name = word();
+        if (pass.name.empty()) fail("expected a name");
+        if (accept('(')) {
+            if (!accept(')')) {
+                do {
+                    std::string key = word();
+                    if (key.empty()) fail("expected an option name");
+                    expect('=');
+                    pass.options.emplace_back(std::move(key), value());
+                } while (accept(','));
+                expect(')');
+            }
+        }
+        return pass;
+    }
+
+    void directive(PipelineSpec& spec, const PassSpec& item) {
+        if (item.name != "fixpoint") fail("unknown directive '" + item.name + "'");
+        if (fixpoint_seen_) fail("fixpoint given twice");
+        fixpoint_seen_ = true;
+        if (item.options.size() > 1 ||
+            (item.options.size() == 1 && item.options[0].first != "max")) {
+            fail("fixpoint takes only max=N");
+        }
+        spec.max_iterations = FIXPOINT_ITERATIONS;
+        if (auto max = item.option("max")) {
+            spec.max_iterations = count(*max);
+        }
+    }
+
+    std::size_t count(const std::string& text) const {
+        if (text.empty() || text.size() > 9 ||
+            !std::all_of(text.begin(), text.end(),
+                         [](char c) { return std::isdigit(static_cast<unsigned char>(c)); }) ||
+            std::stoul(text) == 0) {
+            fail("fixpoint max must be a positive integer, got '" + text + "'");
+        }
+        return std::stoul(text);
+    }
+};
+
+/**
+ * @brief Reader for the JSON pipeline form.
+ *
+ * Accepts general JSON syntax but only the pipeline schema: an object
+ * with "passes" (an array of names or {"pass": name, option: value...}
+ * objects) and optionally "fixpoint" ({"max": N}, true or false).
+ * Option values may be strings, numbers or booleans.
+ *
+ * Used by PipelineSpec::parseJson().
+ */
+class PipelineJsonReader {
+public:
+    explicit PipelineJsonReader(std::string_view text) : text_(text) {}
+
+    PipelineSpec spec() {
+        PipelineSpec spec;
+        bool have_passes = false;
+        object([&](const std::string& key) {
+            if (key == "passes") {
+                have_passes = true;
+                array([&] { spec.passes.push_back(pass()); });
+            } else if (key == "fixpoint") {
+                spec.max_iterations = fixpoint();
+            } else {
+                fail("unknown key \"" + key + "\"");
+            }
+        });
+        skipSpace();
+        if (pos_ < text_.size()) fail("trailing characters");
+        if (!have_passes) fail("missing \"passes\"");
+        return spec;
+    }
+
+private:
+    std::string_view text_;
+    std::size_t pos_ = 0;
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::invalid_argument("Pipeline JSON: " + message + " at offset " +
+                                    std::to_string(pos_));
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    [[nodiscard]] char peek() {
+        skipSpace();
+        return pos_ < text_.size() ? text_[pos_] : '\0';
+    }
+
+    bool accept(char c) {
+        if (peek() != c) return false;
+        ++pos_;
+        return true;
+    }
+
+    void expect(char c) {
+        if (!accept(c)) fail(std::string("expected '") + c + "'");
+    }
+
+    template <typename OnMember>
+    void object(OnMember on_member) {
+        expect('{');
+        if (accept('}')) return;
+        do {
+            std::string key = string();
+            expect(':');
+            on_member(key);
+        } while (accept(','));
+        expect('}');
+    }
+
+    template <typename OnItem>
+    void array(OnItem on_item) {
+        expect('[');
+        if (accept(']')) return;
+        do {
+            on_item();
+        } while (accept(','));
+        expect(']');
+    }
+
+    std::string string() {
+        expect('"');
+        std::string out;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c == '\\') {
+                if (pos_ == text_.size()) break;
+                switch (text_[pos_++]) {
+                    case '"':  c = '"'; break;
+                    case '\\': c = '\\'; break;
+                    case '/':  c = '/'; break;
+                    case 'n':  c = '\n'; break;
+                    case 't':  c = '\t'; break;
+                    case 'r':  c = '\r'; break;
+                    default:   fail("unsupported escape");
+                }
+            }
+            out += c;
+        }
+        if (pos_ == text_.size()) fail("unterminated string");
+        ++pos_;
+        return out;
+    }
+
+    /// @brief A string, number or boolean, as text.
+    std::string scalar() {
+        const char c = peek();
+        if (c == '"') return string();
+        const std::size_t begin = pos_;
+        while (pos_ < text_.size() &&
+               (std::isalnum(static_cast<unsigned char>(text_[pos_])) ||
+                text_[pos_] == '.' || text_[pos_] == '+' || text_[pos_] == '-')) {
+            ++pos_;
+        }
+        std::string out(text_.substr(begin, pos_ - begin));
+        if (out.empty() || out == "null") fail("expected a string, number or boolean");
+        return out;
+    }
+
+    PassSpec pass() {
+        if (peek() == '"') return PassSpec{string(), {}};
+        PassSpec spec;
+        object([&](const std::string& key) {
+            if (key == "pass") {
+                spec.name = string();
+            } else {
+                spec.options.emplace_back(key, scalar());
+            }
+        });
+        if (spec.name.empty()) fail("pass object without \"pass\"");
+        return spec;
+    }
+
+    std::size_t fixpoint() {
+        if (peek() != '{') {
+            const std::string flag = scalar();
+            if (flag == "true") return FIXPOINT_ITERATIONS;
+            if (flag == "false") return 1;
+            fail("fixpoint must be an object or a boolean");
+        }
+        std::size_t max = FIXPOINT_ITERATIONS;
+        object([&](const std::string& key) {
+            if (key != "max") fail("unknown fixpoint key \"" + key + "\"");
+            const std::string text = scalar();
+            if (text.empty() || text.size() > 9 ||
+                !std::all_of(text.begin(), text.end(),
+                             [](char c) { return std::isdigit(static_cast<unsigned char>(c)); }) ||
+                std::stoul(text) == 0) {
+                fail("fixpoint max must be a positive integer");
+            }
+            max = std::stoul(text);
+        });
+        return max;
+    }
+};
+
+inline PipelineSpec PipelineSpec::parse(std::string_view text) {
+    PipelineSpec spec = PipelineSpecReader(text).spec();
+    spec.validate();
+    return spec;
+}
+
+inline PipelineSpec PipelineSpec::parseJson(std::string_view json) {
+    PipelineSpec spec = PipelineJsonReader(json).spec();
+    spec.validate();
+    return spec;
+}
+
+}  // namespace qopt::passes
@@ -9,8 +9,11 @@
  * - Rz(a) · Rz(b) = Rz(a + b)
  * - Rx(a) · Rx(b) = Rx(a + b)
  * - Ry(a) · Ry(b) = Ry(a + b)
+ * - CPhase(a) · CPhase(b) = CPhase(a + b), and likewise for RZZ
  *
- * Angles are normalized to [-π, π] after merging.
+ * Angles are normalized to [-π, π] after merging. Symbolic angles are
+ * added as affine expressions in the DAG's parameter table; a sum whose
+ * symbols cancel becomes a concrete angle again.
  *
  * @see Pass.hpp for the base pass interface
  * @see IdentityEliminationPass.hpp for removing Rz(0) etc.
@@ -19,10 +22,13 @@
 #pragma once
 
 #include "Pass.hpp"
+#include "PassRegistry.hpp"
 #include "../ir/DAG.hpp"
 #include "../ir/Gate.hpp"
+#include "../ir/Parameter.hpp"
 #include "../ir/Types.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <unordered_set>
 #include <vector>
@@ -32,8 +38,8 @@ namespace qopt::passes {
 /**
  * @brief Optimization pass that merges adjacent rotation gates.
  *
- * When two rotation gates of the same type (Rx, Ry, or Rz) are adjacent
- * on the same qubit, they are merged into a single rotation with the
+ * When two rotation gates of the same type (Rx, Ry, Rz, CPhase or RZZ)
+ * are adjacent on the same qubits, they are merged into a single rotation with the
  * sum of their angles.
  *
  * Example:
@@ -53,6 +59,17 @@ public:
         return "RotationMergePass";
     }
 
+    /// @brief Registry entry (see PassRegistry.hpp).
+    [[nodiscard]] static PassInfo describe() {
+        return {"RotationMergePass", "rotmerge",
+                "Merges adjacent rotations about the same axis",
+                {},
+                PassCost::Iterative,
+                [](const PassSpec&) -> std::unique_ptr<Pass> {
+                    return std::make_unique<RotationMergePass>();
+                }};
+    }
+
     void run(ir::DAG& dag) override {
         resetStatistics();
 
@@ -85,13 +102,7 @@ public:
                     // Check if mergeable
                     if (canMerge(dag, id, succ_id)) {
                         // Merge: update first gate's angle, remove second
-                        Angle new_angle = normalizeAngle(
-                            gate.parameter().value() +
-                            succ_gate.parameter().value());
-
-                        // Create new gate with merged angle
-                        ir::Gate merged(gate.type(), gate.qubits(), new_angle);
-                        node.gate() = merged;
+                        dag.replaceGate(id, merge(dag.parameterTable(), gate, succ_gate));
 
                         // Mark successor for removal
                         to_remove.insert(succ_id);
@@ -112,25 +123,48 @@ public:
         }
     }
 
-private:
     /**
-     * @brief Checks if a gate type is a rotation gate.
+     * @brief Merges two rotations of one type on the same qubits.
+     *
+     * Shared with FusedPeepholePass.
+     *
+     * @param table The DAG's parameter table (grows if either angle is symbolic)
+     * @param g1 First rotation (its qubits are kept)
+     * @param g2 Second rotation
+     * @return Rotation by the normalized sum of the angles
+     */
+    [[nodiscard]] static ir::Gate merge(ir::ParameterTable& table,
+                                        const ir::Gate& g1,
+                                        const ir::Gate& g2) {
+        if (g1.isSymbolic() || g2.isSymbolic()) {
+            return mergeSymbolic(table, g1, g2);
+        }
+        return ir::Gate(g1.type(), g1.qubits(),
+                        normalizeAngle(g1.parameter().value() + g2.parameter().value()));
+    }
+
+    /**
+     * @brief Checks if a gate type is a single-angle rotation gate.
      * @param type The gate type
-     * @return true for Rx, Ry, Rz
+     * @return true for Rx, Ry, Rz, CPhase and RZZ
      */
     [[nodiscard]] static bool isRotationGate(ir::GateType type) noexcept {
         return type == ir::GateType::Rx ||
                type == ir::GateType::Ry ||
-               type == ir::GateType::Rz;
+               type == ir::GateType::Rz ||
+               type == ir::GateType::CPhase ||
+               type == ir::GateType::RZZ;
     }
 
+private:
     /**
      * @brief Checks if two rotation gates can be merged.
      *
      * Gates can be merged if:
-     * 1. They are the same rotation type (Rx, Ry, or Rz)
-     * 2. They operate on the same qubit
-     * 3. They are adjacent (direct edge, same qubit)
+     * 1. They are the same rotation type (Rx, Ry, Rz, CPhase or RZZ)
+     * 2. They operate on the same qubits; CPhase and RZZ are symmetric,
+     *    so their operands may be listed in either order
+     * 3. They are adjacent on every one of those qubits
      *
      * @param dag The DAG
      * @param id1 First gate ID
@@ -148,13 +182,50 @@ private:
         if (g1.type() != g2.type()) return false;
         if (!isRotationGate(g1.type())) return false;
 
-        // Same qubit
-        if (g1.qubits() != g2.qubits()) return false;
+        // Same qubits (both rotation types on two qubits are symmetric)
+        if (g1.qubits() != g2.qubits() &&
+            !std::is_permutation(g1.qubits().begin(), g1.qubits().end(),
+                                 g2.qubits().begin(), g2.qubits().end())) {
+            return false;
+        }
 
         // Direct edge (adjacent)
         if (!dag.hasEdge(id1, id2)) return false;
 
-        return true;
+        // No other gate in between on the second wire of a two-qubit rotation
+        const auto& preds = dag.node(id2).predecessors();
+        return std::all_of(preds.begin(), preds.end(),
+                           [id1](GateId p) { return p == id1; });
+    }
+
+    /**
+     * @brief Merges two rotations of which at least one is symbolic.
+     *
+     * The angle sum is appended to the parameter table; if its symbols
+     * cancel, the merged gate gets the (normalized) constant instead.
+     *
+     * @param table The DAG's parameter table
+     * @param g1 First rotation (its qubits are kept)
+     * @param g2 Second rotation
+     * @return Merged rotation
+     */
+    [[nodiscard]] static ir::Gate mergeSymbolic(ir::ParameterTable& table,
+                                                const ir::Gate& g1,
+                                                const ir::Gate& g2) {
+        ir::AffineExpression sum = angleOf(table, g1) + angleOf(table, g2);
+        if (sum.isConstant()) {
+            return ir::Gate(g1.type(), g1.qubits(), normalizeAngle(sum.constant()));
+        }
+        return ir::Gate(g1.type(), g1.qubits(), 0.0).withExpression(0, table.add(sum));
+    }
+
+    /// @brief Returns a rotation's angle as an affine expression.
+    [[nodiscard]] static ir::AffineExpression angleOf(const ir::ParameterTable& table,
+                                                      const ir::Gate& gate) {
+        if (auto expr = gate.expression(0)) {
+            return table.expression(*expr);
+        }
+        return ir::AffineExpression(gate.parameter().value());
     }
 
     /**
@@ -179,4 +250,7 @@ private:
     }
 };
 
+/// @brief Registers RotationMergePass as "rotmerge".
+inline const bool ROTATION_MERGE_PASS_REGISTERED = registerPass<RotationMergePass>();
+
 }  // namespace qopt::passes
@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file SingleQubitFusionPass.hpp
+ * @brief Optimization pass to fuse runs of single-qubit gates
+ *
+ * Multiplies every run of two or more adjacent single-qubit gates on a
+ * wire into one 2x2 unitary and re-emits it as a single gate:
+ * - nothing, if the product is the identity
+ * - Rz(λ), if the product is diagonal
+ * - U3(θ, φ, λ) otherwise
+ *
+ * Equality is up to global phase.
+ *
+ * @see Pass.hpp for the base pass interface
+ * @see RotationMergePass.hpp for merging rotations of one axis
+ */
+
+#pragma once
+
+#include "Pass.hpp"
+#include "PassRegistry.hpp"
+#include "../ir/DAG.hpp"
+#include "../ir/Gate.hpp"
+#include "../ir/Types.hpp"
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace qopt::passes {
+
+/**
+ * @brief Optimization pass that fuses adjacent single-qubit gates into one.
+ *
+ * Runs may mix any single-qubit unitaries (H, X, Y, Z, S, Sdg, T, Tdg,
+ * SX, Rx, Ry, Rz, U3). Gates with symbolic angles end a run, as do
+ * multi-qubit gates, measurements, resets and barriers. A lone gate is
+ * left as it is, so running the pass twice changes nothing.
+ *
+ * Example:
+ * @code
+ * // Before: H q[0]; T q[0]; H q[0];
+ * // After:  U3(π/4, -π/2, π/2) q[0];
+ *
+ * SingleQubitFusionPass pass;
+ * pass.run(dag);
+ * @endcode
+ */
+class SingleQubitFusionPass : public Pass {
+public:
+    /// @brief A 2x2 complex matrix in row-major order.
+    using Matrix = std::array<std::complex<double>, 4>;
+
+    /**
+     * @brief Constructs the pass with specified tolerance.
+     * @param tolerance Matrix entries and angles smaller than this are zero
+     */
+    explicit SingleQubitFusionPass(double tolerance = constants::TOLERANCE)
+        : tolerance_(tolerance)
+    {}
+
+    [[nodiscard]] std::string name() const override {
+        return "SingleQubitFusionPass";
+    }
+
+    /// @brief Registry entry (see PassRegistry.hpp).
+    [[nodiscard]] static PassInfo describe() {
+        return {"SingleQubitFusionPass", "fuse1q",
+                "Fuses runs of single-qubit gates into one U3 or Rz",
+                {{"tolerance", PassOption::Type::Number, numberText(constants::TOLERANCE),
+                  "Matrix entries and angles smaller than this count as zero"}},
+                PassCost::Linear,
+                [](const PassSpec& spec) -> std::unique_ptr<Pass> {
+                    return std::make_unique<SingleQubitFusionPass>(
+                        spec.number("tolerance", constants::TOLERANCE));
+                }};
+    }
+
+    void run(ir::DAG& dag) override {
+        resetStatistics();
+
+        for (GateId id : dag.topologicalOrder()) {
+            // Later members of a run are removed along with it
+            if (!dag.hasNode(id)) continue;
+            if (!isFusable(dag.node(id).gate())) continue;
+
+            std::vector<GateId> fused{id};
+            while (true) {
+                const auto& succs = dag.node(fused.back()).successors();
+                if (succs.size() != 1) break;
+                const GateId next = *succs.begin();
+                if (!isFusable(dag.node(next).gate())) break;
+                fused.push_back(next);
+            }
+            if (fused.size() < 2) continue;
+
+            Matrix product = identity();
+            for (GateId g : fused) {
+                product = multiply(matrixOf(dag.node(g).gate()), product);
+            }
+
+            const QubitIndex qubit = dag.node(id).gate().qubits()[0];
+            std::optional<ir::Gate> replacement = synthesize(product, qubit, tolerance_);
+            for (std::size_t i = replacement ? 1 : 0; i < fused.size(); ++i) {
+                dag.removeNode(fused[i]);
+            }
+            if (replacement) {
+                dag.replaceGate(id, *replacement);
+                gates_removed_ += fused.size() - 1;
+            } else {
+                gates_removed_ += fused.size();
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the unitary of a single-qubit gate.
+     * @param gate A single-qubit unitary gate with concrete angles
+     * @return Its matrix
+     * @throws std::invalid_argument for any other gate
+     */
+    [[nodiscard]] static Matrix matrixOf(const ir::Gate& gate) {
+        using namespace std::complex_literals;
+        const double r = 1.0 / std::sqrt(2.0);
+
+        auto angle = [&gate](std::size_t i) { return gate.parameter(i); };
+        switch (gate.type()) {
+            case ir::GateType::H:   return {r, r, r, -r};
+            case ir::GateType::X:   return {0.0, 1.0, 1.0, 0.0};
+            case ir::GateType::Y:   return {0.0, -1i, 1i, 0.0};
+            case ir::GateType::Z:   return {1.0, 0.0, 0.0, -1.0};
+            case ir::GateType::S:   return {1.0, 0.0, 0.0, 1i};
+            case ir::GateType::Sdg: return {1.0, 0.0, 0.0, -1i};
+            case ir::GateType::T:   return {1.0, 0.0, 0.0, std::polar(1.0, constants::PI_4)};
+            case ir::GateType::Tdg: return {1.0, 0.0, 0.0, std::polar(1.0, -constants::PI_4)};
+            case ir::GateType::SX:
+                return {0.5 + 0.5i, 0.5 - 0.5i, 0.5 - 0.5i, 0.5 + 0.5i};
+            case ir::GateType::Rx: {
+                const double c = std::cos(angle(0) / 2);
+                const double s = std::sin(angle(0) / 2);
+                return {c, -1i * s, -1i * s, c};
+            }
+            case ir::GateType::Ry: {
+                const double c = std::cos(angle(0) / 2);
+                const double s = std::sin(angle(0) / 2);
+                return {c, -s, s, c};
+            }
+            case ir::GateType::Rz:
+                return {std::polar(1.0, -angle(0) / 2), 0.0, 0.0, std::polar(1.0, angle(0) / 2)};
+            case ir::GateType::U3: {
+                const double c = std::cos(angle(0) / 2);
+                const double s = std::sin(angle(0) / 2);
+                return {c,
+                        -std::polar(s, angle(2)),
+                        std::polar(s, angle(1)),
+                        std::polar(c, angle(1) + angle(2))};
+            }
+            default:
+                throw std::invalid_argument(
+                    "No single-qubit matrix for " + gate.toString());
+        }
+    }
+
+    /**
+     * @brief Converts a single-qubit unitary back into at most one gate.
+     * @param u The unitary
+     * @param qubit Qubit of the resulting gate
+     * @param tolerance Entries and angles smaller than this are zero
+     * @return Rz for diagonal matrices, U3 otherwise; nullopt for the identity
+     */
+    [[nodiscard]] static std::optional<ir::Gate> synthesize(
+        const Matrix& u, QubitIndex qubit, double tolerance = constants::TOLERANCE) {
+        if (std::abs(u[2]) < tolerance) {
+            const Angle lambda = normalizeAngle(std::arg(u[3]) - std::arg(u[0]));
+            if (std::abs(lambda) < tolerance) return std::nullopt;
+            return ir::Gate::rz(qubit, lambda);
+        }
+        const Angle theta = 2.0 * std::atan2(std::abs(u[2]), std::abs(u[0]));
+        if (std::abs(u[0]) < tolerance) {
+            // θ = π: only φ - λ is determined
+            return ir::Gate::u3(qubit, theta,
+                                normalizeAngle(std::arg(u[2]) - std::arg(-u[1])), 0.0);
+        }
+        const Angle phase = std::arg(u[0]);
+        return ir::Gate::u3(qubit, theta,
+                            normalizeAngle(std::arg(u[2]) - phase),
+                            normalizeAngle(std::arg(-u[1]) - phase));
+    }
+
+private:
+    double tolerance_;
+
+    /// @brief Single-qubit unitaries with concrete angles.
+    [[nodiscard]] static bool isFusable(const ir::Gate& gate) noexcept {
+        return gate.numQubits() == 1 &&
+               !ir::isNonUnitary(gate.type()) &&
+               !gate.isSymbolic();
+    }
+
+    [[nodiscard]] static Matrix identity() noexcept {
+        return {1.0, 0.0, 0.0, 1.0};
+    }
+
+    /// @brief Returns a · b.
+    [[nodiscard]] static Matrix multiply(const Matrix& a, const Matrix& b) noexcept {
+        return {a[0] * b[0] + a[1] * b[2], a[0] * b[1] + a[1] * b[3],
+                a[2] * b[0] + a[3] * b[2], a[2] * b[1] + a[3] * b[3]};
+    }
+
+    /// @brief Normalizes an angle to the range [-π, π].
+    [[nodiscard]] static Angle normalizeAngle(Angle angle) noexcept {
+        return std::remainder(angle, 2.0 * constants::PI);
+    }
+};
+
+/// @brief Registers SingleQubitFusionPass as "fuse1q".
+inline const bool SINGLE_QUBIT_FUSION_PASS_REGISTERED = registerPass<SingleQubitFusionPass>();
+
+}  // namespace qopt::passes
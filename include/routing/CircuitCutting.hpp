@@ -0,0 +1,447 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file CircuitCutting.hpp
+ * @brief Splitting circuits into qubit-independent parts compiled in parallel
+ *
+ * Two qubits depend on each other if a multi-qubit gate acts on both, or
+ * if measurements of both write the same classical bit. The connected
+ * components of that relation never interact, so each can be optimized
+ * and routed on its own:
+ *
+ * 1. QubitComponents finds the components with union-find
+ * 2. cutCircuit() extracts each component as a subcircuit on local qubits
+ * 3. compileCut() compiles the subcircuits concurrently, each on its own
+ *    connected region of the device, and merges the results
+ *
+ * @see Compiler.hpp for compiling a single circuit
+ * @see TopologyPartition.hpp for the fixed-size regions HierarchicalRouter uses
+ */
+
+#pragma once
+
+#include "../ir/Circuit.hpp"
+#include "../ir/Gate.hpp"
+#include "../ir/Parameter.hpp"
+#include "../ir/Types.hpp"
+#include "../passes/OptimizationLevel.hpp"
+#include "../passes/PassManager.hpp"
+#include "Compiler.hpp"
+#include "Router.hpp"
+#include "Topology.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace qopt::routing {
+
+/**
+ * @brief Connected components of a circuit's qubit-interaction graph.
+ *
+ * Components are numbered by their smallest qubit, and list their qubits
+ * in ascending order. Qubits without gates form components of their own.
+ * Barriers do not join qubits.
+ *
+ * Example:
+ * @code
+ * auto components = QubitComponents::build(circuit);
+ * for (std::size_t c = 0; c < components.numComponents(); ++c) {
+ *     // components.component(c) never interacts with the other components
+ * }
+ * @endcode
+ */
+class QubitComponents {
+public:
+    /**
+     * @brief Finds the components of a circuit.
+     * @param circuit The circuit
+     * @return Its components
+     */
+    [[nodiscard]] static QubitComponents build(const ir::Circuit& circuit) {
+        const std::size_t n = circuit.numQubits();
+        std::vector<std::size_t> parent(n);
+        std::vector<std::size_t> size(n, 1);
+        for (std::size_t q = 0; q < n; ++q) parent[q] = q;
+
+        auto find = [&parent](std::size_t q) {
+            while (parent[q] != q) {
+                parent[q] = parent[parent[q]];  // Path halving
+                q = parent[q];
+            }
+            return q;
+        };
+        auto unite = [&](std::size_t a, std::size_t b) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (size[a] < size[b]) std::swap(a, b);
+            parent[b] = a;
+            size[a] += size[b];
+        };
+
+        std::vector<QubitIndex> clbit_writer(circuit.numClbits(), INVALID_QUBIT);
+        for (const auto& gate : circuit) {
+            if (gate.type() == ir::GateType::Barrier) continue;
+            const auto& qubits = gate.qubits();
+            for (std::size_t i = 1; i < qubits.size(); ++i) unite(qubits[0], qubits[i]);
+
+            if (auto clbit = gate.clbit()) {
+                if (clbit_writer[*clbit] == INVALID_QUBIT) {
+                    clbit_writer[*clbit] = qubits[0];
+                } else {
+                    unite(clbit_writer[*clbit], qubits[0]);
+                }
+            }
+        }
+
+        QubitComponents result;
+        result.component_of_.assign(n, NO_COMPONENT);
+        std::vector<std::size_t> component_of_root(n, NO_COMPONENT);
+        for (std::size_t q = 0; q < n; ++q) {
+            std::size_t& c = component_of_root[find(q)];
+            if (c == NO_COMPONENT) {
+                c = result.components_.size();
+                result.components_.emplace_back();
+            }
+            result.component_of_[q] = c;
+            result.components_[c].push_back(q);
+        }
+        return result;
+    }
+
+    /// @brief Returns the number of components.
+    [[nodiscard]] std::size_t numComponents() const noexcept { return components_.size(); }
+
+    /**
+     * @brief Returns the qubits of a component, ascending.
+     * @param c Component index
+     * @throws std::out_of_range if c is invalid
+     */
+    [[nodiscard]] const std::vector<QubitIndex>& component(std::size_t c) const {
+        if (c >= components_.size()) {
+            throw std::out_of_range(
+                "Component index " + std::to_string(c) +
+                " out of range [0, " + std::to_string(components_.size()) + ")");
+        }
+        return components_[c];
+    }
+
+    /// @brief Returns every component.
+    [[nodiscard]] const std::vector<std::vector<QubitIndex>>& components() const noexcept {
+        return components_;
+    }
+
+    /// @brief Returns the component index of each qubit.
+    [[nodiscard]] const std::vector<std::size_t>& componentOf() const noexcept {
+        return component_of_;
+    }
+
+    /// @brief Sentinel for qubits not yet assigned to a component
+    static constexpr std::size_t NO_COMPONENT = std::numeric_limits<std::size_t>::max();
+
+private:
+    QubitComponents() = default;  // Only constructible via build()
+
+    std::vector<std::vector<QubitIndex>> components_;  // Qubits, ascending
+    std::vector<std::size_t> component_of_;            // Qubit -> component
+};
+
+/**
+ * @brief One component of a circuit, on local qubits.
+ */
+struct Subcircuit {
+    /// @brief The component's gates; local qubit i is qubits[i]
+    ir::Circuit circuit;
+
+    /// @brief Original qubit of each local qubit, ascending
+    std::vector<QubitIndex> qubits;
+};
+
+/**
+ * @brief Splits a circuit into one subcircuit per component.
+ *
+ * Gates keep their relative order. Classical bits keep their indices, so
+ * every subcircuit has the full classical register. A barrier spanning
+ * several components becomes one barrier per component.
+ *
+ * @param circuit The circuit
+ * @param components Its components, from QubitComponents::build(circuit)
+ * @return Subcircuits in component order
+ */
+[[nodiscard]] inline std::vector<Subcircuit> cutCircuit(const ir::Circuit& circuit,
+                                                        const QubitComponents& components) {
+    const auto& component_of = components.componentOf();
+    std::vector<QubitIndex> local(circuit.numQubits());
+    std::vector<Subcircuit> parts;
+    parts.reserve(components.numComponents());
+    for (const auto& qubits : components.components()) {
+        for (std::size_t i = 0; i < qubits.size(); ++i) local[qubits[i]] = i;
+        parts.push_back({ir::Circuit(qubits.size(), circuit.numClbits()), qubits});
+        parts.back().circuit.parameterTable() = circuit.parameterTable();
+    }
+
+    for (const auto& gate : circuit) {
+        if (gate.type() == ir::GateType::Barrier) {
+            std::vector<std::vector<QubitIndex>> split(parts.size());
+            for (QubitIndex q : gate.qubits()) split[component_of[q]].push_back(local[q]);
+            for (std::size_t c = 0; c < split.size(); ++c) {
+                if (split[c].empty()) continue;
+                parts[c].circuit.addGate(ir::Gate::barrier(std::move(split[c])));
+            }
+            continue;
+        }
+        std::vector<QubitIndex> qubits;
+        for (QubitIndex q : gate.qubits()) qubits.push_back(local[q]);
+        parts[component_of[gate.qubits()[0]]].circuit.addGate(gate.withQubits(std::move(qubits)));
+    }
+    return parts;
+}
+
+/**
+ * @brief Result of compileCut(): the merged compilation and its layout.
+ */
+struct CutCompileResult {
+    /// @brief Merged circuit, mappings and statistics, as compile() reports them
+    CompileResult compiled;
+
+    /// @brief Logical qubits of each component
+    std::vector<std::vector<QubitIndex>> components;
+
+    /// @brief Physical qubits given to each component (empty if not cut)
+    std::vector<std::vector<std::size_t>> regions;
+};
+
+namespace detail {
+
+/**
+ * @brief Gives each component a disjoint connected region of the device.
+ *
+ * Largest components first, each region is grown by BFS through free
+ * qubits from the lowest-numbered free qubit that reaches enough of them.
+ *
+ * @return Physical qubits per component, or nullopt if some component
+ *         finds no region
+ */
+[[nodiscard]] inline std::optional<std::vector<std::vector<std::size_t>>> allocateRegions(
+    const Topology& topology, const std::vector<std::vector<QubitIndex>>& components) {
+    std::vector<std::size_t> order(components.size());
+    for (std::size_t c = 0; c < order.size(); ++c) order[c] = c;
+    std::stable_sort(order.begin(), order.end(), [&components](std::size_t a, std::size_t b) {
+        return components[a].size() > components[b].size();
+    });
+
+    std::vector<bool> taken(topology.numQubits(), false);
+    std::vector<std::vector<std::size_t>> regions(components.size());
+    for (std::size_t c : order) {
+        const std::size_t want = components[c].size();
+        std::vector<std::size_t> members;
+        for (std::size_t seed = 0; seed < topology.numQubits() && members.size() < want; ++seed) {
+            if (taken[seed]) continue;
+            members.assign(1, seed);
+            std::vector<bool> seen = taken;
+            seen[seed] = true;
+            // members doubles as the BFS queue
+            for (std::size_t head = 0; head < members.size() && members.size() < want; ++head) {
+                for (std::size_t neighbor : topology.neighbors(members[head])) {
+                    if (members.size() >= want) break;
+                    if (!seen[neighbor]) {
+                        seen[neighbor] = true;
+                        members.push_back(neighbor);
+                    }
+                }
+            }
+        }
+        if (members.size() < want) return std::nullopt;
+        for (std::size_t p : members) taken[p] = true;
+        regions[c] = std::move(members);
+    }
+    return regions;
+}
+
+/**
+ * @brief Returns the subgraph of a topology induced by some qubits.
+ *
+ * Local qubit i is members[i].
+ */
+[[nodiscard]] inline Topology regionTopology(const Topology& topology,
+                                             const std::vector<std::size_t>& members) {
+    std::vector<std::size_t> local(topology.numQubits(), std::numeric_limits<std::size_t>::max());
+    for (std::size_t i = 0; i < members.size(); ++i) local[members[i]] = i;
+
+    Topology region(members.size());
+    for (std::size_t i = 0; i < members.size(); ++i) {
+        for (std::size_t neighbor : topology.neighbors(members[i])) {
+            if (local[neighbor] != std::numeric_limits<std::size_t>::max() && local[neighbor] > i) {
+                region.addEdge(i, local[neighbor]);
+            }
+        }
+    }
+    return region;
+}
+
+/**
+ * @brief Adds one pipeline run's statistics to a running total.
+ *
+ * Per-pass entries are matched by name.
+ */
+inline void accumulateStatistics(passes::PassStatistics& total,
+                                 const passes::PassStatistics& part) {
+    total.total_gates_removed += part.total_gates_removed;
+    total.total_gates_added += part.total_gates_added;
+    total.initial_gate_count += part.initial_gate_count;
+    total.final_gate_count += part.final_gate_count;
+    total.iterations = std::max(total.iterations, part.iterations);
+    for (const auto& [name, removed, added] : part.per_pass) {
+        auto it = std::find_if(total.per_pass.begin(), total.per_pass.end(),
+                               [&name](const auto& entry) { return std::get<0>(entry) == name; });
+        if (it == total.per_pass.end()) {
+            total.per_pass.emplace_back(name, removed, added);
+        } else {
+            std::get<1>(*it) += removed;
+            std::get<2>(*it) += added;
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Compiles a circuit component by component.
+ *
+ * Each component is compiled with compile() on its own connected region
+ * of the device, with exactly as many physical qubits as it has logical
+ * ones. Components are compiled concurrently on up to
+ * std::thread::hardware_concurrency() threads. The routed parts are then
+ * concatenated: they act on disjoint physical qubits and write disjoint
+ * classical bits, so their order does not matter.
+ *
+ * With a single component, or when the device has no disjoint connected
+ * regions of the needed sizes, the whole circuit goes through compile()
+ * and regions is left empty.
+ *
+ * Example:
+ * @code
+ * auto result = compileCut(circuit, Topology::grid(4, 4), passes::OptimizationLevel::O2);
+ * std::cout << result.compiled.routing.routed_circuit;
+ * @endcode
+ *
+ * @param circuit The logical circuit
+ * @param topology The device
+ * @param level The optimization level
+ * @param parallel Compile components concurrently (default: true)
+ * @return The merged compilation, with the components and their regions
+ * @throws std::invalid_argument if the circuit does not fit on the device
+ */
+[[nodiscard]] inline CutCompileResult compileCut(const ir::Circuit& circuit,
+                                                 const Topology& topology,
+                                                 passes::OptimizationLevel level,
+                                                 bool parallel = true) {
+    auto components = QubitComponents::build(circuit);
+    auto regions = components.numComponents() > 1
+                       ? detail::allocateRegions(topology, components.components())
+                       : std::nullopt;
+    if (!regions) {
+        return {compile(circuit, topology, level), components.components(), {}};
+    }
+
+    std::vector<Subcircuit> parts = cutCircuit(circuit, components);
+    std::vector<std::optional<CompileResult>> results(parts.size());
+    auto compile_from = [&](std::size_t first, std::size_t stride) {
+        for (std::size_t c = first; c < parts.size(); c += stride) {
+            results[c] = compile(parts[c].circuit,
+                                 detail::regionTopology(topology, (*regions)[c]), level);
+        }
+    };
+
+    const std::size_t threads =
+        parallel ? std::min<std::size_t>(parts.size(),
+                                         std::max(1U, std::thread::hardware_concurrency()))
+                 : 1;
+    if (threads > 1) {
+        std::vector<std::future<void>> futures;
+        futures.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t) {
+            futures.push_back(std::async(std::launch::async, compile_from, t, threads));
+        }
+        for (auto& f : futures) f.get();
+    } else {
+        compile_from(0, 1);
+    }
+
+    // Merge onto the device. Each part starts from the input's parameter
+    // table; expressions its passes appended are re-added to the merged one.
+    ir::Circuit merged(topology.numQubits(), circuit.numClbits());
+    merged.parameterTable() = circuit.parameterTable();
+    const std::size_t shared_exprs = circuit.parameterTable().numExpressions();
+    RoutingStats stats;
+    stats.initial_mapping.assign(circuit.numQubits(), 0);
+    stats.final_mapping.assign(circuit.numQubits(), 0);
+    stats.original_depth = circuit.depth();
+    stats.telemetry.swap_participation.assign(topology.numQubits(), 0);
+    passes::PassStatistics optimization;
+    passes::PassStatistics cleanup;
+
+    for (std::size_t c = 0; c < parts.size(); ++c) {
+        const auto& members = (*regions)[c];
+        const auto& logical = parts[c].qubits;
+        const CompileResult& part = *results[c];
+        const RoutingResult& routing = part.routing;
+
+        const ir::ParameterTable& table = routing.routed_circuit.parameterTable();
+        std::vector<ParameterExprId> appended;
+        for (std::size_t e = shared_exprs; e < table.numExpressions(); ++e) {
+            appended.push_back(
+                merged.parameterTable().add(table.expression(static_cast<ParameterExprId>(e))));
+        }
+
+        for (const auto& gate : routing.routed_circuit) {
+            std::vector<QubitIndex> qubits;
+            for (QubitIndex q : gate.qubits()) qubits.push_back(members[q]);
+            ir::Gate placed = gate.withQubits(std::move(qubits));
+            for (std::size_t i = 0; i < gate.numParameters(); ++i) {
+                auto expr = gate.expression(i);
+                if (expr && *expr >= shared_exprs) {
+                    placed = placed.withExpression(i, appended[*expr - shared_exprs]);
+                }
+            }
+            merged.addGate(placed);
+        }
+        for (std::size_t i = 0; i < logical.size(); ++i) {
+            stats.initial_mapping[logical[i]] = members[routing.initial_mapping[i]];
+            stats.final_mapping[logical[i]] = members[routing.final_mapping[i]];
+        }
+        stats.swaps_inserted += routing.swaps_inserted;
+
+        RoutingTelemetry counters = routing.telemetry;
+        counters.swap_participation.clear();
+        stats.telemetry.accumulate(counters);
+        for (std::size_t local = 0; local < members.size(); ++local) {
+            stats.telemetry.swap_participation[members[local]] +=
+                routing.telemetry.swap_participation[local];
+        }
+        if (stats.telemetry.parameters.empty()) {
+            stats.telemetry.parameters = routing.telemetry.parameters;
+        }
+
+        detail::accumulateStatistics(optimization, part.optimization);
+        detail::accumulateStatistics(cleanup, part.cleanup);
+    }
+    stats.final_depth = merged.depth();
+    stats.gates_emitted = merged.numGates();
+
+    return {CompileResult{RoutingResult(std::move(merged), std::move(stats)),
+                          std::move(optimization), std::move(cleanup)},
+            components.components(), std::move(*regions)};
+}
+
+}  // namespace qopt::routing
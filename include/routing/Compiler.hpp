@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file Compiler.hpp
+ * @brief Optimize-route-cleanup driver for the optimization levels
+ *
+ * Runs a level's pass pipeline, routes the result with SabreRouter and,
+ * at O3, optimizes the routed circuit once more.
+ *
+ * @see OptimizationLevel.hpp for the pipelines and compile-time budgets
+ * @see SabreRouter.hpp for the router
+ */
+
+#pragma once
+
+#include "../ir/Circuit.hpp"
+#include "../passes/OptimizationLevel.hpp"
+#include "../passes/PassManager.hpp"
+#include "Router.hpp"
+#include "SabreRouter.hpp"
+#include "Topology.hpp"
+
+#include <cstddef>
+
+namespace qopt::routing {
+
+/// @brief Initial mappings SabreRouter tries at O3.
+inline constexpr std::size_t O3_LAYOUT_TRIALS = 4;
+
+/**
+ * @brief Result of compile(): the routed circuit and what each stage did.
+ */
+struct CompileResult {
+    /// @brief Routed (and at O3 cleaned-up) circuit with its mappings
+    RoutingResult routing;
+
+    /// @brief Statistics of the optimization pipeline
+    passes::PassStatistics optimization;
+
+    /// @brief Statistics of the post-routing cleanup (empty below O3)
+    passes::PassStatistics cleanup;
+};
+
+/**
+ * @brief Compiles a circuit for a device at an optimization level.
+ *
+ * 1. Runs passes::makePassManager(level) on a copy of the circuit
+ * 2. Routes it with SabreRouter, breaking SWAP score ties by depth; O3
+ *    tries O3_LAYOUT_TRIALS initial mappings
+ * 3. At O3, runs the O2 pipeline on the routed circuit, where inserted
+ *    SWAPs may cancel against the circuit's own gates. The passes only
+ *    remove or merge gates, so every gate still acts on coupled qubits.
+ *
+ * After cleanup, final_depth, gates_emitted and the lowered two-qubit
+ * count describe the cleaned-up circuit; swaps_inserted and the SWAP
+ * heatmap still count the router's SWAPs.
+ *
+ * Example:
+ * @code
+ * auto result = compile(circuit, Topology::grid(3, 3), passes::OptimizationLevel::O3);
+ * std::cout << result.routing.routed_circuit;
+ * @endcode
+ *
+ * @param circuit The logical circuit
+ * @param topology The device
+ * @param level The optimization level
+ * @return The compiled circuit and per-stage statistics
+ * @throws std::invalid_argument if the circuit does not fit on the device
+ */
+[[nodiscard]] inline CompileResult compile(const ir::Circuit& circuit,
+                                           const Topology& topology,
+                                           passes::OptimizationLevel level) {
+    ir::Circuit optimized = circuit.clone();
+    passes::PassManager pipeline = passes::makePassManager(level);
+    pipeline.run(optimized);
+
+    const bool o3 = level == passes::OptimizationLevel::O3;
+    const bool depth_tie_break = true;
+    SabreRouter router(20, 0.5, 0.5, depth_tie_break, o3 ? O3_LAYOUT_TRIALS : 1);
+    CompileResult result{router.route(optimized, topology), pipeline.statistics(), {}};
+
+    if (o3) {
+        passes::PassManager cleanup = passes::makePassManager(passes::OptimizationLevel::O2);
+        ir::Circuit& routed = result.routing.routed_circuit;
+        cleanup.run(routed);
+        result.cleanup = cleanup.statistics();
+
+        result.routing.final_depth = routed.depth();
+        result.routing.gates_emitted = routed.numGates();
+        result.routing.telemetry.lowered_two_qubit_gates = 0;
+        for (const auto& gate : routed) {
+            result.routing.telemetry.lowered_two_qubit_gates += loweredTwoQubitCost(gate.type());
+        }
+    }
+    return result;
+}
+
+}  // namespace qopt::routing
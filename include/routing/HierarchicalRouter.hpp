@@ -0,0 +1,649 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file HierarchicalRouter.hpp
+ * @brief Partitioned routing for large devices
+ *
+ * Implements a two-level router: the device is split into connected regions
+ * (TopologyPartition), logical qubits are placed region by region using the
+ * circuit's interaction graph, two-qubit gates that cross regions are routed
+ * along the coarse region graph, and everything else is routed inside each
+ * region by a SabreRouter working on the region's small sub-topology.
+ * Regions are independent between crossings, so their leaf routing runs in
+ * parallel.
+ *
+ * @see SabreRouter.hpp for the leaf router
+ * @see TopologyPartition.hpp for region construction
+ */
+
+#pragma once
+
+#include "../ir/Circuit.hpp"
+#include "../ir/Gate.hpp"
+#include "Router.hpp"
+#include "SabreRouter.hpp"
+#include "Topology.hpp"
+#include "TopologyPartition.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace qopt::routing {
+
+/**
+ * @brief Hierarchical router for devices with thousands of qubits.
+ *
+ * Routing proceeds in circuit order:
+ *
+ * 1. **Partition**: Split the topology into connected regions of at most
+ *    region_size qubits and build the coarse region graph
+ * 2. **Placement**: Order logical qubits by BFS over the interaction graph
+ *    (heaviest partners first) and fill regions in coarse-graph BFS order,
+ *    so strongly interacting qubits start in the same or adjacent regions
+ * 3. **Local gates**: Gates whose qubits share a region are appended to
+ *    that region's pending sub-circuit
+ * 4. **Crossing gates**: The regions on the coarse path between the two
+ *    qubits are flushed, then both qubits are moved toward each other with
+ *    SWAPs along a shortest path restricted to those regions. For CCX the
+ *    controls are moved next to the target one after the other
+ * 5. **Flush**: Pending sub-circuits are routed by a SabreRouter on the
+ *    region's sub-topology (concurrently when several regions flush at
+ *    once) and spliced into the output with their final mappings composed
+ *    into the global mapping
+ *
+ * Unlike SabreRouter, the reported initial_mapping is generally not the
+ * identity: routed gates act on physical qubits, and logical qubit i starts
+ * on physical qubit initial_mapping[i].
+ *
+ * Example:
+ * @code
+ * HierarchicalRouter router(64);  // regions of up to 64 qubits
+ * auto topology = Topology::grid(32, 32);
+ * RoutingResult result = router.route(circuit, topology);
+ * @endcode
+ */
+class HierarchicalRouter : public Router {
+public:
+    /**
+     * @brief Constructs a hierarchical router.
+     * @param region_size Maximum physical qubits per region (default: 64)
+     * @param lookahead_depth Leaf SABRE lookahead window (default: 20)
+     * @param decay_factor Leaf SABRE per-layer decay (default: 0.5)
+     * @param extended_set_weight Leaf SABRE lookahead weight (default: 0.5)
+     * @param parallel Route independent regions concurrently (default: true)
+     * @throws std::invalid_argument if region_size is 0
+     */
+    explicit HierarchicalRouter(std::size_t region_size = 64,
+                                std::size_t lookahead_depth = 20,
+                                double decay_factor = 0.5,
+                                double extended_set_weight = 0.5,
+                                bool parallel = true)
+        : region_size_(region_size)
+        , lookahead_depth_(lookahead_depth)
+        , decay_factor_(decay_factor)
+        , extended_set_weight_(extended_set_weight)
+        , parallel_(parallel)
+    {
+        if (region_size == 0) {
+            throw std::invalid_argument("Region size must be positive");
+        }
+    }
+
+    [[nodiscard]] std::string name() const override {
+        return "HierarchicalRouter";
+    }
+
+    [[nodiscard]] RoutingResult route(
+        const ir::Circuit& circuit,
+        const Topology& topology) override {
+        return collectRoute(circuit, topology);
+    }
+
+    /**
+     * @brief Routes a circuit, streaming gates to a sink.
+     *
+     * Only the pending sub-circuits of regions are buffered (each is routed
+     * and released at its next flush); everything else is emitted directly.
+     */
+    RoutingStats routeTo(
+        const ir::Circuit& circuit,
+        const Topology& topology,
+        const GateSink& sink) override {
+        validateRouteInputs(circuit, topology);
+
+        const auto start = Clock::now();
+
+        RoutingStats stats;
+        stats.telemetry.parameters = parameters();
+        stats.telemetry.swap_participation.assign(topology.numQubits(), 0);
+        if (circuit.empty()) {
+            stats.initial_mapping = identityMapping(circuit.numQubits());
+            stats.final_mapping = stats.initial_mapping;
+            return stats;
+        }
+
+        auto partition = TopologyPartition::build(topology, region_size_);
+
+        RouteState state(topology, partition, sink, circuit.numClbits());
+        state.mapping = initialMapping(circuit, partition);
+        state.reverse_mapping.assign(topology.numQubits(), INVALID_LOGICAL);
+        for (std::size_t logical = 0; logical < state.mapping.size(); ++logical) {
+            state.reverse_mapping[state.mapping[logical]] = logical;
+        }
+        stats.initial_mapping = state.mapping;
+
+        for (std::size_t r = 0; r < partition.numRegions(); ++r) {
+            state.local_topologies.push_back(partition.regionTopology(topology, r));
+            state.pending.emplace_back(partition.region(r).size(), circuit.numClbits());
+            state.pending.back().parameterTable() = circuit.parameterTable();
+            state.leaves.emplace_back(lookahead_depth_, decay_factor_, extended_set_weight_);
+        }
+
+        const auto& region_of = partition.regionOf();
+        const auto& local_index = partition.localIndex();
+
+        for (const auto& gate : circuit) {
+            // Qubits of pending regions keep their segment-start positions,
+            // which are exactly the local indices the segment is written in.
+            std::vector<std::size_t> physical;
+            for (auto q : gate.qubits()) {
+                physical.push_back(state.mapping[q]);
+            }
+
+            std::size_t r = region_of[physical[0]];
+            bool local = std::all_of(physical.begin(), physical.end(),
+                                     [&](std::size_t p) { return region_of[p] == r; });
+
+            if (local) {
+                // Regions are spliced in list order, so a measurement into a
+                // bit last written from another region must wait for it
+                if (auto c = gate.clbit();
+                    c && state.clbit_region[*c] != INVALID_LOGICAL && state.clbit_region[*c] != r) {
+                    flushRegions({state.clbit_region[*c]}, state);
+                }
+                std::vector<QubitIndex> qubits;
+                for (std::size_t p : physical) {
+                    qubits.push_back(local_index[p]);
+                }
+                state.pending[r].addGate(gate.withQubits(std::move(qubits)));
+                if (auto c = gate.clbit()) {
+                    state.clbit_region[*c] = r;
+                }
+            } else if (!ir::isMultiQubitGate(gate.type())) {
+                routeBarrier(gate, state);
+            } else if (gate.type() == ir::GateType::CCX) {
+                routeToffoliCrossing(gate, state);
+            } else {
+                routeCrossing(gate, state);
+            }
+        }
+
+        std::vector<std::size_t> all_regions(partition.numRegions());
+        for (std::size_t r = 0; r < all_regions.size(); ++r) {
+            all_regions[r] = r;
+        }
+        flushRegions(all_regions, state);
+
+        stats.final_mapping = std::move(state.mapping);
+        stats.swaps_inserted = state.swaps_inserted;
+        stats.original_depth = circuit.depth();
+        stats.final_depth = state.out.depth();
+        stats.gates_emitted = state.out.numGates();
+
+        // Leaf counters are summed over regions; the router's own work
+        // (placement, crossings, splicing) counts as bookkeeping.
+        stats.telemetry.accumulate(state.leaf_telemetry);
+        stats.telemetry.swap_participation = state.out.swapParticipation();
+        stats.telemetry.lowered_two_qubit_gates = state.out.loweredTwoQubitGates();
+        stats.telemetry.bookkeeping_ms += Ms(Clock::now() - start - state.leaf_wall).count();
+
+        return stats;
+    }
+
+    /**
+     * @brief Returns the tuning parameters as recorded in telemetry.
+     * @return (name, value) pairs, leaf SABRE parameters included
+     */
+    [[nodiscard]] std::vector<std::pair<std::string, double>> parameters() const {
+        return {{"region_size", static_cast<double>(region_size_)},
+                {"lookahead_depth", static_cast<double>(lookahead_depth_)},
+                {"decay_factor", decay_factor_},
+                {"extended_set_weight", extended_set_weight_},
+                {"parallel", parallel_ ? 1.0 : 0.0}};
+    }
+
+private:
+    std::size_t region_size_;
+    std::size_t lookahead_depth_;
+    double decay_factor_;
+    double extended_set_weight_;
+    bool parallel_;
+
+    using Clock = std::chrono::steady_clock;
+    using Ms = std::chrono::duration<double, std::milli>;
+
+    /// @brief Sentinel for unmapped physical qubits and unvisited BFS entries
+    static constexpr std::size_t INVALID_LOGICAL = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Mutable state of one routing run.
+     *
+     * mapping/reverse_mapping are authoritative for flushed regions. For a
+     * region with a pending sub-circuit they still hold the positions at the
+     * start of that segment; flushRegions() brings them up to date.
+     */
+    struct RouteState {
+        const Topology& topology;
+        const TopologyPartition& partition;
+        std::vector<std::size_t> mapping;          ///< logical -> physical
+        std::vector<std::size_t> reverse_mapping;  ///< physical -> logical
+        std::vector<Topology> local_topologies;    ///< Per-region sub-topology
+        std::vector<ir::Circuit> pending;          ///< Per-region unrouted gates
+        std::vector<SabreRouter> leaves;           ///< Per-region leaf router
+        RoutedGateStream out;
+        std::size_t swaps_inserted = 0;
+        RoutingTelemetry leaf_telemetry;           ///< Summed leaf counters
+        Clock::duration leaf_wall{0};              ///< Wall time inside leaf routing
+
+        /// Region holding the last pending measurement of each classical bit
+        std::vector<std::size_t> clbit_region;
+
+        // Scratch for restricted path searches, reset after each use
+        std::vector<std::size_t> parent;
+        std::vector<char> region_allowed;
+
+        RouteState(const Topology& t, const TopologyPartition& p, const GateSink& sink,
+                   std::size_t num_clbits)
+            : topology(t)
+            , partition(p)
+            , out(t.numQubits(), sink, num_clbits)
+            , clbit_region(num_clbits, INVALID_LOGICAL)
+            , parent(t.numQubits(), INVALID_LOGICAL)
+            , region_allowed(p.numRegions(), 0)
+        {}
+    };
+
+    /**
+     * @brief Places logical qubits region by region.
+     *
+     * Logical qubits are ordered by BFS over the interaction graph, seeded
+     * from the most-interacting unplaced qubit and visiting partners in
+     * decreasing interaction count. Physical slots are ordered by BFS over
+     * the coarse region graph, and within a region by local index. The i-th
+     * logical qubit gets the i-th slot.
+     */
+    [[nodiscard]] std::vector<std::size_t> initialMapping(
+        const ir::Circuit& circuit,
+        const TopologyPartition& partition) const {
+
+        const std::size_t num_logical = circuit.numQubits();
+
+        // Weighted interaction lists: (partner, count), sorted heaviest first
+        std::vector<std::vector<std::size_t>> raw(num_logical);
+        for (const auto& gate : circuit) {
+            if (!ir::isMultiQubitGate(gate.type())) continue;
+            const auto& qs = gate.qubits();
+            for (std::size_t i = 0; i < qs.size(); ++i) {
+                for (std::size_t j = 0; j < qs.size(); ++j) {
+                    if (i != j) raw[qs[i]].push_back(qs[j]);
+                }
+            }
+        }
+        std::vector<std::vector<std::pair<std::size_t, std::size_t>>> partners(num_logical);
+        std::vector<std::size_t> total(num_logical, 0);
+        for (std::size_t q = 0; q < num_logical; ++q) {
+            auto& list = raw[q];
+            total[q] = list.size();
+            std::sort(list.begin(), list.end());
+            for (std::size_t i = 0; i < list.size();) {
+                std::size_t j = i;
+                while (j < list.size() && list[j] == list[i]) ++j;
+                partners[q].emplace_back(list[i], j - i);
+                i = j;
+            }
+            std::stable_sort(partners[q].begin(), partners[q].end(),
+                             [](const auto& a, const auto& b) { return a.second > b.second; });
+        }
+
+        std::vector<std::size_t> seeds(num_logical);
+        for (std::size_t q = 0; q < num_logical; ++q) seeds[q] = q;
+        std::stable_sort(seeds.begin(), seeds.end(),
+                         [&](std::size_t a, std::size_t b) { return total[a] > total[b]; });
+
+        std::vector<std::size_t> logical_order;
+        std::vector<char> placed(num_logical, 0);
+        for (std::size_t seed : seeds) {
+            if (placed[seed]) continue;
+            placed[seed] = 1;
+            std::size_t head = logical_order.size();
+            logical_order.push_back(seed);
+            for (; head < logical_order.size(); ++head) {
+                for (const auto& [partner, count] : partners[logical_order[head]]) {
+                    if (!placed[partner]) {
+                        placed[partner] = 1;
+                        logical_order.push_back(partner);
+                    }
+                }
+            }
+        }
+
+        // Physical slots: coarse BFS over regions, local order within each
+        std::vector<std::size_t> slots;
+        std::vector<char> seen(partition.numRegions(), 0);
+        for (std::size_t start = 0;
+             start < partition.numRegions() && slots.size() < num_logical; ++start) {
+            if (seen[start]) continue;
+            seen[start] = 1;
+            std::vector<std::size_t> queue = {start};
+            for (std::size_t head = 0; head < queue.size(); ++head) {
+                const auto& members = partition.region(queue[head]);
+                slots.insert(slots.end(), members.begin(), members.end());
+                for (std::size_t next : partition.adjacentRegions(queue[head])) {
+                    if (!seen[next]) {
+                        seen[next] = 1;
+                        queue.push_back(next);
+                    }
+                }
+            }
+        }
+
+        std::vector<std::size_t> mapping(num_logical);
+        for (std::size_t i = 0; i < num_logical; ++i) {
+            mapping[logical_order[i]] = slots[i];
+        }
+        return mapping;
+    }
+
+    /**
+     * @brief Routes a gate whose qubits lie in different regions.
+     *
+     * Flushes every region on the coarse path between the two qubits, then
+     * finds a shortest physical path through those regions only and moves
+     * both qubits toward its middle with SWAPs before emitting the gate.
+     */
+    void routeCrossing(const ir::Gate& gate, RouteState& state) const {
+        const auto& region_of = state.partition.regionOf();
+        std::size_t from = state.mapping[gate.qubits()[0]];
+        std::size_t to = state.mapping[gate.qubits()[1]];
+
+        auto regions = state.partition.regionPath(region_of[from], region_of[to]);
+        flushRegions(regions, state);
+
+        // Flushing may have moved both qubits within their regions
+        from = state.mapping[gate.qubits()[0]];
+        to = state.mapping[gate.qubits()[1]];
+
+        if (!state.topology.connected(from, to)) {
+            auto path = restrictedPath(from, to, regions, state);
+            if (path.empty()) {
+                throw std::runtime_error(
+                    "No path exists between qubits " + std::to_string(from) +
+                    " and " + std::to_string(to));
+            }
+
+            // path has m edges; m - 1 SWAPs leave the qubits adjacent
+            std::size_t m = path.size() - 1;
+            std::size_t forward = m / 2;
+            for (std::size_t i = 0; i < forward; ++i) {
+                insertSwap(path[i], path[i + 1], state);
+            }
+            for (std::size_t j = m; j > forward + 1; --j) {
+                insertSwap(path[j], path[j - 1], state);
+            }
+        }
+
+        std::vector<QubitIndex> physical;
+        for (auto q : gate.qubits()) {
+            physical.push_back(state.mapping[q]);
+        }
+        state.out.emit(gate.withQubits(std::move(physical)));
+    }
+
+    /**
+     * @brief Routes a CCX whose qubits lie in different regions.
+     *
+     * Flushes the regions on the coarse paths from both controls to the
+     * target, moves the first control next to the target, then the second
+     * control along a path that avoids the first. If the first control
+     * separates the second from the target, target and first control swap
+     * places before retrying, which leaves the target between them.
+     */
+    void routeToffoliCrossing(const ir::Gate& gate, RouteState& state) const {
+        const auto& region_of = state.partition.regionOf();
+        const auto& qubits = gate.qubits();
+        const std::size_t target_region = region_of[state.mapping[qubits[2]]];
+
+        std::vector<std::size_t> regions;
+        for (std::size_t i = 0; i < 2; ++i) {
+            std::size_t control_region = region_of[state.mapping[qubits[i]]];
+            for (std::size_t r : state.partition.regionPath(control_region, target_region)) {
+                if (std::find(regions.begin(), regions.end(), r) == regions.end()) {
+                    regions.push_back(r);
+                }
+            }
+        }
+        flushRegions(regions, state);
+
+        bool placed = moveNextTo(qubits[0], qubits[2], INVALID_LOGICAL, regions, state);
+        if (placed && !moveNextTo(qubits[1], qubits[2], state.mapping[qubits[0]], regions, state)) {
+            insertSwap(state.mapping[qubits[0]], state.mapping[qubits[2]], state);
+            placed = moveNextTo(qubits[1], qubits[2], state.mapping[qubits[0]], regions, state);
+        }
+        if (!placed) {
+            throw std::runtime_error(
+                "Cannot place CCX target between controls on physical qubits " +
+                std::to_string(state.mapping[qubits[0]]) + ", " +
+                std::to_string(state.mapping[qubits[1]]) + " and " +
+                std::to_string(state.mapping[qubits[2]]));
+        }
+
+        std::vector<QubitIndex> physical;
+        for (auto q : qubits) {
+            physical.push_back(state.mapping[q]);
+        }
+        state.out.emit(gate.withQubits(std::move(physical)));
+    }
+
+    /**
+     * @brief Moves a logical qubit along a restricted path until it
+     *        neighbors another.
+     * @param mover Logical qubit to move
+     * @param anchor Logical qubit that stays in place
+     * @param avoid Physical qubit the path must not cross (or INVALID_LOGICAL)
+     * @return false if no such path exists; no SWAPs are inserted then
+     */
+    bool moveNextTo(std::size_t mover, std::size_t anchor, std::size_t avoid,
+                    const std::vector<std::size_t>& regions, RouteState& state) const {
+        auto path = restrictedPath(state.mapping[mover], state.mapping[anchor],
+                                   regions, state, avoid);
+        if (path.empty()) return false;
+        for (std::size_t i = 0; i + 2 < path.size(); ++i) {
+            insertSwap(path[i], path[i + 1], state);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Emits a barrier whose qubits lie in different regions.
+     *
+     * Flushes the regions it spans so every earlier gate on its qubits is
+     * emitted first; no SWAPs are needed.
+     */
+    void routeBarrier(const ir::Gate& gate, RouteState& state) const {
+        const auto& region_of = state.partition.regionOf();
+        std::vector<std::size_t> regions;
+        for (auto q : gate.qubits()) {
+            std::size_t r = region_of[state.mapping[q]];
+            if (std::find(regions.begin(), regions.end(), r) == regions.end()) {
+                regions.push_back(r);
+            }
+        }
+        flushRegions(regions, state);
+
+        std::vector<QubitIndex> physical;
+        for (auto q : gate.qubits()) {
+            physical.push_back(state.mapping[q]);
+        }
+        state.out.emit(gate.withQubits(std::move(physical)));
+    }
+
+    /**
+     * @brief BFS shortest path that only visits qubits of the given regions.
+     *
+     * Consecutive regions on a coarse path share a device edge and every
+     * region is internally connected, so a path always exists unless a
+     * qubit to avoid cuts it.
+     *
+     * @param avoid Physical qubit the path must not visit (or INVALID_LOGICAL)
+     * @return Path from `from` to `to`, or empty if there is none
+     */
+    [[nodiscard]] std::vector<std::size_t> restrictedPath(
+        std::size_t from,
+        std::size_t to,
+        const std::vector<std::size_t>& regions,
+        RouteState& state,
+        std::size_t avoid = INVALID_LOGICAL) const {
+
+        const auto& region_of = state.partition.regionOf();
+        for (std::size_t r : regions) state.region_allowed[r] = 1;
+
+        std::vector<std::size_t> queue = {from};
+        state.parent[from] = from;
+        if (avoid != INVALID_LOGICAL) state.parent[avoid] = avoid;
+        for (std::size_t head = 0;
+             head < queue.size() && state.parent[to] == INVALID_LOGICAL; ++head) {
+            for (std::size_t neighbor : state.topology.neighbors(queue[head])) {
+                if (state.parent[neighbor] == INVALID_LOGICAL &&
+                    state.region_allowed[region_of[neighbor]]) {
+                    state.parent[neighbor] = queue[head];
+                    queue.push_back(neighbor);
+                }
+            }
+        }
+
+        std::vector<std::size_t> path;
+        if (state.parent[to] != INVALID_LOGICAL) {
+            for (std::size_t current = to; current != from; current = state.parent[current]) {
+                path.push_back(current);
+            }
+            path.push_back(from);
+            std::reverse(path.begin(), path.end());
+        }
+
+        for (std::size_t q : queue) state.parent[q] = INVALID_LOGICAL;
+        for (std::size_t r : regions) state.region_allowed[r] = 0;
+        if (avoid != INVALID_LOGICAL) state.parent[avoid] = INVALID_LOGICAL;
+
+        return path;
+    }
+
+    /**
+     * @brief Routes the pending sub-circuits of the given regions.
+     *
+     * Each non-empty region is routed by its leaf SabreRouter on its own
+     * sub-topology; with parallel routing enabled and more than one region
+     * to flush, the leaves run concurrently. Results are spliced into the
+     * output in region-list order, which is valid because the regions are
+     * disjoint. Local logical i of a segment is whatever logical qubit sat
+     * on local physical i when the segment started (the leaf reports an
+     * identity initial mapping), so the leaf's final mapping composes
+     * directly onto reverse_mapping.
+     */
+    void flushRegions(const std::vector<std::size_t>& regions, RouteState& state) const {
+        std::vector<std::size_t> work;
+        for (std::size_t r : regions) {
+            if (!state.pending[r].empty()) work.push_back(r);
+        }
+        if (work.empty()) {
+            return;
+        }
+
+        auto route_region = [&state](std::size_t r) {
+            return state.leaves[r].route(state.pending[r], state.local_topologies[r]);
+        };
+
+        const auto leaf_start = Clock::now();
+        std::vector<RoutingResult> results;
+        results.reserve(work.size());
+        if (parallel_ && work.size() > 1) {
+            std::vector<std::future<RoutingResult>> futures;
+            futures.reserve(work.size());
+            for (std::size_t r : work) {
+                futures.push_back(std::async(std::launch::async, route_region, r));
+            }
+            for (auto& f : futures) {
+                results.push_back(f.get());
+            }
+        } else {
+            for (std::size_t r : work) {
+                results.push_back(route_region(r));
+            }
+        }
+        state.leaf_wall += Clock::now() - leaf_start;
+
+        for (std::size_t i = 0; i < work.size(); ++i) {
+            std::size_t r = work[i];
+            const auto& members = state.partition.region(r);
+            const RoutingResult& leaf = results[i];
+
+            for (const auto& g : leaf.routed_circuit) {
+                std::vector<QubitIndex> qubits;
+                for (auto q : g.qubits()) {
+                    qubits.push_back(members[q]);
+                }
+                state.out.emit(g.withQubits(std::move(qubits)));
+            }
+            state.swaps_inserted += leaf.swaps_inserted;
+
+            // Leaf heatmap and lowered count are rebuilt globally by out
+            RoutingTelemetry leaf_counters = leaf.telemetry;
+            leaf_counters.swap_participation.clear();
+            leaf_counters.lowered_two_qubit_gates = 0;
+            state.leaf_telemetry.accumulate(leaf_counters);
+            for (std::size_t local = 0; local < members.size(); ++local) {
+                state.out.addSwapParticipation(members[local],
+                                               leaf.telemetry.swap_participation[local]);
+            }
+
+            std::vector<std::size_t> start_logical(members.size());
+            for (std::size_t local = 0; local < members.size(); ++local) {
+                start_logical[local] = state.reverse_mapping[members[local]];
+            }
+            for (std::size_t local = 0; local < members.size(); ++local) {
+                std::size_t p = members[leaf.final_mapping[local]];
+                std::size_t logical = start_logical[local];
+                state.reverse_mapping[p] = logical;
+                if (logical != INVALID_LOGICAL) state.mapping[logical] = p;
+            }
+
+            state.pending[r].clear();
+        }
+    }
+
+    /**
+     * @brief Inserts a SWAP gate and updates mappings.
+     */
+    void insertSwap(std::size_t p0, std::size_t p1, RouteState& state) const {
+        state.out.emitSwap(p0, p1);
+        ++state.swaps_inserted;
+
+        std::size_t logical0 = state.reverse_mapping[p0];
+        std::size_t logical1 = state.reverse_mapping[p1];
+
+        if (logical0 != INVALID_LOGICAL) state.mapping[logical0] = p1;
+        if (logical1 != INVALID_LOGICAL) state.mapping[logical1] = p0;
+
+        state.reverse_mapping[p0] = logical1;
+        state.reverse_mapping[p1] = logical0;
+    }
+};
+
+}  // namespace qopt::routing
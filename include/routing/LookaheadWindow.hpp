@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file LookaheadWindow.hpp
+ * @brief SABRE's extended set, laid out from a front tracked as gates execute
+ *
+ * Provides the LookaheadWindow class: the multi-qubit gates in the first
+ * DAG layers after the routing front, each weighted by its layer. The
+ * front is tracked from the gates that execute; the window is laid out
+ * from it only when read after a change.
+ *
+ * @see SabreRouter.hpp for the router that scores SWAPs against it
+ * @see DAG.hpp for the dependency graph
+ */
+
+#pragma once
+
+#include "../ir/DAG.hpp"
+#include "../ir/Gate.hpp"
+#include "../ir/Types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace qopt::routing {
+
+/**
+ * @brief A multi-qubit gate in the lookahead window.
+ *
+ * The weight already folds in the extended-set weight and the per-layer
+ * decay, so scoring is a plain weighted sum of distances.
+ */
+struct LookaheadEntry {
+    GateId id;
+    double weight;
+
+    [[nodiscard]] bool operator==(const LookaheadEntry& other) const noexcept {
+        return id == other.id && weight == other.weight;
+    }
+};
+
+/**
+ * @brief Breadth-limited lookahead window over the unexecuted gates of a DAG.
+ *
+ * Every unexecuted gate has a layer: 0 if all its predecessors have
+ * executed (the front), otherwise one more than its deepest unexecuted
+ * predecessor. The window holds the multi-qubit gates of layers 1, 2, ...
+ * in breadth-first order from the front until max_gates are collected; a
+ * gate in layer k weighs weight * decay^(k - 1). Front gates are visited
+ * in the order they became ready, which is the order the router keeps its
+ * front in, so a window truncated mid-layer keeps the gates that unblock
+ * the longest-waiting front gates.
+ *
+ * The front and the unexecuted-predecessor counts are updated as gates
+ * execute; the layers themselves are not. Re-layering only the changed
+ * descendants is possible, but the breadth-first order above still has to
+ * be recovered from the front afterwards, and that walk is all a rebuild
+ * costs. Keeping layers incrementally measured about 1.2-1.6x slower
+ * routing on the benchmark suite with identical SWAPs, and ordering
+ * layers by gate ID instead of breadth-first added up to 85% more SWAPs
+ * on a 1024-qubit grid. The window is therefore laid out again from the
+ * front on the first read after gates execute (SWAPs leave it unchanged)
+ * and kept in flat buffers reused across rebuilds.
+ *
+ * Example:
+ * @code
+ * LookaheadWindow window(20, 0.5, 0.5);
+ * window.reset(dag);
+ * for (const auto& entry : window.entries(dag)) { ... }
+ * window.execute(dag, front_gate);  // entries() now reflects the new front
+ * @endcode
+ */
+class LookaheadWindow {
+public:
+    /**
+     * @brief Constructs an empty window.
+     * @param max_gates Maximum multi-qubit gates in the window
+     * @param weight Weight of a gate in layer 1
+     * @param decay Weight factor per further layer
+     */
+    LookaheadWindow(std::size_t max_gates, double weight, double decay)
+        : max_gates_(max_gates)
+        , weight_(weight)
+        , decay_(decay) {}
+
+    /**
+     * @brief Starts tracking a DAG with no gate executed.
+     */
+    void reset(const ir::DAG& dag) {
+        std::size_t id_bound = 0;
+        for (GateId id : dag.nodeIds()) {
+            if (id + 1 > id_bound) id_bound = id + 1;
+        }
+        remaining_.assign(id_bound, 0);
+        for (GateId id : dag.nodeIds()) {
+            remaining_[id] = dag.node(id).inDegree();
+        }
+        scratch_.assign(id_bound, UNVISITED);
+        executed_.assign(id_bound, 0);
+        front_ = dag.sources();
+        valid_ = false;
+    }
+
+    /**
+     * @brief Marks a gate of the front as executed.
+     *
+     * Gates that become ready join the front after the gates already in it,
+     * so the router should execute gates in the order it appends their
+     * successors to its own front.
+     */
+    void execute(const ir::DAG& dag, GateId id) {
+        executed_[id] = 1;
+        for (GateId succ : dag.node(id).successors()) {
+            if (--remaining_[succ] == 0) front_.push_back(succ);
+        }
+        valid_ = false;
+    }
+
+    /**
+     * @brief Returns the window for the current front.
+     * @return Multi-qubit gates in breadth-first order, with their weights
+     */
+    [[nodiscard]] const std::vector<LookaheadEntry>& entries(const ir::DAG& dag) {
+        if (!valid_) {
+            rebuild(dag);
+            valid_ = true;
+        }
+        return entries_;
+    }
+
+private:
+    /// @brief Sentinel for gates the current rebuild has not reached
+    static constexpr std::size_t UNVISITED = std::numeric_limits<std::size_t>::max();
+
+    std::size_t max_gates_;
+    double weight_;
+    double decay_;
+
+    std::vector<std::size_t> remaining_;  ///< Unexecuted predecessors, per gate
+    std::vector<std::size_t> scratch_;    ///< Per-rebuild copy of remaining_, or UNVISITED
+    std::vector<std::uint8_t> executed_;
+    std::vector<GateId> front_;           ///< Ready gates (may hold executed ones)
+    bool valid_ = false;
+
+    std::vector<GateId> touched_;
+    std::vector<GateId> frontier_;
+    std::vector<GateId> next_frontier_;
+    std::vector<LookaheadEntry> entries_;
+
+    /// @brief Drops executed gates from front_, keeping the order.
+    void compactFront() {
+        std::size_t kept = 0;
+        for (GateId id : front_) {
+            if (executed_[id] == 0) front_[kept++] = id;
+        }
+        front_.resize(kept);
+    }
+
+    /// @brief Lays out entries_ layer by layer from the front.
+    void rebuild(const ir::DAG& dag) {
+        compactFront();
+        entries_.clear();
+        frontier_.assign(front_.begin(), front_.end());
+
+        double weight = weight_;
+        while (!frontier_.empty() && entries_.size() < max_gates_) {
+            next_frontier_.clear();
+            for (GateId id : frontier_) {
+                for (GateId succ : dag.node(id).successors()) {
+                    if (scratch_[succ] == UNVISITED) {
+                        scratch_[succ] = remaining_[succ];
+                        touched_.push_back(succ);
+                    }
+                    if (--scratch_[succ] == 0) next_frontier_.push_back(succ);
+                }
+            }
+
+            for (GateId id : next_frontier_) {
+                if (entries_.size() >= max_gates_) break;
+                if (ir::isMultiQubitGate(dag.node(id).gate().type())) {
+                    entries_.push_back({id, weight});
+                }
+            }
+
+            std::swap(frontier_, next_frontier_);
+            weight *= decay_;
+        }
+
+        // Restore the scratch counters touched by this rebuild
+        for (GateId id : touched_) {
+            scratch_[id] = UNVISITED;
+        }
+        touched_.clear();
+    }
+};
+
+}  // namespace qopt::routing
@@ -13,6 +13,10 @@
  * The router inserts SWAP gates to move qubit states so that two-qubit
  * gates can be executed on adjacent physical qubits.
  *
+ * Routers can either materialize the routed circuit (route()) or stream
+ * gates to a GateSink as they are produced (routeTo()), e.g. straight into
+ * a QASMWriter, with depth and statistics tracked on the fly.
+ *
  * @see Topology.hpp for device connectivity
  * @see SabreRouter.hpp for SABRE implementation
  */
@@ -22,23 +26,143 @@
 #include "../ir/Circuit.hpp"
 #include "Topology.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdio>
+#include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace qopt::routing {
 
 /**
- * @brief Result container for qubit routing.
+ * @brief Callback receiving routed gates (on physical qubits) in order.
  *
- * Contains the routed circuit with SWAP gates inserted, the initial
- * and final qubit mappings, and routing statistics.
+ * Gates arrive with sequential IDs starting at 0, exactly as they would
+ * appear in RoutingResult::routed_circuit.
  */
-struct RoutingResult {
-    /// @brief The routed circuit with SWAPs inserted
-    ir::Circuit routed_circuit;
+using GateSink = std::function<void(const ir::Gate&)>;
+
+/**
+ * @brief Returns how many two-qubit gates a gate costs after basis lowering.
+ *
+ * The target basis is {1q, CX}: CCX lowers to 6 CX, SWAP to 3, CPhase,
+ * RZZ and iSWAP to 2, CNOT and CZ to one two-qubit gate each, single-qubit
+ * gates and non-unitary operations to none.
+ */
+[[nodiscard]] constexpr std::size_t loweredTwoQubitCost(ir::GateType type) noexcept {
+    switch (type) {
+        case ir::GateType::CCX:
+            return 6;
+        case ir::GateType::SWAP:
+            return 3;
+        case ir::GateType::CPhase:
+        case ir::GateType::RZZ:
+        case ir::GateType::ISWAP:
+            return 2;
+        default:
+            return ir::isTwoQubitGate(type) ? 1 : 0;
+    }
+}
+
+/**
+ * @brief Cost and quality counters collected while routing.
+ *
+ * Intended for tuning router parameters (lookahead_depth, decay_factor,
+ * extended_set_weight, region_size) against measured cost: each router
+ * records the parameters it ran with alongside the counters, and toJson()
+ * exports both. Timings are wall-clock per routing loop; for routers that
+ * run leaves concurrently they are summed over threads.
+ */
+struct RoutingTelemetry {
+    /// @brief Router parameters in effect, as (name, value) pairs
+    std::vector<std::pair<std::string, double>> parameters;
+
+    /// @brief Iterations of the routing loop (execute-or-SWAP steps)
+    std::size_t rounds = 0;
+
+    /// @brief Candidate SWAPs scored across all SWAP selections
+    std::size_t candidates_scored = 0;
+
+    /// @brief Gates routed along shortest paths because SWAP selection found
+    /// no candidate or inserted too many SWAPs without executing a gate
+    std::size_t fallbacks = 0;
+
+    /// @brief Time spent building lookahead windows and scoring candidates
+    double scoring_ms = 0.0;
+
+    /// @brief Time spent in the routing loop outside of scoring
+    double bookkeeping_ms = 0.0;
+
+    /// @brief Inserted SWAPs touching each physical qubit (heatmap)
+    std::vector<std::size_t> swap_participation;
+
+    /// @brief Two-qubit gates in the output after lowering SWAP to 3 CX
+    std::size_t lowered_two_qubit_gates = 0;
+
+    /**
+     * @brief Adds another run's counters to this one.
+     *
+     * Participation is added element-wise; the other run's heatmap must be
+     * indexed by the same physical qubits. Parameters are not merged.
+     */
+    void accumulate(const RoutingTelemetry& other) {
+        rounds += other.rounds;
+        candidates_scored += other.candidates_scored;
+        fallbacks += other.fallbacks;
+        scoring_ms += other.scoring_ms;
+        bookkeeping_ms += other.bookkeeping_ms;
+        lowered_two_qubit_gates += other.lowered_two_qubit_gates;
+        if (swap_participation.size() < other.swap_participation.size()) {
+            swap_participation.resize(other.swap_participation.size(), 0);
+        }
+        for (std::size_t p = 0; p < other.swap_participation.size(); ++p) {
+            swap_participation[p] += other.swap_participation[p];
+        }
+    }
+
+    /**
+     * @brief Exports the telemetry as a JSON object.
+     * @return Single-line JSON text
+     */
+    [[nodiscard]] std::string toJson() const {
+        std::string json = "{\"parameters\":{";
+        for (std::size_t i = 0; i < parameters.size(); ++i) {
+            if (i > 0) json += ",";
+            json += "\"" + parameters[i].first + "\":" + formatNumber(parameters[i].second);
+        }
+        json += "},\"rounds\":" + std::to_string(rounds);
+        json += ",\"candidates_scored\":" + std::to_string(candidates_scored);
+        json += ",\"fallbacks\":" + std::to_string(fallbacks);
+        json += ",\"scoring_ms\":" + formatNumber(scoring_ms);
+        json += ",\"bookkeeping_ms\":" + formatNumber(bookkeeping_ms);
+        json += ",\"lowered_two_qubit_gates\":" + std::to_string(lowered_two_qubit_gates);
+        json += ",\"swap_participation\":[";
+        for (std::size_t p = 0; p < swap_participation.size(); ++p) {
+            if (p > 0) json += ",";
+            json += std::to_string(swap_participation[p]);
+        }
+        json += "]}";
+        return json;
+    }
+
+private:
+    [[nodiscard]] static std::string formatNumber(double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        return buffer;
+    }
+};
 
+/**
+ * @brief Mappings and statistics of a routing run, without the circuit.
+ *
+ * Returned by Router::routeTo(); RoutingResult extends it with the
+ * materialized routed circuit.
+ */
+struct RoutingStats {
     /// @brief Initial mapping: initial_mapping[logical] = physical
     std::vector<std::size_t> initial_mapping;
 
@@ -54,6 +178,12 @@ struct RoutingResult {
     /// @brief Final circuit depth after routing
     std::size_t final_depth = 0;
 
+    /// @brief Number of gates emitted (original gates plus SWAPs)
+    std::size_t gates_emitted = 0;
+
+    /// @brief Cost and quality counters (see RoutingTelemetry)
+    RoutingTelemetry telemetry;
+
     /// @brief Depth overhead from routing (final_depth - original_depth)
     [[nodiscard]] std::size_t depthOverhead() const noexcept {
         return final_depth > original_depth ? final_depth - original_depth : 0;
@@ -91,6 +221,42 @@ struct RoutingResult {
         return result;
     }
 
+    /**
+     * @brief Exports the statistics and telemetry as a JSON object.
+     * @return Single-line JSON text
+     */
+    [[nodiscard]] std::string toJson() const {
+        auto array = [](const std::vector<std::size_t>& values) {
+            std::string out = "[";
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                if (i > 0) out += ",";
+                out += std::to_string(values[i]);
+            }
+            return out + "]";
+        };
+
+        std::string json = "{\"swaps_inserted\":" + std::to_string(swaps_inserted);
+        json += ",\"original_depth\":" + std::to_string(original_depth);
+        json += ",\"final_depth\":" + std::to_string(final_depth);
+        json += ",\"gates_emitted\":" + std::to_string(gates_emitted);
+        json += ",\"initial_mapping\":" + array(initial_mapping);
+        json += ",\"final_mapping\":" + array(final_mapping);
+        json += ",\"telemetry\":" + telemetry.toJson();
+        json += "}";
+        return json;
+    }
+};
+
+/**
+ * @brief Result container for qubit routing.
+ *
+ * Contains the routed circuit with SWAP gates inserted, the initial
+ * and final qubit mappings, and routing statistics.
+ */
+struct RoutingResult : RoutingStats {
+    /// @brief The routed circuit with SWAPs inserted
+    ir::Circuit routed_circuit;
+
     /**
      * @brief Constructs a RoutingResult with the given circuit.
      * @param circuit The routed circuit
@@ -99,6 +265,16 @@ struct RoutingResult {
         : routed_circuit(std::move(circuit))
     {}
 
+    /**
+     * @brief Constructs a RoutingResult from a circuit and its statistics.
+     * @param circuit The routed circuit
+     * @param stats Mappings and statistics of the run
+     */
+    RoutingResult(ir::Circuit circuit, RoutingStats stats)
+        : RoutingStats(std::move(stats))
+        , routed_circuit(std::move(circuit))
+    {}
+
     // Move semantics
     RoutingResult(RoutingResult&&) noexcept = default;
     RoutingResult& operator=(RoutingResult&&) noexcept = default;
@@ -108,6 +284,111 @@ struct RoutingResult {
     RoutingResult& operator=(const RoutingResult&) = delete;
 };
 
+/**
+ * @brief Forwards routed gates to a GateSink, tracking depth on the fly.
+ *
+ * Routers emit through this instead of appending to an ir::Circuit, so the
+ * statistics a routed circuit would provide (gate count, depth, lowered
+ * two-qubit count, SWAP heatmap) are known without materializing it.
+ * Memory is O(num_qubits).
+ */
+class RoutedGateStream {
+public:
+    /**
+     * @brief Constructs a stream over a physical register.
+     * @param num_qubits Number of physical qubits
+     * @param sink Destination for emitted gates (must outlive the stream)
+     * @param num_clbits Number of classical bits written by measurements
+     */
+    RoutedGateStream(std::size_t num_qubits, const GateSink& sink,
+                     std::size_t num_clbits = 0)
+        : sink_(sink)
+        , qubit_depths_(num_qubits, 0)
+        , clbit_depths_(num_clbits, 0)
+        , swap_participation_(num_qubits, 0)
+    {}
+
+    /**
+     * @brief Assigns the next gate ID, updates depth, and forwards the gate.
+     *
+     * Depth is tracked over qubits and classical bits, matching
+     * ir::Circuit::depth().
+     *
+     * @param gate Gate on physical qubits
+     */
+    void emit(ir::Gate gate) {
+        gate.setId(num_gates_++);
+
+        const auto clbit = gate.clbit();
+        std::size_t level = clbit ? clbit_depths_[*clbit] : 0;
+        for (auto q : gate.qubits()) {
+            level = std::max(level, qubit_depths_[q]);
+        }
+        ++level;
+        for (auto q : gate.qubits()) {
+            qubit_depths_[q] = level;
+        }
+        if (clbit) {
+            clbit_depths_[*clbit] = level;
+        }
+        depth_ = std::max(depth_, level);
+        lowered_two_qubit_gates_ += loweredTwoQubitCost(gate.type());
+
+        sink_(gate);
+    }
+
+    /**
+     * @brief Emits a SWAP inserted by the router.
+     *
+     * Same as emit(Gate::swap(p0, p1)), but also counts the SWAP in the
+     * participation heatmap (SWAPs present in the input circuit are not).
+     */
+    void emitSwap(std::size_t p0, std::size_t p1) {
+        ++swap_participation_[p0];
+        ++swap_participation_[p1];
+        emit(ir::Gate::swap(p0, p1));
+    }
+
+    /**
+     * @brief Adds to the heatmap for SWAPs emitted via emit() by a sub-router.
+     * @param p Physical qubit
+     * @param count Number of inserted SWAPs touching p
+     */
+    void addSwapParticipation(std::size_t p, std::size_t count) {
+        swap_participation_[p] += count;
+    }
+
+    /// @brief Returns the depth of the gates emitted so far.
+    [[nodiscard]] std::size_t depth() const noexcept { return depth_; }
+
+    /// @brief Returns the depth reached so far on one physical qubit.
+    [[nodiscard]] std::size_t qubitDepth(std::size_t p) const noexcept {
+        return qubit_depths_[p];
+    }
+
+    /// @brief Returns the number of gates emitted so far.
+    [[nodiscard]] std::size_t numGates() const noexcept { return num_gates_; }
+
+    /// @brief Returns the two-qubit count after lowering SWAP to 3 CX.
+    [[nodiscard]] std::size_t loweredTwoQubitGates() const noexcept {
+        return lowered_two_qubit_gates_;
+    }
+
+    /// @brief Returns inserted SWAPs per physical qubit.
+    [[nodiscard]] const std::vector<std::size_t>& swapParticipation() const noexcept {
+        return swap_participation_;
+    }
+
+private:
+    const GateSink& sink_;
+    std::vector<std::size_t> qubit_depths_;
+    std::vector<std::size_t> clbit_depths_;
+    std::vector<std::size_t> swap_participation_;
+    std::size_t depth_ = 0;
+    std::size_t num_gates_ = 0;
+    std::size_t lowered_two_qubit_gates_ = 0;
+};
+
 /**
  * @brief Abstract base class for qubit routing algorithms.
  *
@@ -164,9 +445,49 @@ public:
         const ir::Circuit& circuit,
         const Topology& topology) = 0;
 
+    /**
+     * @brief Routes a circuit, streaming routed gates to a sink.
+     *
+     * Gates are passed to the sink in the same order (and with the same
+     * IDs) as route() would store them, but the routed circuit is never
+     * held in memory by routers that override this. The default
+     * implementation materializes via route() and replays the result.
+     *
+     * @param circuit The logical circuit to route
+     * @param topology The physical device topology
+     * @param sink Receives each routed gate on physical qubits
+     * @return Mappings and statistics of the run
+     * @throws std::invalid_argument if circuit has more qubits than topology
+     */
+    virtual RoutingStats routeTo(
+        const ir::Circuit& circuit,
+        const Topology& topology,
+        const GateSink& sink) {
+        RoutingResult result = route(circuit, topology);
+        for (const auto& gate : result.routed_circuit) {
+            sink(gate);
+        }
+        return std::move(static_cast<RoutingStats&>(result));
+    }
+
 protected:
     Router() = default;  // Only constructible via derived classes
 
+    /**
+     * @brief Implements route() on top of routeTo() for streaming routers.
+     * @param circuit The logical circuit to route
+     * @param topology The physical device topology
+     * @return RoutingResult with the collected circuit
+     */
+    [[nodiscard]] RoutingResult collectRoute(const ir::Circuit& circuit,
+                                             const Topology& topology) {
+        ir::Circuit routed(topology.numQubits(), circuit.numClbits());
+        routed.parameterTable() = circuit.parameterTable();
+        RoutingStats stats = routeTo(circuit, topology,
+                                     [&routed](const ir::Gate& gate) { routed.addGate(gate); });
+        return RoutingResult(std::move(routed), std::move(stats));
+    }
+
     /**
      * @brief Validates that a circuit can be routed on a topology.
      * @param circuit The circuit to validate
@@ -224,6 +545,11 @@ public:
         result.swaps_inserted = 0;
         result.original_depth = circuit.depth();
         result.final_depth = result.routed_circuit.depth();
+        result.gates_emitted = result.routed_circuit.numGates();
+        result.telemetry.swap_participation.assign(topology.numQubits(), 0);
+        for (const auto& gate : result.routed_circuit) {
+            result.telemetry.lowered_two_qubit_gates += loweredTwoQubitCost(gate.type());
+        }
 
         return result;
     }
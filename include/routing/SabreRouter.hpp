@@ -23,15 +23,18 @@
 #include "../ir/Circuit.hpp"
 #include "../ir/DAG.hpp"
 #include "../ir/Gate.hpp"
+#include "LookaheadWindow.hpp"
 #include "Router.hpp"
 #include "Topology.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <random>
+#include <stdexcept>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 namespace qopt::routing {
@@ -44,9 +47,15 @@ namespace qopt::routing {
  * 1. **Front Layer**: Identify gates with satisfied dependencies
  * 2. **Executable Check**: If front layer gates are on adjacent qubits, execute
  * 3. **SWAP Selection**: Otherwise, score candidate SWAPs and insert best one
- * 4. **Lookahead**: Consider future gates when scoring SWAPs
- *
- * The algorithm runs forward and optionally backward passes for refinement.
+ * 4. **Lookahead**: Consider future gates when scoring SWAPs, layer by layer,
+ *    laid out from the front after gates execute (see LookaheadWindow.hpp)
+ * 5. **Depth tie-break** (optional): Among equally scored SWAPs, prefer the
+ *    one on the least deep qubits, keeping SWAPs off the critical path
+ * 6. **Progress guarantee**: If many SWAPs pass without executing a gate, the
+ *    oldest blocked gate is routed directly along a shortest path
+ * 7. **Layout trials** (optional): Try several initial mappings, each also
+ *    refined by routing the circuit forward and then backward, and keep
+ *    the one that needs the fewest SWAPs
  *
  * Example:
  * @code
@@ -63,18 +72,31 @@ class SabreRouter : public Router {
 public:
     /**
      * @brief Constructs a SABRE router with optional parameters.
-     * @param lookahead_depth How many layers ahead to consider (default: 20)
-     * @param decay_factor Weight decay for distant gates (default: 0.5)
+     * @param lookahead_depth Maximum two-qubit gates in the lookahead window (default: 20)
+     * @param decay_factor Per-layer weight decay for lookahead gates (default: 0.5)
      * @param extended_set_weight Weight for extended set in scoring (default: 0.5)
+     * @param depth_tie_break Break score ties toward SWAPs on less deep qubits
+     *        instead of by candidate order (default: false)
+     * @param layout_trials Initial mappings to try; 1 routes from the
+     *        identity mapping only (default: 1)
+     * @throws std::invalid_argument if layout_trials is 0
      */
     explicit SabreRouter(std::size_t lookahead_depth = 20,
                          double decay_factor = 0.5,
-                         double extended_set_weight = 0.5)
+                         double extended_set_weight = 0.5,
+                         bool depth_tie_break = false,
+                         std::size_t layout_trials = 1)
         : lookahead_depth_(lookahead_depth)
         , decay_factor_(decay_factor)
         , extended_set_weight_(extended_set_weight)
+        , depth_tie_break_(depth_tie_break)
+        , layout_trials_(layout_trials)
         , rng_(std::random_device{}())
-    {}
+    {
+        if (layout_trials_ == 0) {
+            throw std::invalid_argument("SabreRouter needs at least one layout trial");
+        }
+    }
 
     [[nodiscard]] std::string name() const override {
         return "SabreRouter";
@@ -83,45 +105,73 @@ public:
     [[nodiscard]] RoutingResult route(
         const ir::Circuit& circuit,
         const Topology& topology) override {
+        return collectRoute(circuit, topology);
+    }
+
+    /**
+     * @brief Routes a circuit, streaming gates to a sink as they are placed.
+     *
+     * Depth and statistics are tracked while emitting, so the routed circuit
+     * is never materialized.
+     */
+    RoutingStats routeTo(
+        const ir::Circuit& circuit,
+        const Topology& topology,
+        const GateSink& sink) override {
         validateRouteInputs(circuit, topology);
 
+        RoutingStats stats;
+        stats.initial_mapping = identityMapping(circuit.numQubits());
+        stats.telemetry.parameters = parameters();
+        stats.telemetry.swap_participation.assign(topology.numQubits(), 0);
         if (circuit.empty()) {
-            RoutingResult result(ir::Circuit(circuit.numQubits()));
-            result.initial_mapping = identityMapping(circuit.numQubits());
-            result.final_mapping = result.initial_mapping;
-            result.original_depth = 0;
-            result.final_depth = 0;
-            return result;
+            stats.final_mapping = stats.initial_mapping;
+            return stats;
         }
 
-        std::size_t original_depth = circuit.depth();
-
-        // Initialize mapping
-        auto mapping = initialMapping(circuit, topology);
-        auto reverse_mapping = computeReverseMapping(mapping, topology.numQubits());
+        stats.original_depth = circuit.depth();
 
         // Build the circuit DAG
         ir::DAG dag = ir::DAG::fromCircuit(circuit);
 
+        // Initialize mapping
+        auto mapping = layout_trials_ > 1 ? bestInitialMapping(circuit, dag, topology)
+                                          : initialMapping(circuit, topology);
+        auto reverse_mapping = computeReverseMapping(mapping, topology.numQubits());
+        stats.initial_mapping = mapping;
+
         // Route using SABRE forward pass
-        ir::Circuit routed(topology.numQubits());
-        std::size_t swaps = routeForward(dag, topology, mapping, reverse_mapping, routed);
-
-        // Build result
-        RoutingResult result(std::move(routed));
-        result.initial_mapping = identityMapping(circuit.numQubits());
-        result.final_mapping = mapping;
-        result.swaps_inserted = swaps;
-        result.original_depth = original_depth;
-        result.final_depth = result.routed_circuit.depth();
-
-        return result;
+        RoutedGateStream out(topology.numQubits(), sink, circuit.numClbits());
+        stats.swaps_inserted = routeForward(dag, topology, mapping, reverse_mapping, out,
+                                            stats.telemetry);
+
+        stats.final_mapping = mapping;
+        stats.final_depth = out.depth();
+        stats.gates_emitted = out.numGates();
+        stats.telemetry.swap_participation = out.swapParticipation();
+        stats.telemetry.lowered_two_qubit_gates = out.loweredTwoQubitGates();
+
+        return stats;
+    }
+
+    /**
+     * @brief Returns the tuning parameters as recorded in telemetry.
+     * @return (name, value) pairs
+     */
+    [[nodiscard]] std::vector<std::pair<std::string, double>> parameters() const {
+        return {{"lookahead_depth", static_cast<double>(lookahead_depth_)},
+                {"decay_factor", decay_factor_},
+                {"extended_set_weight", extended_set_weight_},
+                {"depth_tie_break", depth_tie_break_ ? 1.0 : 0.0},
+                {"layout_trials", static_cast<double>(layout_trials_)}};
     }
 
 private:
     std::size_t lookahead_depth_;
     double decay_factor_;
     double extended_set_weight_;
+    bool depth_tie_break_;
+    std::size_t layout_trials_;
     mutable std::mt19937 rng_;
 
     /**
@@ -146,6 +196,62 @@ private:
         return mapping;
     }
 
+    /**
+     * @brief Returns the initial mapping that needs the fewest SWAPs.
+     *
+     * Trial 0 starts from initialMapping(), the others from permutations
+     * of it seeded by the trial number, so results are reproducible. Each
+     * start is scored as is and after SABRE's refinement: routing the
+     * circuit forward and then in reverse ends in a mapping suited to the
+     * circuit's first gates. Scoring routes into a discarding sink, so a
+     * trial costs four forward passes.
+     */
+    [[nodiscard]] std::vector<std::size_t> bestInitialMapping(
+        const ir::Circuit& circuit,
+        const ir::DAG& dag,
+        const Topology& topology) const {
+
+        ir::Circuit reversed(circuit.numQubits(), circuit.numClbits());
+        reversed.parameterTable() = circuit.parameterTable();
+        for (std::size_t i = circuit.numGates(); i-- > 0;) {
+            reversed.addGate(circuit[i]);
+        }
+        const ir::DAG reversed_dag = ir::DAG::fromCircuit(reversed);
+
+        const GateSink discard = [](const ir::Gate&) {};
+        auto swapsFrom = [&](const ir::DAG& d, std::vector<std::size_t>& mapping) {
+            auto reverse_mapping = computeReverseMapping(mapping, topology.numQubits());
+            RoutedGateStream out(topology.numQubits(), discard, circuit.numClbits());
+            RoutingTelemetry scratch;
+            return routeForward(d, topology, mapping, reverse_mapping, out, scratch);
+        };
+
+        std::vector<std::size_t> best;
+        std::size_t best_swaps = std::numeric_limits<std::size_t>::max();
+        auto consider = [&](const std::vector<std::size_t>& start) {
+            std::vector<std::size_t> mapping = start;
+            const std::size_t swaps = swapsFrom(dag, mapping);
+            if (swaps < best_swaps) {
+                best_swaps = swaps;
+                best = start;
+            }
+        };
+
+        for (std::size_t trial = 0; trial < layout_trials_; ++trial) {
+            std::vector<std::size_t> start = initialMapping(circuit, topology);
+            if (trial > 0) {
+                std::mt19937 rng(static_cast<std::mt19937::result_type>(trial));
+                std::shuffle(start.begin(), start.end(), rng);
+            }
+            consider(start);
+
+            swapsFrom(dag, start);
+            swapsFrom(reversed_dag, start);
+            consider(start);
+        }
+        return best;
+    }
+
     /**
      * @brief Computes the reverse mapping (physical -> logical).
      */
@@ -163,8 +269,47 @@ private:
     /// @brief Sentinel for unmapped physical qubits
     static constexpr std::size_t INVALID_LOGICAL = std::numeric_limits<std::size_t>::max();
 
+    /**
+     * @brief Scratch state for one routing run.
+     *
+     * Per-gate counters are dense vectors indexed by GateId (the DAG is
+     * freshly built from the circuit, so IDs are contiguous). The scoring
+     * buffers are cleared and refilled rather than reallocated each step.
+     */
+    struct RoutingState {
+        std::vector<std::size_t> remaining_deps;  ///< Unexecuted predecessors
+
+        // Scoring rows (SoA): one per front/lookahead two-qubit gate
+        std::vector<std::uint32_t> row_p0;        ///< Physical endpoint 0
+        std::vector<std::uint32_t> row_p1;        ///< Physical endpoint 1
+        std::vector<double> row_weight;           ///< 1 for front, decayed for lookahead
+        std::vector<double> row_distance;         ///< Current distance of the pair
+
+        // Incidence lists: row endpoints threaded per physical qubit.
+        // Entry e = 2 * row + endpoint; first_entry is indexed by physical qubit.
+        std::vector<std::size_t> first_entry;
+        std::vector<std::size_t> next_entry;
+
+        // Candidate SWAPs (SoA) and their score deltas
+        std::vector<std::size_t> active;          ///< Physical qubits of blocked gates
+        std::vector<std::size_t> active_rank;     ///< Position in active, per physical
+        std::vector<std::uint32_t> cand_a;
+        std::vector<std::uint32_t> cand_b;
+        std::vector<double> cand_delta;
+    };
+
+    /// @brief Sentinel terminating incidence lists and unranked qubits.
+    static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+    /// @brief SWAPs without an executed gate allowed per physical qubit.
+    static constexpr std::size_t STALL_FACTOR = 10;
+
     /**
      * @brief Forward pass of SABRE routing.
+     *
+     * Rounds, candidates scored, fallbacks and the scoring/bookkeeping time
+     * split are added to telemetry.
+     *
      * @return Number of SWAPs inserted
      */
     std::size_t routeForward(
@@ -172,23 +317,45 @@ private:
         const Topology& topology,
         std::vector<std::size_t>& mapping,
         std::vector<std::size_t>& reverse_mapping,
-        ir::Circuit& routed) const {
+        RoutedGateStream& out,
+        RoutingTelemetry& telemetry) const {
+
+        using Clock = std::chrono::steady_clock;
+        const auto loop_start = Clock::now();
+        Clock::duration scoring_time{0};
 
         std::size_t swaps_inserted = 0;
 
-        // Track executed gates
-        std::unordered_set<GateId> executed;
+        // Dense per-gate dependency counters
+        std::size_t id_bound = 0;
+        for (GateId id : dag.nodeIds()) {
+            id_bound = std::max(id_bound, id + 1);
+        }
 
-        // Track remaining predecessors for each gate
-        std::unordered_map<GateId, std::size_t> remaining_deps;
+        RoutingState state;
+        state.remaining_deps.assign(id_bound, 0);
+        state.first_entry.assign(topology.numQubits(), NONE);
+        state.active_rank.assign(topology.numQubits(), NONE);
         for (GateId id : dag.nodeIds()) {
-            remaining_deps[id] = dag.node(id).inDegree();
+            state.remaining_deps[id] = dag.node(id).inDegree();
         }
 
+        // Extended set: follows the front as gates execute
+        LookaheadWindow window(lookahead_depth_, extended_set_weight_, decay_factor_);
+        window.reset(dag);
+
         // Front layer: gates ready to execute (all predecessors executed)
         auto front_layer = dag.sources();
 
+        // SWAPs since a gate last executed. Scores can cycle (e.g. through
+        // the depth tie-break), so past the limit the oldest blocked gate is
+        // routed directly, which bounds the SWAPs between executed gates.
+        const std::size_t stall_limit = STALL_FACTOR * topology.numQubits();
+        std::size_t swaps_since_progress = 0;
+
         while (!front_layer.empty()) {
+            ++telemetry.rounds;
+
             // Try to execute gates in front layer
             std::vector<GateId> executed_this_round;
             std::vector<GateId> blocked;
@@ -196,34 +363,38 @@ private:
             for (GateId id : front_layer) {
                 const ir::Gate& gate = dag.node(id).gate();
 
-                if (gate.numQubits() == 1) {
-                    // Single-qubit gates: always executable
+                if (!ir::isMultiQubitGate(gate.type())) {
+                    // Single-qubit gates, measurements and barriers impose
+                    // no connectivity constraint: always executable
                     // Map logical to physical
-                    std::size_t physical = mapping[gate.qubits()[0]];
-                    routed.addGate(ir::Gate(gate.type(), {physical}, gate.parameter()));
+                    std::vector<QubitIndex> physical;
+                    physical.reserve(gate.numQubits());
+                    for (auto q : gate.qubits()) {
+                        physical.push_back(mapping[q]);
+                    }
+                    out.emit(gate.withQubits(std::move(physical)));
                     executed_this_round.push_back(id);
-                } else {
-                    // Two-qubit gate: check if qubits are adjacent
-                    std::size_t p0 = mapping[gate.qubits()[0]];
-                    std::size_t p1 = mapping[gate.qubits()[1]];
-
-                    if (topology.connected(p0, p1)) {
-                        // Executable: add to routed circuit with physical qubits
-                        routed.addGate(ir::Gate(gate.type(), {p0, p1}, gate.parameter()));
-                        executed_this_round.push_back(id);
-                    } else {
-                        blocked.push_back(id);
+                } else if (blockingQubit(gate, topology, mapping) == NONE) {
+                    // Executable: emit with physical qubits
+                    std::vector<QubitIndex> physical;
+                    physical.reserve(gate.numQubits());
+                    for (auto q : gate.qubits()) {
+                        physical.push_back(mapping[q]);
                     }
+                    out.emit(gate.withQubits(std::move(physical)));
+                    executed_this_round.push_back(id);
+                } else {
+                    blocked.push_back(id);
                 }
             }
 
             if (!executed_this_round.empty()) {
                 // Mark executed and update front layer
                 for (GateId id : executed_this_round) {
-                    executed.insert(id);
+                    window.execute(dag, id);
                     // Update successors
                     for (GateId succ : dag.node(id).successors()) {
-                        if (--remaining_deps[succ] == 0) {
+                        if (--state.remaining_deps[succ] == 0) {
                             blocked.push_back(succ);  // Now ready
                         }
                     }
@@ -231,153 +402,285 @@ private:
 
                 // Update front layer: blocked gates + newly ready gates
                 front_layer = blocked;
+                swaps_since_progress = 0;
+            } else if (swaps_since_progress >= stall_limit) {
+                // Stalled: route the oldest blocked gate along shortest paths
+                ++telemetry.fallbacks;
+                swaps_inserted += forceRoute(dag.node(blocked[0]).gate(), topology,
+                                             mapping, reverse_mapping, out);
+                swaps_since_progress = 0;
             } else {
                 // No progress - need to insert SWAPs
+                // SWAPs do not change the DAG, so the window is only laid
+                // out again after gates have executed.
+                const auto scoring_start = Clock::now();
+                const auto& lookahead = window.entries(dag);
+
                 // Find best SWAP to make progress on blocked gates
-                auto best_swap = selectBestSwap(
-                    dag, topology, mapping, reverse_mapping, blocked, executed, remaining_deps);
+                auto best_swap = selectBestSwap(dag, topology, mapping, blocked, lookahead,
+                                                out, state);
+                telemetry.candidates_scored += state.cand_a.size();
+                scoring_time += Clock::now() - scoring_start;
 
                 if (best_swap.first != INVALID_LOGICAL) {
                     // Insert SWAP
                     insertSwap(best_swap.first, best_swap.second,
-                               mapping, reverse_mapping, routed);
+                               mapping, reverse_mapping, out);
                     ++swaps_inserted;
+                    ++swaps_since_progress;
                 } else {
                     // No valid SWAP found - this shouldn't happen
-                    // Fall back: just pick any blocked gate and force a path
-                    if (!blocked.empty()) {
-                        const ir::Gate& gate = dag.node(blocked[0]).gate();
-                        std::size_t p0 = mapping[gate.qubits()[0]];
-                        std::size_t p1 = mapping[gate.qubits()[1]];
-                        auto path = topology.shortestPath(p0, p1);
-                        if (path.size() >= 2) {
-                            insertSwap(path[0], path[1], mapping, reverse_mapping, routed);
-                            ++swaps_inserted;
-                        }
-                    }
+                    // Fall back: force a path for the oldest blocked gate
+                    ++telemetry.fallbacks;
+                    swaps_inserted += forceRoute(dag.node(blocked[0]).gate(), topology,
+                                                 mapping, reverse_mapping, out);
                 }
             }
         }
 
+        using Ms = std::chrono::duration<double, std::milli>;
+        const auto total_time = Clock::now() - loop_start;
+        telemetry.scoring_ms += Ms(scoring_time).count();
+        telemetry.bookkeeping_ms += Ms(total_time - scoring_time).count();
+
         return swaps_inserted;
     }
 
     /**
-     * @brief Selects the best SWAP to make progress on blocked gates.
+     * @brief Finds a qubit of a gate that is not adjacent to its last qubit.
      *
-     * Uses SABRE's heuristic scoring:
-     * - Consider SWAPs adjacent to qubits in blocked gates
-     * - Score = distance reduction for front layer + lookahead bonus
+     * A gate is executable when every other qubit neighbors its last one:
+     * for two-qubit gates the pair is connected, for CCX the target sits
+     * between both controls.
+     *
+     * @return Position of the first such qubit, or NONE if executable
      */
-    [[nodiscard]] std::pair<std::size_t, std::size_t> selectBestSwap(
-        const ir::DAG& dag,
+    [[nodiscard]] static std::size_t blockingQubit(
+        const ir::Gate& gate,
         const Topology& topology,
-        const std::vector<std::size_t>& mapping,
-        const std::vector<std::size_t>& /*reverse_mapping*/,
-        const std::vector<GateId>& front_layer,
-        const std::unordered_set<GateId>& executed,
-        const std::unordered_map<GateId, std::size_t>& remaining_deps) const {
-
-        double best_score = std::numeric_limits<double>::max();
-        std::pair<std::size_t, std::size_t> best_swap = {INVALID_LOGICAL, INVALID_LOGICAL};
+        const std::vector<std::size_t>& mapping) {
+        const auto& qubits = gate.qubits();
+        const std::size_t last = mapping[qubits.back()];
+        for (std::size_t i = 0; i + 1 < qubits.size(); ++i) {
+            if (!topology.connected(mapping[qubits[i]], last)) return i;
+        }
+        return NONE;
+    }
 
-        // Collect physical qubits involved in blocked two-qubit gates
-        std::unordered_set<std::size_t> active_physical;
-        for (GateId id : front_layer) {
-            const ir::Gate& gate = dag.node(id).gate();
-            if (gate.numQubits() == 2) {
-                active_physical.insert(mapping[gate.qubits()[0]]);
-                active_physical.insert(mapping[gate.qubits()[1]]);
+    /**
+     * @brief Inserts SWAPs until a multi-qubit gate is executable.
+     *
+     * Each blocking qubit is moved along a shortest path to a free neighbor
+     * of the gate's last qubit. The path avoids the gate's other qubits, so
+     * qubits already in place stay there and the loop ends after at most
+     * one path per qubit. If the topology leaves no such path, one SWAP
+     * toward the last qubit is inserted instead.
+     *
+     * @return Number of SWAPs inserted
+     */
+    std::size_t forceRoute(
+        const ir::Gate& gate,
+        const Topology& topology,
+        std::vector<std::size_t>& mapping,
+        std::vector<std::size_t>& reverse_mapping,
+        RoutedGateStream& out) const {
+
+        std::size_t swaps = 0;
+        const auto& qubits = gate.qubits();
+        for (std::size_t i = blockingQubit(gate, topology, mapping); i != NONE;
+             i = blockingQubit(gate, topology, mapping)) {
+            const std::size_t from = mapping[qubits[i]];
+            const std::size_t target = mapping[qubits.back()];
+
+            // BFS from the blocking qubit around the gate's other qubits
+            std::vector<std::size_t> parent(topology.numQubits(), NONE);
+            for (auto q : qubits) parent[mapping[q]] = mapping[q];
+            parent[from] = from;
+            std::vector<std::size_t> queue{from};
+            std::size_t end = NONE;
+            for (std::size_t head = 0; head < queue.size() && end == NONE; ++head) {
+                for (std::size_t neighbor : topology.neighbors(queue[head])) {
+                    if (parent[neighbor] != NONE) continue;
+                    parent[neighbor] = queue[head];
+                    if (topology.connected(neighbor, target)) {
+                        end = neighbor;
+                        break;
+                    }
+                    queue.push_back(neighbor);
+                }
             }
-        }
 
-        // Consider SWAPs on edges involving active qubits
-        for (std::size_t p : active_physical) {
-            for (std::size_t neighbor : topology.neighbors(p)) {
-                // Score this SWAP
-                double score = scoreSwap(
-                    p, neighbor, dag, topology, mapping, front_layer, executed, remaining_deps);
+            std::vector<std::size_t> path;
+            if (end != NONE) {
+                for (std::size_t p = end; p != from; p = parent[p]) path.push_back(p);
+                path.push_back(from);
+                std::reverse(path.begin(), path.end());
+            } else {
+                path = topology.shortestPath(from, target);
+                path.resize(2);
+            }
 
-                if (score < best_score) {
-                    best_score = score;
-                    best_swap = {p, neighbor};
-                }
+            for (std::size_t k = 0; k + 1 < path.size(); ++k) {
+                insertSwap(path[k], path[k + 1], mapping, reverse_mapping, out);
+                ++swaps;
             }
+            if (end == NONE) break;
         }
-
-        return best_swap;
+        return swaps;
     }
 
     /**
-     * @brief Scores a candidate SWAP.
+     * @brief Selects the best SWAP to make progress on blocked gates.
+     *
+     * Uses SABRE's heuristic scoring:
+     * - Consider SWAPs on edges touching qubits of blocked gates
+     * - Score = distance for front layer + weighted lookahead distance
      *
-     * Lower score = better SWAP.
-     * Score considers:
-     * - Distance reduction for front layer gates
-     * - Distance reduction for lookahead gates (with decay)
+     * All candidates for the step are scored in one batch. Front and
+     * lookahead gates are packed into SoA rows (physical endpoints, weight,
+     * current distance), and each row is threaded onto incidence lists of
+     * its two physical qubits. A SWAP (a, b) only changes rows incident to a
+     * or b, so a candidate's score is the shared base score plus a delta
+     * gathered from those rows via the flat distance matrix. The winner is
+     * found with a min-reduction over the delta array. With the depth
+     * tie-break, ties go to the candidate whose deeper qubit is shallowest
+     * in the routed output so far: a SWAP there fills idle time instead of
+     * extending the critical path. Remaining ties go to the first candidate
+     * in front-layer order.
      */
-    [[nodiscard]] double scoreSwap(
-        std::size_t p0,
-        std::size_t p1,
+    [[nodiscard]] std::pair<std::size_t, std::size_t> selectBestSwap(
         const ir::DAG& dag,
         const Topology& topology,
         const std::vector<std::size_t>& mapping,
         const std::vector<GateId>& front_layer,
-        const std::unordered_set<GateId>& executed,
-        const std::unordered_map<GateId, std::size_t>& /*remaining_deps*/) const {
-
-        // Simulate the SWAP
-        auto new_mapping = mapping;
-        std::size_t logical0 = INVALID_LOGICAL;
-        std::size_t logical1 = INVALID_LOGICAL;
-
-        // Find which logical qubits are at these physical positions
-        for (std::size_t l = 0; l < mapping.size(); ++l) {
-            if (mapping[l] == p0) logical0 = l;
-            if (mapping[l] == p1) logical1 = l;
+        const std::vector<LookaheadEntry>& lookahead,
+        const RoutedGateStream& out,
+        RoutingState& state) const {
+
+        const std::size_t n = topology.numQubits();
+        const std::uint32_t* dist = topology.distanceMatrix().data();
+
+        // Pack rows: front layer (weight 1), then the lookahead window
+        state.row_p0.clear();
+        state.row_p1.clear();
+        state.row_weight.clear();
+        state.active.clear();
+
+        // One row per qubit that must neighbor the gate's last qubit: the
+        // pair of a two-qubit gate, or each control of CCX with its target
+        auto push_row = [&](const ir::Gate& gate, double weight) {
+            const auto& qubits = gate.qubits();
+            const auto last = static_cast<std::uint32_t>(mapping[qubits.back()]);
+            for (std::size_t i = 0; i + 1 < qubits.size(); ++i) {
+                state.row_p0.push_back(static_cast<std::uint32_t>(mapping[qubits[i]]));
+                state.row_p1.push_back(last);
+                state.row_weight.push_back(weight);
+            }
+        };
+
+        for (GateId id : front_layer) {
+            const ir::Gate& gate = dag.node(id).gate();
+            if (ir::isMultiQubitGate(gate.type())) {
+                push_row(gate, 1.0);
+                for (auto q : gate.qubits()) {
+                    std::size_t p = mapping[q];
+                    if (state.active_rank[p] == NONE) {
+                        state.active_rank[p] = state.active.size();
+                        state.active.push_back(p);
+                    }
+                }
+            }
+        }
+        for (const auto& entry : lookahead) {
+            push_row(dag.node(entry.id).gate(), entry.weight);
         }
 
-        // Apply SWAP to mapping
-        if (logical0 != INVALID_LOGICAL) new_mapping[logical0] = p1;
-        if (logical1 != INVALID_LOGICAL) new_mapping[logical1] = p0;
+        const std::size_t num_rows = state.row_p0.size();
+        state.row_distance.resize(num_rows);
+        state.next_entry.resize(2 * num_rows);
 
-        // Score: total distance for front layer gates
-        double score = 0.0;
+        for (std::size_t r = 0; r < num_rows; ++r) {
+            std::size_t x = state.row_p0[r];
+            std::size_t y = state.row_p1[r];
+            state.row_distance[r] = static_cast<double>(dist[x * n + y]);
 
-        // Front layer contribution
-        for (GateId id : front_layer) {
-            const ir::Gate& gate = dag.node(id).gate();
-            if (gate.numQubits() == 2) {
-                std::size_t new_p0 = new_mapping[gate.qubits()[0]];
-                std::size_t new_p1 = new_mapping[gate.qubits()[1]];
-                score += static_cast<double>(topology.distance(new_p0, new_p1));
+            state.next_entry[2 * r] = state.first_entry[x];
+            state.first_entry[x] = 2 * r;
+            state.next_entry[2 * r + 1] = state.first_entry[y];
+            state.first_entry[y] = 2 * r + 1;
+        }
+
+        // Candidates: edges touching active qubits, each undirected edge once
+        state.cand_a.clear();
+        state.cand_b.clear();
+        for (std::size_t p : state.active) {
+            for (std::size_t neighbor : topology.neighbors(p)) {
+                // Already generated as (neighbor, p) from an earlier active qubit
+                if (state.active_rank[neighbor] < state.active_rank[p]) continue;
+                state.cand_a.push_back(static_cast<std::uint32_t>(p));
+                state.cand_b.push_back(static_cast<std::uint32_t>(neighbor));
             }
         }
 
-        // Extended set (lookahead) contribution
-        // Limit extended set size based on lookahead_depth_
-        std::unordered_set<GateId> extended;
-        for (GateId id : front_layer) {
-            if (extended.size() >= lookahead_depth_) break;
-            for (GateId succ : dag.node(id).successors()) {
-                if (executed.find(succ) == executed.end()) {
-                    extended.insert(succ);
-                }
+        // Score every candidate: delta over rows incident to a or b
+        const std::size_t num_cands = state.cand_a.size();
+        state.cand_delta.resize(num_cands);
+        for (std::size_t c = 0; c < num_cands; ++c) {
+            const std::size_t a = state.cand_a[c];
+            const std::size_t b = state.cand_b[c];
+            double delta = 0.0;
+
+            for (std::size_t e = state.first_entry[a]; e != NONE; e = state.next_entry[e]) {
+                std::size_t r = e >> 1;
+                std::size_t other = (e & 1) ? state.row_p0[r] : state.row_p1[r];
+                if (other == b) continue;  // SWAP(a, b) keeps the pair's distance
+                delta += state.row_weight[r] *
+                         (static_cast<double>(dist[b * n + other]) - state.row_distance[r]);
+            }
+            for (std::size_t e = state.first_entry[b]; e != NONE; e = state.next_entry[e]) {
+                std::size_t r = e >> 1;
+                std::size_t other = (e & 1) ? state.row_p0[r] : state.row_p1[r];
+                if (other == a) continue;
+                delta += state.row_weight[r] *
+                         (static_cast<double>(dist[a * n + other]) - state.row_distance[r]);
             }
+
+            state.cand_delta[c] = delta;
         }
 
-        double decay = decay_factor_;
-        for (GateId id : extended) {
-            const ir::Gate& gate = dag.node(id).gate();
-            if (gate.numQubits() == 2) {
-                std::size_t new_p0 = new_mapping[gate.qubits()[0]];
-                std::size_t new_p1 = new_mapping[gate.qubits()[1]];
-                score += decay * extended_set_weight_ *
-                         static_cast<double>(topology.distance(new_p0, new_p1));
+        // Min-reduction, then the first candidate attaining it
+        std::pair<std::size_t, std::size_t> best_swap = {INVALID_LOGICAL, INVALID_LOGICAL};
+        if (num_cands > 0) {
+            double best = state.cand_delta[0];
+            for (std::size_t c = 1; c < num_cands; ++c) {
+                best = std::min(best, state.cand_delta[c]);
+            }
+            std::size_t best_depth = std::numeric_limits<std::size_t>::max();
+            for (std::size_t c = 0; c < num_cands; ++c) {
+                if (state.cand_delta[c] != best) continue;
+                if (!depth_tie_break_) {
+                    best_swap = {state.cand_a[c], state.cand_b[c]};
+                    break;
+                }
+                const std::size_t depth = std::max(out.qubitDepth(state.cand_a[c]),
+                                                   out.qubitDepth(state.cand_b[c]));
+                if (depth < best_depth) {
+                    best_depth = depth;
+                    best_swap = {state.cand_a[c], state.cand_b[c]};
+                }
             }
         }
 
-        return score;
+        // Reset per-qubit scratch for the next step
+        for (std::size_t r = 0; r < num_rows; ++r) {
+            state.first_entry[state.row_p0[r]] = NONE;
+            state.first_entry[state.row_p1[r]] = NONE;
+        }
+        for (std::size_t p : state.active) {
+            state.active_rank[p] = NONE;
+        }
+
+        return best_swap;
     }
 
     /**
@@ -388,10 +691,10 @@ private:
         std::size_t p1,
         std::vector<std::size_t>& mapping,
         std::vector<std::size_t>& reverse_mapping,
-        ir::Circuit& routed) const {
+        RoutedGateStream& out) const {
 
         // Add SWAP gate
-        routed.addGate(ir::Gate::swap(p0, p1));
+        out.emitSwap(p0, p1);
 
         // Update mappings
         std::size_t logical0 = reverse_mapping[p0];
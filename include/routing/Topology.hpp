@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <queue>
 #include <stdexcept>
@@ -38,7 +39,8 @@ namespace qopt::routing {
  * - Nodes represent physical qubits
  * - Edges represent direct two-qubit gate connectivity
  *
- * Distances between qubits are computed using BFS and cached for efficiency.
+ * Distances between qubits are computed using BFS and cached for efficiency
+ * in a flat row-major matrix (see distanceMatrix()).
  *
  * Example:
  * @code
@@ -166,7 +168,23 @@ public:
             return 0;
         }
         ensureDistanceComputed();
-        return distance_cache_[q1][q2];
+        std::uint32_t d = distance_cache_[q1 * num_qubits_ + q2];
+        return d == UNREACHABLE ? INFINITE : d;
+    }
+
+    /**
+     * @brief Returns the all-pairs distance matrix as a flat row-major array.
+     *
+     * Entry [q1 * numQubits() + q2] is the distance between q1 and q2, or
+     * UNREACHABLE if they are disconnected. Intended for hot loops (e.g.
+     * batched SWAP scoring) that gather many distances without the bounds
+     * checks of distance().
+     *
+     * @return Reference to the cached numQubits() x numQubits() matrix
+     */
+    [[nodiscard]] const std::vector<std::uint32_t>& distanceMatrix() const {
+        ensureDistanceComputed();
+        return distance_cache_;
     }
 
     /**
@@ -436,11 +454,14 @@ public:
     /// @brief Sentinel value for infinite distance (disconnected qubits)
     static constexpr std::size_t INFINITE = std::numeric_limits<std::size_t>::max();
 
+    /// @brief Sentinel for disconnected pairs in distanceMatrix()
+    static constexpr std::uint32_t UNREACHABLE = std::numeric_limits<std::uint32_t>::max();
+
 private:
     std::size_t num_qubits_;
     std::vector<std::vector<std::size_t>> adjacency_;  // Adjacency list
     std::vector<Edge> edges_;                          // All edges
-    mutable std::vector<std::vector<std::size_t>> distance_cache_;
+    mutable std::vector<std::uint32_t> distance_cache_;  // Flat row-major n x n
     mutable bool distance_computed_;
 
     /**
@@ -466,24 +487,24 @@ private:
             return;
         }
 
-        distance_cache_.assign(num_qubits_,
-                               std::vector<std::size_t>(num_qubits_, INFINITE));
+        distance_cache_.assign(num_qubits_ * num_qubits_, UNREACHABLE);
 
-        // BFS from each qubit
+        // BFS from each qubit, filling one matrix row at a time
+        std::vector<std::size_t> queue(num_qubits_);
         for (std::size_t start = 0; start < num_qubits_; ++start) {
-            std::queue<std::size_t> queue;
-            queue.push(start);
-            distance_cache_[start][start] = 0;
+            std::uint32_t* row = distance_cache_.data() + start * num_qubits_;
+            std::size_t head = 0;
+            std::size_t tail = 0;
+            queue[tail++] = start;
+            row[start] = 0;
 
-            while (!queue.empty()) {
-                std::size_t current = queue.front();
-                queue.pop();
+            while (head < tail) {
+                std::size_t current = queue[head++];
 
                 for (std::size_t neighbor : adjacency_[current]) {
-                    if (distance_cache_[start][neighbor] == INFINITE) {
-                        distance_cache_[start][neighbor] =
-                            distance_cache_[start][current] + 1;
-                        queue.push(neighbor);
+                    if (row[neighbor] == UNREACHABLE) {
+                        row[neighbor] = row[current] + 1;
+                        queue[tail++] = neighbor;
                     }
                 }
             }
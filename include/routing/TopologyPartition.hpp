@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file TopologyPartition.hpp
+ * @brief Partitioning of a device topology into connected regions
+ *
+ * Provides the TopologyPartition class, which splits the physical qubits of
+ * a Topology into connected regions of bounded size and records the coarse
+ * region graph (which regions share an edge). Each region can be extracted
+ * as a standalone Topology over local qubit indices, so any Router can be
+ * run on it unchanged.
+ *
+ * @see HierarchicalRouter.hpp for the router built on top of this
+ * @see Topology.hpp for device connectivity
+ */
+
+#pragma once
+
+#include "Topology.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace qopt::routing {
+
+/**
+ * @brief A partition of a topology's physical qubits into connected regions.
+ *
+ * Regions are grown by BFS from the lowest-numbered unassigned qubit, only
+ * through unassigned qubits, until they reach the requested size or run out
+ * of reachable qubits. Every region is therefore connected in the induced
+ * subgraph, and within a region qubits are listed in BFS order (nearby
+ * qubits get nearby local indices).
+ *
+ * Example:
+ * @code
+ * auto topology = Topology::grid(8, 8);
+ * auto partition = TopologyPartition::build(topology, 16);
+ *
+ * for (std::size_t r = 0; r < partition.numRegions(); ++r) {
+ *     Topology local = partition.regionTopology(topology, r);
+ *     // local qubit i is physical qubit partition.region(r)[i]
+ * }
+ * @endcode
+ */
+class TopologyPartition {
+public:
+    /**
+     * @brief Partitions a topology into connected regions.
+     * @param topology The device topology
+     * @param region_size Maximum number of physical qubits per region
+     * @return The partition
+     * @throws std::invalid_argument if region_size is 0
+     */
+    [[nodiscard]] static TopologyPartition build(const Topology& topology,
+                                                 std::size_t region_size) {
+        if (region_size == 0) {
+            throw std::invalid_argument("Region size must be positive");
+        }
+
+        const std::size_t n = topology.numQubits();
+        TopologyPartition partition;
+        partition.region_of_.assign(n, NO_REGION);
+        partition.local_index_.assign(n, 0);
+
+        for (std::size_t seed = 0; seed < n; ++seed) {
+            if (partition.region_of_[seed] != NO_REGION) continue;
+
+            const std::size_t r = partition.regions_.size();
+            std::vector<std::size_t> members;
+            members.push_back(seed);
+            partition.region_of_[seed] = r;
+
+            // members doubles as the BFS queue
+            for (std::size_t head = 0;
+                 head < members.size() && members.size() < region_size; ++head) {
+                for (std::size_t neighbor : topology.neighbors(members[head])) {
+                    if (members.size() >= region_size) break;
+                    if (partition.region_of_[neighbor] == NO_REGION) {
+                        partition.region_of_[neighbor] = r;
+                        members.push_back(neighbor);
+                    }
+                }
+            }
+
+            for (std::size_t i = 0; i < members.size(); ++i) {
+                partition.local_index_[members[i]] = i;
+            }
+            partition.regions_.push_back(std::move(members));
+        }
+
+        // Coarse graph: regions joined by at least one device edge
+        partition.region_adjacency_.resize(partition.regions_.size());
+        for (const auto& [q1, q2] : topology.edges()) {
+            std::size_t r1 = partition.region_of_[q1];
+            std::size_t r2 = partition.region_of_[q2];
+            if (r1 == r2) continue;
+            auto& adj1 = partition.region_adjacency_[r1];
+            if (std::find(adj1.begin(), adj1.end(), r2) == adj1.end()) {
+                adj1.push_back(r2);
+                partition.region_adjacency_[r2].push_back(r1);
+            }
+        }
+
+        return partition;
+    }
+
+    // -------------------------------------------------------------------------
+    // Queries
+    // -------------------------------------------------------------------------
+
+    /// @brief Returns the number of regions.
+    [[nodiscard]] std::size_t numRegions() const noexcept { return regions_.size(); }
+
+    /**
+     * @brief Returns the physical qubits of a region in local-index order.
+     * @param r Region index
+     * @throws std::out_of_range if r is invalid
+     */
+    [[nodiscard]] const std::vector<std::size_t>& region(std::size_t r) const {
+        validateRegion(r);
+        return regions_[r];
+    }
+
+    /// @brief Returns the region index of each physical qubit.
+    [[nodiscard]] const std::vector<std::size_t>& regionOf() const noexcept {
+        return region_of_;
+    }
+
+    /// @brief Returns each physical qubit's index within its region.
+    [[nodiscard]] const std::vector<std::size_t>& localIndex() const noexcept {
+        return local_index_;
+    }
+
+    /**
+     * @brief Returns the regions sharing at least one device edge with r.
+     * @param r Region index
+     * @throws std::out_of_range if r is invalid
+     */
+    [[nodiscard]] const std::vector<std::size_t>& adjacentRegions(std::size_t r) const {
+        validateRegion(r);
+        return region_adjacency_[r];
+    }
+
+    /**
+     * @brief Returns a shortest path of regions in the coarse graph.
+     * @param from Source region
+     * @param to Destination region
+     * @return Region indices from 'from' to 'to' inclusive
+     * @throws std::out_of_range if either region is invalid
+     * @throws std::runtime_error if the regions are not connected
+     */
+    [[nodiscard]] std::vector<std::size_t> regionPath(std::size_t from,
+                                                      std::size_t to) const {
+        validateRegion(from);
+        validateRegion(to);
+        if (from == to) {
+            return {from};
+        }
+
+        std::vector<std::size_t> parent(regions_.size(), NO_REGION);
+        std::vector<std::size_t> queue;
+        queue.push_back(from);
+        parent[from] = from;
+
+        for (std::size_t head = 0; head < queue.size() && parent[to] == NO_REGION; ++head) {
+            for (std::size_t next : region_adjacency_[queue[head]]) {
+                if (parent[next] == NO_REGION) {
+                    parent[next] = queue[head];
+                    queue.push_back(next);
+                }
+            }
+        }
+
+        if (parent[to] == NO_REGION) {
+            throw std::runtime_error(
+                "No path exists between regions " + std::to_string(from) +
+                " and " + std::to_string(to));
+        }
+
+        std::vector<std::size_t> path;
+        for (std::size_t current = to; current != from; current = parent[current]) {
+            path.push_back(current);
+        }
+        path.push_back(from);
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    /**
+     * @brief Extracts a region as a standalone topology.
+     *
+     * Local qubit i corresponds to physical qubit region(r)[i]; only device
+     * edges with both endpoints in the region are kept.
+     *
+     * @param topology The topology this partition was built from
+     * @param r Region index
+     * @return Topology over the region's local indices
+     * @throws std::out_of_range if r is invalid
+     */
+    [[nodiscard]] Topology regionTopology(const Topology& topology, std::size_t r) const {
+        validateRegion(r);
+        const auto& members = regions_[r];
+        Topology local(members.size());
+        for (std::size_t i = 0; i < members.size(); ++i) {
+            for (std::size_t neighbor : topology.neighbors(members[i])) {
+                if (region_of_[neighbor] == r && local_index_[neighbor] > i) {
+                    local.addEdge(i, local_index_[neighbor]);
+                }
+            }
+        }
+        return local;
+    }
+
+    /// @brief Sentinel for qubits not yet assigned to a region
+    static constexpr std::size_t NO_REGION = std::numeric_limits<std::size_t>::max();
+
+private:
+    TopologyPartition() = default;  // Only constructible via build()
+
+    std::vector<std::vector<std::size_t>> regions_;           // Members, BFS order
+    std::vector<std::size_t> region_of_;                      // Physical -> region
+    std::vector<std::size_t> local_index_;                    // Physical -> local
+    std::vector<std::vector<std::size_t>> region_adjacency_;  // Coarse graph
+
+    void validateRegion(std::size_t r) const {
+        if (r >= regions_.size()) {
+            throw std::out_of_range(
+                "Region index " + std::to_string(r) +
+                " out of range [0, " + std::to_string(regions_.size()) + ")");
+        }
+    }
+};
+
+}  // namespace qopt::routing
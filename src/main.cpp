@@ -7,15 +7,152 @@
  *
  * Demonstrates basic circuit construction and manipulation using the
  * qopt::ir library.
+ *
+ * Usage:
+ *   quantum_circuit_optimizer                   Run the demonstration
+ *   quantum_circuit_optimizer estimate FILE     Print a JSON resource
+ *                                               estimate of a QASM file
+ *   quantum_circuit_optimizer optimize FILE [PIPELINE]
+ *                                               Optimize a QASM file and
+ *                                               print the result as QASM
+ *   quantum_circuit_optimizer passes            List the passes a pipeline
+ *                                               spec can name
+ *
+ * PIPELINE is a level (O0-O3, default O2), a pipeline spec such as
+ * "cancel,rotmerge,idelim;fixpoint(max=4)", or @PATH to read the spec
+ * (text or JSON) from a file. Statistics go to stderr.
  */
 
 #include "ir/Circuit.hpp"
-
+#include "ir/ResourceEstimator.hpp"
+#include "parser/Parser.hpp"
+#include "parser/QASMWriter.hpp"
+#include "passes/AllPasses.hpp"
+#include "passes/OptimizationLevel.hpp"
+#include "passes/PassRegistry.hpp"
+#include "passes/PipelineSpec.hpp"
+
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+/**
+ * @brief Reads a whole file, reporting failure on stderr.
+ * @return true on success
+ */
+bool readFile(const char* path, std::string& contents) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "error: cannot open " << path << "\n";
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+/**
+ * @brief Streams a QASM file through the resource estimator.
+ *
+ * Gates are counted as the parser produces them, so the unrolled circuit
+ * is never held in memory.
+ *
+ * @return Process exit code
+ */
+int estimate(const char* path) {
+    std::string source;  // The parser keeps a view into it
+    if (!readFile(path, source)) return 1;
+
+    qopt::ir::ResourceEstimator estimator;
+    try {
+        qopt::parser::Parser parser(source);
+        auto info = parser.parseStreaming(
+            [&](const qopt::ir::Gate& g) { estimator.add(g); });
+        std::cout << estimator.estimate(info.numQubits).toJson() << "\n";
+    } catch (const qopt::parser::QASMParseException& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Optimizes a QASM file with a level preset or a pipeline spec.
+ * @return Process exit code
+ */
+int optimize(const char* path, std::string_view pipeline) {
+    std::string source;
+    if (!readFile(path, source)) return 1;
+
+    try {
+        qopt::passes::PassManager pm;
+        if (pipeline.size() == 2 && pipeline[0] == 'O') {
+            pm = qopt::passes::makePassManager(qopt::passes::parseOptimizationLevel(pipeline));
+        } else if (!pipeline.empty() && pipeline[0] == '@') {
+            std::string config;
+            if (!readFile(std::string(pipeline.substr(1)).c_str(), config)) return 1;
+            pm = qopt::passes::PipelineSpec::parseConfig(config).build();
+        } else {
+            pm = qopt::passes::PipelineSpec::parse(pipeline).build();
+        }
+
+        auto circuit = qopt::parser::parseQASM(source);
+        pm.run(*circuit);
+        qopt::parser::writeQASM(std::cout, *circuit);
+        std::cerr << pm.statistics().toString();
+    } catch (const qopt::parser::QASMParseException& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Prints every registered pass with its cost class and options.
+ * @return Process exit code
+ */
+int listPasses() {
+    for (const auto* info : qopt::passes::PassRegistry::instance().passes()) {
+        std::cout << info->short_name << " (" << info->name << ", "
+                  << qopt::passes::toString(info->cost) << ")\n"
+                  << "    " << info->description << "\n";
+        for (const auto& option : info->options) {
+            std::cout << "    " << option.name << "=" << option.default_value
+                      << "  " << option.description << "\n";
+        }
+    }
+    return 0;
+}
+
+}  // namespace
 
-int main() {
+int main(int argc, char** argv) {
     using namespace qopt::ir;
 
+    if (argc > 1) {
+        if (argc == 3 && std::string(argv[1]) == "estimate") {
+            return estimate(argv[2]);
+        }
+        if ((argc == 3 || argc == 4) && std::string(argv[1]) == "optimize") {
+            return optimize(argv[2], argc == 4 ? argv[3] : "O2");
+        }
+        if (argc == 2 && std::string(argv[1]) == "passes") {
+            return listPasses();
+        }
+        std::cerr << "usage: " << argv[0]
+                  << " [estimate FILE | optimize FILE [PIPELINE] | passes]\n";
+        return 2;
+    }
+
     std::cout << "=== Quantum Circuit Optimizer ===\n\n";
 
     // Create a 2-qubit Bell state circuit
@@ -10,6 +10,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 namespace qopt::ir {
 namespace {
 
@@ -37,6 +39,15 @@ TEST(CircuitConstructionTest, AcceptsMaxQubits) {
     EXPECT_EQ(c.numQubits(), constants::MAX_QUBITS);
 }
 
+TEST(CircuitConstructionTest, HoldsDeviceSizedRegisters) {
+    // Routing targets 1000+ qubit devices, well past the old 30-qubit limit
+    Circuit c(1024);
+    c.addGate(Gate::cnot(0, 1023));
+    c.addGate(Gate::h(1023));
+    EXPECT_EQ(c.numQubits(), 1024);
+    EXPECT_EQ(c.depth(), 2);
+}
+
 // =============================================================================
 // Gate Management Tests
 // =============================================================================
@@ -87,14 +98,15 @@ TEST(CircuitGateTest, AddGateThrowsOnInvalidQubit) {
     EXPECT_THROW(c.addGate(Gate::cnot(0, 5)), std::out_of_range);
 }
 
-TEST(CircuitGateTest, GatesAccessorReturnsAllGates) {
+TEST(CircuitGateTest, CopyGatesReturnsAllGates) {
     Circuit c(3);
     c.addGate(Gate::h(0));
     c.addGate(Gate::h(1));
     c.addGate(Gate::h(2));
 
-    const auto& gates = c.gates();
-    EXPECT_EQ(gates.size(), 3);
+    const auto gates = c.copyGates();
+    ASSERT_EQ(gates.size(), 3);
+    EXPECT_TRUE(std::equal(gates.begin(), gates.end(), c.begin()));
 }
 
 TEST(CircuitGateTest, ClearRemovesAllGates) {
@@ -207,6 +219,44 @@ TEST(CircuitCountTest, CountTwoQubitGates) {
     EXPECT_EQ(c.countTwoQubitGates(), 3);
 }
 
+TEST(CircuitCountTest, BarriersAreNotTwoQubitGates) {
+    Circuit c(2);
+    c.addGate(Gate::cnot(0, 1));
+    c.addGate(Gate::barrier({0, 1}));
+
+    EXPECT_EQ(c.countTwoQubitGates(), 1);
+    EXPECT_EQ(c.countGates(GateType::Barrier), 1);
+}
+
+// =============================================================================
+// Classical Bit Tests
+// =============================================================================
+
+TEST(CircuitClbitTest, MeasurementsValidateClassicalBits) {
+    Circuit c(2, 1);
+    EXPECT_EQ(c.numClbits(), 1);
+    c.addGate(Gate::measure(1, 0));
+    EXPECT_THROW(c.addGate(Gate::measure(0, 1)), std::out_of_range);
+    EXPECT_NO_THROW(c.addGate(Gate::measure(0)));
+
+    Circuit copy = c.clone();
+    EXPECT_EQ(copy.numClbits(), 1);
+    EXPECT_EQ(copy.gate(0), Gate::measure(1, 0));
+}
+
+TEST(CircuitClbitTest, DepthFollowsClassicalBits) {
+    // Measurements on different qubits into the same bit are serialized
+    Circuit c(2, 1);
+    c.addGate(Gate::measure(0, 0));
+    c.addGate(Gate::measure(1, 0));
+    EXPECT_EQ(c.depth(), 2);
+
+    Circuit d(2, 2);
+    d.addGate(Gate::measure(0, 0));
+    d.addGate(Gate::measure(1, 1));
+    EXPECT_EQ(d.depth(), 1);
+}
+
 // =============================================================================
 // Iteration Tests
 // =============================================================================
@@ -260,6 +310,46 @@ TEST(CircuitCloneTest, CloneCreatesIndependentCopy) {
     EXPECT_EQ(copy.numGates(), 2);
 }
 
+TEST(CircuitCloneTest, CloneSharesStorageUntilModified) {
+    Circuit c(2);
+    const std::size_t n = 3 * Circuit::CHUNK_SIZE + 5;
+    for (std::size_t i = 0; i < n; ++i) {
+        c.addGate(Gate::h(static_cast<QubitIndex>(i % 2)));
+    }
+
+    Circuit snapshot = c.clone();
+    EXPECT_EQ(snapshot.sharedChunks(c), 4u);
+
+    // Rewriting one gate copies only its chunk
+    c.gate(Circuit::CHUNK_SIZE + 1) = Gate::x(1);
+    EXPECT_EQ(snapshot.sharedChunks(c), 3u);
+    EXPECT_EQ(snapshot.gate(Circuit::CHUNK_SIZE + 1), Gate::h(1));
+    EXPECT_EQ(c.gate(Circuit::CHUNK_SIZE + 1), Gate::x(1));
+
+    // Appending unshares only the partial last chunk
+    c.addGate(Gate::z(0));
+    EXPECT_EQ(snapshot.sharedChunks(c), 2u);
+    EXPECT_EQ(snapshot.numGates(), n);
+    EXPECT_EQ(c.numGates(), n + 1);
+    EXPECT_EQ(c.gate(n), Gate::z(0));
+    EXPECT_EQ(c.gate(n).id(), snapshot.gate(n - 1).id() + 1);
+}
+
+TEST(CircuitCloneTest, SnapshotOfSnapshotIsIndependent) {
+    Circuit c(1);
+    c.addGate(Gate::x(0));
+    Circuit a = c.clone();
+    Circuit b = a.clone();
+    b.addGate(Gate::h(0));
+    a.clear();
+
+    EXPECT_EQ(c.numGates(), 1u);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(b.numGates(), 2u);
+    EXPECT_EQ(b.gate(0), Gate::x(0));
+    EXPECT_EQ(b.sharedChunks(c), 0u);  // b copied the chunk it appended to
+}
+
 // =============================================================================
 // ToString Tests
 // =============================================================================
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file test_circuit_view.cpp
+ * @brief Unit tests for non-owning circuit views
+ */
+
+#include "ir/CircuitView.hpp"
+#include "ir/Circuit.hpp"
+#include "ir/Gate.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace qopt::ir {
+namespace {
+
+/// @brief Circuit indices of the gates a view selects.
+std::vector<std::size_t> indicesOf(const CircuitView& view) {
+    std::vector<std::size_t> result;
+    for (auto it = view.begin(); it != view.end(); ++it) {
+        result.push_back(it.index());
+    }
+    return result;
+}
+
+/// @brief H on every qubit, a CNOT ladder, then Rz on every qubit.
+Circuit makeLadder(std::size_t n) {
+    Circuit c(n);
+    for (QubitIndex q = 0; q < n; ++q) c.addGate(Gate::h(q));
+    for (QubitIndex q = 0; q + 1 < n; ++q) c.addGate(Gate::cnot(q, q + 1));
+    for (QubitIndex q = 0; q < n; ++q) c.addGate(Gate::rz(q, 0.5));
+    return c;
+}
+
+// =============================================================================
+// Whole-Circuit Views
+// =============================================================================
+
+TEST(CircuitViewTest, WholeViewMatchesCircuit) {
+    Circuit c = makeLadder(4);
+    CircuitView view(c);
+    EXPECT_EQ(view.numGates(), c.numGates());
+    EXPECT_EQ(view.depth(), c.depth());
+    EXPECT_EQ(view.countGates(GateType::H), 4u);
+    EXPECT_EQ(view.countTwoQubitGates(), 3u);
+    EXPECT_EQ(&*view.begin(), &c.gate(0));  // No copies
+}
+
+TEST(CircuitViewTest, EmptyCircuit) {
+    Circuit c(2);
+    CircuitView view(c);
+    EXPECT_TRUE(view.empty());
+    EXPECT_EQ(view.depth(), 0u);
+}
+
+// =============================================================================
+// Slicing
+// =============================================================================
+
+TEST(CircuitViewTest, SliceSelectsIndexRange) {
+    Circuit c = makeLadder(4);
+    CircuitView middle = CircuitView(c).slice(4, 7);
+    EXPECT_EQ(indicesOf(middle), (std::vector<std::size_t>{4, 5, 6}));
+    EXPECT_EQ(middle.depth(), 3u);
+    EXPECT_EQ(middle.countGates(GateType::CNOT), 3u);
+    EXPECT_TRUE(middle.contains(5));
+    EXPECT_FALSE(middle.contains(7));
+
+    // Nested slices intersect, in circuit indices
+    EXPECT_EQ(indicesOf(middle.slice(5, 9)), (std::vector<std::size_t>{5, 6}));
+    EXPECT_TRUE(middle.slice(0, 2).empty());
+    EXPECT_THROW({ [[maybe_unused]] auto v = middle.slice(3, 2); }, std::out_of_range);
+    EXPECT_THROW({ [[maybe_unused]] auto v = middle.slice(0, 12); }, std::out_of_range);
+}
+
+// =============================================================================
+// Qubit Filters
+// =============================================================================
+
+TEST(CircuitViewTest, QubitFilterKeepsGatesInsideTheSet) {
+    Circuit c = makeLadder(4);
+    CircuitView low = CircuitView(c).onQubits({0, 1});
+    // H0, H1, CNOT(0,1), Rz0, Rz1
+    EXPECT_EQ(indicesOf(low), (std::vector<std::size_t>{0, 1, 4, 7, 8}));
+    EXPECT_EQ(low.numGates(), 5u);
+    EXPECT_EQ(low.depth(), 3u);
+
+    // Filters intersect
+    EXPECT_EQ(indicesOf(low.onQubits({1, 2})), (std::vector<std::size_t>{1, 8}));
+    EXPECT_THROW({ [[maybe_unused]] auto v = low.onQubits({4}); }, std::out_of_range);
+}
+
+TEST(CircuitViewTest, BarrierSpanningOtherQubitsIsExcluded) {
+    Circuit c(3);
+    c.addGate(Gate::x(0));
+    c.addGate(Gate::barrier({0, 1, 2}));
+    c.addGate(Gate::x(1));
+    EXPECT_EQ(indicesOf(CircuitView(c).onQubits({0, 1})), (std::vector<std::size_t>{0, 2}));
+}
+
+// =============================================================================
+// Layer Windows
+// =============================================================================
+
+TEST(CircuitViewTest, LastLayersSelectsATail) {
+    Circuit c = makeLadder(4);
+    ASSERT_EQ(c.depth(), 5u);
+
+    CircuitView last = CircuitView(c).lastLayers(1);
+    // Every Rz ends its wire
+    EXPECT_EQ(indicesOf(last), (std::vector<std::size_t>{7, 8, 9, 10}));
+    EXPECT_EQ(last.depth(), 1u);
+
+    CircuitView tail = CircuitView(c).lastLayers(2);
+    // Plus CNOT(2,3), which only Rz2 and Rz3 follow
+    EXPECT_EQ(indicesOf(tail), (std::vector<std::size_t>{6, 7, 8, 9, 10}));
+    EXPECT_EQ(tail.depth(), 2u);
+
+    EXPECT_EQ(CircuitView(c).lastLayers(5).numGates(), c.numGates());
+    EXPECT_TRUE(CircuitView(c).lastLayers(0).empty());
+}
+
+TEST(CircuitViewTest, LastLayersComposeWithFilters) {
+    Circuit c = makeLadder(4);
+    CircuitView view = CircuitView(c).slice(0, 7).onQubits({2, 3}).lastLayers(1);
+    // Within the slice, qubits 2-3 end with CNOT(2,3)
+    EXPECT_EQ(indicesOf(view), (std::vector<std::size_t>{6}));
+    EXPECT_EQ(view.countGates(GateType::CNOT), 1u);
+}
+
+}  // namespace
+}  // namespace qopt::ir
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file test_critical_path.cpp
+ * @brief Unit tests for incremental critical-path analysis
+ */
+
+#include "ir/CriticalPath.hpp"
+#include "ir/Circuit.hpp"
+#include "ir/DAG.hpp"
+#include "ir/Schedule.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace qopt::ir {
+namespace {
+
+/// @brief 20 ns single-qubit gates, 300 ns two-qubit gates, 1 us measurement.
+DurationTable hardware() {
+    return DurationTable::byArity(20.0, 300.0, 1000.0);
+}
+
+/// @brief Checks every node's slack against a from-scratch Schedule.
+void expectMatchesSchedule(const CriticalPath& cp, const DAG& dag) {
+    Schedule s = Schedule::compute(dag, cp.durations());
+    EXPECT_DOUBLE_EQ(cp.length(), s.duration());
+    for (GateId id : dag.nodeIds()) {
+        EXPECT_NEAR(cp.slack(id), s.slack(id), 1e-9) << "node " << id;
+        EXPECT_DOUBLE_EQ(cp.head(id), s.asap(id)) << "node " << id;
+    }
+}
+
+// =============================================================================
+// Construction Tests
+// =============================================================================
+
+TEST(CriticalPathTest, MarksZeroSlackNodes) {
+    Circuit c(3);
+    c.addGate(Gate::h(0));        // 0: critical
+    c.addGate(Gate::x(1));        // 1: critical (same length as H)
+    c.addGate(Gate::cnot(0, 1));  // 2: critical
+    c.addGate(Gate::x(2));        // 3: 300 ns of slack
+    DAG dag = DAG::fromCircuit(c);
+    CriticalPath cp(dag, hardware());
+
+    EXPECT_DOUBLE_EQ(cp.length(), 320.0);
+    EXPECT_EQ(cp.criticalNodes(), (std::vector<GateId>{0, 1, 2}));
+    EXPECT_DOUBLE_EQ(cp.slack(3), 300.0);
+    EXPECT_DOUBLE_EQ(cp.tail(0), 320.0);
+    EXPECT_FALSE(cp.isCritical(3));
+    EXPECT_THROW({ [[maybe_unused]] auto s = cp.slack(4); }, std::out_of_range);
+    expectMatchesSchedule(cp, dag);
+}
+
+TEST(CriticalPathTest, UnitDurationsGiveDepth) {
+    Circuit c(2);
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::cnot(0, 1));
+    c.addGate(Gate::h(1));
+    DAG dag = DAG::fromCircuit(c);
+    EXPECT_DOUBLE_EQ(CriticalPath(dag).length(), static_cast<double>(dag.depth()));
+    EXPECT_DOUBLE_EQ(CriticalPath(DAG(2)).length(), 0.0);
+}
+
+// =============================================================================
+// Incremental Update Tests
+// =============================================================================
+
+TEST(CriticalPathTest, UpdateFollowsJournaledEdits) {
+    Circuit c(2, 1);
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::cnot(0, 1));
+    c.addGate(Gate::measure(1, 0));
+    DAG dag = DAG::fromCircuit(c);
+    CriticalPath cp(dag, hardware().set(GateType::SWAP, 900.0));
+    EXPECT_DOUBLE_EQ(cp.length(), 1340.0);
+
+    dag.checkpoint();
+    dag.removeNode(0);
+    dag.removeNode(1);
+    auto changed = dag.journaledNodes();
+    cp.update(dag, changed);
+    EXPECT_DOUBLE_EQ(cp.length(), 1300.0);
+    EXPECT_FALSE(cp.contains(0));
+    expectMatchesSchedule(cp, dag);
+
+    // Undo: same node list brings the analysis back
+    dag.rollback();
+    cp.update(dag, changed);
+    EXPECT_DOUBLE_EQ(cp.length(), 1340.0);
+    expectMatchesSchedule(cp, dag);
+
+    dag.checkpoint();
+    dag.replaceGate(2, Gate::swap(0, 1));
+    GateId added = dag.addGate(Gate::x(0));
+    cp.update(dag, dag.journaledNodes());
+    dag.commit();
+    EXPECT_DOUBLE_EQ(cp.length(), 1940.0);
+    EXPECT_TRUE(cp.contains(added));
+    EXPECT_FALSE(cp.isCritical(added));
+    expectMatchesSchedule(cp, dag);
+}
+
+TEST(CriticalPathTest, RandomEditsMatchRecomputation) {
+    constexpr std::size_t n = 6;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<QubitIndex> pick(0, n - 1);
+
+    DAG dag(n);
+    for (int i = 0; i < 60; ++i) {
+        QubitIndex a = pick(rng);
+        QubitIndex b = pick(rng);
+        dag.addGate(a == b ? Gate::h(a) : Gate::cnot(a, b));
+    }
+    CriticalPath cp(dag, hardware());
+
+    for (int round = 0; round < 20; ++round) {
+        dag.checkpoint();
+        auto ids = dag.nodeIds();
+        std::sort(ids.begin(), ids.end());
+        dag.removeNode(ids[rng() % ids.size()]);
+        QubitIndex a = pick(rng);
+        dag.addGate(Gate::x(a));
+        cp.update(dag, dag.journaledNodes());
+        dag.commit();
+        expectMatchesSchedule(cp, dag);
+    }
+}
+
+}  // namespace
+}  // namespace qopt::ir
@@ -40,6 +40,15 @@ TEST(DAGConstructionTest, AcceptsMaxQubits) {
     EXPECT_EQ(dag.numQubits(), constants::MAX_QUBITS);
 }
 
+TEST(DAGConstructionTest, HoldsDeviceSizedRegisters) {
+    Circuit c(1024);
+    c.addGate(Gate::cnot(0, 1023));
+    c.addGate(Gate::h(1023));
+    auto dag = DAG::fromCircuit(c);
+    EXPECT_EQ(dag.numQubits(), 1024);
+    EXPECT_EQ(dag.depth(), 2);
+}
+
 // =============================================================================
 // Node Addition Tests
 // =============================================================================
@@ -522,6 +531,25 @@ TEST(DAGRemoveTest, RemoveSinkReconnects) {
     EXPECT_EQ(dag.sinks()[0], 0);
 }
 
+TEST(DAGRemoveTest, RemoveReconnectsWireByWire) {
+    DAG dag(2);
+    dag.addGate(Gate::cz(0, 1));    // 0
+    dag.addGate(Gate::h(1));        // 1
+    dag.addGate(Gate::cnot(0, 1));  // 2
+    dag.addGate(Gate::x(0));        // 3
+    dag.addGate(Gate::h(1));        // 4
+
+    dag.removeNode(2);
+
+    // Each wire is bridged by its own neighbours only: CZ -> X on q0 and
+    // H -> H on q1, with no CZ -> H(4) edge across the removed CNOT
+    EXPECT_TRUE(dag.hasEdge(0, 3));
+    EXPECT_TRUE(dag.hasEdge(1, 4));
+    EXPECT_FALSE(dag.hasEdge(0, 4));
+    EXPECT_FALSE(dag.hasEdge(1, 3));
+    EXPECT_EQ(dag.node(4).predecessors(), (std::vector<GateId>{1}));
+}
+
 // =============================================================================
 // Circuit Conversion Tests
 // =============================================================================
@@ -610,6 +638,61 @@ TEST(DAGConversionTest, ParameterizedGatesPreserved) {
     EXPECT_EQ(recovered.gate(2).parameter().value(), 3.5);
 }
 
+TEST(DAGConversionTest, RoundTripPreservesNonUnitaryOperations) {
+    Circuit original(2, 2);
+    original.addGate(Gate::h(0));
+    original.addGate(Gate::barrier({0, 1}));
+    original.addGate(Gate::measure(0, 1));
+    original.addGate(Gate::reset(0));
+
+    DAG dag = DAG::fromCircuit(original);
+    EXPECT_EQ(dag.numClbits(), 2);
+    Circuit recovered = dag.toCircuit();
+
+    EXPECT_EQ(recovered.numClbits(), 2);
+    ASSERT_EQ(recovered.numGates(), 4);
+    EXPECT_EQ(recovered.gate(1), Gate::barrier({0, 1}));
+    EXPECT_EQ(recovered.gate(2), Gate::measure(0, 1));
+    EXPECT_EQ(recovered.gate(3), Gate::reset(0));
+}
+
+// =============================================================================
+// Non-Unitary Operation Tests
+// =============================================================================
+
+TEST(DAGNonUnitaryTest, MeasurementsOfSameBitAreOrdered) {
+    DAG dag(2, 1);
+    GateId m0 = dag.addGate(Gate::measure(0, 0));
+    GateId m1 = dag.addGate(Gate::measure(1, 0));
+    GateId h = dag.addGate(Gate::h(1));
+
+    EXPECT_TRUE(dag.hasEdge(m0, m1));
+    EXPECT_TRUE(dag.hasEdge(m1, h));
+    EXPECT_EQ(dag.depth(), 3);
+    EXPECT_THROW(dag.addGate(Gate::measure(0, 1)), std::out_of_range);
+}
+
+TEST(DAGNonUnitaryTest, RemoveNodeKeepsClassicalChain) {
+    DAG dag(3, 1);
+    GateId m0 = dag.addGate(Gate::measure(0, 0));
+    GateId m1 = dag.addGate(Gate::measure(1, 0));
+    dag.removeNode(m1);
+
+    GateId m2 = dag.addGate(Gate::measure(2, 0));
+    EXPECT_TRUE(dag.hasEdge(m0, m2));
+}
+
+TEST(DAGNonUnitaryTest, BarrierJoinsAllItsQubits) {
+    DAG dag(3);
+    GateId h0 = dag.addGate(Gate::h(0));
+    GateId b = dag.addGate(Gate::barrier({0, 1, 2}));
+    GateId x2 = dag.addGate(Gate::x(2));
+
+    EXPECT_TRUE(dag.hasEdge(h0, b));
+    EXPECT_TRUE(dag.hasEdge(b, x2));
+    EXPECT_FALSE(dag.hasEdge(h0, x2));
+}
+
 // =============================================================================
 // Clear Tests
 // =============================================================================
@@ -635,6 +718,165 @@ TEST(DAGClearTest, ClearAllowsNewAdditions) {
     EXPECT_EQ(dag.numNodes(), 1);
 }
 
+// =============================================================================
+// Transaction Tests
+// =============================================================================
+
+/// @brief Every node's gate and edge lists, by ID (independent of map order).
+std::vector<std::string> describeNodes(const DAG& dag) {
+    auto ids = dag.nodeIds();
+    std::sort(ids.begin(), ids.end());
+    std::vector<std::string> result;
+    for (GateId id : ids) {
+        const DAGNode& n = dag.node(id);
+        std::string line = std::to_string(id) + " " + n.gate().toString() + " <-";
+        for (GateId p : n.predecessors()) line += " " + std::to_string(p);
+        line += " ->";
+        for (GateId s : n.successors()) line += " " + std::to_string(s);
+        result.push_back(std::move(line));
+    }
+    return result;
+}
+
+TEST(DAGTransactionTest, RollbackRestoresGraphExactly) {
+    DAG dag(3, 1);
+    dag.addGate(Gate::h(0));
+    GateId cx = dag.addGate(Gate::cnot(0, 1));
+    dag.addGate(Gate::cnot(1, 2));
+    dag.addGate(Gate::measure(2, 0));
+    const auto before = describeNodes(dag);
+
+    dag.checkpoint();
+    dag.removeNode(cx);
+    dag.replaceGate(0, Gate::x(0));
+    GateId added = dag.addGate(Gate::cz(0, 2));
+    EXPECT_EQ(added, 4u);
+    EXPECT_EQ(dag.journalSize(), 3u);
+    dag.rollback();
+
+    EXPECT_EQ(dag.checkpointDepth(), 0u);
+    EXPECT_EQ(dag.journalSize(), 0u);
+    EXPECT_EQ(describeNodes(dag), before);
+    EXPECT_EQ(dag.node(0).gate(), Gate::h(0));
+
+    // Wire tails and IDs are restored too
+    EXPECT_EQ(dag.addGate(Gate::x(2)), 4u);
+    EXPECT_TRUE(dag.hasEdge(3, 4));
+}
+
+TEST(DAGTransactionTest, CommitKeepsChanges) {
+    DAG dag(2);
+    GateId h = dag.addGate(Gate::h(0));
+    dag.addGate(Gate::cnot(0, 1));
+
+    dag.checkpoint();
+    dag.removeNode(h);
+    dag.commit();
+
+    EXPECT_EQ(dag.numNodes(), 1u);
+    EXPECT_EQ(dag.journalSize(), 0u);
+    EXPECT_THROW(dag.rollback(), std::logic_error);
+    EXPECT_THROW(dag.commit(), std::logic_error);
+}
+
+TEST(DAGTransactionTest, NestedTransactions) {
+    DAG dag(2);
+    dag.addGate(Gate::h(0));
+    dag.addGate(Gate::cnot(0, 1));
+
+    dag.checkpoint();
+    dag.addGate(Gate::x(1));
+    dag.checkpoint();
+    dag.addGate(Gate::z(0));
+    dag.rollback();  // Drops Z only
+    EXPECT_EQ(dag.numNodes(), 3u);
+
+    dag.checkpoint();
+    dag.removeNode(1);
+    dag.commit();  // Still undone by the outer rollback
+    EXPECT_EQ(dag.numNodes(), 2u);
+
+    dag.rollback();
+    EXPECT_EQ(dag.numNodes(), 2u);
+    EXPECT_TRUE(dag.hasEdge(0, 1));
+    EXPECT_EQ(dag.checkpointDepth(), 0u);
+}
+
+TEST(DAGTransactionTest, ReplaceGateKeepsWires) {
+    DAG dag(2);
+    GateId rz = dag.addGate(Gate::rz(0, 0.5));
+    dag.replaceGate(rz, Gate::rz(0, 1.5));
+    EXPECT_EQ(dag.node(rz).gate(), Gate::rz(0, 1.5));
+    EXPECT_EQ(dag.node(rz).id(), rz);
+    EXPECT_THROW(dag.replaceGate(rz, Gate::rz(1, 0.0)), std::invalid_argument);
+
+    // Operands may be reordered: the wires stay the same
+    GateId cx = dag.addGate(Gate::cnot(0, 1));
+    dag.replaceGate(cx, Gate::cnot(1, 0));
+    EXPECT_TRUE(dag.hasEdge(rz, cx));
+    EXPECT_THROW(dag.replaceGate(7, Gate::rz(0, 0.0)), std::out_of_range);
+}
+
+// =============================================================================
+// Compaction Tests
+// =============================================================================
+
+TEST(DAGCompactTest, RenumbersDenselyInTopologicalOrder) {
+    DAG dag(2, 1);
+    for (int i = 0; i < 3; ++i) {
+        dag.addGate(Gate::h(0));
+        dag.addGate(Gate::x(1));
+    }
+    dag.addGate(Gate::cnot(0, 1));     // 6
+    dag.addGate(Gate::measure(1, 0));  // 7
+    for (GateId id : {0u, 1u, 2u, 3u}) {
+        dag.removeNode(id);
+    }
+
+    auto remap = dag.compact();
+    ASSERT_EQ(remap.size(), 8u);
+    EXPECT_EQ(remap[0], INVALID_GATE_ID);
+    EXPECT_EQ(remap[3], INVALID_GATE_ID);
+    EXPECT_EQ(remap[4], 0u);
+    EXPECT_EQ(remap[5], 1u);
+    EXPECT_EQ(remap[6], 2u);
+    EXPECT_EQ(remap[7], 3u);
+
+    auto ids = dag.nodeIds();
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, (std::vector<GateId>{0, 1, 2, 3}));
+    EXPECT_TRUE(dag.hasEdge(0, 2));
+    EXPECT_TRUE(dag.hasEdge(1, 2));
+    EXPECT_TRUE(dag.hasEdge(2, 3));
+    EXPECT_EQ(dag.node(2).id(), 2u);
+    EXPECT_EQ(dag.node(3).gate(), Gate::measure(1, 0));
+
+    // New gates continue densely and attach to the remapped wire tails
+    EXPECT_EQ(dag.addGate(Gate::z(1)), 4u);
+    EXPECT_TRUE(dag.hasEdge(3, 4));
+}
+
+TEST(DAGCompactTest, DenseDagIsUnchanged) {
+    DAG dag = DAG::fromCircuit([] {
+        Circuit c(3);
+        c.addGate(Gate::h(2));
+        c.addGate(Gate::cnot(0, 1));
+        c.addGate(Gate::cnot(1, 2));
+        return c;
+    }());
+    const auto before = describeNodes(dag);
+    auto remap = dag.compact();
+    EXPECT_EQ(remap, (std::vector<GateId>{0, 1, 2}));
+    EXPECT_EQ(describeNodes(dag), before);
+}
+
+TEST(DAGCompactTest, RejectedInsideTransaction) {
+    DAG dag(1);
+    dag.addGate(Gate::h(0));
+    dag.checkpoint();
+    EXPECT_THROW(dag.compact(), std::logic_error);
+}
+
 // =============================================================================
 // ToString Tests
 // =============================================================================
@@ -98,6 +98,35 @@ TEST(GateFactoryTest, SAndTGatesCreateCorrectly) {
     EXPECT_EQ(tdg.type(), GateType::Tdg);
 }
 
+TEST(GateFactoryTest, U3TakesThreeParameters) {
+    auto u = Gate::u3(1, 0.1, 0.2, 0.3);
+
+    EXPECT_EQ(u.type(), GateType::U3);
+    EXPECT_EQ(u.numParameters(), 3);
+    EXPECT_DOUBLE_EQ(u.parameter().value(), 0.1);
+    EXPECT_DOUBLE_EQ(u.parameter(1), 0.2);
+    EXPECT_DOUBLE_EQ(u.parameter(2), 0.3);
+    EXPECT_EQ(u.parameters(), (std::vector<Angle>{0.1, 0.2, 0.3}));
+    EXPECT_THROW((void)u.parameter(3), std::out_of_range);
+    EXPECT_NE(u, Gate::u3(1, 0.1, 0.2, 0.4));
+    EXPECT_EQ(u.withParameters({0.5, 0.6, 0.7}), Gate::u3(1, 0.5, 0.6, 0.7));
+}
+
+TEST(GateFactoryTest, NativeTwoAndThreeQubitGates) {
+    EXPECT_EQ(Gate::sx(2).type(), GateType::SX);
+    EXPECT_EQ(Gate::cphase(0, 1, 0.5).parameter(), std::optional<Angle>(0.5));
+    EXPECT_EQ(Gate::rzz(0, 1, 0.5).type(), GateType::RZZ);
+    EXPECT_EQ(Gate::iswap(0, 1).numQubits(), 2);
+
+    auto ccx = Gate::ccx(0, 1, 2);
+    EXPECT_EQ(ccx.type(), GateType::CCX);
+    EXPECT_EQ(ccx.qubits(), (std::vector<QubitIndex>{0, 1, 2}));
+    EXPECT_THROW(Gate::ccx(0, 0, 2), std::invalid_argument);
+    EXPECT_THROW(Gate::ccx(0, 1, 1), std::invalid_argument);
+    EXPECT_THROW(Gate::cphase(3, 3, 0.5), std::invalid_argument);
+    EXPECT_THROW(Gate::iswap(3, 3), std::invalid_argument);
+}
+
 // =============================================================================
 // Accessor Tests
 // =============================================================================
@@ -183,6 +212,74 @@ TEST(GateValidationTest, SingleQubitGateRejectsMultipleQubits) {
     );
 }
 
+TEST(GateValidationTest, BarrierSpansDistinctQubits) {
+    auto b = Gate::barrier({2, 0, 1});
+    EXPECT_EQ(b.numQubits(), 3);
+    EXPECT_THROW(Gate::barrier({}), std::invalid_argument);
+    EXPECT_THROW(Gate::barrier({0, 1, 0}), std::invalid_argument);
+}
+
+TEST(GateValidationTest, OnlyMeasureWritesClassicalBit) {
+    EXPECT_THROW(Gate(GateType::H, {0}, std::nullopt, INVALID_GATE_ID, 0),
+                 std::invalid_argument);
+    EXPECT_THROW(Gate(GateType::Reset, {0, 1}), std::invalid_argument);
+}
+
+TEST(GateValidationTest, ParameterCountMustMatchType) {
+    // U3 needs all three angles
+    EXPECT_THROW(Gate(GateType::U3, {0}, 0.5), std::invalid_argument);
+    EXPECT_THROW(Gate::fromParameters(GateType::U3, {0}, {0.1, 0.2}), std::invalid_argument);
+    EXPECT_THROW(Gate::fromParameters(GateType::Rz, {0}, {0.1, 0.2}), std::invalid_argument);
+    EXPECT_THROW(Gate::fromParameters(GateType::H, {0}, {0.1, 0.2, 0.3, 0.4}),
+                 std::invalid_argument);
+    EXPECT_THROW(Gate(GateType::CCX, {0, 1}), std::invalid_argument);
+    EXPECT_EQ(Gate::fromParameters(GateType::Rz, {0}, {0.1}), Gate::rz(0, 0.1));
+}
+
+// =============================================================================
+// Non-Unitary Operation Tests
+// =============================================================================
+
+TEST(GateNonUnitaryTest, MeasureCarriesClassicalBit) {
+    auto m = Gate::measure(3, 1);
+    EXPECT_EQ(m.type(), GateType::Measure);
+    EXPECT_EQ(m.qubits()[0], 3);
+    EXPECT_EQ(m.clbit(), std::optional<ClbitIndex>(1));
+    EXPECT_FALSE(Gate::measure(3).clbit().has_value());
+    EXPECT_NE(m, Gate::measure(3, 0));
+    EXPECT_NE(m, Gate::measure(3));
+    EXPECT_EQ(m.toString(), "Measure q[3] -> c[1]");
+}
+
+TEST(GateNonUnitaryTest, WithQubitsKeepsEverythingElse) {
+    auto m = Gate::measure(0, 2);
+    m.setId(7);
+    auto moved = m.withQubits({5});
+    EXPECT_EQ(moved, Gate::measure(5, 2));
+    EXPECT_EQ(moved.id(), INVALID_GATE_ID);
+
+    EXPECT_EQ(Gate::rz(0, 0.5).withQubits({1}), Gate::rz(1, 0.5));
+    EXPECT_EQ(Gate::barrier({0, 1}).withQubits({4, 2}), Gate::barrier({4, 2}));
+    EXPECT_THROW(Gate::h(0).withQubits({0, 1}), std::invalid_argument);
+}
+
+TEST(GateNonUnitaryTest, ClassificationHelpers) {
+    EXPECT_TRUE(isTwoQubitGate(GateType::CNOT));
+    EXPECT_TRUE(isTwoQubitGate(GateType::SWAP));
+    EXPECT_FALSE(isTwoQubitGate(GateType::Barrier));
+    EXPECT_FALSE(isTwoQubitGate(GateType::Measure));
+    EXPECT_FALSE(isTwoQubitGate(GateType::CCX));
+    EXPECT_TRUE(isMultiQubitGate(GateType::CCX));
+    EXPECT_TRUE(isMultiQubitGate(GateType::RZZ));
+    EXPECT_FALSE(isMultiQubitGate(GateType::Barrier));
+
+    EXPECT_TRUE(isNonUnitary(GateType::Measure));
+    EXPECT_TRUE(isNonUnitary(GateType::Reset));
+    EXPECT_TRUE(isNonUnitary(GateType::Barrier));
+    EXPECT_FALSE(isNonUnitary(GateType::H));
+    EXPECT_FALSE(isHermitian(GateType::Measure));
+}
+
 // =============================================================================
 // Utility Function Tests
 // =============================================================================
@@ -201,6 +298,13 @@ TEST(GateUtilityTest, NumQubitsForReturnsCorrectCounts) {
     EXPECT_EQ(numQubitsFor(GateType::CNOT), 2);
     EXPECT_EQ(numQubitsFor(GateType::CZ), 2);
     EXPECT_EQ(numQubitsFor(GateType::SWAP), 2);
+    EXPECT_EQ(numQubitsFor(GateType::U3), 1);
+    EXPECT_EQ(numQubitsFor(GateType::CPhase), 2);
+    EXPECT_EQ(numQubitsFor(GateType::ISWAP), 2);
+    EXPECT_EQ(numQubitsFor(GateType::CCX), 3);
+    EXPECT_EQ(numQubitsFor(GateType::Measure), 1);
+    EXPECT_EQ(numQubitsFor(GateType::Reset), 1);
+    EXPECT_EQ(numQubitsFor(GateType::Barrier), 0);  // Any number
 }
 
 TEST(GateUtilityTest, IsParameterizedCorrect) {
@@ -209,6 +313,12 @@ TEST(GateUtilityTest, IsParameterizedCorrect) {
     EXPECT_TRUE(ir::isParameterized(GateType::Rx));
     EXPECT_TRUE(ir::isParameterized(GateType::Ry));
     EXPECT_TRUE(ir::isParameterized(GateType::Rz));
+    EXPECT_TRUE(ir::isParameterized(GateType::RZZ));
+    EXPECT_FALSE(ir::isParameterized(GateType::SX));
+
+    EXPECT_EQ(numParametersFor(GateType::U3), 3);
+    EXPECT_EQ(numParametersFor(GateType::CPhase), 1);
+    EXPECT_EQ(numParametersFor(GateType::ISWAP), 0);
 }
 
 TEST(GateUtilityTest, IsHermitianCorrect) {
@@ -218,6 +328,7 @@ TEST(GateUtilityTest, IsHermitianCorrect) {
     EXPECT_TRUE(isHermitian(GateType::Z));
     EXPECT_TRUE(isHermitian(GateType::CNOT));
     EXPECT_TRUE(isHermitian(GateType::SWAP));
+    EXPECT_TRUE(isHermitian(GateType::CCX));
 
     EXPECT_FALSE(isHermitian(GateType::S));
     EXPECT_FALSE(isHermitian(GateType::T));
@@ -246,6 +357,9 @@ TEST(GateToStringTest, ParameterizedGateFormat) {
     std::string str = rz.toString();
     EXPECT_TRUE(str.find("Rz(") != std::string::npos);
     EXPECT_TRUE(str.find("q[0]") != std::string::npos);
+
+    EXPECT_EQ(Gate::u3(0, 1, 2, 3).toString(), "U3(1.000000, 2.000000, 3.000000) q[0]");
+    EXPECT_EQ(Gate::ccx(2, 0, 1).toString(), "CCX q[2], q[0], q[1]");
 }
 
 }  // namespace
@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file test_parameter.cpp
+ * @brief Unit tests for symbolic parameters and late binding
+ */
+
+#include "ir/Circuit.hpp"
+#include "ir/Gate.hpp"
+#include "ir/Parameter.hpp"
+
+#include <gtest/gtest.h>
+
+namespace qopt::ir {
+namespace {
+
+// =============================================================================
+// AffineExpression Tests
+// =============================================================================
+
+TEST(AffineExpressionTest, ArithmeticMergesTerms) {
+    auto theta = AffineExpression::symbol(0);
+    auto phi = AffineExpression::symbol(1);
+
+    auto e = theta * 2.0 + phi - AffineExpression(0.5) + theta;
+    EXPECT_DOUBLE_EQ(e.constant(), -0.5);
+    ASSERT_EQ(e.terms().size(), 2u);
+    EXPECT_EQ(e.terms()[0], (ParameterTerm{0, 3.0}));
+    EXPECT_EQ(e.terms()[1], (ParameterTerm{1, 1.0}));
+    EXPECT_DOUBLE_EQ(e.evaluate({1.0, 2.0}), 4.5);
+}
+
+TEST(AffineExpressionTest, CancellingTermsFoldToConstant) {
+    auto theta = AffineExpression::symbol(3);
+    auto e = theta + AffineExpression(1.0) - theta;
+    EXPECT_TRUE(e.isConstant());
+    EXPECT_EQ(e, AffineExpression(1.0));
+    EXPECT_TRUE((theta * 0.0).isConstant());
+}
+
+TEST(AffineExpressionTest, EvaluateRequiresEverySymbol) {
+    auto e = AffineExpression::symbol(2);
+    EXPECT_THROW({ [[maybe_unused]] auto v = e.evaluate({1.0}); }, std::out_of_range);
+}
+
+// =============================================================================
+// ParameterTable Tests
+// =============================================================================
+
+TEST(ParameterTableTest, SymbolsAreDeclaredOnce) {
+    ParameterTable table;
+    EXPECT_TRUE(table.empty());
+    SymbolId theta = table.addSymbol("theta");
+    SymbolId phi = table.addSymbol("phi");
+    EXPECT_EQ(table.addSymbol("theta"), theta);
+    EXPECT_NE(theta, phi);
+    EXPECT_EQ(table.numSymbols(), 2u);
+    EXPECT_EQ(table.findSymbol("phi"), phi);
+    EXPECT_FALSE(table.findSymbol("lambda").has_value());
+}
+
+TEST(ParameterTableTest, StoresExpressionsByIndex) {
+    ParameterTable table;
+    SymbolId theta = table.addSymbol("theta");
+    SymbolId phi = table.addSymbol("phi");
+    auto e0 = AffineExpression::symbol(theta) * 0.5;
+    auto e1 = AffineExpression(1.0);
+    auto e2 = AffineExpression::symbol(phi) - AffineExpression::symbol(theta);
+
+    EXPECT_EQ(table.add(e0), 0u);
+    EXPECT_EQ(table.add(e1), 1u);
+    EXPECT_EQ(table.add(e2), 2u);
+    EXPECT_EQ(table.numExpressions(), 3u);
+    EXPECT_EQ(table.expression(0), e0);
+    EXPECT_EQ(table.expression(1), e1);
+    EXPECT_EQ(table.expression(2), e2);
+    EXPECT_THROW({ [[maybe_unused]] auto e = table.expression(3); }, std::out_of_range);
+    EXPECT_THROW(table.add(AffineExpression::symbol(7)), std::out_of_range);
+}
+
+TEST(ParameterTableTest, EvaluatesAllExpressionsInOneSweep) {
+    ParameterTable table;
+    SymbolId theta = table.addSymbol("theta");
+    SymbolId phi = table.addSymbol("phi");
+    table.add(AffineExpression::symbol(theta) * 2.0 + AffineExpression(0.25));
+    table.add(AffineExpression(-1.0));
+    table.add(AffineExpression::symbol(phi) + AffineExpression::symbol(theta));
+
+    auto values = table.evaluate({0.5, 3.0});
+    ASSERT_EQ(values.size(), 3u);
+    EXPECT_DOUBLE_EQ(values[0], 1.25);
+    EXPECT_DOUBLE_EQ(values[1], -1.0);
+    EXPECT_DOUBLE_EQ(values[2], 3.5);
+    EXPECT_THROW({ [[maybe_unused]] auto v = table.evaluate({0.5}); }, std::invalid_argument);
+}
+
+TEST(ParameterTableTest, NamedValuesAreCheckedAgainstSymbols) {
+    ParameterTable table;
+    table.addSymbol("theta");
+    table.addSymbol("phi");
+
+    auto values = table.values({{"phi", 2.0}, {"theta", 1.0}});
+    EXPECT_EQ(values, (std::vector<double>{1.0, 2.0}));
+    EXPECT_THROW({ [[maybe_unused]] auto v = table.values({{"theta", 1.0}}); },
+                 std::invalid_argument);
+    EXPECT_THROW(
+        { [[maybe_unused]] auto v = table.values({{"theta", 1.0}, {"phi", 2.0}, {"x", 0.0}}); },
+        std::invalid_argument);
+}
+
+TEST(ParameterTableTest, FormatsExpressionsAsQasm) {
+    ParameterTable table;
+    SymbolId theta = table.addSymbol("theta");
+    SymbolId phi = table.addSymbol("phi");
+    auto a = table.add(AffineExpression::symbol(theta) * 0.5 -
+                       AffineExpression::symbol(phi) + AffineExpression(1.0));
+    auto b = table.add(AffineExpression::symbol(theta, -1.0) - AffineExpression(0.25));
+    auto c = table.add(AffineExpression(2.0));
+
+    EXPECT_EQ(table.toString(a), "0.5*theta - phi + 1");
+    EXPECT_EQ(table.toString(b), "-theta - 0.25");
+    EXPECT_EQ(table.toString(c), "2");
+}
+
+// =============================================================================
+// Symbolic Gate Tests
+// =============================================================================
+
+TEST(SymbolicGateTest, ExpressionReplacesValue) {
+    Gate rz = Gate::rz(0, 0.0).withExpression(0, 4);
+    EXPECT_TRUE(rz.isSymbolic());
+    EXPECT_EQ(rz.expression(0), 4u);
+    EXPECT_FALSE(rz.parameter().has_value());
+    EXPECT_THROW({ [[maybe_unused]] auto p = rz.parameter(0); }, std::logic_error);
+    EXPECT_EQ(rz.toString(), "Rz($4) q[0]");
+    EXPECT_NE(rz, Gate::rz(0, 0.0));
+    EXPECT_THROW({ [[maybe_unused]] auto g = rz.withExpression(1, 0); }, std::out_of_range);
+
+    Gate u3 = Gate::u3(0, 1.0, 2.0, 3.0).withExpression(1, 0);
+    EXPECT_TRUE(u3.isSymbolic());
+    EXPECT_DOUBLE_EQ(u3.parameter(0), 1.0);
+    EXPECT_FALSE(u3.expression(0).has_value());
+    EXPECT_FALSE(Gate::h(0).isSymbolic());
+}
+
+TEST(SymbolicGateTest, BoundTakesEvaluatedValues) {
+    Gate u3 = Gate::u3(1, 1.0, 0.0, 3.0).withExpression(1, 2);
+    u3.setId(7);
+    Gate bound = u3.bound({0.0, 0.0, 2.0});
+    EXPECT_FALSE(bound.isSymbolic());
+    EXPECT_EQ(bound, Gate::u3(1, 1.0, 2.0, 3.0));
+    EXPECT_EQ(bound.id(), 7u);
+    EXPECT_THROW({ [[maybe_unused]] auto g = u3.bound({0.0}); }, std::out_of_range);
+}
+
+// =============================================================================
+// Circuit Binding Tests
+// =============================================================================
+
+TEST(CircuitBindTest, RejectsUnknownExpressions) {
+    Circuit c(1);
+    EXPECT_THROW(c.addGate(Gate::rz(0, 0.0).withExpression(0, 0)), std::out_of_range);
+}
+
+TEST(CircuitBindTest, BindSubstitutesEverySymbolicParameter) {
+    Circuit c(2);
+    SymbolId theta = c.parameterTable().addSymbol("theta");
+    SymbolId phi = c.parameterTable().addSymbol("phi");
+    auto half = c.parameterTable().add(AffineExpression::symbol(theta) * 0.5);
+    auto sum = c.parameterTable().add(AffineExpression::symbol(theta) +
+                                      AffineExpression::symbol(phi));
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::rz(0, 0.0).withExpression(0, half));
+    c.addGate(Gate::rzz(0, 1, 0.0).withExpression(0, sum));
+    c.addGate(Gate::rx(1, 0.25));
+
+    Circuit bound = c.bind({1.0, 2.0});
+    ASSERT_EQ(bound.numGates(), 4u);
+    EXPECT_TRUE(bound.parameterTable().empty());
+    EXPECT_EQ(bound.gate(0), Gate::h(0));
+    EXPECT_EQ(bound.gate(1), Gate::rz(0, 0.5));
+    EXPECT_EQ(bound.gate(2), Gate::rzz(0, 1, 3.0));
+    EXPECT_EQ(bound.gate(3), Gate::rx(1, 0.25));
+    EXPECT_EQ(bound.gate(2).id(), c.gate(2).id());
+
+    // The template stays symbolic and can be bound again
+    Circuit again = c.bindNamed({{"theta", -2.0}, {"phi", 0.0}});
+    EXPECT_TRUE(c.gate(1).isSymbolic());
+    EXPECT_EQ(again.gate(1), Gate::rz(0, -1.0));
+    EXPECT_EQ(again.gate(2), Gate::rzz(0, 1, -2.0));
+    EXPECT_THROW({ [[maybe_unused]] auto b = c.bind({1.0}); }, std::invalid_argument);
+}
+
+TEST(CircuitBindTest, CloneKeepsParameterTable) {
+    Circuit c(1);
+    SymbolId theta = c.parameterTable().addSymbol("theta");
+    auto e = c.parameterTable().add(AffineExpression::symbol(theta));
+    c.addGate(Gate::ry(0, 0.0).withExpression(0, e));
+
+    Circuit copy = c.clone();
+    EXPECT_EQ(copy.parameterTable().numExpressions(), 1u);
+    EXPECT_EQ(copy.bind({0.75}).gate(0), Gate::ry(0, 0.75));
+}
+
+}  // namespace
+}  // namespace qopt::ir
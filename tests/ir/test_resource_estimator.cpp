@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file test_resource_estimator.cpp
+ * @brief Unit tests for streaming resource estimation
+ */
+
+#include "ir/ResourceEstimator.hpp"
+#include "ir/Circuit.hpp"
+#include "parser/Parser.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace qopt::ir {
+namespace {
+
+// =============================================================================
+// Count Tests
+// =============================================================================
+
+TEST(ResourceEstimatorTest, CountsGateClasses) {
+    ResourceEstimator estimator;
+    estimator.add(Gate::h(0));
+    estimator.add(Gate::t(0));
+    estimator.add(Gate::tdg(1));
+    estimator.add(Gate::cnot(0, 1));
+    estimator.add(Gate::rz(1, 0.3));
+    estimator.add(Gate::cphase(0, 1, 0.1));
+    estimator.add(Gate::ccx(0, 1, 2));
+    estimator.add(Gate::barrier({0, 1, 2}));
+    estimator.add(Gate::measure(2, 0));
+
+    ResourceEstimate e = estimator.estimate();
+    EXPECT_EQ(e.num_qubits, 3u);
+    EXPECT_EQ(e.num_gates, 9u);
+    EXPECT_EQ(e.t_count, 2u);
+    EXPECT_EQ(e.cnot_count, 1u);
+    EXPECT_EQ(e.two_qubit_count, 2u);
+    EXPECT_EQ(e.ccx_count, 1u);
+    EXPECT_EQ(e.rotation_count, 2u);
+    EXPECT_EQ(e.measure_count, 1u);
+    EXPECT_EQ(e.qubit_activity, (std::vector<std::size_t>{5, 5, 2}));
+}
+
+TEST(ResourceEstimatorTest, TDepthCountsOnlyTLayers) {
+    ResourceEstimator estimator;
+    estimator.add(Gate::t(0));         // T layer 1
+    estimator.add(Gate::t(1));         // T layer 1 (parallel)
+    estimator.add(Gate::cnot(0, 1));
+    estimator.add(Gate::h(0));
+    estimator.add(Gate::tdg(0));       // T layer 2
+    estimator.add(Gate::t(2));         // T layer 1
+    ResourceEstimate e = estimator.estimate();
+    EXPECT_EQ(e.t_count, 4u);
+    EXPECT_EQ(e.t_depth, 2u);
+    EXPECT_EQ(e.depth, 4u);
+}
+
+TEST(ResourceEstimatorTest, ReportCoversDeclaredQubits) {
+    ResourceEstimator estimator;
+    estimator.add(Gate::x(1));
+    ResourceEstimate e = estimator.estimate(4);
+    EXPECT_EQ(e.num_qubits, 4u);
+    EXPECT_EQ(e.qubit_activity, (std::vector<std::size_t>{0, 1, 0, 0}));
+    EXPECT_EQ(e.toJson(),
+              "{\"num_qubits\":4,\"num_gates\":1,\"depth\":1,\"t_count\":0,\"t_depth\":0,"
+              "\"cnot_count\":0,\"two_qubit_count\":0,\"ccx_count\":0,\"rotation_count\":0,"
+              "\"measure_count\":0,\"qubit_activity\":[0,1,0,0]}");
+    EXPECT_EQ(ResourceEstimator().estimate().num_qubits, 0u);
+}
+
+// =============================================================================
+// Consistency Tests
+// =============================================================================
+
+TEST(ResourceEstimatorTest, DepthMatchesCircuit) {
+    constexpr std::size_t n = 5;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<QubitIndex> pick(0, n - 1);
+
+    Circuit c(n, n);
+    ResourceEstimator estimator;
+    for (int i = 0; i < 200; ++i) {
+        QubitIndex a = pick(rng);
+        QubitIndex b = pick(rng);
+        Gate g = a == b ? (i % 3 == 0 ? Gate::t(a) : Gate::measure(a, b))
+                        : Gate::cnot(a, b);
+        c.addGate(g);
+        estimator.add(g);
+    }
+    ResourceEstimate e = estimator.estimate(n);
+    EXPECT_EQ(e.depth, c.depth());
+    EXPECT_EQ(e.cnot_count, c.countGates(GateType::CNOT));
+    EXPECT_EQ(e.num_gates, c.numGates());
+}
+
+TEST(ResourceEstimatorTest, EstimatesStreamedQasm) {
+    ResourceEstimator estimator;
+    parser::Parser parser(R"(
+OPENQASM 3.0;
+qubit[3] q;
+for uint i in [0:9] { t q[0]; cx q[0], q[1]; }
+)");
+    auto info = parser.parseStreaming([&](const Gate& g) { estimator.add(g); });
+    ResourceEstimate e = estimator.estimate(info.numQubits);
+    EXPECT_EQ(e.num_qubits, 3u);
+    EXPECT_EQ(e.t_count, 10u);
+    EXPECT_EQ(e.t_depth, 10u);
+    EXPECT_EQ(e.cnot_count, 10u);
+    EXPECT_EQ(e.depth, 20u);
+    EXPECT_EQ(e.qubit_activity, (std::vector<std::size_t>{20, 10, 0}));
+}
+
+}  // namespace
+}  // namespace qopt::ir
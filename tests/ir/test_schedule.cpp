@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file test_schedule.cpp
+ * @brief Unit tests for duration tables and ASAP/ALAP scheduling
+ */
+
+#include "ir/Schedule.hpp"
+#include "ir/Circuit.hpp"
+#include "ir/DAG.hpp"
+
+#include <gtest/gtest.h>
+
+namespace qopt::ir {
+namespace {
+
+/// @brief 20 ns single-qubit gates, 300 ns two-qubit gates, 1 us measurement.
+DurationTable hardware() {
+    return DurationTable::byArity(20.0, 300.0, 1000.0);
+}
+
+// =============================================================================
+// DurationTable Tests
+// =============================================================================
+
+TEST(DurationTableTest, DefaultsToUnitDurations) {
+    DurationTable table;
+    EXPECT_DOUBLE_EQ(table.duration(GateType::H), 1.0);
+    EXPECT_DOUBLE_EQ(table.duration(GateType::CNOT), 1.0);
+    EXPECT_DOUBLE_EQ(table.duration(GateType::Barrier), 0.0);
+}
+
+TEST(DurationTableTest, ByArityAssignsClasses) {
+    DurationTable table = hardware();
+    EXPECT_DOUBLE_EQ(table(Gate::rz(0, 0.1)), 20.0);
+    EXPECT_DOUBLE_EQ(table(Gate::cz(0, 1)), 300.0);
+    EXPECT_DOUBLE_EQ(table(Gate::ccx(0, 1, 2)), 300.0);
+    EXPECT_DOUBLE_EQ(table(Gate::measure(0, 0)), 1000.0);
+    EXPECT_DOUBLE_EQ(table(Gate::barrier({0, 1})), 0.0);
+
+    table.set(GateType::Rz, 0.0).set(GateType::SWAP, 900.0);
+    EXPECT_DOUBLE_EQ(table(Gate::rz(0, 0.1)), 0.0);
+    EXPECT_DOUBLE_EQ(table(Gate::swap(0, 1)), 900.0);
+    EXPECT_THROW(table.set(GateType::X, -1.0), std::invalid_argument);
+}
+
+// =============================================================================
+// Schedule Tests
+// =============================================================================
+
+TEST(ScheduleTest, UnitDurationsMatchDepth) {
+    Circuit c(3);
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::cnot(0, 1));
+    c.addGate(Gate::cnot(1, 2));
+    c.addGate(Gate::x(0));
+    Schedule s = Schedule::compute(c);
+    EXPECT_DOUBLE_EQ(s.duration(), static_cast<double>(c.depth()));
+    EXPECT_EQ(s.numNodes(), 4u);
+}
+
+TEST(ScheduleTest, AsapAlapAndSlack) {
+    // q0: H ─ CNOT ─ measure
+    // q1: X ─ CNOT
+    // q2: X ────────────────── (independent)
+    Circuit c(3, 1);
+    c.addGate(Gate::h(0));           // 0
+    c.addGate(Gate::x(1));           // 1
+    c.addGate(Gate::cnot(0, 1));     // 2
+    c.addGate(Gate::measure(0, 0));  // 3
+    c.addGate(Gate::x(2));           // 4
+    DAG dag = DAG::fromCircuit(c);
+    Schedule s = Schedule::compute(dag, hardware());
+
+    EXPECT_DOUBLE_EQ(s.duration(), 20.0 + 300.0 + 1000.0);
+    EXPECT_DOUBLE_EQ(s.asap(2), 20.0);
+    EXPECT_DOUBLE_EQ(s.asap(3), 320.0);
+    EXPECT_DOUBLE_EQ(s.alap(4), 1300.0);
+    EXPECT_DOUBLE_EQ(s.slack(4), 1300.0);
+    EXPECT_DOUBLE_EQ(s.slack(1), 0.0);  // Same length as H
+    EXPECT_DOUBLE_EQ(s.durationOf(3), 1000.0);
+
+    EXPECT_TRUE(s.isCritical(0));
+    EXPECT_TRUE(s.isCritical(3));
+    EXPECT_FALSE(s.isCritical(4));
+    EXPECT_EQ(s.criticalPath(dag), (std::vector<GateId>{0, 2, 3}));
+    EXPECT_THROW({ [[maybe_unused]] auto t = s.asap(9); }, std::out_of_range);
+}
+
+TEST(ScheduleTest, IdleWindowsPerQubit) {
+    Circuit c(2, 1);
+    c.addGate(Gate::h(0));           // [0, 20)
+    c.addGate(Gate::h(0));           // [20, 40)
+    c.addGate(Gate::cnot(0, 1));     // [40, 340)
+    c.addGate(Gate::measure(0, 0));  // [340, 1340)
+    Schedule s = Schedule::compute(c, hardware());
+
+    // q1 waits for q0's two H gates, then for the measurement
+    EXPECT_EQ(s.idleWindows(1), (std::vector<IdleWindow>{{1, 0.0, 40.0}, {1, 340.0, 1340.0}}));
+    EXPECT_TRUE(s.idleWindows(0).empty());
+    EXPECT_DOUBLE_EQ(s.idleTime(1), 1040.0);
+    EXPECT_EQ(s.idleWindows().size(), 2u);
+    EXPECT_THROW({ [[maybe_unused]] auto w = s.idleWindows(2); }, std::out_of_range);
+}
+
+TEST(ScheduleTest, AlapWindowsShiftSlackToTheStart) {
+    Circuit c(2);
+    c.addGate(Gate::x(1));  // 20 ns of slack before the CNOT
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::cnot(0, 1));
+    Schedule s = Schedule::compute(c, hardware());
+
+    EXPECT_DOUBLE_EQ(s.duration(), 340.0);
+    EXPECT_DOUBLE_EQ(s.slack(0), 20.0);
+    EXPECT_EQ(s.idleWindows(1, Alignment::ASAP), (std::vector<IdleWindow>{{1, 20.0, 40.0}}));
+    EXPECT_EQ(s.idleWindows(1, Alignment::ALAP), (std::vector<IdleWindow>{{1, 0.0, 20.0}}));
+}
+
+TEST(ScheduleTest, EmptyDag) {
+    DAG dag(2);
+    Schedule s = Schedule::compute(dag);
+    EXPECT_DOUBLE_EQ(s.duration(), 0.0);
+    EXPECT_TRUE(s.idleWindows().empty());
+    EXPECT_TRUE(s.criticalPath(dag).empty());
+}
+
+}  // namespace
+}  // namespace qopt::ir
@@ -160,6 +160,54 @@ TEST_F(LexerTest, MeasureKeyword) {
     expectToken(tok, TokenType::Measure, "measure");
 }
 
+TEST_F(LexerTest, GateKeyword) {
+    Token tok = firstToken("gate");
+    expectToken(tok, TokenType::GateDecl, "gate");
+}
+
+TEST_F(LexerTest, LoopKeywordsAndColon) {
+    Lexer lexer("for i in [0:2:8]");
+    auto tokens = lexer.tokenizeAll();
+    ASSERT_GE(tokens.size(), 9u);
+    expectToken(tokens[0], TokenType::For, "for");
+    expectToken(tokens[2], TokenType::In, "in");
+    expectToken(tokens[5], TokenType::Colon, ":");
+    expectToken(tokens[7], TokenType::Colon, ":");
+}
+
+TEST_F(LexerTest, ResetKeyword) {
+    Token tok = firstToken("reset");
+    expectToken(tok, TokenType::Reset, "reset");
+}
+
+TEST_F(LexerTest, ExtendedGateKeywords) {
+    Lexer lexer("U u3 sx cp cphase rzz iswap ccx");
+    EXPECT_EQ(lexer.nextToken().type(), TokenType::GateU3);
+    EXPECT_EQ(lexer.nextToken().type(), TokenType::GateU3);
+    EXPECT_EQ(lexer.nextToken().type(), TokenType::GateSX);
+    EXPECT_EQ(lexer.nextToken().type(), TokenType::GateCPhase);
+    EXPECT_EQ(lexer.nextToken().type(), TokenType::GateCPhase);
+    EXPECT_EQ(lexer.nextToken().type(), TokenType::GateRZZ);
+    EXPECT_EQ(lexer.nextToken().type(), TokenType::GateISwap);
+    Token ccx = lexer.nextToken();
+    EXPECT_EQ(ccx.type(), TokenType::GateCCX);
+    EXPECT_TRUE(ccx.isGate());
+    EXPECT_FALSE(ccx.isTwoQubitGate());
+}
+
+TEST_F(LexerTest, Qasm2DialectKeywords) {
+    Lexer qasm3("qreg creg CX");
+    EXPECT_EQ(qasm3.nextToken().type(), TokenType::Identifier);
+    EXPECT_EQ(qasm3.nextToken().type(), TokenType::Identifier);
+    EXPECT_EQ(qasm3.nextToken().type(), TokenType::Identifier);
+
+    Lexer qasm2("qreg creg CX barrier", Dialect::QASM2);
+    EXPECT_EQ(qasm2.nextToken().type(), TokenType::Qreg);
+    EXPECT_EQ(qasm2.nextToken().type(), TokenType::Creg);
+    EXPECT_EQ(qasm2.nextToken().type(), TokenType::GateCX);
+    EXPECT_EQ(qasm2.nextToken().type(), TokenType::Barrier);
+}
+
 TEST_F(LexerTest, PiKeyword) {
     Token tok = firstToken("pi");
     expectToken(tok, TokenType::Pi, "pi");
@@ -14,7 +14,11 @@
  * - Single-qubit gate applications
  * - Two-qubit gate applications
  * - Parameterized gate applications with arithmetic
- * - Measurement statements
+ * - Measurement, reset and barrier statements
+ * - Custom gate definitions, calls and expansion caching
+ * - For-loop unrolling
+ * - Register broadcast and the OpenQASM 2.0 dialect
+ * - Streaming gates to a callback
  * - Error handling and recovery
  * - Full program parsing
  */
@@ -321,25 +325,525 @@ TEST_F(ParserTest, ParameterizedGateMissingParen) {
     expectParseError("OPENQASM 3.0; qubit q; rz pi q[0];");
 }
 
+TEST_F(ParserTest, InputsMakeSymbolicParameters) {
+    auto circuit = parse(R"(
+OPENQASM 3.0;
+input float[64] theta;
+input angle phi;
+qubit[2] q;
+rz(theta / 2 + pi) q[0];
+rzz(2 * (theta - phi)) q[0], q[1];
+u3(theta, 0.5, -phi) q[1];
+rx(theta - theta + 0.25) q[1];
+)");
+    ASSERT_NE(circuit, nullptr);
+    const auto& table = circuit->parameterTable();
+    EXPECT_EQ(table.symbols(), (std::vector<std::string>{"theta", "phi"}));
+    ASSERT_EQ(circuit->numGates(), 4u);
+    EXPECT_TRUE(circuit->gate(0).isSymbolic());
+    EXPECT_EQ(table.toString(*circuit->gate(1).expression(0)), "2*theta - 2*phi");
+    EXPECT_FALSE(circuit->gate(2).expression(1).has_value());
+    EXPECT_FALSE(circuit->gate(3).isSymbolic());
+
+    ir::Circuit bound = circuit->bind({1.0, 0.25});
+    EXPECT_NEAR(bound.gate(0).parameter(0), 0.5 + M_PI, TOLERANCE);
+    EXPECT_EQ(bound.gate(1), ir::Gate::rzz(0, 1, 1.5));
+    EXPECT_EQ(bound.gate(2), ir::Gate::u3(1, 1.0, 0.5, -0.25));
+    EXPECT_EQ(bound.gate(3), ir::Gate::rx(1, 0.25));
+}
+
+TEST_F(ParserTest, SymbolicArgumentsExpandCustomGates) {
+    auto circuit = parse(R"(
+OPENQASM 3.0;
+input float theta;
+gate crz(lam) a, b { rz(lam / 2) b; cx a, b; rz(-lam / 2) b; cx a, b; }
+qubit[2] q;
+crz(theta) q[0], q[1];
+crz(0.5) q[0], q[1];
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 8u);
+    EXPECT_TRUE(circuit->gate(0).isSymbolic());
+    EXPECT_FALSE(circuit->gate(4).isSymbolic());
+
+    ir::Circuit bound = circuit->bind({0.5});
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(bound.gate(i), bound.gate(i + 4)) << "gate " << i;
+    }
+}
+
+TEST_F(ParserTest, SymbolicParameterErrors) {
+    // Not affine
+    expectParseError("OPENQASM 3.0; input float v; qubit q; rz(v * v) q;");
+    expectParseError("OPENQASM 3.0; input float v; qubit q; rz(1 / v) q;");
+    // Undeclared, redeclared or conflicting names
+    expectParseError("OPENQASM 3.0; qubit q; rz(v) q;");
+    expectParseError("OPENQASM 3.0; input float v; input angle v;");
+    expectParseError("OPENQASM 3.0; input float q; qubit q;");
+    expectParseError("OPENQASM 3.0; input int v;");
+    // Loop bodies only see loop variables
+    expectParseError("OPENQASM 3.0; input float v; qubit[2] q; for i in [0:1] { rz(v) q[i]; }");
+}
+
 // =============================================================================
 // Measurement Tests
 // =============================================================================
 
 TEST_F(ParserTest, MeasurementAssignment) {
-    auto circuit = parse("OPENQASM 3.0; qubit q; bit c; c[0] = measure q[0];");
-    EXPECT_NE(circuit, nullptr);
-    // Measurement doesn't add gates in our model
+    auto circuit = parse("OPENQASM 3.0; qubit[2] q; bit[2] c; c[0] = measure q[1];");
+    ASSERT_NE(circuit, nullptr);
+    EXPECT_EQ(circuit->numClbits(), 2u);
+    ASSERT_EQ(circuit->numGates(), 1u);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::measure(1, 0));
 }
 
 TEST_F(ParserTest, MeasurementWithoutIndex) {
-    auto circuit = parse("OPENQASM 3.0; qubit q; bit c; c = measure q;");
-    EXPECT_NE(circuit, nullptr);
+    auto circuit = parse("OPENQASM 3.0; qubit[2] q; bit[2] c; c = measure q;");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 2u);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::measure(0, 0));
+    EXPECT_EQ(circuit->gate(1), ir::Gate::measure(1, 1));
 }
 
 TEST_F(ParserTest, StandaloneMeasure) {
+    // The result is discarded but the qubit is still measured
     auto circuit = parse("OPENQASM 3.0; qubit q; measure q[0];");
-    EXPECT_NE(circuit, nullptr);
-    // Should generate a warning (result discarded)
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 1u);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::measure(0));
+    EXPECT_FALSE(circuit->gate(0).clbit().has_value());
+}
+
+TEST_F(ParserTest, MeasurementsStayInProgramOrder) {
+    auto circuit = parse(
+        "OPENQASM 3.0; qubit[2] q; bit[2] c; h q[0]; c[0] = measure q[0]; "
+        "reset q[0]; x q[0]; c[1] = measure q[0];");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 5u);
+    EXPECT_EQ(circuit->gate(1), ir::Gate::measure(0, 0));
+    EXPECT_EQ(circuit->gate(2), ir::Gate::reset(0));
+    EXPECT_EQ(circuit->gate(4), ir::Gate::measure(0, 1));
+}
+
+TEST_F(ParserTest, ResetBroadcasts) {
+    auto circuit = parse("OPENQASM 3.0; qubit[3] q; reset q;");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 3u);
+    EXPECT_EQ(circuit->gate(2), ir::Gate::reset(2));
+}
+
+// =============================================================================
+// Gate Definition Tests
+// =============================================================================
+
+TEST_F(ParserTest, GateDefinitionExpandsAtCall) {
+    auto circuit = parse(R"(
+OPENQASM 3.0;
+qubit[3] q;
+gate bell a, b { h a; cx a, b; }
+bell q[2], q[0];
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 2u);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::h(2));
+    EXPECT_EQ(circuit->gate(1), ir::Gate::cnot(2, 0));
+}
+
+TEST_F(ParserTest, GateDefinitionSubstitutesParameters) {
+    auto circuit = parse(R"(
+OPENQASM 3.0;
+qubit[2] q;
+gate crz(theta) a, b { rz(theta / 2) b; cx a, b; rz(-theta / 2) b; cx a, b; }
+crz(pi) q[0], q[1];
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 4u);
+    EXPECT_NEAR(circuit->gate(0).parameter().value(), M_PI / 2.0, TOLERANCE);
+    EXPECT_NEAR(circuit->gate(2).parameter().value(), -M_PI / 2.0, TOLERANCE);
+    EXPECT_EQ(circuit->gate(1), ir::Gate::cnot(0, 1));
+}
+
+TEST_F(ParserTest, GateDefinitionInlinesNestedCalls) {
+    auto circuit = parse(R"(
+OPENQASM 3.0;
+qubit[2] q;
+gate r2(a, b) w { rz(a + b) w; ry(a * b) w; }
+gate outer(theta) p, c { r2(theta, 2 * theta) c; cx p, c; }
+outer(0.5) q[1], q[0];
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 3u);
+    EXPECT_EQ(circuit->gate(0).type(), ir::GateType::Rz);
+    EXPECT_EQ(circuit->gate(0).qubits()[0], 0u);
+    EXPECT_NEAR(circuit->gate(0).parameter().value(), 1.5, TOLERANCE);
+    EXPECT_NEAR(circuit->gate(1).parameter().value(), 0.5, TOLERANCE);
+    EXPECT_EQ(circuit->gate(2), ir::Gate::cnot(1, 0));
+}
+
+TEST_F(ParserTest, GateExpansionIsCachedPerArguments) {
+    Parser parser(R"(
+OPENQASM 3.0;
+qubit[4] q;
+gate g(theta) a { rx(theta) a; h a; }
+g(0.25) q[0];
+g(0.25) q[1];
+g(0.5) q[2];
+g(0.25) q[3];
+)");
+    auto result = parser.parse();
+    ASSERT_TRUE(result.success());
+    EXPECT_EQ(result.circuit->numGates(), 8u);
+    EXPECT_EQ(parser.gateCacheStats().misses, 2u);
+    EXPECT_EQ(parser.gateCacheStats().hits, 2u);
+    EXPECT_EQ(result.circuit->gate(6), ir::Gate::rx(3, 0.25));
+}
+
+TEST_F(ParserTest, GateDefinitionAcceptsGateNamesAsFormals) {
+    auto circuit = parse(R"(
+OPENQASM 3.0;
+qubit[2] q;
+gate foo(rz) x, y { rz(rz) x; cx x, y; }
+gate bar t { t t; }
+foo(0.5) q[1], q[0];
+bar q[0];
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 3u);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::rz(1, 0.5));
+    EXPECT_EQ(circuit->gate(1), ir::Gate::cnot(1, 0));
+    EXPECT_EQ(circuit->gate(2), ir::Gate::t(0));
+}
+
+TEST_F(ParserTest, GateDefinitionWithEmptyBody) {
+    expectGateCount("OPENQASM 3.0; qubit q; gate nop a { } nop q[0]; h q[0];", 1);
+}
+
+TEST_F(ParserTest, GateDefinitionErrors) {
+    // Wrong arity
+    expectParseError("OPENQASM 3.0; qubit[2] q; gate g a, b { cx a, b; } g q[0];");
+    expectParseError("OPENQASM 3.0; qubit q; gate g(theta) a { rz(theta) a; } g q[0];");
+    // Duplicate operands
+    expectParseError("OPENQASM 3.0; qubit[2] q; gate g a, b { cx a, b; } g q[1], q[1];");
+    expectParseError("OPENQASM 3.0; qubit[2] q; gate g a, b { cx a, a; }");
+    expectParseError("OPENQASM 3.0; gate g a, a { h a; }");
+    // Unknown names inside the body
+    expectParseError("OPENQASM 3.0; gate g a { h b; }");
+    expectParseError("OPENQASM 3.0; gate g a { rz(theta) a; }");
+    expectParseError("OPENQASM 3.0; gate g a { g a; }");
+    // Redefinition and clashes with registers
+    expectParseError("OPENQASM 3.0; gate g a { h a; } gate g a { x a; }");
+    expectParseError("OPENQASM 3.0; qubit q; gate q a { h a; }");
+    expectParseError("OPENQASM 3.0; gate q a { h a; } qubit q;");
+    // Non-finite parameter at expansion
+    expectParseError("OPENQASM 3.0; qubit q; gate g(theta) a { rz(1 / theta) a; } g(0) q[0];");
+}
+
+// =============================================================================
+// Loop Tests
+// =============================================================================
+
+TEST_F(ParserTest, ForLoopUnrollsInclusiveRange) {
+    auto circuit = parse(R"(
+OPENQASM 3.0;
+qubit[4] q;
+for uint i in [0:2] { cx q[i], q[i + 1]; }
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 3u);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::cnot(0, 1));
+    EXPECT_EQ(circuit->gate(1), ir::Gate::cnot(1, 2));
+    EXPECT_EQ(circuit->gate(2), ir::Gate::cnot(2, 3));
+}
+
+TEST_F(ParserTest, ForLoopWithStepAndParameters) {
+    auto circuit = parse(R"(
+OPENQASM 3.0;
+qubit[6] q;
+for i in [5:-2:0] rz(i * pi / 4) q[i];
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 3u);
+    EXPECT_EQ(circuit->gate(0).qubits()[0], 5u);
+    EXPECT_EQ(circuit->gate(2).qubits()[0], 1u);
+    EXPECT_NEAR(circuit->gate(1).parameter().value(), 3 * M_PI / 4, TOLERANCE);
+}
+
+TEST_F(ParserTest, NestedLoopsWithDependentBounds) {
+    auto circuit = parse(R"(
+OPENQASM 3.0;
+qubit[4] q;
+for i in [0:3] {
+    h q[i];
+    for j in [i + 1:3] { cz q[i], q[j]; }
+}
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 4u + 6u);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::h(0));
+    EXPECT_EQ(circuit->gate(1), ir::Gate::cz(0, 1));
+    EXPECT_EQ(circuit->gate(4), ir::Gate::h(1));
+    EXPECT_EQ(circuit->gate(9), ir::Gate::h(3));
+}
+
+TEST_F(ParserTest, ForLoopCallsCustomGate) {
+    Parser parser(R"(
+OPENQASM 3.0;
+qubit[3] q;
+qubit[3] r;
+gate zz(theta) a, b { cx a, b; rz(theta) b; cx a, b; }
+for i in [0:2] { zz(0.5) q[i], r[2 - i]; }
+)");
+    auto result = parser.parse();
+    ASSERT_TRUE(result.success());
+    ASSERT_EQ(result.circuit->numGates(), 9u);
+    EXPECT_EQ(result.circuit->gate(3), ir::Gate::cnot(1, 4));
+    EXPECT_EQ(parser.gateCacheStats().misses, 1u);
+    EXPECT_EQ(parser.gateCacheStats().hits, 2u);
+}
+
+TEST_F(ParserTest, ForLoopMeasuresResetsAndBarriers) {
+    auto circuit = parse(R"(
+OPENQASM 3.0;
+qubit[3] q;
+bit[3] c;
+for i in [0:2] { reset q[i]; barrier q[i], q[2 - i]; c[2 - i] = measure q[i]; }
+for i in [0:1] { measure q[i] -> c[i]; measure q[i]; }
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 9u + 4u);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::reset(0));
+    EXPECT_EQ(circuit->gate(1), ir::Gate::barrier({0, 2}));
+    EXPECT_EQ(circuit->gate(2), ir::Gate::measure(0, 2));
+    EXPECT_EQ(circuit->gate(4), ir::Gate::barrier({1}));
+    EXPECT_EQ(circuit->gate(11), ir::Gate::measure(1, 1));
+    EXPECT_EQ(circuit->gate(12), ir::Gate::measure(1));
+}
+
+TEST_F(ParserTest, ExtendedNativeGates) {
+    auto circuit = parse(R"(
+OPENQASM 3.0;
+qubit[3] q;
+gate qftpair(theta) a, b { h a; cp(theta) b, a; }
+U(pi / 2, 0, pi) q[0];
+sx q[1];
+ccx q[0], q[1], q[2];
+cphase(pi / 4) q[2], q[0];
+rzz(0.5) q[0], q[1];
+iswap q[1], q[2];
+qftpair(pi / 8) q[1], q[2];
+for i in [0:1] { cp(i * 0.5) q[i], q[2]; ccx q[i], q[1 - i], q[2]; }
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 6u + 2u + 4u);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::u3(0, M_PI / 2, 0.0, M_PI));
+    EXPECT_EQ(circuit->gate(1), ir::Gate::sx(1));
+    EXPECT_EQ(circuit->gate(2), ir::Gate::ccx(0, 1, 2));
+    EXPECT_EQ(circuit->gate(3), ir::Gate::cphase(2, 0, M_PI / 4));
+    EXPECT_EQ(circuit->gate(4), ir::Gate::rzz(0, 1, 0.5));
+    EXPECT_EQ(circuit->gate(5), ir::Gate::iswap(1, 2));
+    EXPECT_EQ(circuit->gate(7), ir::Gate::cphase(2, 1, M_PI / 8));
+    EXPECT_EQ(circuit->gate(10), ir::Gate::cphase(1, 2, 0.5));
+    EXPECT_EQ(circuit->gate(11), ir::Gate::ccx(1, 0, 2));
+}
+
+TEST_F(ParserTest, ExtendedGateErrors) {
+    // Wrong parameter or operand counts, repeated operands
+    expectParseError("OPENQASM 3.0; qubit q; U(0, 0) q[0];");
+    expectParseError("OPENQASM 3.0; qubit[2] q; cp q[0], q[1];");
+    expectParseError("OPENQASM 3.0; qubit[3] q; ccx q[0], q[1];");
+    expectParseError("OPENQASM 3.0; qubit[3] q; gate g a, b { ccx a, b, a; }");
+    expectParseError("OPENQASM 3.0; qubit[3] q; for i in [0:1] { U(i) q[i]; }");
+}
+
+TEST_F(ParserTest, ForLoopEmptyRange) {
+    expectGateCount("OPENQASM 3.0; qubit[2] q; for i in [1:0] { h q[i]; } x q[0];", 1);
+}
+
+TEST_F(ParserTest, ForLoopErrors) {
+    // Index out of range, non-integer index, zero step
+    expectParseError("OPENQASM 3.0; qubit[2] q; for i in [0:2] { h q[i]; }");
+    expectParseError("OPENQASM 3.0; qubit[2] q; for i in [0:1] { h q[i / 2]; }");
+    expectParseError("OPENQASM 3.0; qubit[2] q; for i in [0:0:1] { h q[i]; }");
+    // Unknown identifiers, shadowing, unsupported statements
+    expectParseError("OPENQASM 3.0; qubit[2] q; for i in [0:n] { h q[i]; }");
+    expectParseError("OPENQASM 3.0; qubit[2] q; for i in [0:1] { for i in [0:1] { h q[i]; } }");
+    expectParseError("OPENQASM 3.0; qubit[2] q; for i in [0:1] { q[i] = measure q[i]; }");
+    // Loop variable is not visible after the loop
+    expectParseError("OPENQASM 3.0; qubit[2] q; for i in [0:1] { h q[i]; } rz(i) q[0];");
+}
+
+TEST_F(ParserTest, UndeclaredRegisterIsError) {
+    expectParseError("OPENQASM 3.0; qubit[2] q; h r[0];");
+    expectParseError("OPENQASM 3.0; qubit[2] q; bit[2] c; h c[0];");
+    expectParseError("OPENQASM 3.0; qubit[2] q; h q[2];");
+}
+
+// =============================================================================
+// Broadcast Tests
+// =============================================================================
+
+TEST_F(ParserTest, BroadcastSingleQubitGate) {
+    auto circuit = parse("OPENQASM 3.0; qubit[3] q; h q;");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 3u);
+    EXPECT_EQ(circuit->gate(2), ir::Gate::h(2));
+}
+
+TEST_F(ParserTest, BroadcastTwoQubitGate) {
+    auto circuit = parse("OPENQASM 3.0; qubit[2] a; qubit[2] b; cx a, b; cz a[0], b;");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 4u);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::cnot(0, 2));
+    EXPECT_EQ(circuit->gate(1), ir::Gate::cnot(1, 3));
+    EXPECT_EQ(circuit->gate(3), ir::Gate::cz(0, 3));
+}
+
+TEST_F(ParserTest, BroadcastSizeMismatch) {
+    expectParseError("OPENQASM 3.0; qubit[2] a; qubit[3] b; cx a, b;");
+    expectParseError("OPENQASM 3.0; qubit[2] q; bit[3] c; c = measure q;");
+}
+
+TEST_F(ParserTest, BarrierSpansOperands) {
+    auto circuit = parse("OPENQASM 3.0; qubit[2] q; qubit r; h q[0]; barrier r, q[1], q; x q[1];");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 3u);
+    EXPECT_EQ(circuit->gate(1), ir::Gate::barrier({0, 1, 2}));
+
+    circuit = parse("OPENQASM 3.0; qubit[2] q; qubit r; barrier;");
+    ASSERT_NE(circuit, nullptr);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::barrier({0, 1, 2}));
+
+    expectParseError("OPENQASM 3.0; qubit[2] q; barrier r;");
+}
+
+// =============================================================================
+// OpenQASM 2.0 Tests
+// =============================================================================
+
+TEST_F(ParserTest, Qasm2Program) {
+    Parser parser(R"(
+OPENQASM 2.0;
+include "qelib1.inc";
+qreg q[2];
+creg c[2];
+h q[0];
+CX q[0], q[1];
+barrier q;
+measure q -> c;
+)");
+    auto result = parser.parse();
+    ASSERT_TRUE(result.success());
+    EXPECT_EQ(parser.dialect(), Dialect::QASM2);
+    EXPECT_TRUE(result.warnings.empty());
+    ASSERT_EQ(result.circuit->numQubits(), 2u);
+    ASSERT_EQ(result.circuit->numClbits(), 2u);
+    ASSERT_EQ(result.circuit->numGates(), 5u);
+    EXPECT_EQ(result.circuit->gate(1), ir::Gate::cnot(0, 1));
+    EXPECT_EQ(result.circuit->gate(2), ir::Gate::barrier({0, 1}));
+    EXPECT_EQ(result.circuit->gate(4), ir::Gate::measure(1, 1));
+}
+
+TEST_F(ParserTest, Qasm2UGatesAreNative) {
+    auto circuit = parse(R"(
+OPENQASM 2.0;
+qreg q[1];
+u1(0.25) q[0];
+u2(0.5, 0.75) q[0];
+u3(1, 2, 3) q[0];
+U(1, 2, 3) q[0];
+id q[0];
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 4u);
+    EXPECT_EQ(circuit->gate(0), ir::Gate::rz(0, 0.25));
+    EXPECT_EQ(circuit->gate(1), ir::Gate::u3(0, M_PI / 2, 0.5, 0.75));
+    EXPECT_EQ(circuit->gate(2), ir::Gate::u3(0, 1.0, 2.0, 3.0));
+    EXPECT_EQ(circuit->gate(3), ir::Gate::u3(0, 1.0, 2.0, 3.0));
+}
+
+TEST_F(ParserTest, Qasm2GateDefinitionUsesBuiltins) {
+    auto circuit = parse(R"(
+OPENQASM 2.0;
+include "qelib1.inc";
+gate cu1(lambda) a, b { u1(lambda / 2) a; CX a, b; u1(-lambda / 2) b; CX a, b; u1(lambda / 2) b; }
+qreg q[3];
+cu1(pi) q[0], q[2];
+)");
+    ASSERT_NE(circuit, nullptr);
+    ASSERT_EQ(circuit->numGates(), 5u);
+    EXPECT_EQ(circuit->gate(1), ir::Gate::cnot(0, 2));
+    EXPECT_NEAR(circuit->gate(2).parameter().value(), -M_PI / 2, TOLERANCE);
+}
+
+TEST_F(ParserTest, Qasm2KeywordsAreDialectSpecific) {
+    // qreg is an ordinary identifier in OpenQASM 3.0
+    expectParseError("OPENQASM 3.0; qreg q[1];");
+    // u2 is not predefined in OpenQASM 3.0
+    expectParseError("OPENQASM 3.0; qubit q; u2(0, 0) q[0];");
+    expectParseError("OPENQASM 2.0; creg c; ");
+}
+
+// =============================================================================
+// Streaming Tests
+// =============================================================================
+
+TEST_F(ParserTest, StreamingMatchesParsedCircuit) {
+    constexpr std::string_view source = R"(
+OPENQASM 3.0;
+qubit[4] q;
+bit[4] c;
+gate bell a, b { h a; cx a, b; }
+bell q[0], q[1];
+for uint i in [1:2] { cx q[i], q[i + 1]; }
+rz(pi / 4) q[3];
+c = measure q;
+)";
+    std::vector<ir::Gate> streamed;
+    Parser parser(source);
+    auto info = parser.parseStreaming([&](const ir::Gate& g) { streamed.push_back(g); });
+
+    auto circuit = parse(source);
+    ASSERT_EQ(info.numGates, circuit->numGates());
+    EXPECT_EQ(info.numQubits, 4u);
+    EXPECT_EQ(info.numClbits, 4u);
+    ASSERT_EQ(streamed.size(), circuit->numGates());
+    for (size_t i = 0; i < streamed.size(); ++i) {
+        EXPECT_EQ(streamed[i], circuit->gate(i)) << "gate " << i;
+        EXPECT_EQ(streamed[i].id(), i);
+    }
+}
+
+TEST_F(ParserTest, StreamingBoundsTheExpansionCache) {
+    // Every call has new arguments; the second loop repeats the first
+    const std::string source =
+        "OPENQASM 3.0; qubit[1] q; gate g(theta) a { rz(theta) a; }\n"
+        "for uint i in [0:299] { g(i) q[0]; }\n"
+        "for uint i in [0:299] { g(i) q[0]; }\n";
+
+    Parser parser(source);
+    std::vector<double> angles;
+    auto info = parser.parseStreaming(
+        [&](const ir::Gate& g) { angles.push_back(g.parameter().value()); });
+    ASSERT_EQ(info.numGates, 600u);
+    EXPECT_DOUBLE_EQ(angles[299], 299.0);
+    EXPECT_DOUBLE_EQ(angles[599], 299.0);
+
+    // Only the first STREAMING_EXPANSION_LIMIT argument values were kept
+    const size_t limit = Parser::STREAMING_EXPANSION_LIMIT;
+    EXPECT_EQ(parser.gateCacheStats().hits, limit);
+    EXPECT_EQ(parser.gateCacheStats().misses, 600u - limit);
+
+    // parse() keeps every expansion
+    Parser collecting(source);
+    [[maybe_unused]] auto result = collecting.parse();
+    EXPECT_EQ(collecting.gateCacheStats().hits, 300u);
+}
+
+TEST_F(ParserTest, StreamingReportsErrors) {
+    Parser parser("OPENQASM 3.0; qubit[2] q; h q[0]; h q[5];");
+    EXPECT_THROW(
+        { [[maybe_unused]] auto info = parser.parseStreaming([](const ir::Gate&) {}); },
+        QASMParseException);
 }
 
 // =============================================================================
@@ -374,9 +878,10 @@ c = measure q;
     auto circuit = parse(source);
     ASSERT_NE(circuit, nullptr);
     EXPECT_EQ(circuit->numQubits(), 2u);
-    EXPECT_EQ(circuit->numGates(), 2u);
+    EXPECT_EQ(circuit->numGates(), 4u);
     EXPECT_EQ(circuit->gate(0).type(), ir::GateType::H);
     EXPECT_EQ(circuit->gate(1).type(), ir::GateType::CNOT);
+    EXPECT_EQ(circuit->countGates(ir::GateType::Measure), 2u);
 }
 
 TEST_F(ParserTest, GHZState) {
@@ -474,7 +979,7 @@ c[1] = measure q[1];
     auto circuit = parse(source);
     ASSERT_NE(circuit, nullptr);
     EXPECT_EQ(circuit->numQubits(), 3u);
-    EXPECT_EQ(circuit->numGates(), 5u);  // h, cx, rz, cx, h
+    EXPECT_EQ(circuit->numGates(), 7u);  // h, cx, rz, cx, h, measure, measure
 }
 
 TEST_F(ParserTest, CircuitDepthCalculation) {
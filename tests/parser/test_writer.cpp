@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file test_writer.cpp
+ * @brief Unit tests for the OpenQASM 3.0 writer
+ * @author Rylan Malarchick
+ * @date 2025
+ *
+ * Tests cover:
+ * - Program header and gate statement formatting
+ * - Round trips through the Parser (including exact angles)
+ * - Streaming routed gates into a writer via Router::routeTo
+ */
+
+#include "parser/QASMWriter.hpp"
+#include "parser/Parser.hpp"
+#include "routing/SabreRouter.hpp"
+#include "routing/Topology.hpp"
+#include "ir/Circuit.hpp"
+#include "ir/Gate.hpp"
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <sstream>
+#include <string>
+
+namespace qopt::parser {
+namespace {
+
+// =============================================================================
+// Formatting Tests
+// =============================================================================
+
+TEST(QASMWriterTest, HeaderDeclaresRegister) {
+    std::ostringstream out;
+    QASMWriter writer(out, 5);
+    EXPECT_EQ(out.str(), "OPENQASM 3.0;\ninclude \"stdgates.inc\";\nqubit[5] q;\n");
+    EXPECT_EQ(writer.gatesWritten(), 0u);
+}
+
+TEST(QASMWriterTest, WritesGateStatements) {
+    std::ostringstream out;
+    QASMWriter writer(out, 3, "r");
+    writer.write(ir::Gate::h(0));
+    writer.write(ir::Gate::cnot(2, 1));
+    writer(ir::Gate::rz(1, 0.5));
+
+    std::string text = out.str();
+    EXPECT_NE(text.find("qubit[3] r;\n"), std::string::npos);
+    EXPECT_NE(text.find("h r[0];\n"), std::string::npos);
+    EXPECT_NE(text.find("cx r[2], r[1];\n"), std::string::npos);
+    EXPECT_NE(text.find("rz(0.5) r[1];\n"), std::string::npos);
+    EXPECT_EQ(writer.gatesWritten(), 3u);
+}
+
+TEST(QASMWriterTest, GateNamesMatchLexerKeywords) {
+    EXPECT_EQ(qasmGateName(ir::GateType::CNOT), "cx");
+    EXPECT_EQ(qasmGateName(ir::GateType::Sdg), "sdg");
+    EXPECT_EQ(qasmGateName(ir::GateType::SWAP), "swap");
+    EXPECT_EQ(qasmGateName(ir::GateType::U3), "u3");
+    EXPECT_EQ(qasmGateName(ir::GateType::CPhase), "cp");
+    EXPECT_EQ(qasmGateName(ir::GateType::CCX), "ccx");
+}
+
+// =============================================================================
+// Round-Trip Tests
+// =============================================================================
+
+TEST(QASMWriterTest, RoundTripPreservesCircuit) {
+    ir::Circuit c(4);
+    c.addGate(ir::Gate::h(0));
+    c.addGate(ir::Gate::x(1));
+    c.addGate(ir::Gate::y(2));
+    c.addGate(ir::Gate::z(3));
+    c.addGate(ir::Gate::s(0));
+    c.addGate(ir::Gate::sdg(1));
+    c.addGate(ir::Gate::t(2));
+    c.addGate(ir::Gate::tdg(3));
+    c.addGate(ir::Gate::rx(0, constants::PI / 3));
+    c.addGate(ir::Gate::ry(1, -1e-7));
+    c.addGate(ir::Gate::rz(2, 12345.678901234567));
+    c.addGate(ir::Gate::cnot(0, 3));
+    c.addGate(ir::Gate::cz(1, 2));
+    c.addGate(ir::Gate::swap(3, 0));
+    c.addGate(ir::Gate::sx(1));
+    c.addGate(ir::Gate::u3(2, constants::PI / 7, -0.25, 1e-9));
+    c.addGate(ir::Gate::cphase(1, 3, constants::PI / 8));
+    c.addGate(ir::Gate::rzz(0, 2, 0.75));
+    c.addGate(ir::Gate::iswap(2, 1));
+    c.addGate(ir::Gate::ccx(3, 1, 0));
+
+    auto parsed = parseQASM(toQASM(c));
+
+    ASSERT_NE(parsed, nullptr);
+    ASSERT_EQ(parsed->numQubits(), c.numQubits());
+    ASSERT_EQ(parsed->numGates(), c.numGates());
+    for (std::size_t i = 0; i < c.numGates(); ++i) {
+        EXPECT_EQ(parsed->gate(i), c.gate(i)) << "gate " << i;
+    }
+}
+
+TEST(QASMWriterTest, RoundTripPreservesNonUnitaryOperations) {
+    ir::Circuit c(3, 2);
+    c.addGate(ir::Gate::h(0));
+    c.addGate(ir::Gate::barrier({0, 2}));
+    c.addGate(ir::Gate::measure(2, 1));
+    c.addGate(ir::Gate::measure(0));
+    c.addGate(ir::Gate::reset(2));
+
+    std::string text = toQASM(c);
+    EXPECT_NE(text.find("bit[2] c;\n"), std::string::npos);
+    EXPECT_NE(text.find("barrier q[0], q[2];\n"), std::string::npos);
+    EXPECT_NE(text.find("c[1] = measure q[2];\n"), std::string::npos);
+
+    auto parsed = parseQASM(text);
+    ASSERT_NE(parsed, nullptr);
+    ASSERT_EQ(parsed->numClbits(), c.numClbits());
+    ASSERT_EQ(parsed->numGates(), c.numGates());
+    for (std::size_t i = 0; i < c.numGates(); ++i) {
+        EXPECT_EQ(parsed->gate(i), c.gate(i)) << "gate " << i;
+    }
+}
+
+TEST(QASMWriterTest, RoundTripPreservesSymbolicParameters) {
+    ir::Circuit c(2);
+    auto& table = c.parameterTable();
+    ir::SymbolId theta = table.addSymbol("theta");
+    ir::SymbolId phi = table.addSymbol("phi");
+    auto a = table.add(ir::AffineExpression::symbol(theta) * 0.5 + ir::AffineExpression(0.25));
+    auto b = table.add(ir::AffineExpression::symbol(phi) - ir::AffineExpression::symbol(theta));
+    c.addGate(ir::Gate::rz(0, 0.0).withExpression(0, a));
+    c.addGate(ir::Gate::u3(1, 1.0, 0.0, 3.0).withExpression(1, b));
+
+    std::string text = toQASM(c);
+    EXPECT_NE(text.find("input float[64] theta;\ninput float[64] phi;\n"), std::string::npos);
+    EXPECT_NE(text.find("rz(0.5*theta + 0.25) q[0];\n"), std::string::npos);
+    EXPECT_NE(text.find("u3(1, -theta + phi, 3) q[1];\n"), std::string::npos);
+
+    auto parsed = parseQASM(text);
+    ASSERT_NE(parsed, nullptr);
+    ir::Circuit expected = c.bind({0.5, 2.0});
+    ir::Circuit actual = parsed->bind({0.5, 2.0});
+    ASSERT_EQ(actual.numGates(), expected.numGates());
+    for (std::size_t i = 0; i < expected.numGates(); ++i) {
+        EXPECT_EQ(actual.gate(i), expected.gate(i)) << "gate " << i;
+    }
+
+    std::ostringstream out;
+    QASMWriter writer(out, 2);
+    EXPECT_THROW(writer.write(c.gate(0)), std::logic_error);
+}
+
+TEST(QASMWriterTest, WritesCircuitViews) {
+    ir::Circuit c(3);
+    c.addGate(ir::Gate::h(0));
+    c.addGate(ir::Gate::cnot(0, 1));
+    c.addGate(ir::Gate::rz(2, 0.5));
+    c.addGate(ir::Gate::cnot(1, 2));
+
+    auto parsed = parseQASM(toQASM(ir::CircuitView(c).slice(1, 4).onQubits({0, 1})));
+    ASSERT_NE(parsed, nullptr);
+    EXPECT_EQ(parsed->numQubits(), 3u);
+    ASSERT_EQ(parsed->numGates(), 1u);
+    EXPECT_EQ(parsed->gate(0), ir::Gate::cnot(0, 1));
+}
+
+TEST(QASMWriterTest, EmptyCircuitIsValidProgram) {
+    ir::Circuit c(2);
+    auto parsed = parseQASM(toQASM(c));
+    ASSERT_NE(parsed, nullptr);
+    EXPECT_EQ(parsed->numQubits(), 2u);
+    EXPECT_TRUE(parsed->empty());
+}
+
+// =============================================================================
+// Streaming Tests
+// =============================================================================
+
+TEST(QASMWriterTest, StreamsRoutedCircuit) {
+    ir::Circuit c(5);
+    c.addGate(ir::Gate::h(0));
+    c.addGate(ir::Gate::cnot(0, 4));
+    c.addGate(ir::Gate::rz(4, 0.25));
+    c.addGate(ir::Gate::cnot(1, 3));
+    auto topology = routing::Topology::linear(5);
+
+    std::ostringstream out;
+    QASMWriter writer(out, topology.numQubits());
+    routing::SabreRouter router;
+    auto stats = router.routeTo(c, topology, std::ref(writer));
+
+    auto reference = router.route(c, topology);
+    auto parsed = parseQASM(out.str());
+
+    ASSERT_NE(parsed, nullptr);
+    EXPECT_EQ(writer.gatesWritten(), stats.gates_emitted);
+    ASSERT_EQ(parsed->numGates(), reference.routed_circuit.numGates());
+    for (std::size_t i = 0; i < parsed->numGates(); ++i) {
+        EXPECT_EQ(parsed->gate(i), reference.routed_circuit.gate(i));
+    }
+    EXPECT_EQ(stats.final_depth, parsed->depth());
+}
+
+}  // namespace
+}  // namespace qopt::parser
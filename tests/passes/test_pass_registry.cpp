@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file test_pass_registry.cpp
+ * @brief Unit tests for pass registration and lookup
+ */
+
+#include "passes/PassRegistry.hpp"
+#include "passes/AllPasses.hpp"
+#include "ir/Circuit.hpp"
+#include "ir/DAG.hpp"
+#include "ir/Gate.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace qopt::passes {
+namespace {
+
+using ir::Circuit;
+using ir::Gate;
+
+/// Pass registered only by this test.
+class NoOpPass : public Pass {
+public:
+    [[nodiscard]] std::string name() const override { return "NoOpPass"; }
+
+    [[nodiscard]] static PassInfo describe() {
+        return {"NoOpPass", "noop", "Does nothing", {}, PassCost::Linear,
+                [](const PassSpec&) -> std::unique_ptr<Pass> {
+                    return std::make_unique<NoOpPass>();
+                }};
+    }
+
+    void run(ir::DAG&) override { resetStatistics(); }
+};
+
+// =============================================================================
+// Lookup Tests
+// =============================================================================
+
+TEST(PassRegistryTest, BuiltInPassesRegisterThemselves) {
+    std::vector<std::string> short_names;
+    for (const PassInfo* info : PassRegistry::instance().passes()) {
+        if (info->short_name != "noop") short_names.push_back(info->short_name);
+    }
+    EXPECT_EQ(short_names, (std::vector<std::string>{"cancel", "commute", "dce", "fuse1q",
+                                                     "fused", "idelim", "peephole",
+                                                     "rotmerge"}));
+}
+
+TEST(PassRegistryTest, FindsByShortAndClassName) {
+    const auto& registry = PassRegistry::instance();
+    ASSERT_NE(registry.find("idelim"), nullptr);
+    EXPECT_EQ(registry.find("idelim"), registry.find("IdentityEliminationPass"));
+    EXPECT_EQ(registry.at("rotmerge").cost, PassCost::Iterative);
+    EXPECT_EQ(registry.at("fused").cost, PassCost::Linear);
+    EXPECT_EQ(registry.find("nosuchpass"), nullptr);
+    EXPECT_THROW((void)registry.at("nosuchpass"), std::invalid_argument);
+}
+
+TEST(PassRegistryTest, DescriptionsMatchThePasses) {
+    for (const PassInfo* info : PassRegistry::instance().passes()) {
+        SCOPED_TRACE(info->short_name);
+        EXPECT_FALSE(info->description.empty());
+        auto pass = PassRegistry::instance().create({info->short_name, {}});
+        EXPECT_EQ(pass->name(), info->name);
+        for (const auto& option : info->options) {
+            EXPECT_FALSE(option.description.empty());
+        }
+    }
+}
+
+TEST(PassRegistryTest, NumberDefaultsMatchTheConstructors) {
+    for (const PassInfo* info : PassRegistry::instance().passes()) {
+        for (const auto& option : info->options) {
+            if (option.type != PassOption::Type::Number) continue;
+            SCOPED_TRACE(info->short_name + "." + option.name);
+            const PassSpec spec{info->short_name, {{option.name, option.default_value}}};
+            const double value = spec.number(option.name, 0.0);
+            if (option.name != "tolerance") continue;
+            EXPECT_EQ(value, constants::TOLERANCE);
+        }
+    }
+}
+
+TEST(PassRegistryTest, NumberTextIsShortAndExact) {
+    EXPECT_EQ(numberText(1e-10), "1e-10");
+    EXPECT_EQ(numberText(0.5), "0.5");
+    EXPECT_EQ(numberText(20), "20");
+    EXPECT_EQ(std::stod(numberText(1.0 / 3.0)), 1.0 / 3.0);
+}
+
+// =============================================================================
+// Construction Tests
+// =============================================================================
+
+TEST(PassRegistryTest, CreatePassesOptionsToTheFactory) {
+    Circuit circuit(1);
+    circuit.addGate(Gate::rz(0, 1e-4));
+
+    auto dag = ir::DAG::fromCircuit(circuit);
+    auto pass = PassRegistry::instance().create({"idelim", {{"tolerance", "1e-3"}}});
+    pass->run(dag);
+    EXPECT_EQ(dag.numNodes(), 0u);
+}
+
+TEST(PassRegistryTest, ValidateChecksTheOptionSchema) {
+    const auto& registry = PassRegistry::instance();
+    EXPECT_NO_THROW(registry.validate({"fuse1q", {{"tolerance", "1e-6"}}}));
+    EXPECT_NO_THROW(registry.validate({"peephole", {{"rules", "X a; X a =>"}}}));
+    EXPECT_THROW(registry.validate({"cancel", {{"tolerance", "1"}}}), std::invalid_argument);
+    EXPECT_THROW(registry.validate({"idelim", {{"tolerance", "abc"}}}), std::invalid_argument);
+    EXPECT_THROW(registry.validate({"idelim", {{"tolerance", "1"}, {"tolerance", "2"}}}),
+                 std::invalid_argument);
+    EXPECT_THROW(registry.validate({"nosuchpass", {}}), std::invalid_argument);
+}
+
+// =============================================================================
+// Registration Tests
+// =============================================================================
+
+TEST(PassRegistryTest, RegistersNewPassesOnce) {
+    auto& registry = PassRegistry::instance();
+    EXPECT_TRUE(registerPass<NoOpPass>());
+    ASSERT_NE(registry.find("noop"), nullptr);
+    EXPECT_EQ(registry.create({"NoOpPass", {}})->name(), "NoOpPass");
+
+    EXPECT_THROW(registerPass<NoOpPass>(), std::invalid_argument);
+    EXPECT_THROW(registry.add({"OtherPass", "other", "", {}, PassCost::Linear, nullptr}),
+                 std::invalid_argument);
+    EXPECT_EQ(registry.find("other"), nullptr);
+}
+
+}  // namespace
+}  // namespace qopt::passes
@@ -6,7 +6,9 @@
  * @brief Unit tests for optimization passes
  *
  * Tests for Pass, PassManager, CancellationPass, RotationMergePass,
- * IdentityEliminationPass, and CommutationPass.
+ * IdentityEliminationPass, CommutationPass, PeepholePass,
+ * FusedPeepholePass, SingleQubitFusionPass, DeadCodeEliminationPass and
+ * the optimization levels.
  */
 
 #include "passes/Pass.hpp"
@@ -15,13 +17,20 @@
 #include "passes/RotationMergePass.hpp"
 #include "passes/IdentityEliminationPass.hpp"
 #include "passes/CommutationPass.hpp"
+#include "passes/PeepholePass.hpp"
+#include "passes/FusedPeepholePass.hpp"
+#include "passes/SingleQubitFusionPass.hpp"
+#include "passes/DeadCodeEliminationPass.hpp"
+#include "passes/OptimizationLevel.hpp"
 #include "ir/Circuit.hpp"
+#include "ir/CriticalPath.hpp"
 #include "ir/DAG.hpp"
 #include "ir/Gate.hpp"
 
 #include <gtest/gtest.h>
 #include <cmath>
 #include <memory>
+#include <random>
 
 using namespace qopt;
 using namespace qopt::ir;
@@ -167,6 +176,53 @@ TEST(PassManagerTest, RunOnCircuitModifiesCircuit) {
     EXPECT_EQ(circuit.numGates(), 1);  // Only X remains
 }
 
+TEST(PassManagerTest, TracksCriticalPathPerPass) {
+    // q0: H H Rz Rz ─ CNOT ; q1: X ─ CNOT
+    Circuit circuit(2);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::rz(0, 0.25));
+    circuit.addGate(Gate::rz(0, 0.5));
+    circuit.addGate(Gate::x(1));
+    circuit.addGate(Gate::cnot(0, 1));
+
+    PassManager pm;
+    pm.addPass(std::make_unique<IdentityEliminationPass>());  // No change
+    pm.addPass(std::make_unique<RotationMergePass>());        // -20 ns
+    pm.addPass(std::make_unique<CancellationPass>());         // -40 ns
+    pm.trackCriticalPath(DurationTable::byArity(20.0, 300.0, 1000.0));
+
+    DAG dag = DAG::fromCircuit(circuit);
+    pm.run(dag);
+
+    const auto& impact = pm.statistics().depth_impact;
+    ASSERT_EQ(impact.size(), 3u);
+    EXPECT_DOUBLE_EQ(impact[0].duration_before, 380.0);
+    EXPECT_DOUBLE_EQ(impact[0].change(), 0.0);
+    EXPECT_DOUBLE_EQ(impact[1].change(), -20.0);
+    EXPECT_DOUBLE_EQ(impact[2].change(), -40.0);
+    EXPECT_DOUBLE_EQ(impact[2].duration_after, 320.0);
+    EXPECT_EQ(dag.checkpointDepth(), 0u);
+
+    auto ranked = pm.statistics().rankedByDepthImpact();
+    EXPECT_EQ(ranked[0].name, "CancellationPass");
+    EXPECT_EQ(ranked[1].name, "RotationMergePass");
+    EXPECT_EQ(ranked[2].name, "IdentityEliminationPass");
+
+    // The incrementally maintained result matches a fresh analysis
+    EXPECT_DOUBLE_EQ(CriticalPath(dag, DurationTable::byArity(20.0, 300.0, 1000.0)).length(),
+                     320.0);
+}
+
+TEST(PassManagerTest, CriticalPathNotTrackedByDefault) {
+    Circuit circuit(1);
+    circuit.addGate(Gate::h(0));
+    PassManager pm;
+    pm.addPass(std::make_unique<CancellationPass>());
+    pm.run(circuit);
+    EXPECT_TRUE(pm.statistics().depth_impact.empty());
+}
+
 TEST(PassManagerTest, ReductionPercentCalculation) {
     Circuit circuit(1);
     for (int i = 0; i < 10; ++i) {
@@ -183,6 +239,57 @@ TEST(PassManagerTest, ReductionPercentCalculation) {
     EXPECT_DOUBLE_EQ(pm.statistics().reductionPercent(), 100.0);
 }
 
+TEST(PassManagerTest, FixpointRepeatsUntilNothingChanges) {
+    // Merging leaves Rz(0), which only the next iteration's
+    // IdentityEliminationPass can remove
+    Circuit circuit(1);
+    circuit.addGate(Gate::rz(0, 0.5));
+    circuit.addGate(Gate::rz(0, -0.5));
+
+    PassManager pm;
+    pm.addPass(std::make_unique<IdentityEliminationPass>());
+    pm.addPass(std::make_unique<RotationMergePass>());
+    EXPECT_EQ(pm.maxIterations(), 1u);
+
+    Circuit once = circuit.clone();
+    pm.run(once);
+    EXPECT_EQ(once.numGates(), 1u);
+    EXPECT_EQ(pm.statistics().iterations, 1u);
+
+    pm.setMaxIterations(8);
+    pm.run(circuit);
+    const auto& stats = pm.statistics();
+    EXPECT_EQ(circuit.numGates(), 0u);
+    EXPECT_EQ(stats.iterations, 3u);  // The last one confirms the fixed point
+    ASSERT_EQ(stats.per_pass.size(), 2u);
+    EXPECT_EQ(std::get<1>(stats.per_pass[0]), 1u);
+    EXPECT_EQ(std::get<1>(stats.per_pass[1]), 1u);
+    EXPECT_EQ(stats.total_gates_removed, 2u);
+    EXPECT_NE(stats.toString().find("Iterations:    3"), std::string::npos);
+}
+
+TEST(PassManagerTest, FixpointStopsAtMaxIterations) {
+    Circuit circuit(1);
+    circuit.addGate(Gate::rz(0, 0.5));
+    circuit.addGate(Gate::rz(0, -0.5));
+
+    PassManager pm;
+    pm.addPass(std::make_unique<IdentityEliminationPass>());
+    pm.addPass(std::make_unique<RotationMergePass>());
+    pm.trackCriticalPath();
+    pm.setMaxIterations(2);
+    pm.run(circuit);
+
+    const auto& stats = pm.statistics();
+    EXPECT_EQ(stats.iterations, 2u);
+    EXPECT_EQ(circuit.numGates(), 0u);
+    ASSERT_EQ(stats.depth_impact.size(), 2u);  // One entry per pass, spanning both runs
+    EXPECT_DOUBLE_EQ(stats.depth_impact[0].duration_before, 2.0);
+    EXPECT_DOUBLE_EQ(stats.depth_impact[0].duration_after, 0.0);
+
+    EXPECT_THROW(pm.setMaxIterations(0), std::invalid_argument);
+}
+
 // =============================================================================
 // CancellationPass Tests
 // =============================================================================
@@ -402,6 +509,50 @@ TEST(CancellationPassTest, PartialCancellation) {
     EXPECT_EQ(pass.gatesRemoved(), 2);
 }
 
+TEST(CancellationPassTest, DoesNotCancelAcrossMeasurement) {
+    Circuit circuit(1, 1);
+    circuit.addGate(Gate::x(0));
+    circuit.addGate(Gate::measure(0, 0));
+    circuit.addGate(Gate::x(0));
+    
+    DAG dag = DAG::fromCircuit(circuit);
+    CancellationPass pass;
+    pass.run(dag);
+    
+    EXPECT_EQ(dag.numNodes(), 3);
+}
+
+TEST(CancellationPassTest, DoesNotCancelAcrossBarrierOnOneQubit) {
+    // The CNOTs are linked directly through qubit 1 but not through qubit 0
+    Circuit circuit(2);
+    circuit.addGate(Gate::cnot(0, 1));
+    circuit.addGate(Gate::barrier({0}));
+    circuit.addGate(Gate::cnot(0, 1));
+    
+    DAG dag = DAG::fromCircuit(circuit);
+    CancellationPass pass;
+    pass.run(dag);
+    
+    EXPECT_EQ(dag.numNodes(), 3);
+    EXPECT_EQ(pass.gatesRemoved(), 0);
+}
+
+TEST(CancellationPassTest, ToffoliCancellation) {
+    Circuit circuit(3);
+    circuit.addGate(Gate::ccx(0, 1, 2));
+    circuit.addGate(Gate::ccx(0, 1, 2));
+    circuit.addGate(Gate::ccx(0, 2, 1));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::ccx(0, 2, 1));
+    
+    DAG dag = DAG::fromCircuit(circuit);
+    CancellationPass pass;
+    pass.run(dag);
+    
+    EXPECT_EQ(dag.numNodes(), 3);  // Only the first pair is adjacent
+    EXPECT_EQ(pass.gatesRemoved(), 2);
+}
+
 TEST(CancellationPassTest, SDoesNotCancelWithS) {
     Circuit circuit(1);
     circuit.addGate(Gate::s(0));
@@ -533,6 +684,76 @@ TEST(RotationMergePassTest, NonAdjacentRotationsDoNotMerge) {
     EXPECT_EQ(dag.numNodes(), 3);  // No merge
 }
 
+TEST(RotationMergePassTest, ResetBlocksMerge) {
+    Circuit circuit(1);
+    circuit.addGate(Gate::rx(0, constants::PI_4));
+    circuit.addGate(Gate::reset(0));
+    circuit.addGate(Gate::rx(0, constants::PI_4));
+    
+    DAG dag = DAG::fromCircuit(circuit);
+    RotationMergePass pass;
+    pass.run(dag);
+    
+    EXPECT_EQ(dag.numNodes(), 3);
+}
+
+TEST(RotationMergePassTest, TwoQubitRotationsMerge) {
+    // CPhase is symmetric, so operand order does not matter
+    Circuit circuit(3);
+    circuit.addGate(Gate::cphase(0, 1, constants::PI_4));
+    circuit.addGate(Gate::cphase(1, 0, constants::PI_4));
+    circuit.addGate(Gate::rzz(1, 2, 0.25));
+    circuit.addGate(Gate::rzz(1, 2, 0.5));
+    
+    DAG dag = DAG::fromCircuit(circuit);
+    RotationMergePass pass;
+    pass.run(dag);
+    
+    ASSERT_EQ(dag.numNodes(), 2);
+    Circuit merged = dag.toCircuit();
+    EXPECT_EQ(merged.gate(0), Gate::cphase(0, 1, constants::PI_2));
+    EXPECT_EQ(merged.gate(1), Gate::rzz(1, 2, 0.75));
+}
+
+TEST(RotationMergePassTest, SymbolicRotationsMergeAsExpressions) {
+    Circuit circuit(2);
+    auto& table = circuit.parameterTable();
+    ir::SymbolId theta = table.addSymbol("theta");
+    auto t = table.add(ir::AffineExpression::symbol(theta));
+    auto minus_t = table.add(ir::AffineExpression::symbol(theta, -1.0));
+    circuit.addGate(Gate::rz(0, 0.0).withExpression(0, t));
+    circuit.addGate(Gate::rz(0, 0.5));
+    circuit.addGate(Gate::rz(0, 0.0).withExpression(0, t));
+    circuit.addGate(Gate::rzz(0, 1, 0.0).withExpression(0, t));
+    circuit.addGate(Gate::rzz(1, 0, 0.0).withExpression(0, minus_t));
+    
+    DAG dag = DAG::fromCircuit(circuit);
+    RotationMergePass pass;
+    pass.run(dag);
+    
+    ASSERT_EQ(dag.numNodes(), 2);
+    Circuit merged = dag.toCircuit();
+    ASSERT_TRUE(merged.gate(0).isSymbolic());
+    EXPECT_EQ(merged.parameterTable().expression(*merged.gate(0).expression(0)),
+              ir::AffineExpression::symbol(theta, 2.0) + ir::AffineExpression(0.5));
+    // theta - theta is concrete again, so identity elimination can drop it
+    EXPECT_EQ(merged.gate(1), Gate::rzz(0, 1, 0.0));
+    EXPECT_EQ(merged.bind({0.25}).gate(0), Gate::rz(0, 1.0));
+}
+
+TEST(RotationMergePassTest, GateOnOtherWireBlocksTwoQubitMerge) {
+    Circuit circuit(2);
+    circuit.addGate(Gate::rzz(0, 1, 0.25));
+    circuit.addGate(Gate::h(1));
+    circuit.addGate(Gate::rzz(0, 1, 0.25));
+    
+    DAG dag = DAG::fromCircuit(circuit);
+    RotationMergePass pass;
+    pass.run(dag);
+    
+    EXPECT_EQ(dag.numNodes(), 3);
+}
+
 TEST(RotationMergePassTest, MultipleConsecutiveRotationsMerge) {
     Circuit circuit(1);
     circuit.addGate(Gate::rz(0, constants::PI_4));
@@ -669,6 +890,36 @@ TEST(IdentityEliminationPassTest, NonZeroRotationPreserved) {
     EXPECT_EQ(dag.numNodes(), 1);  // Preserved
 }
 
+TEST(IdentityEliminationPassTest, NativeGatesWithZeroAnglesRemoved) {
+    Circuit circuit(2);
+    circuit.addGate(Gate::cphase(0, 1, 0.0));
+    circuit.addGate(Gate::rzz(0, 1, 2 * constants::PI));
+    circuit.addGate(Gate::u3(0, 0.0, 0.5, -0.5));  // Rz(0.5) Rz(-0.5)
+    circuit.addGate(Gate::u3(1, 0.0, 0.5, 0.5));   // Rz(1)
+    circuit.addGate(Gate::iswap(0, 1));
+    
+    DAG dag = DAG::fromCircuit(circuit);
+    IdentityEliminationPass pass;
+    pass.run(dag);
+    
+    EXPECT_EQ(dag.numNodes(), 2);
+    EXPECT_EQ(pass.gatesRemoved(), 3);
+}
+
+TEST(IdentityEliminationPassTest, SymbolicRotationsPreserved) {
+    Circuit circuit(1);
+    ir::SymbolId theta = circuit.parameterTable().addSymbol("theta");
+    auto t = circuit.parameterTable().add(ir::AffineExpression::symbol(theta));
+    circuit.addGate(Gate::rz(0, 0.0).withExpression(0, t));
+    circuit.addGate(Gate::u3(0, 0.0, 0.0, 0.0).withExpression(1, t));
+    
+    DAG dag = DAG::fromCircuit(circuit);
+    IdentityEliminationPass pass;
+    pass.run(dag);
+    
+    EXPECT_EQ(dag.numNodes(), 2);
+}
+
 TEST(IdentityEliminationPassTest, NonRotationGatesPreserved) {
     Circuit circuit(1);
     circuit.addGate(Gate::h(0));
@@ -760,6 +1011,678 @@ TEST(CommutationPassTest, PreservesCircuitSemantics) {
     EXPECT_EQ(dag.numNodes(), initial_count);  // Same gate count
 }
 
+TEST(CommutationPassTest, NothingCommutesThroughBarrier) {
+    // Z would otherwise move next to the first Z and cancel with it
+    Circuit circuit(2, 1);
+    circuit.addGate(Gate::z(0));
+    circuit.addGate(Gate::barrier({0, 1}));
+    circuit.addGate(Gate::z(0));
+    circuit.addGate(Gate::measure(0, 0));
+    circuit.addGate(Gate::z(0));
+    
+    PassManager pm;
+    pm.addPass(std::make_unique<CommutationPass>());
+    pm.addPass(std::make_unique<CancellationPass>());
+    pm.run(circuit);
+    
+    ASSERT_EQ(circuit.numGates(), 5);
+    EXPECT_EQ(circuit.gate(1), Gate::barrier({0, 1}));
+    EXPECT_EQ(circuit.gate(3), Gate::measure(0, 0));
+}
+
+// =============================================================================
+// PeepholePass Tests
+// =============================================================================
+
+TEST(PeepholePassTest, NameReturnsCorrectValue) {
+    PeepholePass pass;
+    EXPECT_EQ(pass.name(), "PeepholePass");
+    EXPECT_FALSE(pass.rules().empty());
+}
+
+TEST(PeepholePassTest, CompilesRules) {
+    PeepholeRule rule = PeepholeRule::parse("  Rz(x) a; Rz(2 * x - pi / 2) a => Rz(3 * x) a ");
+    EXPECT_EQ(rule.text, "Rz(x) a; Rz(2 * x - pi / 2) a => Rz(3 * x) a");
+    EXPECT_EQ(rule.pattern.size(), 2u);
+    EXPECT_EQ(rule.replacement.size(), 1u);
+    EXPECT_EQ(rule.num_qubits, 1u);
+    EXPECT_EQ(rule.num_angles, 1u);
+    EXPECT_EQ(rule.pattern[0].angles[0].binds, 0u);
+    EXPECT_FALSE(rule.pattern[1].angles[0].binds.has_value());
+    EXPECT_DOUBLE_EQ(rule.pattern[1].angles[0].coefficients[0], 2.0);
+    EXPECT_DOUBLE_EQ(rule.pattern[1].angles[0].constant, -constants::PI_2);
+
+    EXPECT_THROW(PeepholeRule::parse("H a => H a"), std::invalid_argument);
+    EXPECT_THROW(PeepholeRule::parse("H a; H b =>"), std::invalid_argument);
+    EXPECT_THROW(PeepholeRule::parse("H a; CX a, b =>"), std::invalid_argument);
+    EXPECT_THROW(PeepholeRule::parse("Foo a; Foo a =>"), std::invalid_argument);
+    EXPECT_THROW(PeepholeRule::parse("Rz(x) a; Rz(x) a => Rz(y) a"), std::invalid_argument);
+    EXPECT_THROW(PeepholeRule::parse("Rz(x) a; Rz(y) a => Rz(x * y) a"), std::invalid_argument);
+    EXPECT_THROW(PeepholeRule::parse("Measure a; Measure a =>"), std::invalid_argument);
+    EXPECT_THROW(PeepholeRule::parse("H a; H a"), std::invalid_argument);
+}
+
+TEST(PeepholePassTest, DefaultRulesCancelAndMerge) {
+    Circuit circuit(2);
+    circuit.addGate(Gate::t(0));
+    circuit.addGate(Gate::t(0));
+    circuit.addGate(Gate::t(0));
+    circuit.addGate(Gate::t(0));  // T^4 = Z
+    circuit.addGate(Gate::h(1));
+    circuit.addGate(Gate::h(1));
+    circuit.addGate(Gate::rz(1, 0.25));
+    circuit.addGate(Gate::rz(1, 0.5));
+
+    DAG dag = DAG::fromCircuit(circuit);
+    PeepholePass pass;
+    pass.run(dag);
+
+    Circuit result = dag.toCircuit();
+    ASSERT_EQ(result.numGates(), 2u);
+    EXPECT_EQ(result.gate(0).type(), GateType::Z);
+    EXPECT_EQ(result.gate(1).type(), GateType::Rz);
+    EXPECT_NEAR(result.gate(1).parameter().value(), 0.75, 1e-12);
+    EXPECT_EQ(pass.gatesRemoved(), 6u);
+}
+
+TEST(PeepholePassTest, ThreeCnotsBecomeSwap) {
+    Circuit circuit(3);
+    circuit.addGate(Gate::cnot(1, 2));
+    circuit.addGate(Gate::cnot(2, 1));
+    circuit.addGate(Gate::cnot(1, 2));
+
+    DAG dag = DAG::fromCircuit(circuit);
+    PeepholePass pass;
+    pass.run(dag);
+
+    Circuit result = dag.toCircuit();
+    ASSERT_EQ(result.numGates(), 1u);
+    EXPECT_EQ(result.gate(0), Gate::swap(1, 2));
+}
+
+TEST(PeepholePassTest, RequiresDirectAdjacency) {
+    Circuit circuit(2, 1);
+    circuit.addGate(Gate::cnot(0, 1));
+    circuit.addGate(Gate::h(1));          // Between the CNOTs on q1
+    circuit.addGate(Gate::cnot(0, 1));
+    circuit.addGate(Gate::x(0));
+    circuit.addGate(Gate::measure(0, 0));
+    circuit.addGate(Gate::x(0));
+    ParameterExprId theta = circuit.parameterTable().add(AffineExpression(1.0));
+    circuit.addGate(Gate::rz(0, 0.0).withExpression(0, theta));
+    circuit.addGate(Gate::rz(0, 0.0));  // Symbolic angles are never matched
+
+    DAG dag = DAG::fromCircuit(circuit);
+    PeepholePass pass("X a; X a =>\nCX a, b; CX a, b =>\nRz(x) a; Rz(y) a => Rz(x + y) a");
+    pass.run(dag);
+    EXPECT_EQ(dag.numNodes(), 8u);
+    EXPECT_EQ(pass.gatesRemoved(), 0u);
+}
+
+TEST(PeepholePassTest, CustomRulesAndHitCounts) {
+    PeepholePass pass(R"(
+# Comment lines and blank lines are skipped
+
+Rz(x) a; Rz(x) a => Rz(2 * x) a
+U(t, p, l) a; Rz(pi) a => U(t, p, l + pi) a
+)");
+    ASSERT_EQ(pass.rules().size(), 2u);
+    pass.addRule("CZ a, b; CZ b, a =>");
+
+    Circuit circuit(2);
+    circuit.addGate(Gate::rz(0, 0.25));
+    circuit.addGate(Gate::rz(0, 0.25));   // Equal angles: matches
+    circuit.addGate(Gate::rz(1, 0.25));
+    circuit.addGate(Gate::rz(1, 0.5));    // Different angles: does not
+    circuit.addGate(Gate::u3(0, 0.1, 0.2, 0.3));
+    circuit.addGate(Gate::rz(0, constants::PI));
+    circuit.addGate(Gate::cz(0, 1));
+    circuit.addGate(Gate::cz(1, 0));
+
+    DAG dag = DAG::fromCircuit(circuit);
+    pass.run(dag);
+
+    Circuit result = dag.toCircuit();
+    ASSERT_EQ(result.numGates(), 4u);
+    EXPECT_EQ(result.countGates(GateType::Rz), 3u);
+    for (const Gate& g : result) {
+        if (g.type() == GateType::U3) {
+            EXPECT_NEAR(g.parameter(2), 0.3 + constants::PI, 1e-12);
+        } else if (g.qubits()[0] == 0) {
+            EXPECT_NEAR(g.parameter().value(), 0.5, 1e-12);
+        }
+    }
+    EXPECT_EQ(pass.ruleHits(), (std::vector<std::size_t>{1, 1, 1}));
+    EXPECT_EQ(pass.gatesRemoved(), 4u);
+}
+
+TEST(PeepholePassTest, EditsAreJournaled) {
+    Circuit circuit(1);
+    circuit.addGate(Gate::s(0));
+    circuit.addGate(Gate::s(0));
+    DAG dag = DAG::fromCircuit(circuit);
+
+    dag.checkpoint();
+    PeepholePass pass;
+    pass.run(dag);
+    EXPECT_EQ(dag.numNodes(), 1u);
+    dag.rollback();
+    EXPECT_EQ(dag.toCircuit().gate(1), Gate::s(0));
+    EXPECT_EQ(dag.node(0).gate(), Gate::s(0));
+}
+
+// =============================================================================
+// FusedPeepholePass Tests
+// =============================================================================
+
+namespace {
+
+/// @brief Gates on each qubit, in order; equal for equivalent DAG rewrites.
+std::vector<std::vector<Gate>> wireSequences(const DAG& dag) {
+    std::vector<std::vector<Gate>> wires(dag.numQubits());
+    for (const Gate& g : dag.toCircuit()) {
+        for (QubitIndex q : g.qubits()) wires[q].push_back(g);
+    }
+    return wires;
+}
+
+void expectSameWires(const DAG& a, const DAG& b) {
+    auto wa = wireSequences(a);
+    auto wb = wireSequences(b);
+    ASSERT_EQ(wa.size(), wb.size());
+    for (std::size_t q = 0; q < wa.size(); ++q) {
+        ASSERT_EQ(wa[q].size(), wb[q].size()) << "qubit " << q;
+        for (std::size_t i = 0; i < wa[q].size(); ++i) {
+            EXPECT_EQ(wa[q][i].type(), wb[q][i].type()) << "qubit " << q << " gate " << i;
+            EXPECT_EQ(wa[q][i].qubits(), wb[q][i].qubits());
+            auto pa = wa[q][i].parameters();
+            auto pb = wb[q][i].parameters();
+            ASSERT_EQ(pa.size(), pb.size());
+            for (std::size_t k = 0; k < pa.size(); ++k) EXPECT_NEAR(pa[k], pb[k], 1e-9);
+        }
+    }
+}
+
+}  // namespace
+
+TEST(FusedPeepholePassTest, NameAndRuleStatistics) {
+    FusedPeepholePass pass;
+    EXPECT_EQ(pass.name(), "FusedPeepholePass");
+    auto rules = pass.ruleStatistics();
+    ASSERT_EQ(rules.size(), 4u);
+    EXPECT_EQ(rules[1].name, "CancellationPass");
+}
+
+TEST(FusedPeepholePassTest, CollapsesNestedPairsInOneSweep) {
+    Circuit circuit(2);
+    circuit.addGate(Gate::x(0));
+    circuit.addGate(Gate::rz(0, 0.5));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::rz(0, -0.5));  // Merges to Rz(0), which is removed
+    circuit.addGate(Gate::x(0));         // Now adjacent to the first X
+    circuit.addGate(Gate::cnot(0, 1));
+    circuit.addGate(Gate::rx(1, 0.0));
+    circuit.addGate(Gate::cnot(0, 1));
+
+    DAG dag = DAG::fromCircuit(circuit);
+    FusedPeepholePass pass;
+    pass.run(dag);
+
+    EXPECT_EQ(dag.numNodes(), 0u);
+    EXPECT_EQ(pass.gatesRemoved(), 9u);
+    auto rules = pass.ruleStatistics();
+    EXPECT_EQ(rules[1].gates_removed, 6u);
+    EXPECT_EQ(rules[2].gates_removed, 1u);
+    EXPECT_EQ(rules[3].gates_removed, 2u);
+}
+
+TEST(FusedPeepholePassTest, RespectsBarriersAndMeasurements) {
+    Circuit circuit(2, 1);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::barrier({0, 1}));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::cnot(0, 1));
+    circuit.addGate(Gate::measure(1, 0));
+    circuit.addGate(Gate::cnot(0, 1));
+
+    DAG dag = DAG::fromCircuit(circuit);
+    FusedPeepholePass pass;
+    pass.run(dag);
+    EXPECT_EQ(dag.numNodes(), 6u);
+}
+
+TEST(FusedPeepholePassTest, MatchesPassesRunToFixedPoint) {
+    std::mt19937 rng(2024);
+    for (int trial = 0; trial < 30; ++trial) {
+        constexpr QubitIndex n = 3;
+        std::uniform_int_distribution<int> kind(0, 11);
+        std::uniform_int_distribution<QubitIndex> pick(0, n - 1);
+        std::uniform_int_distribution<int> angle(-2, 2);
+
+        Circuit circuit(n, 1);
+        for (int i = 0; i < 60; ++i) {
+            QubitIndex a = pick(rng);
+            QubitIndex b = (a + 1 + pick(rng) % (n - 1)) % n;
+            Angle theta = constants::PI_4 * angle(rng);
+            switch (kind(rng)) {
+                case 0: circuit.addGate(Gate::h(a)); break;
+                case 1: circuit.addGate(Gate::x(a)); break;
+                case 2: circuit.addGate(Gate::s(a)); break;
+                case 3: circuit.addGate(Gate::sdg(a)); break;
+                case 4: circuit.addGate(Gate::t(a)); break;
+                case 5: circuit.addGate(Gate::tdg(a)); break;
+                case 6: circuit.addGate(Gate::rz(a, theta)); break;
+                case 7: circuit.addGate(Gate::rx(a, theta)); break;
+                case 8: circuit.addGate(Gate::cnot(a, b)); break;
+                case 9: circuit.addGate(Gate::cphase(a, b, theta)); break;
+                case 10: circuit.addGate(Gate::cz(a, b)); break;
+                default: circuit.addGate(Gate::measure(a, 0)); break;
+            }
+        }
+
+        DAG fused = DAG::fromCircuit(circuit);
+        FusedPeepholePass pass;
+        pass.run(fused);
+
+        DAG reference = DAG::fromCircuit(circuit);
+        PassManager pm;
+        pm.addPass(std::make_unique<CommutationPass>());
+        pm.addPass(std::make_unique<CancellationPass>());
+        pm.addPass(std::make_unique<RotationMergePass>());
+        pm.addPass(std::make_unique<IdentityEliminationPass>());
+        std::size_t removed = 0;
+        do {
+            pm.run(reference);
+            removed += pm.statistics().total_gates_removed;
+        } while (pm.statistics().total_gates_removed > 0);
+
+        SCOPED_TRACE("trial " + std::to_string(trial));
+        expectSameWires(fused, reference);
+        EXPECT_EQ(pass.gatesRemoved(), removed);
+    }
+}
+
+TEST(FusedPeepholePassTest, PassManagerReportsPerRuleEntries) {
+    Circuit circuit(1);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::rz(0, 0.0));
+
+    PassManager pm;
+    pm.addPass(std::make_unique<FusedPeepholePass>());
+    pm.run(circuit);
+
+    const auto& stats = pm.statistics();
+    ASSERT_EQ(stats.per_pass.size(), 4u);
+    EXPECT_EQ(std::get<0>(stats.per_pass[1]), "CancellationPass");
+    EXPECT_EQ(std::get<1>(stats.per_pass[1]), 2u);
+    EXPECT_EQ(std::get<0>(stats.per_pass[3]), "IdentityEliminationPass");
+    EXPECT_EQ(std::get<1>(stats.per_pass[3]), 1u);
+    EXPECT_EQ(stats.total_gates_removed, 3u);
+    EXPECT_EQ(circuit.numGates(), 0u);
+}
+
+// =============================================================================
+// SingleQubitFusionPass Tests
+// =============================================================================
+
+namespace {
+
+using Matrix = SingleQubitFusionPass::Matrix;
+
+bool equalUpToPhase(const Matrix& a, const Matrix& b) {
+    std::size_t k = std::abs(b[0]) > std::abs(b[1]) ? 0 : 1;
+    if (std::abs(b[k]) < 1e-6) return false;
+    const std::complex<double> phase = a[k] / b[k];
+    if (std::abs(std::abs(phase) - 1.0) > 1e-9) return false;
+    for (std::size_t i = 0; i < 4; ++i) {
+        if (std::abs(a[i] - phase * b[i]) > 1e-9) return false;
+    }
+    return true;
+}
+
+/// @brief Unitary of a single-qubit circuit.
+Matrix unitaryOf(const Circuit& circuit) {
+    Matrix u{1.0, 0.0, 0.0, 1.0};
+    for (const Gate& g : circuit) {
+        const Matrix m = SingleQubitFusionPass::matrixOf(g);
+        u = {m[0] * u[0] + m[1] * u[2], m[0] * u[1] + m[1] * u[3],
+             m[2] * u[0] + m[3] * u[2], m[2] * u[1] + m[3] * u[3]};
+    }
+    return u;
+}
+
+}  // namespace
+
+TEST(SingleQubitFusionPassTest, NameReturnsCorrectValue) {
+    SingleQubitFusionPass pass;
+    EXPECT_EQ(pass.name(), "SingleQubitFusionPass");
+}
+
+TEST(SingleQubitFusionPassTest, FusesRunIntoU3) {
+    Circuit circuit(1);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::t(0));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::rx(0, 0.3));
+    const Matrix expected = unitaryOf(circuit);
+
+    DAG dag = DAG::fromCircuit(circuit);
+    SingleQubitFusionPass pass;
+    pass.run(dag);
+
+    Circuit fused = dag.toCircuit();
+    ASSERT_EQ(fused.numGates(), 1u);
+    EXPECT_EQ(fused[0].type(), GateType::U3);
+    EXPECT_TRUE(equalUpToPhase(unitaryOf(fused), expected));
+    EXPECT_EQ(pass.gatesRemoved(), 3u);
+}
+
+TEST(SingleQubitFusionPassTest, DiagonalProductBecomesRz) {
+    Circuit circuit(1);
+    circuit.addGate(Gate::s(0));
+    circuit.addGate(Gate::t(0));
+
+    DAG dag = DAG::fromCircuit(circuit);
+    SingleQubitFusionPass().run(dag);
+
+    Circuit fused = dag.toCircuit();
+    ASSERT_EQ(fused.numGates(), 1u);
+    EXPECT_EQ(fused[0].type(), GateType::Rz);
+    EXPECT_NEAR(fused[0].parameter(0), 3 * constants::PI_4, 1e-12);
+}
+
+TEST(SingleQubitFusionPassTest, IdentityProductIsRemoved) {
+    Circuit circuit(1);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::z(0));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::x(0));  // H Z H = X
+
+    DAG dag = DAG::fromCircuit(circuit);
+    SingleQubitFusionPass pass;
+    pass.run(dag);
+    EXPECT_EQ(dag.numNodes(), 0u);
+    EXPECT_EQ(pass.gatesRemoved(), 4u);
+}
+
+TEST(SingleQubitFusionPassTest, RunsEndAtOtherGates) {
+    Circuit circuit(2, 1);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::cnot(0, 1));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::barrier({0}));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::measure(0, 0));
+    circuit.addGate(Gate::h(0));
+    auto& table = circuit.parameterTable();
+    auto theta = table.add(AffineExpression::symbol(table.addSymbol("theta")));
+    circuit.addGate(Gate::rz(0, 0.0).withExpression(0, theta));
+    circuit.addGate(Gate::h(0));
+
+    DAG dag = DAG::fromCircuit(circuit);
+    SingleQubitFusionPass pass;
+    pass.run(dag);
+    EXPECT_EQ(dag.numNodes(), 9u);
+    EXPECT_EQ(pass.gatesRemoved(), 0u);
+}
+
+TEST(SingleQubitFusionPassTest, SecondRunChangesNothing) {
+    Circuit circuit(2);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::sx(0));
+    circuit.addGate(Gate::cnot(0, 1));
+    circuit.addGate(Gate::y(1));
+    circuit.addGate(Gate::u3(1, 0.1, 0.2, 0.3));
+
+    DAG dag = DAG::fromCircuit(circuit);
+    SingleQubitFusionPass pass;
+    pass.run(dag);
+    EXPECT_EQ(dag.numNodes(), 3u);
+    pass.run(dag);
+    EXPECT_EQ(dag.numNodes(), 3u);
+    EXPECT_EQ(pass.gatesRemoved(), 0u);
+}
+
+TEST(SingleQubitFusionPassTest, SynthesisRoundTripsRandomUnitaries) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> angle(-constants::PI, constants::PI);
+    std::uniform_int_distribution<int> kind(0, 12);
+
+    for (int trial = 0; trial < 200; ++trial) {
+        Circuit circuit(1);
+        for (int i = 0; i < 6; ++i) {
+            switch (kind(rng)) {
+                case 0: circuit.addGate(Gate::h(0)); break;
+                case 1: circuit.addGate(Gate::x(0)); break;
+                case 2: circuit.addGate(Gate::y(0)); break;
+                case 3: circuit.addGate(Gate::z(0)); break;
+                case 4: circuit.addGate(Gate::s(0)); break;
+                case 5: circuit.addGate(Gate::sdg(0)); break;
+                case 6: circuit.addGate(Gate::t(0)); break;
+                case 7: circuit.addGate(Gate::tdg(0)); break;
+                case 8: circuit.addGate(Gate::sx(0)); break;
+                case 9: circuit.addGate(Gate::rx(0, angle(rng))); break;
+                case 10: circuit.addGate(Gate::ry(0, angle(rng))); break;
+                case 11: circuit.addGate(Gate::rz(0, angle(rng))); break;
+                default: circuit.addGate(Gate::u3(0, angle(rng), angle(rng), angle(rng))); break;
+            }
+        }
+        const Matrix u = unitaryOf(circuit);
+        auto gate = SingleQubitFusionPass::synthesize(u, 0);
+        SCOPED_TRACE("trial " + std::to_string(trial));
+        ASSERT_TRUE(gate.has_value());
+        EXPECT_TRUE(equalUpToPhase(SingleQubitFusionPass::matrixOf(*gate), u));
+    }
+
+    // θ = π, where only φ - λ is determined
+    auto y = SingleQubitFusionPass::synthesize(SingleQubitFusionPass::matrixOf(Gate::y(0)), 0);
+    ASSERT_TRUE(y.has_value());
+    EXPECT_TRUE(equalUpToPhase(SingleQubitFusionPass::matrixOf(*y),
+                               SingleQubitFusionPass::matrixOf(Gate::y(0))));
+}
+
+// =============================================================================
+// DeadCodeEliminationPass Tests
+// =============================================================================
+
+namespace {
+
+/// @brief Runs a pass on a circuit through its DAG.
+void runOn(Pass& pass, Circuit& circuit) {
+    DAG dag = DAG::fromCircuit(circuit);
+    pass.run(dag);
+    circuit = dag.toCircuit();
+}
+
+}  // namespace
+
+TEST(DeadCodeEliminationPassTest, NameReturnsCorrectValue) {
+    DeadCodeEliminationPass pass;
+    EXPECT_EQ(pass.name(), "DeadCodeEliminationPass");
+}
+
+TEST(DeadCodeEliminationPassTest, RemovesGatesOnUnmeasuredQubits) {
+    Circuit circuit(3, 1);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::x(2));
+    circuit.addGate(Gate::measure(0, 0));
+    circuit.addGate(Gate::cnot(0, 1));  // After the only measurement
+    circuit.addGate(Gate::h(1));
+
+    DeadCodeEliminationPass pass;
+    runOn(pass, circuit);
+
+    ASSERT_EQ(circuit.numGates(), 2u);
+    EXPECT_EQ(circuit[0].type(), GateType::H);
+    EXPECT_EQ(circuit[1].type(), GateType::Measure);
+    EXPECT_EQ(pass.gatesRemoved(), 3u);
+}
+
+TEST(DeadCodeEliminationPassTest, TwoQubitGatesCarryLiveness) {
+    Circuit circuit(3, 1);
+    circuit.addGate(Gate::h(2));
+    circuit.addGate(Gate::cnot(2, 1));
+    circuit.addGate(Gate::t(1));
+    circuit.addGate(Gate::cnot(1, 0));
+    circuit.addGate(Gate::measure(0, 0));
+
+    DeadCodeEliminationPass pass;
+    runOn(pass, circuit);
+    EXPECT_EQ(circuit.numGates(), 5u);
+    EXPECT_EQ(pass.gatesRemoved(), 0u);
+}
+
+TEST(DeadCodeEliminationPassTest, ResetCutsDependency) {
+    Circuit circuit(1, 2);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::measure(0, 0));
+    circuit.addGate(Gate::t(0));      // Overwritten by the reset
+    circuit.addGate(Gate::reset(0));
+    circuit.addGate(Gate::x(0));
+    circuit.addGate(Gate::measure(0, 1));
+    circuit.addGate(Gate::h(0));      // After the last measurement
+
+    DeadCodeEliminationPass pass;
+    runOn(pass, circuit);
+
+    ASSERT_EQ(circuit.numGates(), 5u);
+    EXPECT_EQ(circuit.countGates(GateType::T), 0u);
+    EXPECT_EQ(circuit.countGates(GateType::Reset), 1u);
+    EXPECT_EQ(circuit.countGates(GateType::H), 1u);
+    EXPECT_EQ(circuit[4].type(), GateType::Measure);
+}
+
+TEST(DeadCodeEliminationPassTest, DeadResetAndBarrierAreRemoved) {
+    Circuit circuit(2, 1);
+    circuit.addGate(Gate::reset(1));
+    circuit.addGate(Gate::barrier({0, 1}));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::measure(0, 0));
+    circuit.addGate(Gate::barrier({0, 1}));
+
+    DeadCodeEliminationPass pass;
+    runOn(pass, circuit);
+
+    ASSERT_EQ(circuit.numGates(), 3u);
+    EXPECT_EQ(circuit[0].type(), GateType::Barrier);
+    EXPECT_EQ(circuit.countGates(GateType::Reset), 0u);
+}
+
+TEST(DeadCodeEliminationPassTest, CircuitsWithoutMeasurementsAreUnchanged) {
+    Circuit circuit(2);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::cnot(0, 1));
+
+    DeadCodeEliminationPass pass;
+    runOn(pass, circuit);
+    EXPECT_EQ(circuit.numGates(), 2u);
+}
+
+TEST(DeadCodeEliminationPassTest, ReleasesUnusedQubits) {
+    Circuit circuit(5, 2);
+    circuit.addGate(Gate::h(1));
+    circuit.addGate(Gate::cnot(1, 3));
+    circuit.addGate(Gate::barrier({0, 1, 2, 3}));
+    circuit.addGate(Gate::barrier({4}));
+    circuit.addGate(Gate::measure(3, 1));
+
+    auto released = DeadCodeEliminationPass::releaseUnusedQubits(circuit);
+
+    EXPECT_EQ(released.original_qubits, (std::vector<QubitIndex>{1, 3}));
+    const Circuit& compact = released.circuit;
+    EXPECT_EQ(compact.numQubits(), 2u);
+    EXPECT_EQ(compact.numClbits(), 2u);
+    ASSERT_EQ(compact.numGates(), 4u);
+    EXPECT_EQ(compact[1].qubits(), (std::vector<QubitIndex>{0, 1}));
+    EXPECT_EQ(compact[2].qubits(), (std::vector<QubitIndex>{0, 1}));
+    EXPECT_EQ(compact[3].qubits(), (std::vector<QubitIndex>{1}));
+    EXPECT_EQ(compact[3].clbit(), 1u);
+
+    Circuit empty(3);
+    EXPECT_EQ(DeadCodeEliminationPass::releaseUnusedQubits(empty).circuit.numQubits(), 1u);
+}
+
+// =============================================================================
+// Optimization Level Tests
+// =============================================================================
+
+TEST(OptimizationLevelTest, NamesRoundTrip) {
+    for (auto level : {OptimizationLevel::O0, OptimizationLevel::O1,
+                       OptimizationLevel::O2, OptimizationLevel::O3}) {
+        EXPECT_EQ(parseOptimizationLevel(toString(level)), level);
+    }
+    EXPECT_EQ(parseOptimizationLevel("2"), OptimizationLevel::O2);
+    EXPECT_EQ(parseOptimizationLevel("o3"), OptimizationLevel::O3);
+    EXPECT_THROW((void)parseOptimizationLevel("O4"), std::invalid_argument);
+    EXPECT_THROW((void)parseOptimizationLevel(""), std::invalid_argument);
+}
+
+TEST(OptimizationLevelTest, PipelinesAndBudgetsGrowWithLevel) {
+    EXPECT_TRUE(makePassManager(OptimizationLevel::O0).empty());
+    EXPECT_EQ(makePassManager(OptimizationLevel::O1).numPasses(), 1u);
+    EXPECT_EQ(makePassManager(OptimizationLevel::O1).maxIterations(), 1u);
+    EXPECT_EQ(makePassManager(OptimizationLevel::O2).numPasses(), 2u);
+    EXPECT_EQ(makePassManager(OptimizationLevel::O2).maxIterations(), FIXPOINT_ITERATIONS);
+    EXPECT_EQ(makePassManager(OptimizationLevel::O3).numPasses(), 3u);
+
+    EXPECT_LT(compileBudgetMicrosPerGate(OptimizationLevel::O0),
+              compileBudgetMicrosPerGate(OptimizationLevel::O1));
+    EXPECT_LT(compileBudgetMicrosPerGate(OptimizationLevel::O1),
+              compileBudgetMicrosPerGate(OptimizationLevel::O2));
+    EXPECT_LT(compileBudgetMicrosPerGate(OptimizationLevel::O2),
+              compileBudgetMicrosPerGate(OptimizationLevel::O3));
+}
+
+TEST(OptimizationLevelTest, HigherLevelsRemoveAtLeastAsMuch) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> kind(0, 6);
+    std::uniform_int_distribution<QubitIndex> pick(0, 2);
+
+    Circuit circuit(3);
+    for (int i = 0; i < 300; ++i) {
+        QubitIndex a = pick(rng);
+        QubitIndex b = (a + 1) % 3;
+        switch (kind(rng)) {
+            case 0: circuit.addGate(Gate::h(a)); break;
+            case 1: circuit.addGate(Gate::t(a)); break;
+            case 2: circuit.addGate(Gate::x(a)); break;
+            case 3: circuit.addGate(Gate::rz(a, constants::PI_4)); break;
+            case 4: circuit.addGate(Gate::cz(a, b)); break;
+            case 5: circuit.addGate(Gate::cz(b, a)); break;
+            default: circuit.addGate(Gate::cnot(a, b)); break;
+        }
+    }
+
+    std::size_t previous = circuit.numGates();
+    for (auto level : {OptimizationLevel::O0, OptimizationLevel::O1,
+                       OptimizationLevel::O2, OptimizationLevel::O3}) {
+        Circuit optimized = circuit.clone();
+        makePassManager(level).run(optimized);
+        SCOPED_TRACE(std::string(toString(level)));
+        EXPECT_LE(optimized.numGates(), previous);
+        previous = optimized.numGates();
+    }
+    EXPECT_LT(previous, circuit.numGates());
+}
+
+TEST(OptimizationLevelTest, O2PreservesSingleQubitUnitary) {
+    Circuit circuit(1);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::t(0));
+    circuit.addGate(Gate::rx(0, 0.7));
+    circuit.addGate(Gate::s(0));
+    circuit.addGate(Gate::sdg(0));
+    circuit.addGate(Gate::y(0));
+    const Matrix expected = unitaryOf(circuit);
+
+    makePassManager(OptimizationLevel::O2).run(circuit);
+    EXPECT_EQ(circuit.numGates(), 1u);
+    EXPECT_TRUE(equalUpToPhase(unitaryOf(circuit), expected));
+}
+
 // =============================================================================
 // Integration Tests - PassManager with Multiple Passes
 // =============================================================================
@@ -800,6 +1723,27 @@ TEST(IntegrationTest, FullOptimizationPipeline) {
     EXPECT_EQ(circuit.numGates(), 1);  // Only X remains
 }
 
+TEST(IntegrationTest, PipelineKeepsMeasurementsInPlace) {
+    Circuit circuit(2, 2);
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::h(0));
+    circuit.addGate(Gate::measure(0, 0));
+    circuit.addGate(Gate::rz(1, constants::PI_4));
+    circuit.addGate(Gate::measure(1, 1));
+    circuit.addGate(Gate::rz(1, -constants::PI_4));
+    
+    PassManager pm;
+    pm.addPass(std::make_unique<CancellationPass>());
+    pm.addPass(std::make_unique<RotationMergePass>());
+    pm.addPass(std::make_unique<IdentityEliminationPass>());
+    pm.run(circuit);
+    
+    ASSERT_EQ(circuit.numGates(), 4);
+    EXPECT_EQ(circuit.numClbits(), 2);
+    EXPECT_EQ(circuit.countGates(GateType::Measure), 2);
+    EXPECT_EQ(circuit.countGates(GateType::Rz), 2);
+}
+
 TEST(IntegrationTest, StatisticsToString) {
     Circuit circuit(1);
     circuit.addGate(Gate::h(0));
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Rylan Malarchick
+
+/**
+ * @file test_pipeline_spec.cpp
+ * @brief Unit tests for textual and JSON pipeline specs
+ */
+
+#include "passes/PipelineSpec.hpp"
+#include "ir/Circuit.hpp"
+#include "ir/Gate.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace qopt::passes {
+namespace {
+
+using ir::Circuit;
+using ir::Gate;
+
+// =============================================================================
+// Text Form Tests
+// =============================================================================
+
+TEST(PipelineSpecTest, ParsesPassesOptionsAndFixpoint) {
+    auto spec = PipelineSpec::parse("cancel, rotmerge, idelim(tolerance=1e-6); fixpoint(max=4)");
+
+    ASSERT_EQ(spec.passes.size(), 3u);
+    EXPECT_EQ(spec.passes[0].name, "cancel");
+    EXPECT_EQ(spec.passes[1].name, "rotmerge");
+    EXPECT_EQ(spec.passes[2].name, "idelim");
+    EXPECT_EQ(spec.passes[2].option("tolerance"), "1e-6");
+    EXPECT_DOUBLE_EQ(spec.passes[2].number("tolerance", 0.0), 1e-6);
+    EXPECT_EQ(spec.max_iterations, 4u);
+}
+
+TEST(PipelineSpecTest, AcceptsClassNamesAndDefaults) {
+    auto spec = PipelineSpec::parse("CancellationPass,fused;fixpoint");
+    ASSERT_EQ(spec.passes.size(), 2u);
+    EXPECT_EQ(spec.passes[0].name, "cancel");
+    EXPECT_EQ(spec.max_iterations, FIXPOINT_ITERATIONS);
+
+    EXPECT_TRUE(PipelineSpec::parse("").passes.empty());
+    EXPECT_EQ(PipelineSpec::parse("cancel").max_iterations, 1u);
+    EXPECT_EQ(PipelineSpec::parse("; fixpoint(max=2)").max_iterations, 2u);
+}
+
+TEST(PipelineSpecTest, QuotedValuesCarryPeepholeRules) {
+    auto spec = PipelineSpec::parse(R"(peephole(rules="H a; H a =>\nS a; S a => Z a"))");
+    ASSERT_EQ(spec.passes.size(), 1u);
+
+    auto pm = spec.build();
+    Circuit circuit(1);
+    circuit.addGate(Gate::s(0));
+    circuit.addGate(Gate::s(0));
+    circuit.addGate(Gate::t(0));
+    circuit.addGate(Gate::tdg(0));  // Not in the custom rules
+    pm.run(circuit);
+    EXPECT_EQ(circuit.numGates(), 3u);
+}
+
+TEST(PipelineSpecTest, ToStringRoundTrips) {
+    for (const char* text : {"cancel,rotmerge,idelim(tolerance=1e-6);fixpoint(max=4)",
+                             "fused,fuse1q(tolerance=0.001)",
+                             R"(peephole(rules="X a; X a =>"),commute)",
+                             ""}) {
+        auto spec = PipelineSpec::parse(text);
+        EXPECT_EQ(spec.toString(), text);
+        EXPECT_EQ(PipelineSpec::parse(spec.toString()), spec);
+    }
+}
+
+TEST(PipelineSpecTest, RejectsMalformedSpecs) {
+    for (const char* text : {"cancel,", "cancel(", "cancel(tolerance)", "cancel;;fixpoint",
+                             "cancel fused", "fixpoint", "cancel;fixpoint;fixpoint",
+                             "cancel;repeat", "cancel;fixpoint(max=0)", "cancel;fixpoint(max=x)",
+                             "peephole(rules=\"H a", "nosuchpass", "cancel(tolerance=1)",
+                             "idelim(tolerance=abc)", "idelim(tolerance=1,tolerance=2)",
+                             "peephole(rules=\"H a => X a\")", "cancel;fixpoint(max=2,max=3)"}) {
+        SCOPED_TRACE(text);
+        EXPECT_THROW((void)PipelineSpec::parse(text), std::invalid_argument);
+    }
+}
+
+TEST(PipelineSpecTest, ErrorsNameTheColumn) {
+    try {
+        (void)PipelineSpec::parse("cancel, rotmerge idelim");
+        FAIL() << "expected an exception";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_NE(std::string(e.what()).find("column 18"), std::string::npos) << e.what();
+    }
+}
+
+// =============================================================================
+// JSON Form Tests
+// =============================================================================
+
+TEST(PipelineSpecTest, JsonMatchesText) {
+    auto json = PipelineSpec::parseJson(R"({
+        "passes": ["cancel", "RotationMergePass", {"pass": "idelim", "tolerance": 1e-6}],
+        "fixpoint": {"max": 4}
+    })");
+    EXPECT_EQ(json, PipelineSpec::parse("cancel,rotmerge,idelim(tolerance=1e-6);fixpoint(max=4)"));
+
+    EXPECT_EQ(PipelineSpec::parseJson(R"({"passes": [], "fixpoint": true})").max_iterations,
+              FIXPOINT_ITERATIONS);
+    EXPECT_EQ(PipelineSpec::parseJson(R"({"passes": ["fused"], "fixpoint": false})").max_iterations,
+              1u);
+}
+
+TEST(PipelineSpecTest, JsonStringOptionsUnescape) {
+    auto spec = PipelineSpec::parseJson(
+        R"({"passes": [{"pass": "peephole", "rules": "H a; H a =>\nX a; X a =>"}]})");
+    ASSERT_EQ(spec.passes.size(), 1u);
+    EXPECT_EQ(spec.passes[0].option("rules"), "H a; H a =>\nX a; X a =>");
+}
+
+TEST(PipelineSpecTest, RejectsMalformedJson) {
+    for (const char* json : {"{}", "{\"passes\": [\"cancel\"]", "{\"passes\": [1]}",
+                             "{\"passes\": [{\"tolerance\": 1}]}",
+                             "{\"passes\": [], \"extra\": 1}",
+                             "{\"passes\": [], \"fixpoint\": {\"max\": 0}}",
+                             "{\"passes\": [], \"fixpoint\": {\"min\": 2}}",
+                             "{\"passes\": [{\"pass\": \"idelim\", \"tolerance\": null}]}",
+                             "{\"passes\": [\"nosuchpass\"]}",
+                             "{\"passes\": []} trailing"}) {
+        SCOPED_TRACE(json);
+        EXPECT_THROW((void)PipelineSpec::parseJson(json), std::invalid_argument);
+    }
+}
+
+TEST(PipelineSpecTest, ParseConfigDetectsTheForm) {
+    EXPECT_EQ(PipelineSpec::parseConfig("  {\"passes\": [\"cancel\"]}\n"),
+              PipelineSpec::parse("cancel"));
+    EXPECT_EQ(PipelineSpec::parseConfig("cancel\n"), PipelineSpec::parse("cancel"));
+}
+
+// =============================================================================
+// Build Tests
+// =============================================================================
+
+TEST(PipelineSpecTest, BuildConfiguresPassesAndIterations) {
+    auto pm = PipelineSpec::parse("idelim, rotmerge; fixpoint(max=3)").build();
+    EXPECT_EQ(pm.numPasses(), 2u);
+    EXPECT_EQ(pm.maxIterations(), 3u);
+
+    Circuit circuit(1);
+    circuit.addGate(Gate::rz(0, 0.5));
+    circuit.addGate(Gate::rz(0, -0.5));
+    pm.run(circuit);
+    EXPECT_EQ(circuit.numGates(), 0u);
+    EXPECT_EQ(std::get<0>(pm.statistics().per_pass[0]), "IdentityEliminationPass");
+}
+
+TEST(PipelineSpecTest, ToleranceOptionReachesThePass) {
+    Circuit circuit(1);
+    circuit.addGate(Gate::rz(0, 1e-4));
+
+    Circuit strict = circuit.clone();
+    PipelineSpec::parse("idelim").build().run(strict);
+    EXPECT_EQ(strict.numGates(), 1u);
+
+    PipelineSpec::parse("idelim(tolerance=1e-3)").build().run(circuit);
+    EXPECT_EQ(circuit.numGates(), 0u);
+}
+
+}  // namespace
+}  // namespace qopt::passes
@@ -5,18 +5,27 @@
  * @file test_routing.cpp
  * @brief Unit tests for qubit routing
  *
- * Tests for Topology, Router, TrivialRouter, and SabreRouter.
+ * Tests for Topology, Router, TrivialRouter, SabreRouter, TopologyPartition,
+ * HierarchicalRouter, compile() and circuit cutting.
  */
 
 #include "routing/Topology.hpp"
 #include "routing/Router.hpp"
 #include "routing/SabreRouter.hpp"
+#include "routing/HierarchicalRouter.hpp"
+#include "routing/TopologyPartition.hpp"
+#include "routing/Compiler.hpp"
+#include "routing/CircuitCutting.hpp"
+#include "routing/LookaheadWindow.hpp"
 #include "ir/Circuit.hpp"
 #include "ir/Gate.hpp"
 
 #include <gtest/gtest.h>
 #include <cmath>
 #include <memory>
+#include <random>
+#include <string>
+#include <vector>
 
 using namespace qopt;
 using namespace qopt::ir;
@@ -130,6 +139,25 @@ TEST(TopologyTest, DistanceValidatesQubits) {
     EXPECT_THROW((void)t.distance(10, 0), std::out_of_range);
 }
 
+TEST(TopologyTest, DistanceMatrixIsFlatRowMajor) {
+    auto t = Topology::grid(2, 3);
+    const auto& matrix = t.distanceMatrix();
+    ASSERT_EQ(matrix.size(), 36u);
+    for (std::size_t a = 0; a < 6; ++a) {
+        for (std::size_t b = 0; b < 6; ++b) {
+            EXPECT_EQ(matrix[a * 6 + b], t.distance(a, b));
+        }
+    }
+}
+
+TEST(TopologyTest, DistanceMatrixMarksDisconnectedPairs) {
+    Topology t(4);
+    t.addEdge(0, 1);
+    t.addEdge(2, 3);
+    EXPECT_EQ(t.distanceMatrix()[0 * 4 + 2], Topology::UNREACHABLE);
+    EXPECT_EQ(t.distance(0, 2), Topology::INFINITE);
+}
+
 TEST(TopologyTest, ShortestPathSameQubit) {
     auto t = Topology::linear(5);
     auto path = t.shortestPath(2, 2);
@@ -593,6 +621,950 @@ TEST(SabreRouterTest, CustomParameters) {
     }
 }
 
+TEST(SabreRouterTest, LookaheadSeesPastSingleQubitLayers) {
+    // cnot(0,2) can be fixed by SWAP(0,1) or SWAP(2,1) at equal cost.
+    // The next two-qubit gate on q0 sits two layers ahead, behind an H;
+    // only SWAP(0,1) also keeps cnot(1,0) adjacent.
+    SabreRouter router(20, 0.5, 0.5);
+    Circuit c(3);
+    c.addGate(Gate::cnot(0, 2));
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::cnot(1, 0));
+    auto topology = Topology::linear(3);
+
+    auto result = router.route(c, topology);
+
+    ASSERT_GE(result.routed_circuit.numGates(), 1u);
+    const Gate& first = result.routed_circuit.gate(0);
+    EXPECT_EQ(first.type(), GateType::SWAP);
+    EXPECT_EQ(std::min(first.qubits()[0], first.qubits()[1]), 0u);
+    EXPECT_EQ(std::max(first.qubits()[0], first.qubits()[1]), 1u);
+    EXPECT_EQ(result.swaps_inserted, 1u);
+}
+
+TEST(SabreRouterTest, DepthTieBreakKeepsSwapsOffTheCriticalPath) {
+    // cnot(1,3) can be fixed by SWAP(1,2) or SWAP(2,3) at equal cost, but
+    // q1 is busy with five H gates: swapping 2 and 3 overlaps with them.
+    Circuit c(4);
+    for (int i = 0; i < 5; ++i) c.addGate(Gate::h(1));
+    c.addGate(Gate::cnot(1, 3));
+    auto topology = Topology::linear(4);
+
+    auto aware = SabreRouter(20, 0.5, 0.5, true).route(c, topology);
+    auto plain = SabreRouter(20, 0.5, 0.5, false).route(c, topology);
+
+    EXPECT_EQ(aware.swaps_inserted, 1u);
+    EXPECT_EQ(plain.swaps_inserted, 1u);
+    EXPECT_EQ(aware.final_depth, 6u);
+    EXPECT_EQ(plain.final_depth, 7u);
+}
+
+TEST(SabreRouterTest, ZeroLookaheadStillRoutes) {
+    SabreRouter router(0, 0.5, 0.5);
+    Circuit c(5);
+    c.addGate(Gate::cnot(0, 4));
+    c.addGate(Gate::cnot(1, 3));
+    c.addGate(Gate::cnot(4, 2));
+    auto topology = Topology::linear(5);
+
+    auto result = router.route(c, topology);
+    EXPECT_EQ(result.routed_circuit.numGates(), 3u + result.swaps_inserted);
+    for (const auto& gate : result.routed_circuit) {
+        if (gate.numQubits() == 2) {
+            EXPECT_TRUE(topology.connected(gate.qubits()[0], gate.qubits()[1]));
+        }
+    }
+}
+
+TEST(SabreRouterTest, LargeDeviceRandomCircuit) {
+    // 100-qubit grid with a wide front layer exercises batched scoring
+    constexpr std::size_t n = 100;
+    Circuit c(n);
+    std::size_t a = 7;
+    for (std::size_t i = 0; i < 400; ++i) {
+        a = (a * 37 + 11) % n;
+        std::size_t b = (a * 53 + 29) % n;
+        if (a == b) b = (b + 1) % n;
+        c.addGate(Gate::cnot(a, b));
+    }
+    auto topology = Topology::grid(10, 10);
+
+    SabreRouter router;
+    auto result = router.route(c, topology);
+
+    EXPECT_EQ(result.routed_circuit.numGates(), c.numGates() + result.swaps_inserted);
+    for (const auto& gate : result.routed_circuit) {
+        EXPECT_TRUE(topology.connected(gate.qubits()[0], gate.qubits()[1]));
+    }
+}
+
+// =============================================================================
+// TopologyPartition Tests
+// =============================================================================
+
+TEST(TopologyPartitionTest, RejectsZeroRegionSize) {
+    auto topology = Topology::linear(4);
+    EXPECT_THROW((void)TopologyPartition::build(topology, 0), std::invalid_argument);
+}
+
+TEST(TopologyPartitionTest, RegionsCoverAllQubitsOnce) {
+    auto topology = Topology::grid(6, 6);
+    auto partition = TopologyPartition::build(topology, 8);
+
+    std::vector<int> seen(topology.numQubits(), 0);
+    for (std::size_t r = 0; r < partition.numRegions(); ++r) {
+        const auto& members = partition.region(r);
+        EXPECT_LE(members.size(), 8u);
+        for (std::size_t i = 0; i < members.size(); ++i) {
+            ++seen[members[i]];
+            EXPECT_EQ(partition.regionOf()[members[i]], r);
+            EXPECT_EQ(partition.localIndex()[members[i]], i);
+        }
+    }
+    for (int count : seen) {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST(TopologyPartitionTest, RegionTopologiesAreConnected) {
+    auto topology = Topology::heavyHex(3);
+    auto partition = TopologyPartition::build(topology, 10);
+
+    for (std::size_t r = 0; r < partition.numRegions(); ++r) {
+        auto local = partition.regionTopology(topology, r);
+        EXPECT_EQ(local.numQubits(), partition.region(r).size());
+        EXPECT_TRUE(local.isConnected());
+        for (const auto& [a, b] : local.edges()) {
+            EXPECT_TRUE(topology.connected(partition.region(r)[a], partition.region(r)[b]));
+        }
+    }
+}
+
+TEST(TopologyPartitionTest, CoarseGraphFollowsDeviceEdges) {
+    // Chain of 12 in regions of 4: 0-3, 4-7, 8-11 form a path of regions
+    auto topology = Topology::linear(12);
+    auto partition = TopologyPartition::build(topology, 4);
+
+    ASSERT_EQ(partition.numRegions(), 3u);
+    EXPECT_EQ(partition.adjacentRegions(0), std::vector<std::size_t>{1});
+    EXPECT_EQ(partition.adjacentRegions(1).size(), 2u);
+    EXPECT_EQ(partition.regionPath(0, 2), (std::vector<std::size_t>{0, 1, 2}));
+    EXPECT_THROW((void)partition.region(3), std::out_of_range);
+}
+
+// =============================================================================
+// HierarchicalRouter Tests
+// =============================================================================
+
+namespace {
+
+/**
+ * @brief Checks that a routed circuit implements the logical circuit.
+ *
+ * Replays the routed circuit from the reported initial mapping, treating
+ * every SWAP as a relabeling, and compares the gates seen by each logical
+ * qubit and the measurements written to each classical bit with the
+ * original circuit's. Assumes the input has no SWAPs.
+ */
+void expectFaithfulRouting(const Circuit& logical, const RoutingResult& result,
+                           const Topology& topology) {
+    const std::size_t n = logical.numQubits();
+    std::vector<std::vector<std::string>> expected(n);
+    std::vector<std::vector<std::string>> expected_bits(logical.numClbits());
+    for (const auto& gate : logical) {
+        for (auto q : gate.qubits()) {
+            expected[q].push_back(gate.toString());
+        }
+        if (auto c = gate.clbit()) {
+            expected_bits[*c].push_back(gate.toString());
+        }
+    }
+    ASSERT_EQ(result.routed_circuit.numClbits(), logical.numClbits());
+
+    std::vector<std::size_t> at(topology.numQubits(), n);  // physical -> logical
+    for (std::size_t q = 0; q < n; ++q) {
+        at[result.initial_mapping[q]] = q;
+    }
+
+    std::vector<std::vector<std::string>> actual(n);
+    std::vector<std::vector<std::string>> actual_bits(logical.numClbits());
+    for (const auto& gate : result.routed_circuit) {
+        if (isMultiQubitGate(gate.type())) {
+            // Every qubit neighbors the last one (the CCX target)
+            for (std::size_t i = 0; i + 1 < gate.numQubits(); ++i) {
+                ASSERT_TRUE(topology.connected(gate.qubits()[i], gate.qubits().back()));
+            }
+        }
+        if (gate.type() == GateType::SWAP) {
+            std::swap(at[gate.qubits()[0]], at[gate.qubits()[1]]);
+            continue;
+        }
+        std::vector<QubitIndex> qubits;
+        for (auto p : gate.qubits()) {
+            ASSERT_LT(at[p], n);
+            qubits.push_back(at[p]);
+        }
+        Gate relabeled = gate.withQubits(qubits);
+        for (auto q : qubits) {
+            actual[q].push_back(relabeled.toString());
+        }
+        if (auto c = gate.clbit()) {
+            actual_bits[*c].push_back(relabeled.toString());
+        }
+    }
+
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(actual_bits, expected_bits);
+    for (std::size_t p = 0; p < at.size(); ++p) {
+        if (at[p] < n) {
+            EXPECT_EQ(result.final_mapping[at[p]], p);
+        }
+    }
+}
+
+Circuit pseudoRandomCircuit(std::size_t n, std::size_t gates) {
+    Circuit c(n);
+    std::size_t a = 3;
+    for (std::size_t i = 0; i < gates; ++i) {
+        a = (a * 37 + 11) % n;
+        if (i % 3 == 0) {
+            c.addGate(Gate::h(a));
+            continue;
+        }
+        std::size_t b = (a * 53 + 29) % n;
+        if (a == b) b = (b + 1) % n;
+        c.addGate(Gate::cnot(a, b));
+    }
+    return c;
+}
+
+/// Dense random H/CX circuit from raw mt19937 output (portable across libraries).
+Circuit randomCxCircuit(unsigned seed, std::size_t n, std::size_t gates) {
+    std::mt19937 rng(seed);
+    Circuit c(n);
+    for (std::size_t i = 0; i < gates; ++i) {
+        std::size_t a = rng() % n;
+        if (rng() % 4 == 0) {
+            c.addGate(Gate::h(a));
+            continue;
+        }
+        std::size_t b = rng() % (n - 1);
+        if (b >= a) ++b;
+        c.addGate(Gate::cnot(a, b));
+    }
+    return c;
+}
+
+}  // namespace
+
+TEST(SabreRouterTest, RemapsMeasurementsAndBarriers) {
+    Circuit c(4, 2);
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::cnot(0, 3));  // Needs SWAPs on a line
+    c.addGate(Gate::barrier({0, 1, 2, 3}));
+    c.addGate(Gate::measure(0, 1));
+    c.addGate(Gate::reset(3));
+    c.addGate(Gate::measure(3, 0));
+    auto topology = Topology::linear(4);
+
+    SabreRouter router;
+    auto result = router.route(c, topology);
+
+    expectFaithfulRouting(c, result, topology);
+    EXPECT_GT(result.swaps_inserted, 0u);
+    EXPECT_EQ(result.routed_circuit.countGates(GateType::Barrier), 1u);
+    EXPECT_EQ(result.final_depth, result.routed_circuit.depth());
+}
+
+TEST(SabreRouterTest, RoutesToffoliAndNativeTwoQubitGates) {
+    Circuit c(5);
+    c.addGate(Gate::ccx(0, 4, 2));
+    c.addGate(Gate::cphase(0, 4, 0.3));
+    c.addGate(Gate::rzz(1, 3, 0.2));
+    c.addGate(Gate::iswap(4, 0));
+    c.addGate(Gate::ccx(4, 0, 1));
+    c.addGate(Gate::u3(2, 0.1, 0.2, 0.3));
+    auto topology = Topology::linear(5);
+
+    SabreRouter router;
+    auto result = router.route(c, topology);
+
+    expectFaithfulRouting(c, result, topology);
+    EXPECT_GT(result.swaps_inserted, 0u);
+    EXPECT_EQ(result.routed_circuit.countGates(GateType::CCX), 2u);
+    EXPECT_EQ(result.telemetry.lowered_two_qubit_gates,
+              2 * 6 + 3 * 2 + 3 * result.swaps_inserted);
+}
+
+TEST(SabreRouterTest, LayoutTrialsAreFaithfulAndNeverWorse) {
+    auto c = pseudoRandomCircuit(16, 300);
+    auto topology = Topology::grid(4, 4);
+
+    SabreRouter single;
+    SabreRouter trials(20, 0.5, 0.5, false, 6);
+    auto baseline = single.route(c, topology);
+    auto best = trials.route(c, topology);
+
+    expectFaithfulRouting(c, best, topology);
+    EXPECT_LE(best.swaps_inserted, baseline.swaps_inserted);
+
+    // Seeded by trial number, so repeatable
+    auto again = trials.route(c, topology);
+    EXPECT_EQ(again.initial_mapping, best.initial_mapping);
+    EXPECT_EQ(again.swaps_inserted, best.swaps_inserted);
+
+    EXPECT_THROW(SabreRouter(20, 0.5, 0.5, true, 0), std::invalid_argument);
+}
+
+TEST(SabreRouterTest, DepthTieBreakCannotLivelock) {
+    // With these starts the depth tie-break once cycled between SWAPs forever
+    auto c = randomCxCircuit(8, 29, 405);
+    auto topology = Topology::ring(29);
+
+    SabreRouter router(20, 0.5, 0.5, true, 2);
+    auto result = router.route(c, topology);
+    expectFaithfulRouting(c, result, topology);
+}
+
+TEST(CompilerTest, EveryLevelRespectsCoupling) {
+    auto c = pseudoRandomCircuit(9, 200);
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::h(0));
+    auto topology = Topology::grid(3, 3);
+
+    std::size_t o0_gates = 0;
+    for (auto level : {passes::OptimizationLevel::O0, passes::OptimizationLevel::O1,
+                       passes::OptimizationLevel::O2, passes::OptimizationLevel::O3}) {
+        SCOPED_TRACE(std::string(passes::toString(level)));
+        auto result = compile(c, topology, level);
+        const auto& routed = result.routing.routed_circuit;
+
+        for (const auto& gate : routed) {
+            if (gate.numQubits() == 2) {
+                EXPECT_TRUE(topology.connected(gate.qubits()[0], gate.qubits()[1]));
+            }
+        }
+        EXPECT_EQ(result.routing.gates_emitted, routed.numGates());
+        EXPECT_EQ(result.routing.final_depth, routed.depth());
+
+        if (level == passes::OptimizationLevel::O0) {
+            o0_gates = routed.numGates();
+            EXPECT_EQ(result.optimization.total_gates_removed, 0u);
+        } else {
+            EXPECT_GT(result.optimization.total_gates_removed, 0u);
+            EXPECT_LE(routed.numGates(), o0_gates);
+        }
+        if (level == passes::OptimizationLevel::O3) {
+            EXPECT_GE(result.cleanup.iterations, 1u);
+        } else {
+            EXPECT_EQ(result.cleanup.iterations, 0u);
+        }
+    }
+}
+
+TEST(CompilerTest, O0RoutesTheCircuitUnchanged) {
+    auto c = pseudoRandomCircuit(6, 60);
+    auto topology = Topology::linear(6);
+    auto result = compile(c, topology, passes::OptimizationLevel::O0);
+    expectFaithfulRouting(c, result.routing, topology);
+}
+
+TEST(CompilerTest, O3FinishesOnDenseRandomCircuits) {
+    // Layout trials with shuffled starts once livelocked SABRE on this circuit
+    auto c = randomCxCircuit(19, 29, 405);
+    auto topology = Topology::ring(29);
+
+    auto result = compile(c, topology, passes::OptimizationLevel::O3);
+    const auto& routed = result.routing.routed_circuit;
+    for (const auto& gate : routed) {
+        if (gate.numQubits() == 2) {
+            EXPECT_TRUE(topology.connected(gate.qubits()[0], gate.qubits()[1]));
+        }
+    }
+    EXPECT_GT(result.routing.swaps_inserted, 0u);
+}
+
+// =============================================================================
+// Lookahead Window Tests
+// =============================================================================
+
+TEST(LookaheadWindowTest, WeighsGatesByLayer) {
+    Circuit c(3);
+    c.addGate(Gate::cnot(0, 1));  // Front
+    c.addGate(Gate::cnot(1, 2));  // Layer 1
+    c.addGate(Gate::h(0));        // Layer 1, not in the window
+    c.addGate(Gate::cnot(0, 2));  // Layer 2
+    c.addGate(Gate::cnot(0, 1));  // Layer 3
+    auto dag = DAG::fromCircuit(c);
+
+    LookaheadWindow window(20, 0.5, 0.5);
+    window.reset(dag);
+    EXPECT_EQ(window.entries(dag),
+              (std::vector<LookaheadEntry>{{1, 0.5}, {3, 0.25}, {4, 0.125}}));
+
+    LookaheadWindow two(2, 0.5, 0.5);
+    two.reset(dag);
+    EXPECT_EQ(two.entries(dag), (std::vector<LookaheadEntry>{{1, 0.5}, {3, 0.25}}));
+
+    window.execute(dag, 0);
+    EXPECT_EQ(window.entries(dag), (std::vector<LookaheadEntry>{{3, 0.5}, {4, 0.25}}));
+}
+
+TEST(LookaheadWindowTest, IncrementalUpdatesMatchARebuild) {
+    auto circuits = {pseudoRandomCircuit(12, 300), randomCxCircuit(3, 16, 400)};
+    for (const auto& c : circuits) {
+        auto dag = DAG::fromCircuit(c);
+        for (std::size_t max_gates : {0u, 1u, 5u, 20u}) {
+            SCOPED_TRACE(max_gates);
+            LookaheadWindow incremental(max_gates, 0.5, 0.5);
+            incremental.reset(dag);
+            std::vector<GateId> history;
+
+            // Execute a random part of the front at each step
+            std::mt19937 rng(static_cast<std::mt19937::result_type>(max_gates));
+            std::vector<std::size_t> remaining(dag.numNodes());
+            std::vector<GateId> front;
+            for (GateId id : dag.nodeIds()) {
+                remaining[id] = dag.node(id).inDegree();
+                if (remaining[id] == 0) front.push_back(id);
+            }
+            while (!front.empty()) {
+                // A window that only sees the executed gates, never read before
+                LookaheadWindow fresh(max_gates, 0.5, 0.5);
+                fresh.reset(dag);
+                for (GateId id : history) fresh.execute(dag, id);
+                ASSERT_EQ(incremental.entries(dag), fresh.entries(dag));
+
+                std::vector<GateId> next;
+                for (std::size_t i = 0; i < front.size(); ++i) {
+                    if (i > 0 && rng() % 2 == 0) {
+                        next.push_back(front[i]);
+                        continue;
+                    }
+                    incremental.execute(dag, front[i]);
+                    history.push_back(front[i]);
+                    for (GateId succ : dag.node(front[i]).successors()) {
+                        if (--remaining[succ] == 0) next.push_back(succ);
+                    }
+                }
+                front = std::move(next);
+            }
+            EXPECT_TRUE(incremental.entries(dag).empty());
+        }
+    }
+}
+
+// =============================================================================
+// Circuit Cutting Tests
+// =============================================================================
+
+namespace {
+
+/// @brief Two independent pseudo-random blocks, interleaved gate by gate.
+Circuit twoBlockCircuit() {
+    auto block = pseudoRandomCircuit(4, 60);
+    Circuit c(8, 2);
+    for (std::size_t i = 0; i < block.numGates(); ++i) {
+        c.addGate(block[i]);
+        std::vector<QubitIndex> shifted;
+        for (auto q : block[i].qubits()) shifted.push_back(q + 4);
+        c.addGate(block[i].withQubits(shifted));
+    }
+    c.addGate(Gate::measure(1, 0));
+    c.addGate(Gate::measure(6, 1));
+    return c;
+}
+
+}  // namespace
+
+TEST(QubitComponentsTest, JoinsInteractingQubits) {
+    Circuit c(7, 1);
+    c.addGate(Gate::cnot(0, 2));
+    c.addGate(Gate::cz(3, 4));
+    c.addGate(Gate::h(1));
+    c.addGate(Gate::barrier({0, 1, 2, 3, 4, 5, 6}));
+    c.addGate(Gate::measure(5, 0));
+    c.addGate(Gate::measure(1, 0));  // Same bit: 1 and 5 depend on each other
+
+    auto components = QubitComponents::build(c);
+
+    ASSERT_EQ(components.numComponents(), 4u);
+    EXPECT_EQ(components.component(0), (std::vector<QubitIndex>{0, 2}));
+    EXPECT_EQ(components.component(1), (std::vector<QubitIndex>{1, 5}));
+    EXPECT_EQ(components.component(2), (std::vector<QubitIndex>{3, 4}));
+    EXPECT_EQ(components.component(3), (std::vector<QubitIndex>{6}));
+    EXPECT_EQ(components.componentOf()[5], 1u);
+    EXPECT_THROW((void)components.component(4), std::out_of_range);
+}
+
+TEST(QubitComponentsTest, CutCircuitRemapsQubits) {
+    Circuit c(4, 1);
+    c.addGate(Gate::cnot(3, 1));
+    c.addGate(Gate::barrier({0, 1, 2, 3}));
+    c.addGate(Gate::rz(2, 0.5));
+    c.addGate(Gate::measure(3, 0));
+
+    auto parts = cutCircuit(c, QubitComponents::build(c));
+
+    ASSERT_EQ(parts.size(), 3u);
+    EXPECT_EQ(parts[1].qubits, (std::vector<QubitIndex>{1, 3}));
+    const Circuit& pair = parts[1].circuit;
+    EXPECT_EQ(pair.numQubits(), 2u);
+    EXPECT_EQ(pair.numClbits(), 1u);
+    ASSERT_EQ(pair.numGates(), 3u);
+    EXPECT_EQ(pair[0].qubits(), (std::vector<QubitIndex>{1, 0}));
+    EXPECT_EQ(pair[1].qubits(), (std::vector<QubitIndex>{0, 1}));
+    EXPECT_EQ(pair[2].clbit(), 0u);
+
+    EXPECT_EQ(parts[0].circuit.numGates(), 1u);  // Its share of the barrier
+    ASSERT_EQ(parts[2].circuit.numGates(), 2u);
+    EXPECT_EQ(parts[2].circuit[1].type(), GateType::Rz);
+}
+
+TEST(CircuitCuttingTest, CompilesComponentsOnDisjointRegions) {
+    auto c = twoBlockCircuit();
+    auto topology = Topology::grid(3, 3);
+
+    auto result = compileCut(c, topology, passes::OptimizationLevel::O0);
+
+    ASSERT_EQ(result.regions.size(), 2u);
+    std::vector<bool> used(topology.numQubits(), false);
+    for (std::size_t r = 0; r < result.regions.size(); ++r) {
+        EXPECT_EQ(result.regions[r].size(), result.components[r].size());
+        for (auto p : result.regions[r]) {
+            EXPECT_FALSE(used[p]);
+            used[p] = true;
+        }
+    }
+    const auto& routing = result.compiled.routing;
+    expectFaithfulRouting(c, routing, topology);
+    EXPECT_EQ(routing.gates_emitted, routing.routed_circuit.numGates());
+    EXPECT_EQ(routing.final_depth, routing.routed_circuit.depth());
+
+    auto serial = compileCut(c, topology, passes::OptimizationLevel::O0, false);
+    EXPECT_EQ(serial.compiled.routing.routed_circuit.numGates(), routing.routed_circuit.numGates());
+
+    auto optimized = compileCut(c, topology, passes::OptimizationLevel::O2);
+    EXPECT_EQ(optimized.compiled.optimization.initial_gate_count, c.numGates());
+    EXPECT_GE(optimized.compiled.optimization.iterations, 1u);
+}
+
+TEST(CircuitCuttingTest, MergesExpressionsAddedByEachPart) {
+    // Each component merges Rz(a) Rz(b) into Rz(a + b), a new expression
+    Circuit c(4);
+    auto& table = c.parameterTable();
+    auto a = table.add(ir::AffineExpression::symbol(table.addSymbol("a")));
+    auto b = table.add(ir::AffineExpression::symbol(table.addSymbol("b")));
+    for (QubitIndex q : {QubitIndex{0}, QubitIndex{2}}) {
+        c.addGate(Gate::cnot(q, q + 1));
+        c.addGate(Gate::rz(q, 0.0).withExpression(0, a));
+        c.addGate(Gate::rz(q, 0.0).withExpression(0, b));
+    }
+
+    auto result = compileCut(c, Topology::grid(2, 2), passes::OptimizationLevel::O1);
+    ASSERT_EQ(result.regions.size(), 2u);
+
+    const auto& routed = result.compiled.routing.routed_circuit;
+    EXPECT_EQ(routed.parameterTable().numExpressions(), 4u);
+    auto bound = routed.bind({0.25, 0.5});
+    std::size_t rotations = 0;
+    for (const auto& gate : bound) {
+        if (gate.type() != ir::GateType::Rz) continue;
+        EXPECT_DOUBLE_EQ(gate.parameter(0), 0.75);
+        ++rotations;
+    }
+    EXPECT_EQ(rotations, 2u);
+}
+
+TEST(CircuitCuttingTest, FallsBackWithoutDisjointRegions) {
+    // Star: once a component takes the hub, no connected pair is left
+    Topology star(4);
+    star.addEdge(0, 1);
+    star.addEdge(0, 2);
+    star.addEdge(0, 3);
+    Circuit c(4);
+    c.addGate(Gate::cnot(0, 1));
+    c.addGate(Gate::cnot(2, 3));
+
+    auto result = compileCut(c, star, passes::OptimizationLevel::O0);
+    EXPECT_EQ(result.components.size(), 2u);
+    EXPECT_TRUE(result.regions.empty());
+    expectFaithfulRouting(c, result.compiled.routing, star);
+
+    Circuit single(3);
+    single.addGate(Gate::cnot(0, 1));
+    single.addGate(Gate::cnot(1, 2));
+    EXPECT_TRUE(compileCut(single, Topology::linear(3), passes::OptimizationLevel::O1)
+                    .regions.empty());
+}
+
+TEST(HierarchicalRouterTest, NameReturnsCorrectValue) {
+    HierarchicalRouter router;
+    EXPECT_EQ(router.name(), "HierarchicalRouter");
+}
+
+TEST(HierarchicalRouterTest, RejectsZeroRegionSize) {
+    EXPECT_THROW(HierarchicalRouter(0), std::invalid_argument);
+}
+
+TEST(HierarchicalRouterTest, EmptyCircuit) {
+    HierarchicalRouter router;
+    Circuit c(4);
+    auto result = router.route(c, Topology::linear(4));
+    EXPECT_TRUE(result.routed_circuit.empty());
+    EXPECT_EQ(result.swaps_inserted, 0u);
+}
+
+TEST(HierarchicalRouterTest, PlacesInteractingQubitsTogether) {
+    // q0 and q5 interact heavily: they should start adjacent
+    HierarchicalRouter router(3);
+    Circuit c(6);
+    for (int i = 0; i < 4; ++i) {
+        c.addGate(Gate::cnot(0, 5));
+    }
+    auto topology = Topology::linear(6);
+
+    auto result = router.route(c, topology);
+
+    EXPECT_EQ(topology.distance(result.initial_mapping[0], result.initial_mapping[5]), 1u);
+    EXPECT_EQ(result.swaps_inserted, 0u);
+    expectFaithfulRouting(c, result, topology);
+}
+
+TEST(HierarchicalRouterTest, CrossRegionGateOnLinear) {
+    HierarchicalRouter router(2);
+    Circuit c(8);
+    c.addGate(Gate::cnot(0, 1));
+    c.addGate(Gate::cnot(2, 3));
+    c.addGate(Gate::cnot(4, 5));
+    c.addGate(Gate::cnot(6, 7));
+    c.addGate(Gate::cz(1, 6));
+    c.addGate(Gate::h(6));
+    auto topology = Topology::linear(8);
+
+    auto result = router.route(c, topology);
+    expectFaithfulRouting(c, result, topology);
+}
+
+TEST(HierarchicalRouterTest, FewerLogicalThanPhysical) {
+    HierarchicalRouter router(4);
+    auto c = pseudoRandomCircuit(10, 120);
+    auto topology = Topology::grid(4, 4);
+
+    auto result = router.route(c, topology);
+    EXPECT_EQ(result.initial_mapping.size(), 10u);
+    expectFaithfulRouting(c, result, topology);
+}
+
+TEST(HierarchicalRouterTest, SequentialAndParallelAgree) {
+    auto c = pseudoRandomCircuit(64, 600);
+    auto topology = Topology::grid(8, 8);
+
+    HierarchicalRouter parallel(16, 20, 0.5, 0.5, true);
+    HierarchicalRouter sequential(16, 20, 0.5, 0.5, false);
+    auto a = parallel.route(c, topology);
+    auto b = sequential.route(c, topology);
+
+    expectFaithfulRouting(c, a, topology);
+    EXPECT_EQ(a.swaps_inserted, b.swaps_inserted);
+    EXPECT_EQ(a.routed_circuit.toString(), b.routed_circuit.toString());
+}
+
+TEST(HierarchicalRouterTest, LargeHeavyHexDevice) {
+    auto topology = Topology::heavyHex(8);  // 289 qubits
+    auto c = pseudoRandomCircuit(topology.numQubits(), 1500);
+
+    HierarchicalRouter router(32);
+    auto result = router.route(c, topology);
+
+    EXPECT_EQ(result.routed_circuit.numGates(), c.numGates() + result.swaps_inserted);
+    expectFaithfulRouting(c, result, topology);
+}
+
+TEST(HierarchicalRouterTest, CarriesMeasurementsResetsAndBarriers) {
+    HierarchicalRouter router(2);
+    Circuit c(8, 2);
+    c.addGate(Gate::cnot(0, 1));
+    c.addGate(Gate::cnot(6, 7));
+    // Same bits written from different regions, in both orders
+    c.addGate(Gate::measure(0, 0));
+    c.addGate(Gate::measure(7, 0));
+    c.addGate(Gate::measure(7, 1));
+    c.addGate(Gate::measure(0, 1));
+    c.addGate(Gate::barrier({1, 3, 6}));
+    c.addGate(Gate::reset(6));
+    c.addGate(Gate::cz(1, 6));
+    auto topology = Topology::linear(8);
+
+    auto result = router.route(c, topology);
+    expectFaithfulRouting(c, result, topology);
+    EXPECT_EQ(result.routed_circuit.countGates(GateType::Measure), 4u);
+    EXPECT_EQ(result.routed_circuit.countGates(GateType::Barrier), 1u);
+    EXPECT_EQ(result.final_depth, result.routed_circuit.depth());
+}
+
+TEST(HierarchicalRouterTest, KeepsSymbolicParameters) {
+    HierarchicalRouter router(2);
+    Circuit c(8);
+    auto& table = c.parameterTable();
+    auto theta = table.add(ir::AffineExpression::symbol(table.addSymbol("theta")));
+    c.addGate(Gate::cnot(0, 1));
+    c.addGate(Gate::rz(1, 0.0).withExpression(0, theta));  // Inside a region
+    c.addGate(Gate::cz(1, 6));
+    c.addGate(Gate::rz(6, 0.0).withExpression(0, theta));
+    auto topology = Topology::linear(8);
+
+    auto result = router.route(c, topology);
+    expectFaithfulRouting(c, result, topology);
+
+    const auto& routed = result.routed_circuit;
+    EXPECT_EQ(routed.parameterTable().numSymbols(), 1u);
+    auto bound = routed.bind({0.5});
+    EXPECT_EQ(bound.countGates(GateType::Rz), 2u);
+    for (const auto& gate : bound) {
+        if (gate.type() != GateType::Rz) continue;
+        EXPECT_DOUBLE_EQ(gate.parameter(0), 0.5);
+    }
+}
+
+TEST(HierarchicalRouterTest, ToffoliAcrossRegions) {
+    HierarchicalRouter router(2);
+    Circuit c(8);
+    c.addGate(Gate::cnot(0, 1));
+    c.addGate(Gate::cnot(2, 3));
+    c.addGate(Gate::cnot(4, 5));
+    c.addGate(Gate::cnot(6, 7));
+    c.addGate(Gate::ccx(0, 7, 3));  // Controls on both sides of the target
+    c.addGate(Gate::ccx(1, 2, 6));  // Both controls on one side
+    c.addGate(Gate::ccx(5, 4, 0));
+    auto topology = Topology::linear(8);
+
+    auto result = router.route(c, topology);
+    expectFaithfulRouting(c, result, topology);
+    EXPECT_EQ(result.routed_circuit.countGates(GateType::CCX), 3u);
+}
+
+TEST(HierarchicalRouterTest, RandomToffoliCircuitOnGrid) {
+    Circuit c(36);
+    std::size_t a = 5;
+    for (std::size_t i = 0; i < 200; ++i) {
+        a = (a * 37 + 11) % 36;
+        std::size_t b = (a * 53 + 29) % 36;
+        std::size_t t = (a * 17 + 7) % 36;
+        if (a == b || a == t || b == t) {
+            c.addGate(Gate::h(a));
+        } else if (i % 2 == 0) {
+            c.addGate(Gate::ccx(a, b, t));
+        } else {
+            c.addGate(Gate::cphase(a, t, 0.25));
+        }
+    }
+    auto topology = Topology::grid(6, 6);
+
+    HierarchicalRouter router(9);
+    auto result = router.route(c, topology);
+    expectFaithfulRouting(c, result, topology);
+}
+
+TEST(HierarchicalRouterTest, SingleRegionMatchesSabreCorrectness) {
+    HierarchicalRouter router(1000);
+    auto c = pseudoRandomCircuit(12, 150);
+    auto topology = Topology::ring(12);
+
+    auto result = router.route(c, topology);
+    expectFaithfulRouting(c, result, topology);
+}
+
+// =============================================================================
+// Streaming (routeTo) Tests
+// =============================================================================
+
+TEST(RouteToTest, SabreStreamMatchesMaterializedRoute) {
+    auto c = pseudoRandomCircuit(16, 200);
+    auto topology = Topology::grid(4, 4);
+
+    SabreRouter materializing;
+    auto result = materializing.route(c, topology);
+
+    std::vector<Gate> streamed;
+    SabreRouter streaming;
+    RoutingStats stats = streaming.routeTo(
+        c, topology, [&streamed](const Gate& g) { streamed.push_back(g); });
+
+    ASSERT_EQ(streamed.size(), result.routed_circuit.numGates());
+    for (std::size_t i = 0; i < streamed.size(); ++i) {
+        EXPECT_EQ(streamed[i], result.routed_circuit.gate(i));
+        EXPECT_EQ(streamed[i].id(), i);
+    }
+    EXPECT_EQ(stats.swaps_inserted, result.swaps_inserted);
+    EXPECT_EQ(stats.final_mapping, result.final_mapping);
+    EXPECT_EQ(stats.gates_emitted, streamed.size());
+    EXPECT_EQ(stats.final_depth, result.routed_circuit.depth());
+    EXPECT_EQ(result.final_depth, result.routed_circuit.depth());
+    EXPECT_EQ(result.gates_emitted, result.routed_circuit.numGates());
+}
+
+TEST(RouteToTest, HierarchicalTracksDepthWhileStreaming) {
+    auto c = pseudoRandomCircuit(36, 300);
+    auto topology = Topology::grid(6, 6);
+
+    HierarchicalRouter router(9);
+    std::size_t count = 0;
+    RoutingStats stats = router.routeTo(c, topology, [&count](const Gate&) { ++count; });
+    auto result = router.route(c, topology);
+
+    EXPECT_EQ(stats.gates_emitted, count);
+    EXPECT_EQ(count, c.numGates() + stats.swaps_inserted);
+    EXPECT_EQ(result.final_depth, result.routed_circuit.depth());
+    expectFaithfulRouting(c, result, topology);
+}
+
+TEST(RouteToTest, DefaultImplementationReplaysRoute) {
+    TrivialRouter router;
+    Circuit c(3);
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::cnot(0, 1));
+
+    std::vector<Gate> streamed;
+    RoutingStats stats = router.routeTo(
+        c, Topology::linear(3), [&streamed](const Gate& g) { streamed.push_back(g); });
+
+    ASSERT_EQ(streamed.size(), 2u);
+    EXPECT_EQ(streamed[1], Gate::cnot(0, 1));
+    EXPECT_EQ(stats.final_depth, 2u);
+}
+
+TEST(RouteToTest, EmptyCircuitEmitsNothing) {
+    SabreRouter router;
+    Circuit c(2);
+    std::size_t count = 0;
+    RoutingStats stats = router.routeTo(c, Topology::linear(2), [&count](const Gate&) { ++count; });
+    EXPECT_EQ(count, 0u);
+    EXPECT_EQ(stats.final_mapping, (std::vector<std::size_t>{0, 1}));
+}
+
+// =============================================================================
+// Telemetry Tests
+// =============================================================================
+
+namespace {
+
+std::size_t sum(const std::vector<std::size_t>& values) {
+    std::size_t total = 0;
+    for (std::size_t v : values) total += v;
+    return total;
+}
+
+}  // namespace
+
+TEST(RoutingTelemetryTest, LoweredCostPerGateType) {
+    EXPECT_EQ(loweredTwoQubitCost(GateType::SWAP), 3u);
+    EXPECT_EQ(loweredTwoQubitCost(GateType::CNOT), 1u);
+    EXPECT_EQ(loweredTwoQubitCost(GateType::CZ), 1u);
+    EXPECT_EQ(loweredTwoQubitCost(GateType::H), 0u);
+}
+
+TEST(RoutingTelemetryTest, SabreCountsRoundsAndCandidates) {
+    SabreRouter router(10, 0.25, 0.75);
+    Circuit c(5);
+    c.addGate(Gate::h(0));
+    c.addGate(Gate::cnot(0, 4));
+    auto topology = Topology::linear(5);
+
+    auto result = router.route(c, topology);
+    const auto& t = result.telemetry;
+
+    EXPECT_GE(t.rounds, result.swaps_inserted + 1);
+    EXPECT_GT(t.candidates_scored, 0u);
+    EXPECT_EQ(t.fallbacks, 0u);
+    EXPECT_GE(t.scoring_ms, 0.0);
+    EXPECT_GE(t.bookkeeping_ms, 0.0);
+    ASSERT_EQ(t.swap_participation.size(), 5u);
+    EXPECT_EQ(sum(t.swap_participation), 2 * result.swaps_inserted);
+    EXPECT_EQ(t.lowered_two_qubit_gates, 1 + 3 * result.swaps_inserted);
+
+    ASSERT_EQ(t.parameters.size(), 5u);
+    EXPECT_EQ(t.parameters[0].first, "lookahead_depth");
+    EXPECT_DOUBLE_EQ(t.parameters[0].second, 10.0);
+    EXPECT_DOUBLE_EQ(t.parameters[1].second, 0.25);
+    EXPECT_DOUBLE_EQ(t.parameters[2].second, 0.75);
+    EXPECT_EQ(t.parameters[3].first, "depth_tie_break");
+    EXPECT_DOUBLE_EQ(t.parameters[3].second, 0.0);
+    EXPECT_EQ(t.parameters[4].first, "layout_trials");
+    EXPECT_DOUBLE_EQ(t.parameters[4].second, 1.0);
+}
+
+TEST(RoutingTelemetryTest, InputSwapsAreNotInHeatmap) {
+    SabreRouter router;
+    Circuit c(3);
+    c.addGate(Gate::swap(0, 1));
+    auto result = router.route(c, Topology::linear(3));
+
+    EXPECT_EQ(result.swaps_inserted, 0u);
+    EXPECT_EQ(sum(result.telemetry.swap_participation), 0u);
+    EXPECT_EQ(result.telemetry.lowered_two_qubit_gates, 3u);
+}
+
+TEST(RoutingTelemetryTest, HierarchicalAggregatesLeaves) {
+    auto c = pseudoRandomCircuit(36, 300);
+    auto topology = Topology::grid(6, 6);
+
+    HierarchicalRouter router(9);
+    auto result = router.route(c, topology);
+    const auto& t = result.telemetry;
+
+    EXPECT_GT(t.rounds, 0u);
+    EXPECT_EQ(sum(t.swap_participation), 2 * result.swaps_inserted);
+    std::size_t lowered = 0;
+    for (const auto& gate : result.routed_circuit) {
+        lowered += loweredTwoQubitCost(gate.type());
+    }
+    EXPECT_EQ(t.lowered_two_qubit_gates, lowered);
+    EXPECT_EQ(t.parameters.front().first, "region_size");
+}
+
+TEST(RoutingTelemetryTest, TrivialRouterCountsLoweredGates) {
+    TrivialRouter router;
+    Circuit c(2);
+    c.addGate(Gate::cnot(0, 1));
+    c.addGate(Gate::swap(0, 1));
+    auto result = router.route(c, Topology::linear(2));
+    EXPECT_EQ(result.telemetry.lowered_two_qubit_gates, 4u);
+    EXPECT_EQ(result.gates_emitted, 2u);
+}
+
+TEST(RoutingTelemetryTest, AccumulateSumsCounters) {
+    RoutingTelemetry a;
+    a.rounds = 2;
+    a.swap_participation = {1, 0};
+    RoutingTelemetry b;
+    b.rounds = 3;
+    b.fallbacks = 1;
+    b.swap_participation = {0, 2, 5};
+
+    a.accumulate(b);
+    EXPECT_EQ(a.rounds, 5u);
+    EXPECT_EQ(a.fallbacks, 1u);
+    EXPECT_EQ(a.swap_participation, (std::vector<std::size_t>{1, 2, 5}));
+}
+
+TEST(RoutingTelemetryTest, JsonExport) {
+    SabreRouter router;
+    Circuit c(3);
+    c.addGate(Gate::cnot(0, 2));
+    auto result = router.route(c, Topology::linear(3));
+
+    std::string json = result.toJson();
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_NE(json.find("\"swaps_inserted\":1"), std::string::npos);
+    EXPECT_NE(json.find("\"initial_mapping\":[0,1,2]"), std::string::npos);
+    EXPECT_NE(json.find("\"telemetry\":{\"parameters\":{\"lookahead_depth\":20,"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"lowered_two_qubit_gates\":4"), std::string::npos);
+    EXPECT_NE(json.find("\"swap_participation\":["), std::string::npos);
+}
+
 // =============================================================================
 // Integration Tests
 // =============================================================================